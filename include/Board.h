@@ -102,6 +102,7 @@
 #define TIMER_INIT              19
 
 // Master state machine timers
+#define TIMER_BACKGROUND4       22
 #define TIMER_MAIN              23
 #define TIMER_MAIN2             24
 #define TIMER_MAIN3             25
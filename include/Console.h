@@ -0,0 +1,141 @@
+/**
+ * @file    Console.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Deferred, formatted output for the serial console.
+ *
+ * @details
+ * Formatting with printf (especially floats, which are soft-float on the
+ * PIC32) is too slow for the control loop, and printf drops characters
+ * when the serial transmit buffer is full. Instead, code records a message
+ * ID from ConsoleMessages.h and its raw 32-bit arguments with CONSOLE_LOG,
+ * which only copies a few bytes into a ring buffer. Console_runSM later
+ * empties the ring buffer when the serial port has room, either by
+ * formatting the messages on the board (text mode) or by sending the raw
+ * records for tool/console_decoder to format on the host (binary mode).
+ *
+ * A binary record is: CONSOLE_SYNC, message ID, argument count, the time in
+ * milliseconds (4 bytes), then the arguments (4 bytes each), all little
+ * endian.
+ *
+ * Messages must only be logged from the main loop, not from interrupts.
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef Console_H
+#define Console_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "ConsoleMessages.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define CONSOLE_MODE_TEXT       0 // format on the board in Console_runSM
+#define CONSOLE_MODE_BINARY     1 // send raw records for the host decoder
+
+#define CONSOLE_SYNC            0xC5 // first byte of a binary record
+#define CONSOLE_MAX_ARGS        8
+
+// Convert arguments to the raw 32-bit words that are recorded
+#define CONSOLE_INT(x)          ((uint32_t)(int32_t)(x))
+#define CONSOLE_FLOAT(x)        Console_floatToWord(x)
+
+// Record a message with arguments, e.g. CONSOLE_LOG(ID, CONSOLE_INT(a), CONSOLE_FLOAT(b))
+#define CONSOLE_LOG(id, ...) \
+    do { \
+        const uint32_t consoleArgs[] = { __VA_ARGS__ }; \
+        Console_log((id), consoleArgs, sizeof(consoleArgs) / sizeof(uint32_t)); \
+    } while (0)
+
+// Record a message without arguments
+#define CONSOLE_LOG0(id)        Console_log((id), NULL, 0)
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef enum {
+#define CONSOLE_MESSAGE(name, format) name,
+    CONSOLE_MESSAGES
+#undef CONSOLE_MESSAGE
+    CONSOLE_MESSAGE_COUNT
+} ConsoleMessageId;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: Console_init
+ * @param CONSOLE_MODE_TEXT or CONSOLE_MODE_BINARY.
+ * @return SUCCESS or FAILURE.
+ * @remark Serial must be initialized first. Until this is called, logged
+ *  messages are formatted and printed immediately instead of deferred.
+ * @author David Goodman
+ * @date October 18, 2026 */
+char Console_init(uint8_t mode);
+
+/**
+ * Function: Console_log
+ * @param Message ID from ConsoleMessages.h.
+ * @param Array of raw arguments (see CONSOLE_INT and CONSOLE_FLOAT).
+ * @param Number of arguments.
+ * @return None.
+ * @remark Use the CONSOLE_LOG macros instead of calling this directly. The
+ *  message is dropped and counted if the ring buffer is full.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Console_log(uint8_t id, const uint32_t *args, uint8_t count);
+
+/**
+ * Function: Console_runSM
+ * @return None.
+ * @remark Sends logged messages while the serial transmit buffer has room.
+ *  Call from the main loop.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Console_runSM();
+
+/**
+ * Function: Console_getDropped
+ * @return Number of messages dropped because the ring buffer was full.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint32_t Console_getDropped();
+
+/**
+ * Function: Console_format
+ * @param Array to save the formatted message into.
+ * @param Size of the array.
+ * @param Message ID from ConsoleMessages.h.
+ * @param Array of raw arguments.
+ * @param Number of arguments.
+ * @return Length of the formatted message, or 0 for an unknown ID.
+ * @remark Renders a message the way text mode does, e.g. for a DEBUG_EVENT
+ *  received over MAVLink. Doesn't need Console_init.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t Console_format(char *line, uint16_t size, uint16_t id,
+    const uint32_t *args, uint8_t count);
+
+/**
+ * Function: Console_floatToWord
+ * @param Float argument.
+ * @return The float's bits as a raw argument word.
+ * @date October 18, 2026 */
+static inline uint32_t Console_floatToWord(float value) {
+    union {
+        float f;
+        uint32_t w;
+    } convert;
+    convert.f = value;
+    return convert.w;
+}
+
+#endif // Console_H
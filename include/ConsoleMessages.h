@@ -0,0 +1,34 @@
+/**
+ * @file    ConsoleMessages.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Table of format strings for deferred console messages.
+ *
+ * @details
+ * Each CONSOLE_MESSAGE(name, format) entry defines a message ID (its
+ * position in the table) and the printf format used to render it. Only the
+ * ID and the raw arguments are recorded at run time, so entries must only
+ * use numeric conversions (%d, %u, %x, %c, %f, %e, %g); a %s cannot be
+ * deferred because the string may be gone by the time it is printed.
+ *
+ * The host decoder (tool/console_decoder) reads this file to render binary
+ * console streams, and the IDs are also sent in MAVLink DEBUG_EVENT
+ * messages, so add new entries at the end and never reorder them.
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef ConsoleMessages_H
+#define ConsoleMessages_H
+
+#define CONSOLE_MESSAGES \
+    CONSOLE_MESSAGE(CONSOLE_NAVIGATION_POSITION, "My position: N=%.2f, E=%.2f, D=%.2f\n") \
+    CONSOLE_MESSAGE(CONSOLE_NAVIGATION_COURSE, "\tCourse: distance=%.2f, heading=%.2f\n") \
+    CONSOLE_MESSAGE(CONSOLE_NAVIGATION_DRIVING, "\tDriving: distance=%.2f [m], speed=%d [%%], heading=%.2f [deg]\n") \
+    CONSOLE_MESSAGE(CONSOLE_DRIVE_LEFT_MOTOR, "Setting left motor to RC_TIME=%d\n") \
+    CONSOLE_MESSAGE(CONSOLE_DRIVE_RIGHT_MOTOR, "Setting right motor to RC_TIME=%d\n") \
+    CONSOLE_MESSAGE(CONSOLE_DRIVE_RUDDER, "Setting rudder to RC_TIME=%d\n") \
+    CONSOLE_MESSAGE(CONSOLE_DRIVE_RUDDER_CONTROL, "Rudder control: rDegrees=%d, yDegrees=%d, eDegrees=%d, uDegrees=%.2f, uPercent=%d[%c]\n\n") \
+    CONSOLE_MESSAGE(CONSOLE_DRIVE_TRACK, "R=%d, Y=%d, e=%d, U=%.2f, Up=%d[%c], BB=%d, S=%d\n")
+
+#endif // ConsoleMessages_H
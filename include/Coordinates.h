@@ -0,0 +1,188 @@
+/**
+ * @file    Coordinates.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Coordinate types and the conversions between them.
+ *
+ * @details
+ * ECEF coordinates are kept as whole centimeters, like NAV-SOL sends them.
+ * A float only resolves about half a meter at the size of the earth, so
+ * two float ECEF positions couldn't be subtracted without losing the
+ * difference between them. ECEF coordinates are only subtracted as
+ * integers, and the result, a few kilometers at most, is turned into a
+ * float local (NED) vector from the origin. Conversions from geodetic
+ * coordinates use doubles.
+ *
+ * Positions are converted to NED every update, always from the same
+ * origin, so a LocalOrigin keeps the origin's rotation from ECEF to NED
+ * and a conversion is only a subtraction and a matrix multiply.
+ *
+ * Moved here from Gps.c so they also build on a host (see
+ * tool/ecef_accuracy and tool/ned_benchmark).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef Coordinates_H
+#define Coordinates_H
+
+#include <math.h>
+#include <stdint.h>
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define PI                      M_PI
+#define DEGREE_TO_RADIAN        ((float)(PI/(float)180.0))
+#define RADIAN_TO_DEGREE        ((float)((float)180.0/PI))
+
+#define ECEF_PER_METER          100 // GeocentricCoordinate is in cm
+#define ECEF_TO_METERS(coord)   ((float)(coord)/ECEF_PER_METER)
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+// Geodetic (lat, lon, alt) coordinate
+typedef struct oGeodeticCoord {
+    float lat, lon, alt;
+} GeodeticCoordinate;
+
+// Geocentric (ECEF) coordinate in centimeters
+typedef struct oGeocentricCoord {
+    int32_t x, y, z;
+} GeocentricCoordinate;
+
+// Local (NED) coordinate
+typedef struct oLocalCoord {
+    float north, east, down;
+} LocalCoordinate;
+
+// Origin of the local (NED) frame, with its ECEF to NED rotation
+typedef struct oLocalOrigin {
+    GeocentricCoordinate ecef;
+    GeodeticCoordinate lla;
+    float rotation[3][3];   // rows are north, east and down in ECEF
+} LocalOrigin;
+
+// Course vector, where d is distance and heading is degrees from North
+typedef struct oCourseVector {
+    float distance, heading;
+} CourseVector;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: convertGeodetic2ECEF
+ * @param A pointer to a new ECEF coordinate variable to save result into.
+ * @param A pointer to a geodetic position.
+ * @return None.
+ * @remark Converts the given geodetic (LLA) coordinate into a geocentric (ECEF)
+ *  coordinate in degrees.
+ * @author David Goodman
+ * @author MATLAB
+ * @date 2013.03.10  */
+void convertGeodetic2ECEF(GeocentricCoordinate *ecef, GeodeticCoordinate *lla);
+
+/**
+ * Function: convertFixedGeodetic2ECEF
+ * @param A pointer to a new ECEF coordinate variable to save result into.
+ * @param Latitude in 1e-7 degrees.
+ * @param Longitude in 1e-7 degrees.
+ * @param Height above the ellipsoid in millimeters.
+ * @return None.
+ * @remark Like convertGeodetic2ECEF, for a position as the receiver sends
+ *  it (e.g. NAV-PVT), which a float would round to about half a meter.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void convertFixedGeodetic2ECEF(GeocentricCoordinate *ecef, int32_t lat, int32_t lon,
+    int32_t height);
+
+/**
+ * Function: convertECEF2Geodetic
+ * @param A pointer to a new geodetic position.
+ * @param A pointer to an ECEF coordinate.
+ * @return None.
+ * @remark Converts the given ECEF coordinates into a geodetic coordinate in degrees.
+ * @author David Goodman
+ * @author MATLAB
+ * @date 2013.03.10 */
+void convertECEF2Geodetic(GeodeticCoordinate *lla, GeocentricCoordinate *ecef);
+
+
+/**
+ * Function: projectEulerToNED
+ * @param A pointer to a new NED coordinate variable to save result into.
+ * @param Yaw in degrees from north.
+ * @param Pitch in degrees from level.
+ * @param Height in meters from target.
+ * @return None.
+ * @remark Projects a ray with the given height from the given yaw and
+ *  pitch, and returns a NED for the intersection location.
+ * @author David Goodman
+ * @date 2013.03.10  */
+void projectEulerToNED(LocalCoordinate *ned, float yaw, float pitch, float height);
+
+
+/**
+ * Function: getCourseVector
+ * @param A pointer to a new NED vector variable to save result into.
+ * @param A pointer to a NED reference position (current position).
+ * @param A poimter to a NED position (desired position).
+ * @return None.
+ * @remark Calculates a vector (magnitude and angle) pointing from
+ *  the current NED position to the desired NED position. Note that
+ *  the down component (z) is not used.
+ * @author David Goodman
+ * @date 2013.04.02  */
+void getCourseVector(CourseVector *course, LocalCoordinate *ned_cur,
+        LocalCoordinate *ned_des);
+
+
+/**
+ * Function: convertECEF2NED
+ * @param A pointer to a new NED vector variable to save result into.
+ * @param A pointer to an ECEF position (current position).
+ * @param A pointer to an ECEF reference position.
+ * @param A pointer to the same referemce position, but in geodetic coords.
+ * @return None.
+ * @remark Converts the ECEF position into a NED vector starting from the
+ *  geodetic reference point. Note that this function does not use the down
+ *  component (z), though it will be used to calculate the north component.
+ *  The positions are subtracted as integers, so the vector keeps every
+ *  centimeter.
+ * @author David Goodman
+ * @date 2013.04.02  */
+void convertECEF2NED(LocalCoordinate *ned, GeocentricCoordinate *ecef_cur,
+    GeocentricCoordinate *ecef_ref, GeodeticCoordinate *geo_ref);
+
+
+/**
+ * Function: setLocalOrigin
+ * @param A pointer to the origin to set.
+ * @param A pointer to the origin's ECEF position.
+ * @return None.
+ * @remark Works out the origin's geodetic position and its rotation from
+ *  ECEF to NED, once, for convertECEF2LocalNED.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void setLocalOrigin(LocalOrigin *origin, GeocentricCoordinate *ecef);
+
+
+/**
+ * Function: convertECEF2LocalNED
+ * @param A pointer to a new NED vector variable to save result into.
+ * @param A pointer to an ECEF position (current position).
+ * @param A pointer to an origin set by setLocalOrigin.
+ * @return None.
+ * @remark Like convertECEF2NED, without working out the rotation again.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void convertECEF2LocalNED(LocalCoordinate *ned, GeocentricCoordinate *ecef,
+    const LocalOrigin *origin);
+
+#endif // Coordinates_H
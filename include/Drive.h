@@ -86,13 +86,16 @@ void Drive_stop();
 
 
 /**********************************************************************
- * Function: Drive_getDebugString
- * @return None
- * @remark 
+ * Function: Drive_getDebugEvent
+ * @param Array for the arguments, with room for CONSOLE_MAX_ARGS.
+ * @return Number of arguments, or 0 if nothing new.
+ * @remark Arguments of a CONSOLE_DRIVE_TRACK message from the last rudder
+ *  update, if there was one since the last call. Send them with
+ *  Mavlink_sendDebugEvent.
  * @author David Goodman
- * @date 2013.05.25 
+ * @date 2026.10.18 
  **********************************************************************/
-char *Drive_getDebugString();
+uint8_t Drive_getDebugEvent(uint32_t *args);
 
 
 #endif // Drive_H
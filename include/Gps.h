@@ -13,7 +13,7 @@
  *
  * @note
  *  The longitude and latitude can be in either ECEF or geodetic coordinates,
- *      where ECEF is in meters.
+ *      where ECEF is in centimeters (see Coordinates.h).
  *  The heading is in degrees from north, from 0 to 360.
  *  The velocity is in m/s.
  * 
@@ -22,7 +22,9 @@
 #ifndef Gps_H
 #define Gps_H
 #include <math.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include "Coordinates.h"
 
 
 /***********************************************************************
@@ -31,34 +33,32 @@
 #define USE_GEOCENTRIC_COORDINATES  // uses GEODETIC if not defined
 
 
-#define PI                      M_PI
-#define DEGREE_TO_RADIAN        ((float)(PI/(float)180.0))
-#define RADIAN_TO_DEGREE        ((float)((float)180.0/PI))
-
-
 /***********************************************************************
  * PUBLIC TYPEDEFS
  ***********************************************************************/
 
-// Geodetic (lat, lon, alt) coordinate
-typedef struct oGeodeticCoord {
-    float lat, lon, alt;
-} GeodeticCoordinate;
-
-// Geocentric (ECEF) coordinate
-typedef struct oGeocentricCoord {
-    float x, y, z;
-} GeocentricCoordinate;
-
-// Local (NED) coordinate
-typedef struct oLocalCoord {
-    float north, east, down;
-} LocalCoordinate;
+// One navigation solution from the receiver, see GPS_getLatestFix
+typedef struct GpsFix {
+    uint32_t iTow;          // (ms) GPS time of week of the solution
+    uint32_t time;          // (ms) from get_time, when its message arrived
+#ifdef USE_GEOCENTRIC_COORDINATES
+    GeocentricCoordinate position;
+#else
+    GeodeticCoordinate position;
+#endif
+    int32_t northVelocity, eastVelocity; // (cm/s)
+    int32_t heading;        // (1e-5 deg) of motion
+    uint32_t hAcc, vAcc;    // (mm) accuracy estimates, 3D for NAV-SOL
+    uint8_t numSv;          // satellites used
+    uint8_t fixType;        // 0 no fix, 2 2D, 3 3D
+} GpsFix;
 
-// Course vector, where d is distance and heading is degrees from North
-typedef struct oCourseVector {
-    float distance, heading;
-} CourseVector;
+// Counters for the UBX frames from the receiver, see GPS_getStatistics
+typedef struct GpsStatistics {
+    uint32_t frames;            // frames with a good checksum
+    uint32_t checksumErrors;    // frames dropped for a bad length or checksum
+    uint32_t resyncBytes;       // bytes skipped looking for the sync bytes
+} GpsStatistics;
 
 
 /***********************************************************************
@@ -86,6 +86,14 @@ bool GPS_isInitialized();
  **********************************************************************/
 void GPS_runSM();
 
+/**********************************************************************
+ * Function: GPS_isConfigured
+ * @return TRUE once the receiver's baud rate, rate and messages are set.
+ * @remark Positions can arrive before then, at the rate the receiver was
+ *  left at.
+ **********************************************************************/
+bool GPS_isConfigured();
+
 /**********************************************************************
  * Function: GPS_hasFix
  * @return TRUE if a lock has been obtained.
@@ -113,7 +121,7 @@ bool GPS_isConnected();
  * Function: GPS_getPosition
  * @param New geocentric coordinate to copy position into.
  * @return none
- * @remark  Copies the measured geocentric (ECEF) position in meters into the
+ * @remark  Copies the measured geocentric (ECEF) position in centimeters into the
  *  given coordinate object.
  **********************************************************************/
 void GPS_getPosition(GeocentricCoordinate *ecefPos);
@@ -151,101 +159,66 @@ int32_t GPS_getEastVelocity();
  **********************************************************************/
 float GPS_getVelocity();
 
-
 /**********************************************************************
- * Function: GPS_getHeading
- * @return Returns the current heading in degrees.
- * @remark 
+ * Function: GPS_getFixTime
+ * @return Time in milliseconds when the message with the current position
+ *  started arriving, or 0 if it is not known.
+ * @remark Compare with get_time() to find how old the position is.
  **********************************************************************/
-float GPS_getHeading();
-
+uint32_t GPS_getFixTime();
 
+/**********************************************************************
+ * Function: GPS_getStatistics
+ * @return Frame, checksum error and resync counters, read only.
+ * @remark Counted since GPS_init.
+ **********************************************************************/
+const GpsStatistics *GPS_getStatistics();
 
-/***********************************************************************
- * Library FUNCTIONS
- ***********************************************************************/
-
-/**
- * Function: convertENU2ECEF
- * @param A pointer to a new ECEF coordinate variable to save result into.
- * @param East component in meters.
- * @param North component in meters.
- * @param Up component in meters.
- * @return None.
- * @remark Converts the given ENU vector into a ECEF coordinate.
- * @author David Goodman
- * @author MATLAB
- * @date 2013.03.10  
-void convertENU2ECEF(GeocentricCoordinate *ecef, float east, float north, float up, float lat_ref,
-    float lon_ref, float alt_ref);
-*/
+/**********************************************************************
+ * Function: GPS_getLatestFix
+ * @return The newest fix with a position and velocity, or NULL if there
+ *  are none yet.
+ * @remark Read only, and replaced by the next fix.
+ **********************************************************************/
+const GpsFix *GPS_getLatestFix();
 
-/**
- * Function: convertGeodetic2ECEF
- * @param A pointer to a new ECEF coordinate variable to save result into.
- * @param A pointer to a geodetic position.
- * @return None.
- * @remark Converts the given geodetic (LLA) coordinate into a geocentric (ECEF)
- *  coordinate in degrees.
- * @author David Goodman
- * @author MATLAB
- * @date 2013.03.10  */
-void convertGeodetic2ECEF(GeocentricCoordinate *ecef, GeodeticCoordinate *lla);
+/**********************************************************************
+ * Function: GPS_getFixAt
+ * @param Time in milliseconds, from get_time.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is within the last GPS_HISTORY_LENGTH fixes.
+ * @remark Interpolated between the fixes before and after the time.
+ **********************************************************************/
+bool GPS_getFixAt(uint32_t time, GpsFix *fix);
 
-/**
- * Function: convertECEF2Geodetic
- * @param A pointer to a new geodetic position.
- * @param A pointer to an ECEF coordinate.
- * @return None.
- * @remark Converts the given ECEF coordinates into a geodetic coordinate in degrees.
- * @author David Goodman
- * @author MATLAB
- * @date 2013.03.10 */
-void convertECEF2Geodetic(GeodeticCoordinate *lla, GeocentricCoordinate *ecef);
- 
+/**********************************************************************
+ * Function: GPS_getFixAtTow
+ * @param GPS time of week in milliseconds.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is within the last GPS_HISTORY_LENGTH fixes.
+ * @remark Like GPS_getFixAt, for data stamped with GPS time.
+ **********************************************************************/
+bool GPS_getFixAtTow(uint32_t iTow, GpsFix *fix);
 
-/**
- * Function: projectEulerToNED
- * @param A pointer to a new NED coordinate variable to save result into.
- * @param Yaw in degrees from north.
- * @param Pitch in degrees from level.
- * @param Height in meters from target.
- * @return None.
- * @remark Projects a ray with the given height from the given yaw and
- *  pitch, and returns a NED for the intersection location.
- * @author David Goodman
- * @date 2013.03.10  */
-void projectEulerToNED(LocalCoordinate *ned, float yaw, float pitch, float height);
+/**********************************************************************
+ * Function: GPS_isFixUsable
+ * @param Fix, e.g. from GPS_getLatestFix.
+ * @param Oldest it can be, in milliseconds.
+ * @param Worst horizontal accuracy it can have, in millimeters.
+ * @return TRUE if the fix is recent and accurate enough.
+ * @remark FALSE for NULL, so the result of GPS_getLatestFix can be passed
+ *  straight in.
+ **********************************************************************/
+bool GPS_isFixUsable(const GpsFix *fix, uint32_t maxAge, uint32_t maxAccuracy);
 
 
-/**
- * Function: getCourseVector
- * @param A pointer to a new NED vector variable to save result into.
- * @param A pointer to a NED reference position (current position).
- * @param A poimter to a NED position (desired position).
- * @return None.
- * @remark Calculates a vector (magnitude and angle) pointing from
- *  the current NED position to the desired NED position. Note that
- *  the down component (z) is not used.
- * @author David Goodman
- * @date 2013.04.02  */
-void getCourseVector(CourseVector *course, LocalCoordinate *ned_cur,
-        LocalCoordinate *ned_des);
+/**********************************************************************
+ * Function: GPS_getHeading
+ * @return Returns the current heading in degrees.
+ * @remark 
+ **********************************************************************/
+float GPS_getHeading();
 
 
-/**
- * Function: convertECEF2NED
- * @param A pointer to a new NED vector variable to save result into.
- * @param A pointer to an ECEF position (current position).
- * @param A pointer to an ECEF reference position.
- * @param A pointer to the same referemce position, but in geodetic coords.
- * @return None.
- * @remark Converts the ECEF position into a NED vector starting from the
- *  geodetic reference point. Note that this function does not use the down
- *  component (z), though it will be used to calculate the north component.
- * @author David Goodman
- * @date 2013.04.02  */
-void convertECEF2NED(LocalCoordinate *ned, GeocentricCoordinate *ecef_cur,
-    GeocentricCoordinate *ecef_ref, GeodeticCoordinate *geo_ref);
 
 #endif
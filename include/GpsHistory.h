@@ -0,0 +1,103 @@
+/**
+ * @file    GpsHistory.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Ring buffer of the last GPS fixes, by arrival and GPS time.
+ *
+ * @details
+ * The GPS adds each decoded navigation solution, with its GPS time of
+ * week (iTow) and local arrival time, so other modules can look up the
+ * latest fix or where the boat was at a given time without parsing
+ * again. Between two fixes the position, velocity and heading are
+ * interpolated; accuracies are the worse of the two.
+ *
+ * Fixes are added in time order, so lookups are a binary search over at
+ * most GPS_HISTORY_LENGTH fixes. When full, the oldest fix is replaced.
+ *
+ * Doesn't use the UART or timers, so it also builds on a host (see
+ * tool/gps_history).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef GpsHistory_H
+#define GpsHistory_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Gps.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define GPS_HISTORY_LENGTH      16 // fixes, 1.6 s at 10 Hz
+
+#define GPS_WEEK_MS             604800000UL // iTow wraps here
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct GpsHistory {
+    GpsFix fixes[GPS_HISTORY_LENGTH];
+    uint8_t latest;         // index of the newest fix
+    uint8_t count;          // fixes held
+} GpsHistory;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: GpsHistory_init
+ * @param History to empty.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void GpsHistory_init(GpsHistory *history);
+
+/**
+ * Function: GpsHistory_add
+ * @param History.
+ * @param Fix to copy in, newer than the ones held.
+ * @return None.
+ * @remark A fix that isn't newer, by iTow, empties the history first,
+ *  since the receiver was reset or the times can't be compared.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void GpsHistory_add(GpsHistory *history, const GpsFix *fix);
+
+/**
+ * Function: GpsHistory_getLatest
+ * @param History.
+ * @return The newest fix, or NULL if there are none.
+ * @author David Goodman
+ * @date October 18, 2026 */
+const GpsFix *GpsHistory_getLatest(const GpsHistory *history);
+
+/**
+ * Function: GpsHistory_getAt
+ * @param History.
+ * @param Local time in milliseconds, as in GpsFix.time.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is between the oldest and newest fixes.
+ * @remark Interpolated between the fixes on either side.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool GpsHistory_getAt(const GpsHistory *history, uint32_t time, GpsFix *fix);
+
+/**
+ * Function: GpsHistory_getAtTow
+ * @param History.
+ * @param GPS time of week in milliseconds.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is between the oldest and newest fixes.
+ * @remark Like GpsHistory_getAt, e.g. for corrections stamped with GPS
+ *  time. Works across the end of the week.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool GpsHistory_getAtTow(const GpsHistory *history, uint32_t iTow, GpsFix *fix);
+
+#endif // GpsHistory_H
@@ -14,6 +14,7 @@
  *
  */
 #include "Error.h"
+#include "LinkStats.h"
 
 #ifndef INTERFACE_H
 #define INTERFACE_H
@@ -276,6 +277,16 @@ void Interface_showErrorMessage(error_t errorCode);
  **********************************************************************/
 void Interface_showBoatErrorMessage(error_t errorCode);
 
+/**********************************************************************
+ * Function: Interface_showLinkStats
+ * @param Link statistics to print.
+ * @return None.
+ * @remark Prints the RTT min/avg/max, loss rate, CRC failures and bytes/s
+ *  from the boat under the ready message. Does nothing while any other
+ *  message is showing.
+ **********************************************************************/
+void Interface_showLinkStats(const LinkStats *stats);
+
 /**********************************************************************
  * Function: Interface_clearAll
  * @param None.
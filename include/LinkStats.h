@@ -0,0 +1,160 @@
+/**
+ * @file    LinkStats.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Measures the XBee link between the command center and the boat.
+ *
+ * @details
+ * Both ends keep these statistics about what they receive from the other.
+ * Heartbeats carry the sender's time and, echoed back, the time from the
+ * last heartbeat it got and how long it held it. The original sender takes
+ * the round trip time from that echo. The last LINK_STATS_RTT_SAMPLES
+ * round trips give the RTT min, average and max.
+ *
+ * Heartbeats also carry how many frames the sender has written to its
+ * UART. Frames the sender wrote but that never arrived whole count as
+ * lost. Counting frames is used rather than MAVLink sequence gaps, because
+ * the scheduler reorders frames by priority and replaces stale telemetry.
+ *
+ * Loss rate, CRC failures and bytes/s are worked out over each
+ * LINK_STATS_WINDOW.
+ *
+ * Only uses the MAVLink headers, and takes the time as an argument, so it
+ * also builds on a host (see tool/link_stats).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef LinkStats_H
+#define LinkStats_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define LINK_STATS_RTT_SAMPLES      8 // round trips kept for min/avg/max
+#define LINK_STATS_WINDOW           10000 // (ms) for loss and rates
+#define LINK_STATS_NO_ECHO          0xFFFF // echoDelay with nothing to echo
+#define LINK_STATS_MAX_RTT          60000 // (ms) longer samples are dropped
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct LinkStats {
+    // Round trip time, from heartbeat echoes
+    uint16_t rttSamples[LINK_STATS_RTT_SAMPLES]; // (ms)
+    uint8_t rttCount; // samples held
+    uint8_t rttNext;
+    uint16_t rttMin; // (ms) of the samples held
+    uint16_t rttAverage; // (ms)
+    uint16_t rttMax; // (ms)
+
+    // Last heartbeat from the other end, to echo
+    bool hasPeerTime;
+    uint32_t peerTime; // (ms) on the other end's clock
+    uint32_t peerArrival; // (ms) when it arrived
+
+    // Frames the other end says it sent, for loss
+    bool hasPeerCount;
+    uint16_t peerFramesSent;
+    uint32_t receivedAtPeerCount;
+    int32_t frameSurplus; // received ahead of the other end's count
+
+    // Totals
+    uint32_t framesReceived;
+    uint32_t framesSent;
+    uint32_t framesLost;
+    uint32_t bytesIn;
+    uint32_t bytesOut;
+    uint32_t crcErrors;
+
+    // Current window
+    uint32_t windowStart; // (ms)
+    bool hasWindow;
+    uint32_t windowPeerSent; // frames the other end sent in the window
+    uint32_t windowLost;
+    uint32_t windowBytesIn;
+    uint32_t windowBytesOut;
+    uint32_t windowCrcErrors;
+
+    // Last complete window
+    uint16_t lossRate; // (0.1%) of the frames the other end sent
+    uint16_t crcErrorCount;
+    uint16_t bytesInRate; // (bytes/s)
+    uint16_t bytesOutRate; // (bytes/s)
+} LinkStats;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: LinkStats_init
+ * @param Statistics to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void LinkStats_init(LinkStats *stats);
+
+/**
+ * Function: LinkStats_received
+ * @param Statistics.
+ * @param Length of a good frame from the other end.
+ * @return None.
+ * @remark Call for every frame the parser accepts.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void LinkStats_received(LinkStats *stats, uint16_t length);
+
+/**
+ * Function: LinkStats_sent
+ * @param Statistics.
+ * @param Length of a frame written to the link.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void LinkStats_sent(LinkStats *stats, uint16_t length);
+
+/**
+ * Function: LinkStats_fillHeartbeat
+ * @param Statistics.
+ * @param Heartbeat to fill in.
+ * @param Current time (ms).
+ * @return None.
+ * @remark Sets the time, echo and frame count fields, leaving ack and data.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void LinkStats_fillHeartbeat(LinkStats *stats, mavlink_heartbeat_t *heartbeat,
+    uint32_t time);
+
+/**
+ * Function: LinkStats_handleHeartbeat
+ * @param Statistics.
+ * @param Heartbeat from the other end.
+ * @param Time (ms) the heartbeat's first byte arrived.
+ * @return TRUE if it gave a round trip time.
+ * @remark Call after LinkStats_received for the heartbeat's frame.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool LinkStats_handleHeartbeat(LinkStats *stats, const mavlink_heartbeat_t *heartbeat,
+    uint32_t arrival);
+
+/**
+ * Function: LinkStats_runSM
+ * @param Statistics.
+ * @param CRC failures counted by the parser so far.
+ * @param Current time (ms).
+ * @return None.
+ * @remark Works out the loss rate, CRC failures and byte rates at the end
+ *  of each window.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void LinkStats_runSM(LinkStats *stats, uint32_t crcErrors, uint32_t time);
+
+#endif // LinkStats_H
@@ -20,16 +20,14 @@
 #include "mavlink/autoLifeguard/mavlink.h"
 #include "Xbee.h"
 #include "Gps.h"
+#include "Transport.h"
+#include "Scheduler.h"
+#include "LinkStats.h"
 
 /***********************************************************************
  * PUBLIC DEFINITIONS                                                  *
  ***********************************************************************/
-// Acknowledgement related
-#define ACK_STATUS_NO_ACK 0
-#define ACK_STATUS_RECIEVED 1
-#define ACK_STATUS_WAIT 2
-#define ACK_STATUS_DEAD 3
-
+// Acknowledgement related (ACK_STATUS_* are in Transport.h)
 #define WANT_ACK    TRUE
 #define NO_ACK      FALSE
 
@@ -66,6 +64,13 @@
 #define MAVLINK_SENDER_ATLAS            0x1
 #define MAVLINK_SENDER_COMPAS           0x2
 
+// Heartbeat data bits
+#define MAVLINK_HEARTBEAT_ALIVE         0x1 // always set
+#define MAVLINK_HEARTBEAT_TRIMMED       0x2 // sender takes trimmed payloads
+
+// Drop the trailing zeros of payloads sent to an end that takes them
+#define MAVLINK_TRIM_PAYLOADS
+
 // * at end denotes WANT_ACK
 
 /**********************************************************************
@@ -81,6 +86,9 @@ union MAVLINK_MESSAGE {
     mavlink_gps_ned_t           gpsLocalData;
     mavlink_data_t              telemetryData;
     mavlink_debug_t             debugData;
+    mavlink_debug_event_t       debugEventData;
+    mavlink_uart_stats_t        uartStatsData;
+    mavlink_boat_state_t        boatStateData; // also rebuilt from deltas
 } Mavlink_newMessage;
 
 mavlink_heartbeat_t Mavlink_heartbeatData;
@@ -90,14 +98,50 @@ mavlink_heartbeat_t Mavlink_heartbeatData;
  **********************************************************************/
 void Mavlink_recieve();
 
+// Parses MAVLink frames from a span that arrived at the given time (ms),
+// e.g. the RF data of an XBee API frame, instead of reading the UART
+void Mavlink_parse(const uint8_t *data, uint16_t length, uint32_t time);
+
+// Moves the oldest received message into Mavlink_newMessage, FALSE if none
 bool Mavlink_hasNewMessage();
 
 int Mavlink_getNewMessageID();
 
+uint8_t Mavlink_getNewMessageSysID();
+
+// Time (ms) when the first byte of the new message arrived, or 0 if unknown
+uint32_t Mavlink_getNewMessageTime();
+
+// Messages dropped because the receive queue was full
+uint32_t Mavlink_getQueueDropped();
+
 
 bool Mavlink_hasHeartbeat();
 
 
+/*----------------------- Acknowledgements ---------------------------*/
+
+/* Messages sent with WANT_ACK are resent until acked. Returns an ACK_STATUS_*
+ * for the message with the given ID and status code. */
+uint8_t Mavlink_getAckStatus(uint8_t msgID, uint16_t msgStatus);
+
+// Stops resending every message still waiting for an ACK
+void Mavlink_cancelResends();
+
+// Resends messages whose ACK is overdue and sends queued messages as the
+// link allows, called from Xbee_runSM
+void Mavlink_runSM();
+
+// Resend counters and the RTT estimate, read only
+const Transport *Mavlink_getTransport();
+
+// Queue counters and waits by priority, read only
+const Scheduler *Mavlink_getScheduler();
+
+// Link RTT, loss, CRC failures and bytes/s from the heartbeats, read only
+const LinkStats *Mavlink_getLinkStats();
+
+
 /*------------------------- Send Messages ----------------------------*/
 
 void Mavlink_sendAck(uint8_t msgID, uint16_t msgStatus);
@@ -142,8 +186,22 @@ void Mavlink_sendBoatPosition(LocalCoordinate *nedPos);
 
 void Mavlink_sendBoatData(float temperature, float altitude, uint16_t batVolt1, uint16_t batVolt2);
 
+/* Sends the boat's state as a keyframe or a delta (see Telemetry.h). Heading
+ * is in degrees and speed in m/s. Received deltas come out of the queue as
+ * full BOAT_STATE messages. */
+void Mavlink_sendBoatState(LocalCoordinate *nedPos, float heading, float speed,
+    uint8_t navState, uint8_t error, uint16_t batVolt1, uint16_t batVolt2);
+
 void Mavlink_sendDebug(char sender, char *message);
 
+/* Sends a message ID from ConsoleMessages.h and its raw arguments (see
+ * CONSOLE_INT and CONSOLE_FLOAT), for the receiver to format with
+ * Console_format. Much shorter than the text Mavlink_sendDebug sends. */
+void Mavlink_sendDebugEvent(uint8_t sender, uint16_t id, const uint32_t *args,
+    uint8_t count);
+
+void Mavlink_sendUartStatistics(uint8_t uartId);
+
 
 #ifdef XBEE_TEST
 void Mavlink_send_Test_data(uint8_t uart_id, uint8_t data);
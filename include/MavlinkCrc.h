@@ -0,0 +1,114 @@
+/**
+ * @file    MavlinkCrc.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Table-driven X.25 checksum for MAVLink frames.
+ *
+ * @details
+ * Gives the same checksum as crc_accumulate in mavlink/checksum.h, run over
+ * a whole span at a time. MAVLINK_CRC_METHOD picks how, trading flash for
+ * speed:
+ *   MAVLINK_CRC_BITWISE  crc_accumulate's shifts, no table
+ *   MAVLINK_CRC_NIBBLE   two lookups a byte in a 16 entry table (32 bytes)
+ *   MAVLINK_CRC_TABLE    one lookup a byte in a 256 entry table (512 bytes)
+ *   MAVLINK_CRC_SLICE8   eight bytes at a time in 8 tables built in RAM
+ *                        (4 KB), for tools on a host only
+ *
+ * MavlinkCrc_update uses the chosen method. Defining MAVLINK_CRC_ALL also
+ * builds every method under its own name, so a tool can compare them (see
+ * tool/crc_benchmark).
+ *
+ * Only uses stdint, so it also builds on a host.
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef MavlinkCrc_H
+#define MavlinkCrc_H
+
+#include <stdint.h>
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define MAVLINK_CRC_BITWISE     0
+#define MAVLINK_CRC_NIBBLE      1
+#define MAVLINK_CRC_TABLE       2
+#define MAVLINK_CRC_SLICE8      3
+
+#ifndef MAVLINK_CRC_METHOD
+#define MAVLINK_CRC_METHOD      MAVLINK_CRC_TABLE
+#endif
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_SLICE8 && defined(__PIC32MX__)
+#error "MAVLINK_CRC_SLICE8 needs 4 KB of RAM, use MAVLINK_CRC_TABLE on the PIC32."
+#endif
+
+#define MAVLINK_CRC_INIT        0xFFFF // X25_INIT_CRC
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_BITWISE
+#define MavlinkCrc_update       MavlinkCrc_updateBitwise
+#elif MAVLINK_CRC_METHOD == MAVLINK_CRC_NIBBLE
+#define MavlinkCrc_update       MavlinkCrc_updateNibble
+#elif MAVLINK_CRC_METHOD == MAVLINK_CRC_TABLE
+#define MavlinkCrc_update       MavlinkCrc_updateTable
+#elif MAVLINK_CRC_METHOD == MAVLINK_CRC_SLICE8
+#define MavlinkCrc_update       MavlinkCrc_updateSlice8
+#else
+#error "Unknown MAVLINK_CRC_METHOD."
+#endif
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: MavlinkCrc_update
+ * @param Checksum so far, MAVLINK_CRC_INIT to start.
+ * @param Bytes to add.
+ * @param Number of bytes.
+ * @return Checksum with the bytes added.
+ * @remark Same as calling crc_accumulate on each byte. Calls the function
+ *  for MAVLINK_CRC_METHOD, below.
+ * @author David Goodman
+ * @date October 18, 2026 */
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_BITWISE || defined(MAVLINK_CRC_ALL)
+/**
+ * Function: MavlinkCrc_updateBitwise
+ * @remark MavlinkCrc_update with MAVLINK_CRC_BITWISE.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkCrc_updateBitwise(uint16_t crc, const uint8_t *data, uint16_t length);
+#endif
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_NIBBLE || defined(MAVLINK_CRC_ALL)
+/**
+ * Function: MavlinkCrc_updateNibble
+ * @remark MavlinkCrc_update with MAVLINK_CRC_NIBBLE.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkCrc_updateNibble(uint16_t crc, const uint8_t *data, uint16_t length);
+#endif
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_TABLE || defined(MAVLINK_CRC_ALL)
+/**
+ * Function: MavlinkCrc_updateTable
+ * @remark MavlinkCrc_update with MAVLINK_CRC_TABLE.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkCrc_updateTable(uint16_t crc, const uint8_t *data, uint16_t length);
+#endif
+
+#if MAVLINK_CRC_METHOD == MAVLINK_CRC_SLICE8 || defined(MAVLINK_CRC_ALL)
+/**
+ * Function: MavlinkCrc_updateSlice8
+ * @remark MavlinkCrc_update with MAVLINK_CRC_SLICE8. Builds its tables on
+ *  the first call.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkCrc_updateSlice8(uint16_t crc, const uint8_t *data, uint16_t length);
+#endif
+
+#endif // MavlinkCrc_H
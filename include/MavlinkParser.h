@@ -0,0 +1,114 @@
+/**
+ * @file    MavlinkParser.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Span-based parser for MAVLink 1.0 frames.
+ *
+ * @details
+ * Replaces feeding mavlink_parse_char one byte at a time. The parser scans
+ * a whole span of received bytes (e.g. from UART_peekContiguous) for the
+ * start byte, then checks the length and X.25 checksum (with the dialect's
+ * crc_extra) of each frame in a tight loop. Frames that lie entirely inside
+ * the span are handed to the handler in place, without copying. A frame cut
+ * off by the end of the span is saved and completed from the next span.
+ *
+ * After a bad checksum the parser only skips the start byte, so it finds the
+ * next frame in the bytes it had already taken as payload. A length too
+ * long for the message is caught as soon as the header is in, so the
+ * frames behind it aren't held back.
+ *
+ * A payload shorter than the dialect's length had its trailing zeros
+ * dropped by the sender (see _mav_trim_payload). The parser puts them back,
+ * so the handler always gets the full payload.
+ *
+ * MavlinkParser_pack goes the other way, writing a whole frame from a
+ * payload struct straight into the caller's buffer, without building a
+ * mavlink_message_t first.
+ *
+ * Only uses the MAVLink headers, so it also builds on a host (see
+ * tool/mavlink_benchmark).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef MavlinkParser_H
+#define MavlinkParser_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+// A checked frame, valid only while the handler runs
+typedef struct MavlinkFrame {
+    uint8_t msgid;
+    uint8_t sysid;
+    uint8_t compid;
+    uint8_t seq;
+    uint8_t len;        // payload length, with any dropped zeros put back
+    uint8_t wireLen;    // payload length as received
+    const uint8_t *payload;
+    int16_t start; // offset of the start byte in the span, -1 if in an earlier one
+} MavlinkFrame;
+
+typedef void (*MavlinkFrameHandler)(const MavlinkFrame *frame);
+
+typedef struct MavlinkParser {
+    uint8_t pending[MAVLINK_MAX_PACKET_LEN]; // frame cut off by the end of a span
+    uint8_t payload[MAVLINK_MAX_DIALECT_PAYLOAD_SIZE]; // trimmed payload filled out
+    uint16_t pendingLength;
+    int16_t pendingStart;   // offset of the pending frame in the last span, or -1
+    uint32_t frameCount;    // frames passed to the handler
+    uint32_t errorCount;    // frames with a bad length or checksum
+    uint32_t skippedCount;  // bytes skipped while looking for a start byte
+} MavlinkParser;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: MavlinkParser_init
+ * @param Parser to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void MavlinkParser_init(MavlinkParser *parser);
+
+/**
+ * Function: MavlinkParser_parse
+ * @param Parser.
+ * @param Span of received bytes.
+ * @param Number of bytes in the span.
+ * @param Function to call with each good frame.
+ * @return Number of frames passed to the handler.
+ * @remark Takes every byte of the span, so the caller can consume all of it.
+ *  If a frame is left pending and it started in this span, its offset is in
+ *  the parser's pendingStart.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkParser_parse(MavlinkParser *parser, const uint8_t *data,
+    uint16_t length, MavlinkFrameHandler handler);
+
+/**
+ * Function: MavlinkParser_pack
+ * @param Buffer for the frame, with room for the payload length plus
+ *  MAVLINK_NUM_NON_PAYLOAD_BYTES.
+ * @param Sequence number.
+ * @param System ID.
+ * @param Component ID.
+ * @param Message ID.
+ * @param Payload, e.g. a mavlink_*_t struct, which is already in wire order
+ *  on a little endian CPU.
+ * @param Payload length.
+ * @return Length of the frame.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t MavlinkParser_pack(uint8_t *frame, uint8_t seq, uint8_t sysid,
+    uint8_t compid, uint8_t msgid, const void *payload, uint8_t length);
+
+#endif // MavlinkParser_H
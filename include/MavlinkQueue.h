@@ -0,0 +1,111 @@
+/**
+ * @file    MavlinkQueue.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Queue of received MAVLink messages waiting for the state machines.
+ *
+ * @details
+ * A fixed ring of MAVLINK_QUEUE_SIZE entries, each holding a decoded
+ * payload and where it came from. Mavlink.c reserves the next free entry,
+ * fills it from a received frame, and commits it, or leaves it uncommitted
+ * to drop the frame (e.g. a repeat the transport recognized). The state
+ * machines pop the oldest entry through Mavlink_hasNewMessage. When the
+ * queue is full, new messages are dropped and counted, so the ones already
+ * waiting keep their order.
+ *
+ * Only uses the MAVLink headers, so it also builds on a host (see
+ * tool/queue_flood).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef MavlinkQueue_H
+#define MavlinkQueue_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+// Messages that can wait at once, must be a power of two up to 128
+#ifndef MAVLINK_QUEUE_SIZE
+#define MAVLINK_QUEUE_SIZE  8
+#endif
+
+// Largest payload, in whole words like a union of the message structs
+#define MAVLINK_QUEUE_PAYLOAD_SIZE  ((MAVLINK_MAX_DIALECT_PAYLOAD_SIZE + 3) & ~3)
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct MavlinkQueueEntry {
+    uint8_t msgid;
+    uint8_t sysid;
+    uint8_t seq;
+    bool wantsAck; // tell the transport when it's delivered
+    uint32_t time; // (ms) arrival of the first byte
+    uint8_t payload[MAVLINK_QUEUE_PAYLOAD_SIZE];
+} MavlinkQueueEntry;
+
+typedef struct MavlinkQueue {
+    MavlinkQueueEntry entries[MAVLINK_QUEUE_SIZE];
+    uint8_t head, tail; // free-running
+    bool isReserved;
+    uint32_t droppedCount; // arrived while full
+} MavlinkQueue;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: MavlinkQueue_init
+ * @param Queue to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void MavlinkQueue_init(MavlinkQueue *queue);
+
+/**
+ * Function: MavlinkQueue_reserve
+ * @param Queue.
+ * @return Next free entry, or NULL if the queue is full.
+ * @remark The entry is only added by MavlinkQueue_commit. Reserving again
+ *  without committing gives the same entry. A full queue counts the
+ *  message as dropped.
+ * @author David Goodman
+ * @date October 18, 2026 */
+MavlinkQueueEntry *MavlinkQueue_reserve(MavlinkQueue *queue);
+
+/**
+ * Function: MavlinkQueue_commit
+ * @param Queue.
+ * @return None.
+ * @remark Adds the reserved entry to the end of the queue.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void MavlinkQueue_commit(MavlinkQueue *queue);
+
+/**
+ * Function: MavlinkQueue_pop
+ * @param Queue.
+ * @return Oldest entry, or NULL if the queue is empty.
+ * @remark The entry is removed, and is only valid until the next reserve.
+ * @author David Goodman
+ * @date October 18, 2026 */
+const MavlinkQueueEntry *MavlinkQueue_pop(MavlinkQueue *queue);
+
+/**
+ * Function: MavlinkQueue_getLength
+ * @param Queue.
+ * @return Number of entries waiting.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t MavlinkQueue_getLength(const MavlinkQueue *queue);
+
+#endif // MavlinkQueue_H
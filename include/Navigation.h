@@ -82,8 +82,8 @@ void Navigation_getLocalPosition(LocalCoordinate *nedPosition);
  * @param A pointer to geocentric coordinate location.
  * @return None
  * @remark Sets the geodetic and ECEF origin point (generally the location
- *  of the command center), by calculating the geodetic from the given
- *  ECEF coordinate.
+ *  of the command center), by calculating the geodetic, and the rotation
+ *  to local (NED) coordinates, from the given ECEF coordinate.
  **********************************************************************/
 void Navigation_setOrigin(GeocentricCoordinate *ecefRef);
 
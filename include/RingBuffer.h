@@ -0,0 +1,298 @@
+/**
+ * @file    RingBuffer.h
+ * @author  David Goodman
+ * @author  John Ash
+ *
+ * @brief
+ * Lock-free single-producer, single-consumer byte ring buffer.
+ *
+ * @details
+ * A byte queue for handing data between an interrupt and the main loop
+ * without disabling interrupts. Exactly one context may write (put/write)
+ * and exactly one context may read (get/read/consume), e.g. the UART
+ * receive ISR produces and a parser consumes.
+ *
+ * The capacity must be a power of two so indices are reduced with a mask.
+ * The head and tail are free-running 16-bit counters, so the length is
+ * always (tail - head) and a full buffer holds all of its bytes. Each side
+ * only writes its own index, and publishes it after a barrier so the other
+ * side never sees an index ahead of the data.
+ *
+ * Everything is static inline so the ISR paths compile without calls.
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef RingBuffer_H
+#define RingBuffer_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define RINGBUFFER_MAX_SIZE     32768
+
+// True if the given buffer size can be used with the ring buffer
+#define RINGBUFFER_IS_VALID_SIZE(size) \
+    ((size) > 1 && (size) <= RINGBUFFER_MAX_SIZE && ((size) & ((size) - 1)) == 0)
+
+/* The PIC32MX is a single in-order core, so the ISR and main loop always see
+ * memory in program order and a compiler barrier is enough. Other targets
+ * (host tools) get a full fence. */
+#ifdef __PIC32MX__
+#define RINGBUFFER_BARRIER()    __asm__ __volatile__("" ::: "memory")
+#else
+#define RINGBUFFER_BARRIER()    __sync_synchronize()
+#endif
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct oRingBuffer {
+    uint8_t *buffer;
+    uint16_t mask;                  // size - 1
+    volatile uint16_t head;         // free-running read index (consumer)
+    volatile uint16_t tail;         // free-running write index (producer)
+    volatile uint32_t overflowCount; // bytes dropped by the producer
+} RingBuffer;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: RingBuffer_init
+ * @param Ring buffer to initialize.
+ * @param Storage for the ring buffer.
+ * @param Size of the storage in bytes, must be a power of two.
+ * @return SUCCESS or FAILURE if the size is invalid.
+ * @remark Must be called before either side uses the ring buffer.
+ * @date October 18, 2026 */
+static inline int8_t RingBuffer_init(RingBuffer *rb, uint8_t *storage, uint16_t size) {
+    if (!RINGBUFFER_IS_VALID_SIZE(size) || storage == NULL)
+        return 1; // FAILURE
+    rb->buffer = storage;
+    rb->mask = size - 1;
+    rb->head = 0;
+    rb->tail = 0;
+    rb->overflowCount = 0;
+    return 0; // SUCCESS
+}
+
+/**
+ * Function: RingBuffer_getSize
+ * @param Ring buffer.
+ * @return Capacity of the ring buffer in bytes.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_getSize(const RingBuffer *rb) {
+    return rb->mask + 1;
+}
+
+/**
+ * Function: RingBuffer_getLength
+ * @param Ring buffer.
+ * @return Number of unread bytes.
+ * @remark Safe from either side; the result may only grow when called by the
+ *  consumer, and only shrink when called by the producer.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_getLength(const RingBuffer *rb) {
+    return (uint16_t)(rb->tail - rb->head);
+}
+
+/**
+ * Function: RingBuffer_getSpace
+ * @param Ring buffer.
+ * @return Number of bytes that can be written.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_getSpace(const RingBuffer *rb) {
+    return (uint16_t)(rb->mask + 1 - RingBuffer_getLength(rb));
+}
+
+/**
+ * Function: RingBuffer_isEmpty
+ * @param Ring buffer.
+ * @return True if there is nothing to read.
+ * @date October 18, 2026 */
+static inline bool RingBuffer_isEmpty(const RingBuffer *rb) {
+    return rb->tail == rb->head;
+}
+
+/**
+ * Function: RingBuffer_isFull
+ * @param Ring buffer.
+ * @return True if there is no room to write.
+ * @date October 18, 2026 */
+static inline bool RingBuffer_isFull(const RingBuffer *rb) {
+    return RingBuffer_getLength(rb) > rb->mask;
+}
+
+/**
+ * Function: RingBuffer_put
+ * @param Ring buffer.
+ * @param Byte to write.
+ * @return True if written, false if full and the byte was dropped.
+ * @remark Producer only. Dropped bytes are counted in the overflow count.
+ * @date October 18, 2026 */
+static inline bool RingBuffer_put(RingBuffer *rb, uint8_t data) {
+    uint16_t tail = rb->tail;
+    if ((uint16_t)(tail - rb->head) > rb->mask) {
+        rb->overflowCount++;
+        return false;
+    }
+    rb->buffer[tail & rb->mask] = data;
+    RINGBUFFER_BARRIER();
+    rb->tail = tail + 1;
+    return true;
+}
+
+/**
+ * Function: RingBuffer_get
+ * @param Ring buffer.
+ * @param Pointer to save the byte into.
+ * @return True if a byte was read, false if empty.
+ * @remark Consumer only.
+ * @date October 18, 2026 */
+static inline bool RingBuffer_get(RingBuffer *rb, uint8_t *data) {
+    uint16_t head = rb->head;
+    if (head == rb->tail)
+        return false;
+    RINGBUFFER_BARRIER();
+    *data = rb->buffer[head & rb->mask];
+    RINGBUFFER_BARRIER();
+    rb->head = head + 1;
+    return true;
+}
+
+/**
+ * Function: RingBuffer_peek
+ * @param Ring buffer.
+ * @param Pointer to save the byte into.
+ * @return True if a byte was available, false if empty.
+ * @remark Consumer only. The byte is not removed.
+ * @date October 18, 2026 */
+static inline bool RingBuffer_peek(const RingBuffer *rb, uint8_t *data) {
+    uint16_t head = rb->head;
+    if (head == rb->tail)
+        return false;
+    RINGBUFFER_BARRIER();
+    *data = rb->buffer[head & rb->mask];
+    return true;
+}
+
+/**
+ * Function: RingBuffer_write
+ * @param Ring buffer.
+ * @param Bytes to write.
+ * @param Number of bytes to write.
+ * @return Number of bytes written.
+ * @remark Producer only. Writes as much as fits in at most two copies and
+ *  publishes it all at once. Bytes that did not fit are not counted as
+ *  overflow, since the caller decides what to do with them.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_write(RingBuffer *rb, const uint8_t *data, uint16_t length) {
+    uint16_t tail = rb->tail;
+    uint16_t space = (uint16_t)(rb->mask + 1 - (uint16_t)(tail - rb->head));
+    uint16_t offset = tail & rb->mask;
+    uint16_t first;
+
+    if (length > space)
+        length = space;
+    first = rb->mask + 1 - offset;
+    if (first > length)
+        first = length;
+    memcpy(&rb->buffer[offset], data, first);
+    memcpy(&rb->buffer[0], data + first, length - first);
+    RINGBUFFER_BARRIER();
+    rb->tail = tail + length;
+    return length;
+}
+
+/**
+ * Function: RingBuffer_read
+ * @param Ring buffer.
+ * @param Array to copy bytes into.
+ * @param Maximum number of bytes to read.
+ * @return Number of bytes read.
+ * @remark Consumer only.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_read(RingBuffer *rb, uint8_t *data, uint16_t length) {
+    uint16_t head = rb->head;
+    uint16_t available = (uint16_t)(rb->tail - head);
+    uint16_t offset = head & rb->mask;
+    uint16_t first;
+
+    if (length > available)
+        length = available;
+    RINGBUFFER_BARRIER();
+    first = rb->mask + 1 - offset;
+    if (first > length)
+        first = length;
+    memcpy(data, &rb->buffer[offset], first);
+    memcpy(data + first, &rb->buffer[0], length - first);
+    RINGBUFFER_BARRIER();
+    rb->head = head + length;
+    return length;
+}
+
+/**
+ * Function: RingBuffer_peekContiguous
+ * @param Ring buffer.
+ * @param Pointer to save the address of the first unread byte into.
+ * @return Number of unread bytes stored contiguously from that address.
+ * @remark Consumer only. Exposes unread bytes in place, without copying.
+ *  When the unread data wraps around the end of the storage, only the part
+ *  up to the end is returned; consume it and peek again for the rest.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_peekContiguous(const RingBuffer *rb, const uint8_t **data) {
+    uint16_t head = rb->head;
+    uint16_t available = (uint16_t)(rb->tail - head);
+    uint16_t offset = head & rb->mask;
+    uint16_t first = rb->mask + 1 - offset;
+
+    RINGBUFFER_BARRIER();
+    *data = &rb->buffer[offset];
+    return (available < first) ? available : first;
+}
+
+/**
+ * Function: RingBuffer_consume
+ * @param Ring buffer.
+ * @param Number of bytes to discard.
+ * @return Number of bytes discarded.
+ * @remark Consumer only. Releases bytes returned by peekContiguous.
+ * @date October 18, 2026 */
+static inline uint16_t RingBuffer_consume(RingBuffer *rb, uint16_t length) {
+    uint16_t head = rb->head;
+    uint16_t available = (uint16_t)(rb->tail - head);
+    if (length > available)
+        length = available;
+    RINGBUFFER_BARRIER();
+    rb->head = head + length;
+    return length;
+}
+
+/**
+ * Function: RingBuffer_clear
+ * @param Ring buffer.
+ * @return None.
+ * @remark Consumer only. Discards all unread bytes.
+ * @date October 18, 2026 */
+static inline void RingBuffer_clear(RingBuffer *rb) {
+    rb->head = rb->tail;
+}
+
+/**
+ * Function: RingBuffer_getOverflow
+ * @param Ring buffer.
+ * @return Number of bytes dropped because the buffer was full.
+ * @date October 18, 2026 */
+static inline uint32_t RingBuffer_getOverflow(const RingBuffer *rb) {
+    return rb->overflowCount;
+}
+
+#endif // RingBuffer_H
@@ -0,0 +1,164 @@
+/**
+ * @file    Scheduler.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Orders outgoing MAVLink frames by priority and paces them to the link.
+ *
+ * @details
+ * Frames wait in one queue per priority class, and a queue is only served
+ * once every queue above it is empty. Commands and ACKs go out right away.
+ * The other classes spend tokens from a bucket that fills at the link's
+ * rate, so periodic traffic can't get ahead of the UART and leave a stop
+ * command waiting behind a full transmit buffer. Commands spend tokens too,
+ * which holds back everything else for a while after a burst of them.
+ *
+ * A frame queued with a key replaces a waiting frame with the same key, in
+ * its place in line, so only the newest telemetry of each kind is sent.
+ *
+ * Only uses the MAVLink headers, and takes the time as an argument, so it
+ * also builds on a host (see tool/scheduler_sim).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef Scheduler_H
+#define Scheduler_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+// Priority classes, highest first
+#define SCHEDULER_PRIORITY_COMMAND      0 // commands and ACKs, not paced
+#define SCHEDULER_PRIORITY_STATE        1 // status, errors and heartbeats
+#define SCHEDULER_PRIORITY_TELEMETRY    2
+#define SCHEDULER_PRIORITY_DEBUG        3
+#define SCHEDULER_PRIORITIES            4
+
+#define SCHEDULER_KEY_NONE              0 // never replaced
+
+// Bytes of queue for each class, a frame takes 6 more than its length
+#define SCHEDULER_COMMAND_SIZE          128
+#define SCHEDULER_STATE_SIZE            96
+#define SCHEDULER_TELEMETRY_SIZE        128
+#define SCHEDULER_DEBUG_SIZE            (2*(MAVLINK_NUM_NON_PAYLOAD_BYTES \
+                                            + MAVLINK_MSG_ID_DEBUG_LEN + 6))
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+// Writes a whole frame or none of it, and returns the bytes taken
+typedef uint16_t (*SchedulerWriter)(const uint8_t *data, uint16_t length);
+
+typedef struct SchedulerQueue {
+    uint8_t *buffer;
+    uint16_t size;
+    uint16_t used; // bytes
+    uint32_t queuedCount;
+    uint32_t sentCount;
+    uint32_t droppedCount; // didn't fit
+    uint32_t refusedCount; // writes the link refused, retried later
+    uint32_t replacedCount; // replaced by a newer frame with the same key
+    uint32_t maxWait; // (ms) longest a frame waited to be sent
+} SchedulerQueue;
+
+typedef struct Scheduler {
+    SchedulerQueue queues[SCHEDULER_PRIORITIES];
+    uint8_t commandBuffer[SCHEDULER_COMMAND_SIZE];
+    uint8_t stateBuffer[SCHEDULER_STATE_SIZE];
+    uint8_t telemetryBuffer[SCHEDULER_TELEMETRY_SIZE];
+    uint8_t debugBuffer[SCHEDULER_DEBUG_SIZE];
+    SchedulerWriter write;
+    uint16_t rate; // (bytes/s) that the bucket fills at
+    uint16_t burst; // (bytes) that the bucket holds
+    int32_t tokens; // (bytes/1000) can go below zero after commands
+    uint32_t lastTime; // (ms) of the last refill
+    bool hasTime;
+    uint8_t *reserved; // frame space not yet committed
+} Scheduler;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: Scheduler_init
+ * @param Scheduler to initialize.
+ * @param Function that sends a frame out the link, or refuses it.
+ * @param Rate (bytes/s) the link can carry.
+ * @param Bytes that may be sent at once, beyond the rate.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Scheduler_init(Scheduler *scheduler, SchedulerWriter write, uint16_t rate,
+    uint16_t burst);
+
+/**
+ * Function: Scheduler_queue
+ * @param Scheduler.
+ * @param Priority class, SCHEDULER_PRIORITY_COMMAND to SCHEDULER_PRIORITY_DEBUG.
+ * @param Key of the frame, or SCHEDULER_KEY_NONE.
+ * @param Encoded frame.
+ * @param Length of the frame.
+ * @param Current time (ms).
+ * @return TRUE if the frame was queued, FALSE if it didn't fit.
+ * @remark Call Scheduler_runSM to send it.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool Scheduler_queue(Scheduler *scheduler, uint8_t priority, uint8_t key,
+    const uint8_t *frame, uint16_t length, uint32_t time);
+
+/**
+ * Function: Scheduler_reserve
+ * @param Scheduler.
+ * @param Priority class, SCHEDULER_PRIORITY_COMMAND to SCHEDULER_PRIORITY_DEBUG.
+ * @param Key of the frame, or SCHEDULER_KEY_NONE.
+ * @param Length of the frame.
+ * @param Current time (ms).
+ * @return Contiguous space for the frame in the queue, or NULL if it didn't
+ *  fit or another frame is still reserved.
+ * @remark Lets a frame be packed straight into the queue. The frame takes
+ *  its place in line now, but nothing is sent until Scheduler_commit, which
+ *  must come before the next reserve.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t *Scheduler_reserve(Scheduler *scheduler, uint8_t priority, uint8_t key,
+    uint16_t length, uint32_t time);
+
+/**
+ * Function: Scheduler_commit
+ * @param Scheduler.
+ * @return None.
+ * @remark Marks the reserved frame as written, so it can be sent.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Scheduler_commit(Scheduler *scheduler);
+
+/**
+ * Function: Scheduler_runSM
+ * @param Scheduler.
+ * @param Current time (ms).
+ * @return None.
+ * @remark Refills the bucket, then sends waiting frames by priority for as
+ *  long as the tokens last. A frame the link refuses stays first in line,
+ *  keeps its tokens, and is tried again on the next call.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Scheduler_runSM(Scheduler *scheduler, uint32_t time);
+
+/**
+ * Function: Scheduler_isQueued
+ * @param Scheduler.
+ * @param Key of a frame.
+ * @return TRUE if a frame with the key is waiting in any class.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool Scheduler_isQueued(Scheduler *scheduler, uint8_t key);
+
+#endif // Scheduler_H
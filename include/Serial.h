@@ -59,6 +59,15 @@ void Serial_putChar(char ch);
  * @date 2011.11.10  */
 char Serial_getChar(void);
 
+/**
+ * Function: Serial_getUartId
+ * @param None
+ * @return The UART module used by the serial console.
+ * @remark For modules that write to the serial port with UART_write.
+ * @author David Goodman
+ * @date 2026.10.18  */
+uint8_t Serial_getUartId(void);
+
 /**
  * Function: Serial_isTransmitEmpty
  * @param None
@@ -0,0 +1,107 @@
+/**
+ * @file    Telemetry.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Keyframe and delta encoding of the boat's state for the XBee link.
+ *
+ * @details
+ * The boat's position, heading, speed, nav state, error and batteries go out
+ * as one stream. A full BOAT_STATE keyframe is sent every
+ * TELEMETRY_KEYFRAME_INTERVAL frames, or when the nav state or error
+ * changes, or when a change won't fit in a delta. The frames in between are
+ * 16 byte BOAT_STATE_DELTA frames holding the change since the keyframe.
+ *
+ * Deltas are relative to the keyframe rather than to the frame before, so
+ * losing one only loses that update. A delta whose keyframe was lost is
+ * dropped by the decoder.
+ *
+ * Only uses the MAVLink headers, so it also builds on a host (see
+ * tool/link_budget).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef Telemetry_H
+#define Telemetry_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define TELEMETRY_KEYFRAME_INTERVAL     8 // frames from one keyframe to the next
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct TelemetryEncoder {
+    mavlink_boat_state_t keyframe; // last keyframe sent
+    uint8_t frameCount; // frames since the keyframe
+    bool hasKeyframe;
+} TelemetryEncoder;
+
+// Payload of either frame, in wire order
+typedef union TelemetryPayload {
+    mavlink_boat_state_t keyframe;
+    mavlink_boat_state_delta_t delta;
+} TelemetryPayload;
+
+typedef struct TelemetryDecoder {
+    mavlink_boat_state_t keyframe; // last keyframe received
+    bool hasKeyframe;
+    uint32_t droppedCount; // deltas whose keyframe was missed
+} TelemetryDecoder;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: Telemetry_initEncoder
+ * @param Encoder to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Telemetry_initEncoder(TelemetryEncoder *encoder);
+
+/**
+ * Function: Telemetry_encode
+ * @param Encoder.
+ * @param State of the boat. Its ack and keyframe fields are ignored.
+ * @param Set to the payload.
+ * @param Set to MAVLINK_MSG_ID_BOAT_STATE or MAVLINK_MSG_ID_BOAT_STATE_DELTA.
+ * @return Length of the payload in bytes.
+ * @remark The payload is ready for MavlinkParser_pack.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t Telemetry_encode(TelemetryEncoder *encoder, const mavlink_boat_state_t *state,
+    TelemetryPayload *payload, uint8_t *msgid);
+
+/**
+ * Function: Telemetry_initDecoder
+ * @param Decoder to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Telemetry_initDecoder(TelemetryDecoder *decoder);
+
+/**
+ * Function: Telemetry_unpack
+ * @param Decoder.
+ * @param MAVLINK_MSG_ID_BOAT_STATE or MAVLINK_MSG_ID_BOAT_STATE_DELTA.
+ * @param Message payload.
+ * @param Payload length.
+ * @param Set to the boat's full state.
+ * @return TRUE if the state was rebuilt, FALSE for a delta without its
+ *  keyframe.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool Telemetry_unpack(TelemetryDecoder *decoder, uint8_t msgid,
+    const uint8_t *payload, uint8_t length, mavlink_boat_state_t *state);
+
+#endif // Telemetry_H
@@ -0,0 +1,231 @@
+/**
+ * @file    Transport.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Reliable delivery for MAVLink messages that want an ACK.
+ *
+ * @details
+ * Keeps a small table of sent WANT_ACK frames and resends each one until a
+ * MAVLINK_ACK with the same message ID and status comes back. The frame is
+ * saved as encoded, so a resend carries the same MAVLink sequence number,
+ * which is what the receiver uses to recognize it. Several messages can be
+ * waiting at once, and callers poll their status.
+ *
+ * The resend timeout follows the measured round trip time (as in RFC 6298):
+ * smoothed RTT plus four deviations, doubled after every resend. RTT is only
+ * sampled from messages that were acked on the first try (Karn's rule). A
+ * message fails if it isn't acked within TRANSPORT_DELIVERY_TIMEOUT.
+ *
+ * On the receiving side, WANT_ACK frames are remembered by sender, message
+ * ID and sequence number. A repeat is dropped while the first copy is still
+ * waiting to be handled, and acked again if the first copy was already
+ * acked, since the first ACK must have been lost. If the first copy was
+ * handled but never acked (e.g. it came in the wrong state), the repeat is
+ * handled again.
+ *
+ * Only uses the MAVLink headers, and takes the time as an argument, so it
+ * also builds on a host (see tool/transport_loopback).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef Transport_H
+#define Transport_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "mavlink/autoLifeguard/mavlink.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+// Acknowledgement status of a sent message
+#define ACK_STATUS_NO_ACK 0 // not being tracked
+#define ACK_STATUS_RECIEVED 1
+#define ACK_STATUS_WAIT 2
+#define ACK_STATUS_DEAD 3 // gave up
+
+// What to do with a received WANT_ACK frame
+#define TRANSPORT_NEW_FRAME         0 // handle it, then Transport_delivered
+#define TRANSPORT_DUPLICATE         1 // drop it
+#define TRANSPORT_DUPLICATE_ACKED   2 // drop it and send the ACK again
+
+#define TRANSPORT_SLOTS             4 // messages waiting for an ACK at once
+#define TRANSPORT_RECENT_SIZE       8 // received frames remembered
+#define TRANSPORT_FRAME_SIZE        (MAVLINK_NUM_NON_PAYLOAD_BYTES + 16)
+
+#define TRANSPORT_INITIAL_TIMEOUT   1000 // (ms) before the first RTT sample
+#define TRANSPORT_MIN_TIMEOUT       100 // (ms)
+#define TRANSPORT_MAX_TIMEOUT       4000 // (ms)
+#define TRANSPORT_DELIVERY_TIMEOUT  20000 // (ms) before giving up
+#define TRANSPORT_RECENT_AGE        (TRANSPORT_DELIVERY_TIMEOUT + TRANSPORT_MAX_TIMEOUT)
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef void (*TransportWriter)(const uint8_t *data, uint16_t length);
+
+typedef struct TransportSlot {
+    uint8_t frame[TRANSPORT_FRAME_SIZE];
+    uint8_t length;
+    uint8_t msgID;
+    uint16_t msgStatus;
+    uint8_t ackStatus;
+    uint8_t sendCount;
+    uint32_t firstSendTime; // (ms)
+    uint32_t lastSendTime; // (ms)
+    uint32_t timeout; // (ms) after the last send
+} TransportSlot;
+
+typedef struct TransportRecent {
+    uint8_t sysID;
+    uint8_t msgID;
+    uint8_t seq;
+    bool isDelivered;       // handed to the state machines
+    bool isAcked;
+    uint16_t ackStatus; // status that was acked
+    uint32_t time; // (ms) when it first arrived
+} TransportRecent;
+
+typedef struct Transport {
+    TransportSlot slots[TRANSPORT_SLOTS];
+    TransportRecent recent[TRANSPORT_RECENT_SIZE];
+    uint8_t recentNext;
+    TransportWriter write;
+    bool hasRtt;
+    uint32_t smoothedRtt; // (ms)
+    uint32_t rttVariance; // (ms)
+    uint32_t timeout; // (ms) for the next new message
+    bool hasEvicted;
+    uint8_t evictedMsgID; // last message given up on for a new one
+    uint16_t evictedMsgStatus;
+    uint32_t sentCount;
+    uint32_t resentCount;
+    uint32_t deliveredCount;
+    uint32_t failedCount; // timed out or evicted
+    uint32_t duplicateCount; // received frames dropped as repeats
+} Transport;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: Transport_init
+ * @param Transport to initialize.
+ * @param Function that sends bytes out the link.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Transport_init(Transport *transport, TransportWriter write);
+
+/**
+ * Function: Transport_send
+ * @param Transport.
+ * @param Encoded frame.
+ * @param Length of the frame.
+ * @param Message ID the ACK will carry.
+ * @param Message status the ACK will carry.
+ * @param Current time (ms).
+ * @return TRUE if the message is being tracked.
+ * @remark Sends the frame and resends it until acked. A message still being
+ *  tracked with the same ID and status is replaced. If the frame is too big,
+ *  it is only sent once. If every slot is waiting for an ACK, the message
+ *  sent first is given up on (ACK_STATUS_DEAD) to make room.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool Transport_send(Transport *transport, const uint8_t *frame, uint16_t length,
+    uint8_t msgID, uint16_t msgStatus, uint32_t time);
+
+/**
+ * Function: Transport_handleAck
+ * @param Transport.
+ * @param Message ID from the ACK.
+ * @param Message status from the ACK.
+ * @param Current time (ms).
+ * @return TRUE if it acked a message that was waiting.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool Transport_handleAck(Transport *transport, uint8_t msgID, uint16_t msgStatus,
+    uint32_t time);
+
+/**
+ * Function: Transport_runSM
+ * @param Transport.
+ * @param Current time (ms).
+ * @return None.
+ * @remark Resends messages whose timeout expired, and gives up on the ones
+ *  past TRANSPORT_DELIVERY_TIMEOUT.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Transport_runSM(Transport *transport, uint32_t time);
+
+/**
+ * Function: Transport_getStatus
+ * @param Transport.
+ * @param Message ID.
+ * @param Message status.
+ * @return ACK_STATUS_WAIT, ACK_STATUS_RECIEVED, ACK_STATUS_DEAD, or
+ *  ACK_STATUS_NO_ACK if the message isn't tracked.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t Transport_getStatus(Transport *transport, uint8_t msgID, uint16_t msgStatus);
+
+/**
+ * Function: Transport_cancel
+ * @param Transport.
+ * @return None.
+ * @remark Stops resending and forgets every tracked message.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Transport_cancel(Transport *transport);
+
+/**
+ * Function: Transport_receive
+ * @param Transport.
+ * @param System ID of the sender.
+ * @param Message ID of the WANT_ACK frame.
+ * @param Sequence number of the frame.
+ * @param Current time (ms).
+ * @param Set to the status to ack again for TRANSPORT_DUPLICATE_ACKED.
+ * @return TRANSPORT_NEW_FRAME, TRANSPORT_DUPLICATE or TRANSPORT_DUPLICATE_ACKED.
+ * @remark A repeat of a frame that was delivered and not acked is
+ *  TRANSPORT_NEW_FRAME again.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t Transport_receive(Transport *transport, uint8_t sysID, uint8_t msgID,
+    uint8_t seq, uint32_t time, uint16_t *ackStatus);
+
+/**
+ * Function: Transport_delivered
+ * @param Transport.
+ * @param System ID of the sender.
+ * @param Message ID of the frame.
+ * @param Sequence number of the frame.
+ * @return None.
+ * @remark Marks a frame from Transport_receive as handed to the state
+ *  machines, so a repeat is handled again unless it gets acked.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Transport_delivered(Transport *transport, uint8_t sysID, uint8_t msgID,
+    uint8_t seq);
+
+/**
+ * Function: Transport_sentAck
+ * @param Transport.
+ * @param System ID of the sender of the acked frame.
+ * @param Message ID that was acked.
+ * @param Sequence number of the acked frame.
+ * @param Message status that was acked.
+ * @return None.
+ * @remark Marks that frame as acked, so repeats of it can be acked again
+ *  with the same status.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void Transport_sentAck(Transport *transport, uint8_t sysID, uint8_t msgID, uint8_t seq,
+    uint16_t msgStatus);
+
+#endif // Transport_H
@@ -16,10 +16,34 @@
 #ifndef UART_H
 #define UART_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #define UART1_ID 1
 #define UART2_ID 2
+#define UART3_ID 3 // UART3 to UART6 only exist on larger PIC32MX parts
+#define UART4_ID 4
+#define UART5_ID 5
+#define UART6_ID 6
 #define UART_SERIAL_ID UART1_ID
 
+// Policies for UART_write when the transmit buffer cannot hold the whole span
+#define UART_WRITE_REJECT       0   // enqueue nothing unless the whole span fits
+#define UART_WRITE_TRUNCATE     1   // enqueue what fits and drop the rest
+#define UART_WRITE_WAIT         2   // wait up to a timeout for the ISR to drain
+
+// Counters for a UART module, see UART_getStatistics
+typedef struct UartStatistics {
+    uint32_t bytesIn;           // bytes moved from the hardware into the receive buffer
+    uint32_t bytesOut;          // bytes moved from the transmit buffer to the hardware
+    uint32_t receiveDropped;    // received bytes lost because the receive buffer was full
+    uint32_t transmitDropped;   // bytes not queued because the transmit buffer was full
+    uint32_t interruptCount;    // times the interrupt ran
+    uint32_t interruptTicks;    // core timer ticks (SYSCLK/2) spent in the interrupt
+    uint16_t receivePeak;       // most bytes waiting in the receive buffer
+    uint16_t transmitPeak;      // most bytes waiting in the transmit buffer
+} UartStatistics;
+
 /**
 * Function: UART_init()
 * @param id: identifies the UART module we want to initialize.
@@ -32,6 +56,17 @@
 
 void UART_init(uint8_t id, uint32_t baudRate);
 
+/**
+* Function: UART_setBaudRate
+* @param identifies the UART module
+* @param New baud rate.
+* @return None
+* @remark Keeps the buffers and counters, unlike UART_init. Bytes still
+*   being sent are garbled, so wait for UART_isTransmitEmpty first.
+* @author David Goodman
+* @date October 18, 2026 */
+void UART_setBaudRate(uint8_t id, uint32_t baudRate);
+
 /**
 * Function: UART_putChar
 * @param identifies the UART module
@@ -46,17 +81,44 @@ void UART_putChar(uint8_t id, char ch);
 
 
 /**
-* Function: UART_putChar
+* Function: UART_putString
 * @param identifies the UART module
 * @param an array of character to be sent
 * @param The length of the array
 * @return None
-* @remark adds character to circular buffer and starts the uart transmitting
-* if not already
+* @remark adds the whole array to the circular buffer in one pass and starts
+* the uart transmitting if not already. The array is dropped if it does not fit
+* (see UART_write with UART_WRITE_REJECT), so frames are never cut in half.
 * @author John Ash
 * @date February 1st, 2013 */
 void UART_putString(uint8_t id, char* Data, int Length);
 
+/**
+* Function: UART_write
+* @param identifies the UART module
+* @param an array of bytes to be sent
+* @param The length of the array
+* @param Policy for a full transmit buffer: UART_WRITE_REJECT,
+*   UART_WRITE_TRUNCATE, or UART_WRITE_WAIT.
+* @param Milliseconds to wait for space with UART_WRITE_WAIT.
+* @return Number of bytes accepted into the transmit buffer.
+* @remark Copies the span into the transmit buffer in one pass and lets the
+*   ISR drain it, so the caller never busy-waits per byte. UART_WRITE_WAIT
+*   needs the timer module, and truncates if it was not initialized.
+* @author David Goodman
+* @date October 18, 2026 */
+uint16_t UART_write(uint8_t id, const uint8_t *data, uint16_t length,
+    uint8_t policy, uint16_t timeout);
+
+/**
+* Function: UART_getTransmitSpace
+* @param identifies the UART module
+* @return Number of bytes that can be enqueued without dropping any.
+* @remark
+* @author David Goodman
+* @date October 18, 2026 */
+uint16_t UART_getTransmitSpace(uint8_t id);
+
 
 /**
 * Function: UART_getChar
@@ -91,4 +153,91 @@ char UART_isTransmitEmpty(uint8_t id);
 * @date February 1st, 2013 */
 char UART_isReceiveEmpty(uint8_t id);
 
+/**
+* Function: UART_peekContiguous
+* @param identifies the UART module
+* @param Pointer to save the address of the first unread byte into.
+* @param Pointer to save the number of contiguous unread bytes into.
+* @return TRUE if there are unread bytes, or FALSE.
+* @remark Exposes the readable region of the receive buffer in place so a
+*   parser can scan a whole span without copying or calling UART_getChar for
+*   every byte. The bytes stay in the buffer until UART_consume is called. If
+*   the data wraps around the end of the buffer, the rest is returned by the
+*   next peek after consuming this span.
+* @author David Goodman
+* @date October 18, 2026 */
+bool UART_peekContiguous(uint8_t id, const uint8_t **data, uint16_t *length);
+
+/**
+* Function: UART_consume
+* @param identifies the UART module
+* @param Number of bytes to release from the receive buffer.
+* @return None
+* @remark Releases bytes obtained with UART_peekContiguous.
+* @author David Goodman
+* @date October 18, 2026 */
+void UART_consume(uint8_t id, uint16_t length);
+
+/**
+* Function: UART_getReceiveOverflow
+* @param identifies the UART module
+* @return Number of received bytes dropped because the receive buffer was full.
+* @remark A growing count means the buffer is too small or the main loop is
+*   too slow to empty it.
+* @author David Goodman
+* @date October 18, 2026 */
+uint32_t UART_getReceiveOverflow(uint8_t id);
+
+/**
+* Function: UART_getReceiveTime
+* @param identifies the UART module
+* @param Offset of an unread byte from the next byte to be read.
+* @return Time in milliseconds (see get_time) when the byte arrived, or 0 if
+*   it is not known.
+* @remark Call before consuming the byte, e.g. with the offset of the first
+*   byte of a frame in a span from UART_peekContiguous. The time is measured
+*   from the start of the burst the byte arrived in, so it does not depend on
+*   how long the byte waited in the receive buffer. Needs the timer module.
+* @author David Goodman
+* @date October 18, 2026 */
+uint32_t UART_getReceiveTime(uint8_t id, uint16_t offset);
+
+/**
+* Function: UART_getInterruptCount
+* @param identifies the UART module
+* @return Number of times the module's interrupt has run since UART_init.
+* @author David Goodman
+* @date October 18, 2026 */
+uint32_t UART_getInterruptCount(uint8_t id);
+
+/**
+* Function: UART_getInterruptRate
+* @param identifies the UART module
+* @return Interrupts per second over the last measured second.
+* @remark The rate is sampled when this is called, so call it about once a
+*   second (e.g. when printing a report). Needs the timer module.
+* @author David Goodman
+* @date October 18, 2026 */
+uint32_t UART_getInterruptRate(uint8_t id);
+
+/**
+* Function: UART_getStatistics
+* @param identifies the UART module
+* @param Statistics object to copy the counters into.
+* @return TRUE if the module is initialized and the counters were copied.
+* @remark The counters are copied with interrupts briefly disabled, so they
+*   are consistent with each other.
+* @author David Goodman
+* @date October 18, 2026 */
+bool UART_getStatistics(uint8_t id, UartStatistics *stats);
+
+/**
+* Function: UART_clearStatistics
+* @param identifies the UART module
+* @return None
+* @remark Zeroes the counters and peaks, including the receive overflow count.
+* @author David Goodman
+* @date October 18, 2026 */
+void UART_clearStatistics(uint8_t id);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * @file    UbxConfig.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Finds a u-blox receiver's baud rate and sets its port, rate and messages.
+ *
+ * @details
+ * Replaces setting up the receiver by hand (model/gps/gps_configure_ublox.m).
+ * The steps are:
+ *      detect   - poll CFG-PRT at each likely baud rate until a checked UBX
+ *                 frame comes back
+ *      port     - CFG-PRT to the wanted baud rate with UBX only in and out,
+ *                 which also stops NMEA, then poll it again at the new rate
+ *      rate     - CFG-RATE for the navigation rate, ACK-ACK expected
+ *      messages - CFG-MSG turning on NAV-PVT and off the NAV messages it
+ *                 replaces. A receiver without NAV-PVT (protocol 13 and
+ *                 before, e.g. the LEA-6) answers ACK-NAK, and NAV-SOL,
+ *                 NAV-VELNED and NAV-STATUS are turned on instead.
+ * Commands without an answer are sent again, and if the new baud rate
+ * can't be verified, detection starts over.
+ *
+ * The steps are run by calling UbxConfig_run often, with the time, and
+ * handing it each frame from a UbxParser. Bytes go out, and the baud rate
+ * is changed, through the functions in a UbxConfigPort, so it also builds
+ * on a host (see tool/ubx_emulator).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef UbxConfig_H
+#define UbxConfig_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "UbxParser.h"
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define UBX_CONFIG_MIN_RATE     1 // (Hz) navigation rates
+#define UBX_CONFIG_MAX_RATE     10
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+// Access to the serial port the receiver is on
+typedef struct UbxConfigPort {
+    // Writes a whole frame, returning its length, or 0 if it doesn't fit
+    uint16_t (*send)(const uint8_t *frame, uint16_t length);
+    // TRUE once everything written has left the port
+    bool (*isSent)(void);
+    void (*setBaudRate)(uint32_t baudRate);
+} UbxConfigPort;
+
+typedef struct UbxConfig {
+    const UbxConfigPort *port;
+    uint32_t desiredBaudRate;
+    uint16_t measureRate;   // (ms) between navigation solutions
+    uint8_t state;
+    uint8_t step;           // CFG-MSG being sent
+    uint8_t tries;          // of the command being sent
+    uint8_t baudIndex;      // baud rate being tried
+    bool isWaiting;         // for an answer to the command
+    bool hasAnswer, hasNak;
+    uint8_t commandId;      // CFG message waiting for an answer
+    uint32_t sentTime;      // (ms)
+    uint32_t baudRate;      // the receiver's, 0 until found
+    bool hasPvt;            // receiver sends NAV-PVT, once done
+} UbxConfig;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: UbxConfig_init
+ * @param Configuration to start.
+ * @param Functions for the receiver's serial port.
+ * @param Baud rate to switch the receiver to.
+ * @param Navigation rate in Hz, from UBX_CONFIG_MIN_RATE to
+ *  UBX_CONFIG_MAX_RATE.
+ * @return None.
+ * @remark Nothing is sent until UbxConfig_run.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void UbxConfig_init(UbxConfig *config, const UbxConfigPort *port,
+    uint32_t baudRate, uint8_t navigationRate);
+
+/**
+ * Function: UbxConfig_run
+ * @param Configuration.
+ * @param Time in milliseconds, e.g. from get_time.
+ * @return None.
+ * @remark Sends the next command, or again after a timeout. Call often
+ *  until UbxConfig_isDone.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void UbxConfig_run(UbxConfig *config, uint32_t time);
+
+/**
+ * Function: UbxConfig_handleFrame
+ * @param Configuration.
+ * @param Parser holding a checked frame from the receiver.
+ * @return None.
+ * @remark Looks for answers to the commands; other frames only show the
+ *  baud rate is right while detecting it.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void UbxConfig_handleFrame(UbxConfig *config, const UbxParser *parser);
+
+/**
+ * Function: UbxConfig_isDone
+ * @param Configuration.
+ * @return TRUE once every step was answered, or FALSE while running, or if
+ *  the receiver refused a setting.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool UbxConfig_isDone(const UbxConfig *config);
+
+/**
+ * Function: UbxConfig_hasFailed
+ * @param Configuration.
+ * @return TRUE if the receiver refused or never answered a setting after
+ *  its baud rate was found. It is left sending what it was.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool UbxConfig_hasFailed(const UbxConfig *config);
+
+#endif // UbxConfig_H
@@ -0,0 +1,214 @@
+/**
+ * @file    UbxParser.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Checked frame assembly for u-blox UBX messages.
+ *
+ * @details
+ * A UBX frame is two sync bytes (0xB5 0x62), the class, the ID, a little
+ * endian payload length, the payload, and an 8-bit Fletcher checksum
+ * (CK_A, CK_B) over everything from the class to the end of the payload.
+ *
+ * The parser takes spans of received bytes (e.g. from UART_peekContiguous)
+ * and stops at the end of each good frame, which stays in the parser until
+ * the next read. A frame with a bad length or checksum is dropped, and the
+ * parser looks for the next sync bytes in the bytes it already holds, so a
+ * good frame right behind a corrupted one isn't lost.
+ *
+ * The NAV payloads the GPS decodes are laid out below as packed structs,
+ * which a whole payload is copied into in one go. UBX is little endian,
+ * like the PIC32, so the fields can be read straight from the structs.
+ *
+ * Doesn't use the UART or timers, so it also builds on a host (see
+ * tool/ubx_stream).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef UbxParser_H
+#define UbxParser_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define UBX_SYNC1               0xB5
+#define UBX_SYNC2               0x62
+
+#define UBX_HEADER_LEN          6 // sync, class, ID and length
+#define UBX_CHECKSUM_LEN        2
+#define UBX_MAX_FRAME_LEN       255 // (bytes) longer frames are dropped
+#define UBX_MAX_PAYLOAD_LEN     (UBX_MAX_FRAME_LEN - UBX_HEADER_LEN - UBX_CHECKSUM_LEN)
+
+// Offsets in a frame
+#define UBX_CLASS_INDEX         2
+#define UBX_ID_INDEX            3
+#define UBX_LENGTH_INDEX        4
+#define UBX_PAYLOAD_INDEX       6
+
+// Message classes and IDs
+#define UBX_NAV_CLASS           0x01
+#define UBX_NAV_POSLLH_ID       0x02
+#define UBX_NAV_STATUS_ID       0x03
+#define UBX_NAV_SOL_ID          0x06
+#define UBX_NAV_PVT_ID          0x07 // protocol 14 and later (u-blox 7 on)
+#define UBX_NAV_VELNED_ID       0x12
+#define UBX_ACK_CLASS           0x05
+#define UBX_ACK_NAK_ID          0x00
+#define UBX_ACK_ACK_ID          0x01
+#define UBX_CFG_CLASS           0x06
+#define UBX_CFG_PRT_ID          0x00
+#define UBX_CFG_MSG_ID          0x01
+#define UBX_CFG_RATE_ID         0x08
+
+#define UBX_PACKED              __attribute__((packed))
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+typedef struct UbxParser {
+    uint8_t frame[UBX_MAX_FRAME_LEN]; // frame so far, from the sync bytes
+    uint8_t held;           // bytes held, which can run past a found frame
+    uint8_t length;         // of the frame, when hasFrame
+    bool hasFrame;          // frame starts with a whole, checked frame
+    int16_t start;          // offset of frame[0] in the last span, or -1
+    uint32_t frameCount;    // good frames
+    uint32_t errorCount;    // frames with a bad length or checksum
+    uint32_t skippedCount;  // bytes dropped looking for the sync bytes
+} UbxParser;
+
+// NAV-POSLLH (0x01 0x02) geodetic position
+typedef struct UBX_PACKED UbxNavPosllh {
+    uint32_t iTow;          // (ms) GPS time of week
+    int32_t lon, lat;       // (1e-7 deg)
+    int32_t height;         // (mm) above the ellipsoid
+    int32_t hMsl;           // (mm) above mean sea level
+    uint32_t hAcc, vAcc;    // (mm) accuracy estimates
+} UbxNavPosllh;
+
+// NAV-STATUS (0x01 0x03) receiver navigation status
+typedef struct UBX_PACKED UbxNavStatus {
+    uint32_t iTow;          // (ms)
+    uint8_t gpsFix;         // 0 no fix, 2 2D, 3 3D
+    uint8_t flags, fixStat, flags2;
+    uint32_t ttff;          // (ms) time to first fix
+    uint32_t msss;          // (ms) since startup
+} UbxNavStatus;
+
+// NAV-SOL (0x01 0x06) navigation solution, in ECEF
+typedef struct UBX_PACKED UbxNavSol {
+    uint32_t iTow;          // (ms)
+    int32_t fTow;           // (ns) fraction of iTow
+    int16_t week;
+    uint8_t gpsFix, flags;
+    int32_t ecefX, ecefY, ecefZ; // (cm)
+    uint32_t pAcc;          // (cm)
+    int32_t ecefVX, ecefVY, ecefVZ; // (cm/s)
+    uint32_t sAcc;          // (cm/s)
+    uint16_t pDop;          // (0.01)
+    uint8_t reserved1, numSv;
+    uint32_t reserved2;
+} UbxNavSol;
+
+// NAV-PVT (0x01 0x07) position, velocity and time in one
+typedef struct UBX_PACKED UbxNavPvt {
+    uint32_t iTow;          // (ms)
+    uint16_t year;
+    uint8_t month, day, hour, min, sec;
+    uint8_t valid;
+    uint32_t tAcc;          // (ns)
+    int32_t nano;           // (ns)
+    uint8_t fixType;        // like gpsFix in NAV-STATUS
+    uint8_t flags, flags2, numSv;
+    int32_t lon, lat;       // (1e-7 deg)
+    int32_t height, hMsl;   // (mm)
+    uint32_t hAcc, vAcc;    // (mm)
+    int32_t velN, velE, velD; // (mm/s)
+    int32_t gSpeed;         // (mm/s)
+    int32_t headMot;        // (1e-5 deg) heading of motion
+    uint32_t sAcc;          // (mm/s)
+    uint32_t headAcc;       // (1e-5 deg)
+    uint16_t pDop;          // (0.01)
+    uint8_t reserved1[6];
+    int32_t headVeh;        // (1e-5 deg)
+    uint8_t reserved2[4];
+} UbxNavPvt;
+
+// NAV-VELNED (0x01 0x12) velocity in north, east and down
+typedef struct UBX_PACKED UbxNavVelned {
+    uint32_t iTow;          // (ms)
+    int32_t velN, velE, velD; // (cm/s)
+    uint32_t speed, gSpeed; // (cm/s) 3D and ground speed
+    int32_t heading;        // (1e-5 deg)
+    uint32_t sAcc;          // (cm/s)
+    uint32_t cAcc;          // (1e-5 deg)
+} UbxNavVelned;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: UbxParser_init
+ * @param Parser to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void UbxParser_init(UbxParser *parser);
+
+/**
+ * Function: UbxParser_read
+ * @param Parser.
+ * @param Span of received bytes.
+ * @param Number of bytes in the span.
+ * @return Number of bytes taken from the span.
+ * @remark Stops after a good frame, with hasFrame set, leaving the bytes
+ *  after it for the next read. The frame is dropped by the next read. If
+ *  the parser holds (part of) a frame, start is the offset of its first
+ *  byte in this span, or -1 if it arrived in an earlier one. A frame found
+ *  in the bytes of a dropped one can be followed by bytes the parser
+ *  already holds, which are read before the span.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t UbxParser_read(UbxParser *parser, const uint8_t *data, uint16_t length);
+
+/**
+ * Function: UbxParser_getPayloadLength
+ * @param Parser with a frame.
+ * @return Payload length of the frame.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t UbxParser_getPayloadLength(const UbxParser *parser);
+
+/**
+ * Function: UbxParser_getPayload
+ * @param Parser with a frame.
+ * @param Struct to copy the payload into, e.g. a UbxNavSol.
+ * @param Size of the struct.
+ * @return TRUE if the payload filled the struct.
+ * @remark Nothing is copied from a shorter payload. Bytes past the size,
+ *  added in later protocol versions, are left out.
+ * @author David Goodman
+ * @date October 18, 2026 */
+bool UbxParser_getPayload(const UbxParser *parser, void *payload, uint16_t size);
+
+/**
+ * Function: UbxParser_pack
+ * @param Buffer for the frame, with room for the payload length plus 8.
+ * @param Message class.
+ * @param Message ID.
+ * @param Payload.
+ * @param Payload length.
+ * @return Length of the frame.
+ * @remark Used to send configuration messages to the receiver.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t UbxParser_pack(uint8_t *frame, uint8_t messageClass, uint8_t messageId,
+    const uint8_t *payload, uint16_t length);
+
+#endif // UbxParser_H
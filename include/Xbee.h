@@ -21,6 +21,26 @@
  * PUBLIC DEFINITIONS                                                  *
  ***********************************************************************/
 
+// Frames MAVLink in XBee API frames, for delivery status, RSSI and unicast
+// to the other radio (see XbeeApi.h), instead of transparent mode
+//#define XBEE_API_MODE
+
+#ifdef XBEE_API_MODE
+#include "XbeeApi.h"
+
+// Counters for the radio in API mode, see Xbee_getStatistics
+typedef struct XbeeStatistics {
+    uint32_t packetsReceived;
+    uint32_t delivered;     // transmit requests the radio got through
+    uint32_t failed;        // transmit requests the radio gave up on
+    uint32_t retries;       // made by the radio for those
+    uint32_t frameErrors;   // API frames with a bad length or checksum
+    uint8_t rssi;           // (-dBm) of a recent packet, 0 if none yet
+    bool hasPeerAddress;    // else transmit requests are broadcast
+    uint8_t peerAddress[XBEE_API_ADDRESS_LEN];
+} XbeeStatistics;
+#endif
+
 /**********************************************************************
  * PUBLIC FUNCTIONS                                                   *
  **********************************************************************/
@@ -58,6 +78,29 @@ void Xbee_runSM();
  **********************************************************************/
 uint8_t Xbee_getUartId();
 
+#ifdef XBEE_API_MODE
+/**********************************************************************
+ * Function: Xbee_send
+ * @param Frame to send, e.g. a MAVLink frame.
+ * @param Length of the frame.
+ * @return Length if the frame was written, else 0.
+ * @remark Writes the frame as a transmit request to the other radio, or a
+ *  broadcast until a packet has come from it. Nothing is written unless
+ *  the whole request fits in the UART's transmit buffer.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+uint16_t Xbee_send(const uint8_t *data, uint16_t length);
+
+/**********************************************************************
+ * Function: Xbee_getStatistics
+ * @return Delivery, retry and RSSI statistics, read only.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+const XbeeStatistics *Xbee_getStatistics();
+#endif
+
 //#define XBEE_TEST
 #ifdef XBEE_TEST
 /**********************************************************************
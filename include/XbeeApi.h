@@ -0,0 +1,161 @@
+/**
+ * @file    XbeeApi.h
+ * @author  David Goodman
+ *
+ * @brief
+ * Packs and parses XBee API frames.
+ *
+ * @details
+ * In API mode (AP=1) everything to and from the radio is framed as a start
+ * byte, a big endian length, the frame data and a checksum. The frame data
+ * starts with the frame type. These are used:
+ *      0x10 transmit request  - RF data for a 64 bit address
+ *      0x8B transmit status   - delivery of a transmit request, by frame ID
+ *      0x90 receive packet    - RF data and the 64 bit address it came from
+ *      0x08 AT command        - used to read DB, the RSSI of the last packet
+ *      0x88 AT response
+ *
+ * The parser scans spans of received bytes like MavlinkParser, copying a
+ * frame's data until it is complete and its checksum is good. A handler is
+ * called with each frame, decoded into an XbeeApiFrame.
+ *
+ * Doesn't use the UART or timers, so it also builds on a host (see
+ * tool/xbee_emulator).
+ *
+ * @date October 18, 2026      -- Created
+ */
+#ifndef XbeeApi_H
+#define XbeeApi_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************
+ * PUBLIC DEFINITIONS                                                  *
+ ***********************************************************************/
+
+#define XBEE_API_START                  0x7E
+
+// Frame types
+#define XBEE_API_AT_COMMAND             0x08
+#define XBEE_API_TRANSMIT_REQUEST       0x10
+#define XBEE_API_AT_RESPONSE            0x88
+#define XBEE_API_TRANSMIT_STATUS        0x8B
+#define XBEE_API_RECEIVE_PACKET         0x90
+
+#define XBEE_API_DELIVERED              0x00 // transmit status
+#define XBEE_API_AT_OK                  0x00 // AT response status
+
+#define XBEE_API_ADDRESS_LEN            8
+#define XBEE_API_MAX_DATA               256 // (bytes) of RF data, NP on the radio
+#define XBEE_API_NO_FRAME_ID            0 // no transmit status is sent
+
+// Start, length, frame type, ID, addresses, radius and options
+#define XBEE_API_TRANSMIT_HEADER_LEN    17
+// Transmit header and checksum around the RF data
+#define XBEE_API_TRANSMIT_OVERHEAD      (XBEE_API_TRANSMIT_HEADER_LEN + 1)
+// Frame data of a receive packet before the RF data
+#define XBEE_API_RECEIVE_HEADER_LEN     12
+#define XBEE_API_MAX_FRAME_DATA         (XBEE_API_RECEIVE_HEADER_LEN + XBEE_API_MAX_DATA)
+#define XBEE_API_MAX_FRAME_LEN          (XBEE_API_MAX_FRAME_DATA + 4)
+
+/***********************************************************************
+ * PUBLIC TYPEDEFS                                                     *
+ ***********************************************************************/
+
+// A checked frame, valid only while the handler runs
+typedef struct XbeeApiFrame {
+    uint8_t type;
+    uint8_t frameId;    // transmit status and AT response
+    uint8_t status;     // delivery status, or AT command status
+    uint8_t retries;    // transmit status
+    uint8_t options;    // receive packet
+    const uint8_t *address; // 64 bit source of a receive packet, or NULL
+    char command[2];    // AT response
+    const uint8_t *data; // RF data, AT response value, or the frame data
+                         // after the type for other frames
+    uint16_t length;
+    int16_t start; // offset of the start byte in the span, -1 if in an earlier one
+} XbeeApiFrame;
+
+typedef void (*XbeeApiFrameHandler)(const XbeeApiFrame *frame);
+
+typedef struct XbeeApiParser {
+    uint8_t frame[XBEE_API_MAX_FRAME_DATA]; // frame data so far
+    uint8_t state;
+    uint16_t length;        // of the frame data
+    uint16_t index;
+    uint8_t sum;            // of the frame data so far
+    int16_t pendingStart;   // offset of the pending frame in the last span, or -1
+    uint32_t frameCount;    // frames passed to the handler
+    uint32_t errorCount;    // frames with a bad length or checksum
+    uint32_t skippedCount;  // bytes skipped while looking for a start byte
+} XbeeApiParser;
+
+
+/***********************************************************************
+ * PUBLIC FUNCTIONS                                                    *
+ ***********************************************************************/
+
+/**
+ * Function: XbeeApi_init
+ * @param Parser to initialize.
+ * @return None.
+ * @author David Goodman
+ * @date October 18, 2026 */
+void XbeeApi_init(XbeeApiParser *parser);
+
+/**
+ * Function: XbeeApi_parse
+ * @param Parser.
+ * @param Span of received bytes.
+ * @param Number of bytes in the span.
+ * @param Function to call with each good frame.
+ * @return Number of frames passed to the handler.
+ * @remark Takes every byte of the span. If a frame is left pending and it
+ *  started in this span, its offset is in the parser's pendingStart.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t XbeeApi_parse(XbeeApiParser *parser, const uint8_t *data, uint16_t length,
+    XbeeApiFrameHandler handler);
+
+/**
+ * Function: XbeeApi_pack
+ * @param Buffer for the frame, with room for the frame data plus 4.
+ * @param Frame type.
+ * @param Frame data after the type.
+ * @param Length of the frame data after the type.
+ * @return Length of the frame.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t XbeeApi_pack(uint8_t *frame, uint8_t type, const uint8_t *data,
+    uint16_t length);
+
+/**
+ * Function: XbeeApi_packTransmitHeader
+ * @param Buffer for XBEE_API_TRANSMIT_HEADER_LEN bytes.
+ * @param Frame ID for the transmit status, or XBEE_API_NO_FRAME_ID.
+ * @param 64 bit destination address, big endian.
+ * @param RF data.
+ * @param Length of the RF data.
+ * @param Checksum to send after the RF data.
+ * @return Length of the header.
+ * @remark Lets a transmit request be written as the header, the RF data
+ *  where it already is, and the checksum.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint8_t XbeeApi_packTransmitHeader(uint8_t *header, uint8_t frameId,
+    const uint8_t *address, const uint8_t *data, uint16_t length, uint8_t *checksum);
+
+/**
+ * Function: XbeeApi_packAtCommand
+ * @param Buffer for the frame, with room for 8 bytes.
+ * @param Frame ID for the response.
+ * @param Two letter command, e.g. "DB".
+ * @return Length of the frame.
+ * @remark Queries the setting, with no parameter.
+ * @author David Goodman
+ * @date October 18, 2026 */
+uint16_t XbeeApi_packAtCommand(uint8_t *frame, uint8_t frameId, const char *command);
+
+#endif // XbeeApi_H
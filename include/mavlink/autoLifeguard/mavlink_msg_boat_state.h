@@ -0,0 +1,364 @@
+// MESSAGE BOAT_STATE PACKING
+
+#define MAVLINK_MSG_ID_BOAT_STATE 246
+
+typedef struct __mavlink_boat_state_t
+{
+ int32_t north; ///< North position from the origin in cm.
+ int32_t east; ///< East position from the origin in cm.
+ int16_t down; ///< Down position from the origin in cm.
+ uint16_t heading; ///< Heading in hundredths of a degree (0 to 35999).
+ uint16_t speed; ///< Speed over ground in cm/s.
+ uint16_t batVolt1; ///< Voltage of battery 1 in millivolts.
+ uint16_t batVolt2; ///< Voltage of battery 2 in millivolts.
+ uint8_t ack; ///< Always FALSE.
+ uint8_t keyframe; ///< Keyframe number that delta frames refer to, counts up and wraps.
+ uint8_t navState; ///< State of the boat's master state machine.
+ uint8_t error; ///< Last error code, or zero if none.
+} mavlink_boat_state_t;
+
+#define MAVLINK_MSG_ID_BOAT_STATE_LEN 22
+#define MAVLINK_MSG_ID_246_LEN 22
+
+
+
+#define MAVLINK_MESSAGE_INFO_BOAT_STATE { \
+	"BOAT_STATE", \
+	11, \
+	{  { "north", NULL, MAVLINK_TYPE_INT32_T, 0, 0, offsetof(mavlink_boat_state_t, north) }, \
+         { "east", NULL, MAVLINK_TYPE_INT32_T, 0, 4, offsetof(mavlink_boat_state_t, east) }, \
+         { "down", NULL, MAVLINK_TYPE_INT16_T, 0, 8, offsetof(mavlink_boat_state_t, down) }, \
+         { "heading", NULL, MAVLINK_TYPE_UINT16_T, 0, 10, offsetof(mavlink_boat_state_t, heading) }, \
+         { "speed", NULL, MAVLINK_TYPE_UINT16_T, 0, 12, offsetof(mavlink_boat_state_t, speed) }, \
+         { "batVolt1", NULL, MAVLINK_TYPE_UINT16_T, 0, 14, offsetof(mavlink_boat_state_t, batVolt1) }, \
+         { "batVolt2", NULL, MAVLINK_TYPE_UINT16_T, 0, 16, offsetof(mavlink_boat_state_t, batVolt2) }, \
+         { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 18, offsetof(mavlink_boat_state_t, ack) }, \
+         { "keyframe", NULL, MAVLINK_TYPE_UINT8_T, 0, 19, offsetof(mavlink_boat_state_t, keyframe) }, \
+         { "navState", NULL, MAVLINK_TYPE_UINT8_T, 0, 20, offsetof(mavlink_boat_state_t, navState) }, \
+         { "error", NULL, MAVLINK_TYPE_UINT8_T, 0, 21, offsetof(mavlink_boat_state_t, error) }, \
+         } \
+}
+
+
+/**
+ * @brief Pack a boat_state message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param ack Always FALSE.
+ * @param keyframe Keyframe number that delta frames refer to, counts up and wraps.
+ * @param north North position from the origin in cm.
+ * @param east East position from the origin in cm.
+ * @param down Down position from the origin in cm.
+ * @param heading Heading in hundredths of a degree (0 to 35999).
+ * @param speed Speed over ground in cm/s.
+ * @param navState State of the boat's master state machine.
+ * @param error Last error code, or zero if none.
+ * @param batVolt1 Voltage of battery 1 in millivolts.
+ * @param batVolt2 Voltage of battery 2 in millivolts.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_boat_state_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint8_t ack, uint8_t keyframe, int32_t north, int32_t east, int16_t down, uint16_t heading, uint16_t speed, uint8_t navState, uint8_t error, uint16_t batVolt1, uint16_t batVolt2)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[22];
+	_mav_put_int32_t(buf, 0, north);
+	_mav_put_int32_t(buf, 4, east);
+	_mav_put_int16_t(buf, 8, down);
+	_mav_put_uint16_t(buf, 10, heading);
+	_mav_put_uint16_t(buf, 12, speed);
+	_mav_put_uint16_t(buf, 14, batVolt1);
+	_mav_put_uint16_t(buf, 16, batVolt2);
+	_mav_put_uint8_t(buf, 18, ack);
+	_mav_put_uint8_t(buf, 19, keyframe);
+	_mav_put_uint8_t(buf, 20, navState);
+	_mav_put_uint8_t(buf, 21, error);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 22);
+#else
+	mavlink_boat_state_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.down = down;
+	packet.heading = heading;
+	packet.speed = speed;
+	packet.batVolt1 = batVolt1;
+	packet.batVolt2 = batVolt2;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.navState = navState;
+	packet.error = error;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 22);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_BOAT_STATE;
+	return mavlink_finalize_message(msg, system_id, component_id, 22, 177);
+}
+
+/**
+ * @brief Pack a boat_state message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message was sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param ack Always FALSE.
+ * @param keyframe Keyframe number that delta frames refer to, counts up and wraps.
+ * @param north North position from the origin in cm.
+ * @param east East position from the origin in cm.
+ * @param down Down position from the origin in cm.
+ * @param heading Heading in hundredths of a degree (0 to 35999).
+ * @param speed Speed over ground in cm/s.
+ * @param navState State of the boat's master state machine.
+ * @param error Last error code, or zero if none.
+ * @param batVolt1 Voltage of battery 1 in millivolts.
+ * @param batVolt2 Voltage of battery 2 in millivolts.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_boat_state_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint8_t ack,uint8_t keyframe,int32_t north,int32_t east,int16_t down,uint16_t heading,uint16_t speed,uint8_t navState,uint8_t error,uint16_t batVolt1,uint16_t batVolt2)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[22];
+	_mav_put_int32_t(buf, 0, north);
+	_mav_put_int32_t(buf, 4, east);
+	_mav_put_int16_t(buf, 8, down);
+	_mav_put_uint16_t(buf, 10, heading);
+	_mav_put_uint16_t(buf, 12, speed);
+	_mav_put_uint16_t(buf, 14, batVolt1);
+	_mav_put_uint16_t(buf, 16, batVolt2);
+	_mav_put_uint8_t(buf, 18, ack);
+	_mav_put_uint8_t(buf, 19, keyframe);
+	_mav_put_uint8_t(buf, 20, navState);
+	_mav_put_uint8_t(buf, 21, error);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 22);
+#else
+	mavlink_boat_state_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.down = down;
+	packet.heading = heading;
+	packet.speed = speed;
+	packet.batVolt1 = batVolt1;
+	packet.batVolt2 = batVolt2;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.navState = navState;
+	packet.error = error;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 22);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_BOAT_STATE;
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 22, 177);
+}
+
+/**
+ * @brief Encode a boat_state struct into a message
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param boat_state C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_boat_state_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_boat_state_t* boat_state)
+{
+	return mavlink_msg_boat_state_pack(system_id, component_id, msg, boat_state->ack, boat_state->keyframe, boat_state->north, boat_state->east, boat_state->down, boat_state->heading, boat_state->speed, boat_state->navState, boat_state->error, boat_state->batVolt1, boat_state->batVolt2);
+}
+
+/**
+ * @brief Send a boat_state message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param ack Always FALSE.
+ * @param keyframe Keyframe number that delta frames refer to, counts up and wraps.
+ * @param north North position from the origin in cm.
+ * @param east East position from the origin in cm.
+ * @param down Down position from the origin in cm.
+ * @param heading Heading in hundredths of a degree (0 to 35999).
+ * @param speed Speed over ground in cm/s.
+ * @param navState State of the boat's master state machine.
+ * @param error Last error code, or zero if none.
+ * @param batVolt1 Voltage of battery 1 in millivolts.
+ * @param batVolt2 Voltage of battery 2 in millivolts.
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_boat_state_send(mavlink_channel_t chan, uint8_t ack, uint8_t keyframe, int32_t north, int32_t east, int16_t down, uint16_t heading, uint16_t speed, uint8_t navState, uint8_t error, uint16_t batVolt1, uint16_t batVolt2)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[22];
+	_mav_put_int32_t(buf, 0, north);
+	_mav_put_int32_t(buf, 4, east);
+	_mav_put_int16_t(buf, 8, down);
+	_mav_put_uint16_t(buf, 10, heading);
+	_mav_put_uint16_t(buf, 12, speed);
+	_mav_put_uint16_t(buf, 14, batVolt1);
+	_mav_put_uint16_t(buf, 16, batVolt2);
+	_mav_put_uint8_t(buf, 18, ack);
+	_mav_put_uint8_t(buf, 19, keyframe);
+	_mav_put_uint8_t(buf, 20, navState);
+	_mav_put_uint8_t(buf, 21, error);
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_BOAT_STATE, buf, 22, 177);
+#else
+	mavlink_boat_state_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.down = down;
+	packet.heading = heading;
+	packet.speed = speed;
+	packet.batVolt1 = batVolt1;
+	packet.batVolt2 = batVolt2;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.navState = navState;
+	packet.error = error;
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_BOAT_STATE, (const char *)&packet, 22, 177);
+#endif
+}
+
+#endif
+
+// MESSAGE BOAT_STATE UNPACKING
+
+
+/**
+ * @brief Get field ack from boat_state message
+ *
+ * @return Always FALSE.
+ */
+static inline uint8_t mavlink_msg_boat_state_get_ack(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  18);
+}
+
+/**
+ * @brief Get field keyframe from boat_state message
+ *
+ * @return Keyframe number that delta frames refer to, counts up and wraps.
+ */
+static inline uint8_t mavlink_msg_boat_state_get_keyframe(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  19);
+}
+
+/**
+ * @brief Get field north from boat_state message
+ *
+ * @return North position from the origin in cm.
+ */
+static inline int32_t mavlink_msg_boat_state_get_north(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int32_t(msg,  0);
+}
+
+/**
+ * @brief Get field east from boat_state message
+ *
+ * @return East position from the origin in cm.
+ */
+static inline int32_t mavlink_msg_boat_state_get_east(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int32_t(msg,  4);
+}
+
+/**
+ * @brief Get field down from boat_state message
+ *
+ * @return Down position from the origin in cm.
+ */
+static inline int16_t mavlink_msg_boat_state_get_down(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int16_t(msg,  8);
+}
+
+/**
+ * @brief Get field heading from boat_state message
+ *
+ * @return Heading in hundredths of a degree (0 to 35999).
+ */
+static inline uint16_t mavlink_msg_boat_state_get_heading(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  10);
+}
+
+/**
+ * @brief Get field speed from boat_state message
+ *
+ * @return Speed over ground in cm/s.
+ */
+static inline uint16_t mavlink_msg_boat_state_get_speed(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  12);
+}
+
+/**
+ * @brief Get field navState from boat_state message
+ *
+ * @return State of the boat's master state machine.
+ */
+static inline uint8_t mavlink_msg_boat_state_get_navState(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  20);
+}
+
+/**
+ * @brief Get field error from boat_state message
+ *
+ * @return Last error code, or zero if none.
+ */
+static inline uint8_t mavlink_msg_boat_state_get_error(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  21);
+}
+
+/**
+ * @brief Get field batVolt1 from boat_state message
+ *
+ * @return Voltage of battery 1 in millivolts.
+ */
+static inline uint16_t mavlink_msg_boat_state_get_batVolt1(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  14);
+}
+
+/**
+ * @brief Get field batVolt2 from boat_state message
+ *
+ * @return Voltage of battery 2 in millivolts.
+ */
+static inline uint16_t mavlink_msg_boat_state_get_batVolt2(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  16);
+}
+
+/**
+ * @brief Decode a boat_state message into a struct
+ *
+ * @param msg The message to decode
+ * @param boat_state C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_boat_state_decode(const mavlink_message_t* msg, mavlink_boat_state_t* boat_state)
+{
+#if MAVLINK_NEED_BYTE_SWAP
+	boat_state->north = mavlink_msg_boat_state_get_north(msg);
+	boat_state->east = mavlink_msg_boat_state_get_east(msg);
+	boat_state->down = mavlink_msg_boat_state_get_down(msg);
+	boat_state->heading = mavlink_msg_boat_state_get_heading(msg);
+	boat_state->speed = mavlink_msg_boat_state_get_speed(msg);
+	boat_state->batVolt1 = mavlink_msg_boat_state_get_batVolt1(msg);
+	boat_state->batVolt2 = mavlink_msg_boat_state_get_batVolt2(msg);
+	boat_state->ack = mavlink_msg_boat_state_get_ack(msg);
+	boat_state->keyframe = mavlink_msg_boat_state_get_keyframe(msg);
+	boat_state->navState = mavlink_msg_boat_state_get_navState(msg);
+	boat_state->error = mavlink_msg_boat_state_get_error(msg);
+#else
+	memcpy(boat_state, _MAV_PAYLOAD(msg), 22);
+#endif
+}
@@ -0,0 +1,254 @@
+// MESSAGE BOAT_STATE_DELTA PACKING
+
+#define MAVLINK_MSG_ID_BOAT_STATE_DELTA 247
+
+typedef struct __mavlink_boat_state_delta_t
+{
+ int16_t north; ///< Change in north position in cm.
+ int16_t east; ///< Change in east position in cm.
+ uint8_t ack; ///< Always FALSE.
+ uint8_t keyframe; ///< Number of the keyframe this frame is relative to.
+ int8_t heading; ///< Change in heading in degrees.
+ int8_t speed; ///< Change in speed in cm/s.
+} mavlink_boat_state_delta_t;
+
+#define MAVLINK_MSG_ID_BOAT_STATE_DELTA_LEN 8
+#define MAVLINK_MSG_ID_247_LEN 8
+
+
+
+#define MAVLINK_MESSAGE_INFO_BOAT_STATE_DELTA { \
+	"BOAT_STATE_DELTA", \
+	6, \
+	{  { "north", NULL, MAVLINK_TYPE_INT16_T, 0, 0, offsetof(mavlink_boat_state_delta_t, north) }, \
+         { "east", NULL, MAVLINK_TYPE_INT16_T, 0, 2, offsetof(mavlink_boat_state_delta_t, east) }, \
+         { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 4, offsetof(mavlink_boat_state_delta_t, ack) }, \
+         { "keyframe", NULL, MAVLINK_TYPE_UINT8_T, 0, 5, offsetof(mavlink_boat_state_delta_t, keyframe) }, \
+         { "heading", NULL, MAVLINK_TYPE_INT8_T, 0, 6, offsetof(mavlink_boat_state_delta_t, heading) }, \
+         { "speed", NULL, MAVLINK_TYPE_INT8_T, 0, 7, offsetof(mavlink_boat_state_delta_t, speed) }, \
+         } \
+}
+
+
+/**
+ * @brief Pack a boat_state_delta message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param ack Always FALSE.
+ * @param keyframe Number of the keyframe this frame is relative to.
+ * @param north Change in north position in cm.
+ * @param east Change in east position in cm.
+ * @param heading Change in heading in degrees.
+ * @param speed Change in speed in cm/s.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_boat_state_delta_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint8_t ack, uint8_t keyframe, int16_t north, int16_t east, int8_t heading, int8_t speed)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[8];
+	_mav_put_int16_t(buf, 0, north);
+	_mav_put_int16_t(buf, 2, east);
+	_mav_put_uint8_t(buf, 4, ack);
+	_mav_put_uint8_t(buf, 5, keyframe);
+	_mav_put_int8_t(buf, 6, heading);
+	_mav_put_int8_t(buf, 7, speed);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 8);
+#else
+	mavlink_boat_state_delta_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.heading = heading;
+	packet.speed = speed;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 8);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_BOAT_STATE_DELTA;
+	return mavlink_finalize_message(msg, system_id, component_id, 8, 94);
+}
+
+/**
+ * @brief Pack a boat_state_delta message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message was sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param ack Always FALSE.
+ * @param keyframe Number of the keyframe this frame is relative to.
+ * @param north Change in north position in cm.
+ * @param east Change in east position in cm.
+ * @param heading Change in heading in degrees.
+ * @param speed Change in speed in cm/s.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_boat_state_delta_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint8_t ack,uint8_t keyframe,int16_t north,int16_t east,int8_t heading,int8_t speed)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[8];
+	_mav_put_int16_t(buf, 0, north);
+	_mav_put_int16_t(buf, 2, east);
+	_mav_put_uint8_t(buf, 4, ack);
+	_mav_put_uint8_t(buf, 5, keyframe);
+	_mav_put_int8_t(buf, 6, heading);
+	_mav_put_int8_t(buf, 7, speed);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 8);
+#else
+	mavlink_boat_state_delta_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.heading = heading;
+	packet.speed = speed;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 8);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_BOAT_STATE_DELTA;
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 8, 94);
+}
+
+/**
+ * @brief Encode a boat_state_delta struct into a message
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param boat_state_delta C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_boat_state_delta_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_boat_state_delta_t* boat_state_delta)
+{
+	return mavlink_msg_boat_state_delta_pack(system_id, component_id, msg, boat_state_delta->ack, boat_state_delta->keyframe, boat_state_delta->north, boat_state_delta->east, boat_state_delta->heading, boat_state_delta->speed);
+}
+
+/**
+ * @brief Send a boat_state_delta message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param ack Always FALSE.
+ * @param keyframe Number of the keyframe this frame is relative to.
+ * @param north Change in north position in cm.
+ * @param east Change in east position in cm.
+ * @param heading Change in heading in degrees.
+ * @param speed Change in speed in cm/s.
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_boat_state_delta_send(mavlink_channel_t chan, uint8_t ack, uint8_t keyframe, int16_t north, int16_t east, int8_t heading, int8_t speed)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[8];
+	_mav_put_int16_t(buf, 0, north);
+	_mav_put_int16_t(buf, 2, east);
+	_mav_put_uint8_t(buf, 4, ack);
+	_mav_put_uint8_t(buf, 5, keyframe);
+	_mav_put_int8_t(buf, 6, heading);
+	_mav_put_int8_t(buf, 7, speed);
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_BOAT_STATE_DELTA, buf, 8, 94);
+#else
+	mavlink_boat_state_delta_t packet;
+	packet.north = north;
+	packet.east = east;
+	packet.ack = ack;
+	packet.keyframe = keyframe;
+	packet.heading = heading;
+	packet.speed = speed;
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_BOAT_STATE_DELTA, (const char *)&packet, 8, 94);
+#endif
+}
+
+#endif
+
+// MESSAGE BOAT_STATE_DELTA UNPACKING
+
+
+/**
+ * @brief Get field ack from boat_state_delta message
+ *
+ * @return Always FALSE.
+ */
+static inline uint8_t mavlink_msg_boat_state_delta_get_ack(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  4);
+}
+
+/**
+ * @brief Get field keyframe from boat_state_delta message
+ *
+ * @return Number of the keyframe this frame is relative to.
+ */
+static inline uint8_t mavlink_msg_boat_state_delta_get_keyframe(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  5);
+}
+
+/**
+ * @brief Get field north from boat_state_delta message
+ *
+ * @return Change in north position in cm.
+ */
+static inline int16_t mavlink_msg_boat_state_delta_get_north(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int16_t(msg,  0);
+}
+
+/**
+ * @brief Get field east from boat_state_delta message
+ *
+ * @return Change in east position in cm.
+ */
+static inline int16_t mavlink_msg_boat_state_delta_get_east(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int16_t(msg,  2);
+}
+
+/**
+ * @brief Get field heading from boat_state_delta message
+ *
+ * @return Change in heading in degrees.
+ */
+static inline int8_t mavlink_msg_boat_state_delta_get_heading(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int8_t(msg,  6);
+}
+
+/**
+ * @brief Get field speed from boat_state_delta message
+ *
+ * @return Change in speed in cm/s.
+ */
+static inline int8_t mavlink_msg_boat_state_delta_get_speed(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_int8_t(msg,  7);
+}
+
+/**
+ * @brief Decode a boat_state_delta message into a struct
+ *
+ * @param msg The message to decode
+ * @param boat_state_delta C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_boat_state_delta_decode(const mavlink_message_t* msg, mavlink_boat_state_delta_t* boat_state_delta)
+{
+#if MAVLINK_NEED_BYTE_SWAP
+	boat_state_delta->north = mavlink_msg_boat_state_delta_get_north(msg);
+	boat_state_delta->east = mavlink_msg_boat_state_delta_get_east(msg);
+	boat_state_delta->ack = mavlink_msg_boat_state_delta_get_ack(msg);
+	boat_state_delta->keyframe = mavlink_msg_boat_state_delta_get_keyframe(msg);
+	boat_state_delta->heading = mavlink_msg_boat_state_delta_get_heading(msg);
+	boat_state_delta->speed = mavlink_msg_boat_state_delta_get_speed(msg);
+#else
+	memcpy(boat_state_delta, _MAV_PAYLOAD(msg), 8);
+#endif
+}
@@ -0,0 +1,226 @@
+// MESSAGE DEBUG_EVENT PACKING
+
+#define MAVLINK_MSG_ID_DEBUG_EVENT 248
+
+typedef struct __mavlink_debug_event_t
+{
+ uint16_t message; ///< ID of the format in ConsoleMessages.h.
+ uint8_t ack; ///< Always FALSE.
+ uint8_t sender; ///< Sent by AtLAs (0x1) or ComPAS (0x2).
+ uint8_t count; ///< Number of arguments used.
+ uint8_t args[32]; ///< Raw 32-bit arguments (see CONSOLE_INT and CONSOLE_FLOAT), little endian. Unused ones are zero, so a trimmed payload drops them.
+} mavlink_debug_event_t;
+
+#define MAVLINK_MSG_ID_DEBUG_EVENT_LEN 37
+#define MAVLINK_MSG_ID_248_LEN 37
+
+#define MAVLINK_MSG_DEBUG_EVENT_FIELD_ARGS_LEN 32
+
+#define MAVLINK_MESSAGE_INFO_DEBUG_EVENT { \
+	"DEBUG_EVENT", \
+	5, \
+	{  { "message", NULL, MAVLINK_TYPE_UINT16_T, 0, 0, offsetof(mavlink_debug_event_t, message) }, \
+         { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 2, offsetof(mavlink_debug_event_t, ack) }, \
+         { "sender", NULL, MAVLINK_TYPE_UINT8_T, 0, 3, offsetof(mavlink_debug_event_t, sender) }, \
+         { "count", NULL, MAVLINK_TYPE_UINT8_T, 0, 4, offsetof(mavlink_debug_event_t, count) }, \
+         { "args", NULL, MAVLINK_TYPE_UINT8_T, 32, 5, offsetof(mavlink_debug_event_t, args) }, \
+         } \
+}
+
+
+/**
+ * @brief Pack a debug_event message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param ack Always FALSE.
+ * @param sender Sent by AtLAs (0x1) or ComPAS (0x2).
+ * @param message ID of the format in ConsoleMessages.h.
+ * @param count Number of arguments used.
+ * @param args Raw 32-bit arguments (see CONSOLE_INT and CONSOLE_FLOAT), little endian. Unused ones are zero, so a trimmed payload drops them.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_debug_event_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint8_t ack, uint8_t sender, uint16_t message, uint8_t count, const uint8_t *args)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[37];
+	_mav_put_uint16_t(buf, 0, message);
+	_mav_put_uint8_t(buf, 2, ack);
+	_mav_put_uint8_t(buf, 3, sender);
+	_mav_put_uint8_t(buf, 4, count);
+	_mav_put_uint8_t_array(buf, 5, args, 32);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 37);
+#else
+	mavlink_debug_event_t packet;
+	packet.message = message;
+	packet.ack = ack;
+	packet.sender = sender;
+	packet.count = count;
+	mav_array_memcpy(packet.args, args, sizeof(uint8_t)*32);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 37);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_DEBUG_EVENT;
+	return mavlink_finalize_message(msg, system_id, component_id, 37, 75);
+}
+
+/**
+ * @brief Pack a debug_event message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message was sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param ack Always FALSE.
+ * @param sender Sent by AtLAs (0x1) or ComPAS (0x2).
+ * @param message ID of the format in ConsoleMessages.h.
+ * @param count Number of arguments used.
+ * @param args Raw 32-bit arguments (see CONSOLE_INT and CONSOLE_FLOAT), little endian. Unused ones are zero, so a trimmed payload drops them.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_debug_event_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint8_t ack,uint8_t sender,uint16_t message,uint8_t count,const uint8_t *args)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[37];
+	_mav_put_uint16_t(buf, 0, message);
+	_mav_put_uint8_t(buf, 2, ack);
+	_mav_put_uint8_t(buf, 3, sender);
+	_mav_put_uint8_t(buf, 4, count);
+	_mav_put_uint8_t_array(buf, 5, args, 32);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 37);
+#else
+	mavlink_debug_event_t packet;
+	packet.message = message;
+	packet.ack = ack;
+	packet.sender = sender;
+	packet.count = count;
+	mav_array_memcpy(packet.args, args, sizeof(uint8_t)*32);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 37);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_DEBUG_EVENT;
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 37, 75);
+}
+
+/**
+ * @brief Encode a debug_event struct into a message
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param debug_event C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_debug_event_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_debug_event_t* debug_event)
+{
+	return mavlink_msg_debug_event_pack(system_id, component_id, msg, debug_event->ack, debug_event->sender, debug_event->message, debug_event->count, debug_event->args);
+}
+
+/**
+ * @brief Send a debug_event message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param ack Always FALSE.
+ * @param sender Sent by AtLAs (0x1) or ComPAS (0x2).
+ * @param message ID of the format in ConsoleMessages.h.
+ * @param count Number of arguments used.
+ * @param args Raw 32-bit arguments (see CONSOLE_INT and CONSOLE_FLOAT), little endian. Unused ones are zero, so a trimmed payload drops them.
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_debug_event_send(mavlink_channel_t chan, uint8_t ack, uint8_t sender, uint16_t message, uint8_t count, const uint8_t *args)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[37];
+	_mav_put_uint16_t(buf, 0, message);
+	_mav_put_uint8_t(buf, 2, ack);
+	_mav_put_uint8_t(buf, 3, sender);
+	_mav_put_uint8_t(buf, 4, count);
+	_mav_put_uint8_t_array(buf, 5, args, 32);
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_DEBUG_EVENT, buf, 37, 75);
+#else
+	mavlink_debug_event_t packet;
+	packet.message = message;
+	packet.ack = ack;
+	packet.sender = sender;
+	packet.count = count;
+	mav_array_memcpy(packet.args, args, sizeof(uint8_t)*32);
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_DEBUG_EVENT, (const char *)&packet, 37, 75);
+#endif
+}
+
+#endif
+
+// MESSAGE DEBUG_EVENT UNPACKING
+
+
+/**
+ * @brief Get field ack from debug_event message
+ *
+ * @return Always FALSE.
+ */
+static inline uint8_t mavlink_msg_debug_event_get_ack(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  2);
+}
+
+/**
+ * @brief Get field sender from debug_event message
+ *
+ * @return Sent by AtLAs (0x1) or ComPAS (0x2).
+ */
+static inline uint8_t mavlink_msg_debug_event_get_sender(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  3);
+}
+
+/**
+ * @brief Get field message from debug_event message
+ *
+ * @return ID of the format in ConsoleMessages.h.
+ */
+static inline uint16_t mavlink_msg_debug_event_get_message(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  0);
+}
+
+/**
+ * @brief Get field count from debug_event message
+ *
+ * @return Number of arguments used.
+ */
+static inline uint8_t mavlink_msg_debug_event_get_count(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  4);
+}
+
+/**
+ * @brief Get field args from debug_event message
+ *
+ * @return Raw 32-bit arguments (see CONSOLE_INT and CONSOLE_FLOAT), little endian. Unused ones are zero, so a trimmed payload drops them.
+ */
+static inline uint16_t mavlink_msg_debug_event_get_args(const mavlink_message_t* msg, uint8_t *args)
+{
+	return _MAV_RETURN_uint8_t_array(msg, args, 32,  5);
+}
+
+/**
+ * @brief Decode a debug_event message into a struct
+ *
+ * @param msg The message to decode
+ * @param debug_event C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_debug_event_decode(const mavlink_message_t* msg, mavlink_debug_event_t* debug_event)
+{
+#if MAVLINK_NEED_BYTE_SWAP
+	debug_event->message = mavlink_msg_debug_event_get_message(msg);
+	debug_event->ack = mavlink_msg_debug_event_get_ack(msg);
+	debug_event->sender = mavlink_msg_debug_event_get_sender(msg);
+	debug_event->count = mavlink_msg_debug_event_get_count(msg);
+	mavlink_msg_debug_event_get_args(msg, debug_event->args);
+#else
+	memcpy(debug_event, _MAV_PAYLOAD(msg), 37);
+#endif
+}
@@ -4,9 +4,9 @@
 
 typedef struct __mavlink_gps_ecef_t
 {
- float x; ///< Geocentric x position in meters
- float y; ///< Geocentric y position in meters
- float z; ///< Geocentric z position in meters
+ int32_t x; ///< Geocentric x position in cm
+ int32_t y; ///< Geocentric y position in cm
+ int32_t z; ///< Geocentric z position in cm
  uint8_t ack; ///< TRUE or FALSE if acknowledgement required.
  uint8_t status; ///< Command center's origin (0x1), or GPS error (0x2)
 } mavlink_gps_ecef_t;
@@ -19,9 +19,9 @@ typedef struct __mavlink_gps_ecef_t
 #define MAVLINK_MESSAGE_INFO_GPS_ECEF { \
 	"GPS_ECEF", \
 	5, \
-	{  { "x", NULL, MAVLINK_TYPE_FLOAT, 0, 0, offsetof(mavlink_gps_ecef_t, x) }, \
-         { "y", NULL, MAVLINK_TYPE_FLOAT, 0, 4, offsetof(mavlink_gps_ecef_t, y) }, \
-         { "z", NULL, MAVLINK_TYPE_FLOAT, 0, 8, offsetof(mavlink_gps_ecef_t, z) }, \
+	{  { "x", NULL, MAVLINK_TYPE_INT32_T, 0, 0, offsetof(mavlink_gps_ecef_t, x) }, \
+         { "y", NULL, MAVLINK_TYPE_INT32_T, 0, 4, offsetof(mavlink_gps_ecef_t, y) }, \
+         { "z", NULL, MAVLINK_TYPE_INT32_T, 0, 8, offsetof(mavlink_gps_ecef_t, z) }, \
          { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 12, offsetof(mavlink_gps_ecef_t, ack) }, \
          { "status", NULL, MAVLINK_TYPE_UINT8_T, 0, 13, offsetof(mavlink_gps_ecef_t, status) }, \
          } \
@@ -36,19 +36,19 @@ typedef struct __mavlink_gps_ecef_t
  *
  * @param ack TRUE or FALSE if acknowledgement required.
  * @param status Command center's origin (0x1), or GPS error (0x2)
- * @param x Geocentric x position in meters
- * @param y Geocentric y position in meters
- * @param z Geocentric z position in meters
+ * @param x Geocentric x position in cm
+ * @param y Geocentric y position in cm
+ * @param z Geocentric z position in cm
  * @return length of the message in bytes (excluding serial stream start sign)
  */
 static inline uint16_t mavlink_msg_gps_ecef_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
-						       uint8_t ack, uint8_t status, float x, float y, float z)
+						       uint8_t ack, uint8_t status, int32_t x, int32_t y, int32_t z)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
 	char buf[14];
-	_mav_put_float(buf, 0, x);
-	_mav_put_float(buf, 4, y);
-	_mav_put_float(buf, 8, z);
+	_mav_put_int32_t(buf, 0, x);
+	_mav_put_int32_t(buf, 4, y);
+	_mav_put_int32_t(buf, 8, z);
 	_mav_put_uint8_t(buf, 12, ack);
 	_mav_put_uint8_t(buf, 13, status);
 
@@ -65,7 +65,7 @@ static inline uint16_t mavlink_msg_gps_ecef_pack(uint8_t system_id, uint8_t comp
 #endif
 
 	msg->msgid = MAVLINK_MSG_ID_GPS_ECEF;
-	return mavlink_finalize_message(msg, system_id, component_id, 14, 222);
+	return mavlink_finalize_message(msg, system_id, component_id, 14, 44);
 }
 
 /**
@@ -76,20 +76,20 @@ static inline uint16_t mavlink_msg_gps_ecef_pack(uint8_t system_id, uint8_t comp
  * @param msg The MAVLink message to compress the data into
  * @param ack TRUE or FALSE if acknowledgement required.
  * @param status Command center's origin (0x1), or GPS error (0x2)
- * @param x Geocentric x position in meters
- * @param y Geocentric y position in meters
- * @param z Geocentric z position in meters
+ * @param x Geocentric x position in cm
+ * @param y Geocentric y position in cm
+ * @param z Geocentric z position in cm
  * @return length of the message in bytes (excluding serial stream start sign)
  */
 static inline uint16_t mavlink_msg_gps_ecef_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
 							   mavlink_message_t* msg,
-						           uint8_t ack,uint8_t status,float x,float y,float z)
+						           uint8_t ack,uint8_t status,int32_t x,int32_t y,int32_t z)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
 	char buf[14];
-	_mav_put_float(buf, 0, x);
-	_mav_put_float(buf, 4, y);
-	_mav_put_float(buf, 8, z);
+	_mav_put_int32_t(buf, 0, x);
+	_mav_put_int32_t(buf, 4, y);
+	_mav_put_int32_t(buf, 8, z);
 	_mav_put_uint8_t(buf, 12, ack);
 	_mav_put_uint8_t(buf, 13, status);
 
@@ -106,7 +106,7 @@ static inline uint16_t mavlink_msg_gps_ecef_pack_chan(uint8_t system_id, uint8_t
 #endif
 
 	msg->msgid = MAVLINK_MSG_ID_GPS_ECEF;
-	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 14, 222);
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 14, 44);
 }
 
 /**
@@ -128,23 +128,23 @@ static inline uint16_t mavlink_msg_gps_ecef_encode(uint8_t system_id, uint8_t co
  *
  * @param ack TRUE or FALSE if acknowledgement required.
  * @param status Command center's origin (0x1), or GPS error (0x2)
- * @param x Geocentric x position in meters
- * @param y Geocentric y position in meters
- * @param z Geocentric z position in meters
+ * @param x Geocentric x position in cm
+ * @param y Geocentric y position in cm
+ * @param z Geocentric z position in cm
  */
 #ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
-static inline void mavlink_msg_gps_ecef_send(mavlink_channel_t chan, uint8_t ack, uint8_t status, float x, float y, float z)
+static inline void mavlink_msg_gps_ecef_send(mavlink_channel_t chan, uint8_t ack, uint8_t status, int32_t x, int32_t y, int32_t z)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
 	char buf[14];
-	_mav_put_float(buf, 0, x);
-	_mav_put_float(buf, 4, y);
-	_mav_put_float(buf, 8, z);
+	_mav_put_int32_t(buf, 0, x);
+	_mav_put_int32_t(buf, 4, y);
+	_mav_put_int32_t(buf, 8, z);
 	_mav_put_uint8_t(buf, 12, ack);
 	_mav_put_uint8_t(buf, 13, status);
 
-	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_GPS_ECEF, buf, 14, 222);
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_GPS_ECEF, buf, 14, 44);
 #else
 	mavlink_gps_ecef_t packet;
 	packet.x = x;
@@ -153,7 +153,7 @@ static inline void mavlink_msg_gps_ecef_send(mavlink_channel_t chan, uint8_t ack
 	packet.ack = ack;
 	packet.status = status;
 
-	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_GPS_ECEF, (const char *)&packet, 14, 222);
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_GPS_ECEF, (const char *)&packet, 14, 44);
 #endif
 }
 
@@ -185,31 +185,31 @@ static inline uint8_t mavlink_msg_gps_ecef_get_status(const mavlink_message_t* m
 /**
  * @brief Get field x from gps_ecef message
  *
- * @return Geocentric x position in meters
+ * @return Geocentric x position in cm
  */
-static inline float mavlink_msg_gps_ecef_get_x(const mavlink_message_t* msg)
+static inline int32_t mavlink_msg_gps_ecef_get_x(const mavlink_message_t* msg)
 {
-	return _MAV_RETURN_float(msg,  0);
+	return _MAV_RETURN_int32_t(msg,  0);
 }
 
 /**
  * @brief Get field y from gps_ecef message
  *
- * @return Geocentric y position in meters
+ * @return Geocentric y position in cm
  */
-static inline float mavlink_msg_gps_ecef_get_y(const mavlink_message_t* msg)
+static inline int32_t mavlink_msg_gps_ecef_get_y(const mavlink_message_t* msg)
 {
-	return _MAV_RETURN_float(msg,  4);
+	return _MAV_RETURN_int32_t(msg,  4);
 }
 
 /**
  * @brief Get field z from gps_ecef message
  *
- * @return Geocentric z position in meters
+ * @return Geocentric z position in cm
  */
-static inline float mavlink_msg_gps_ecef_get_z(const mavlink_message_t* msg)
+static inline int32_t mavlink_msg_gps_ecef_get_z(const mavlink_message_t* msg)
 {
-	return _MAV_RETURN_float(msg,  8);
+	return _MAV_RETURN_int32_t(msg,  8);
 }
 
 /**
@@ -4,20 +4,28 @@
 
 typedef struct __mavlink_heartbeat_t
 {
+ uint32_t time; ///< Time (ms) of the sender when sent.
+ uint32_t echoTime; ///< Time from the last heartbeat received from the other end.
+ uint16_t echoDelay; ///< Time (ms) since that heartbeat arrived, or 0xFFFF if there is none.
+ uint16_t framesSent; ///< Frames sent by the sender so far, modulo 65536.
  uint8_t ack; ///< TRUE or FALSE if acknowledgement required.
- uint8_t data; ///< Holds raw data for use in testing
+ uint8_t data; ///< Bit 0 is always set. Bit 1 is set if the sender fills out payloads with their trailing zeros dropped.
 } mavlink_heartbeat_t;
 
-#define MAVLINK_MSG_ID_HEARTBEAT_LEN 2
-#define MAVLINK_MSG_ID_236_LEN 2
+#define MAVLINK_MSG_ID_HEARTBEAT_LEN 14
+#define MAVLINK_MSG_ID_236_LEN 14
 
 
 
 #define MAVLINK_MESSAGE_INFO_HEARTBEAT { \
 	"HEARTBEAT", \
-	2, \
-	{  { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 0, offsetof(mavlink_heartbeat_t, ack) }, \
-         { "data", NULL, MAVLINK_TYPE_UINT8_T, 0, 1, offsetof(mavlink_heartbeat_t, data) }, \
+	6, \
+	{  { "time", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_heartbeat_t, time) }, \
+         { "echoTime", NULL, MAVLINK_TYPE_UINT32_T, 0, 4, offsetof(mavlink_heartbeat_t, echoTime) }, \
+         { "echoDelay", NULL, MAVLINK_TYPE_UINT16_T, 0, 8, offsetof(mavlink_heartbeat_t, echoDelay) }, \
+         { "framesSent", NULL, MAVLINK_TYPE_UINT16_T, 0, 10, offsetof(mavlink_heartbeat_t, framesSent) }, \
+         { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 12, offsetof(mavlink_heartbeat_t, ack) }, \
+         { "data", NULL, MAVLINK_TYPE_UINT8_T, 0, 13, offsetof(mavlink_heartbeat_t, data) }, \
          } \
 }
 
@@ -29,28 +37,40 @@ typedef struct __mavlink_heartbeat_t
  * @param msg The MAVLink message to compress the data into
  *
  * @param ack TRUE or FALSE if acknowledgement required.
- * @param data Holds raw data for use in testing
+ * @param data Bit 0 is always set. Bit 1 is set if the sender fills out payloads with their trailing zeros dropped.
+ * @param time Time (ms) of the sender when sent.
+ * @param echoTime Time from the last heartbeat received from the other end.
+ * @param echoDelay Time (ms) since that heartbeat arrived, or 0xFFFF if there is none.
+ * @param framesSent Frames sent by the sender so far, modulo 65536.
  * @return length of the message in bytes (excluding serial stream start sign)
  */
 static inline uint16_t mavlink_msg_heartbeat_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
-						       uint8_t ack, uint8_t data)
+						       uint8_t ack, uint8_t data, uint32_t time, uint32_t echoTime, uint16_t echoDelay, uint16_t framesSent)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
-	char buf[2];
-	_mav_put_uint8_t(buf, 0, ack);
-	_mav_put_uint8_t(buf, 1, data);
-
-        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 2);
+	char buf[14];
+	_mav_put_uint32_t(buf, 0, time);
+	_mav_put_uint32_t(buf, 4, echoTime);
+	_mav_put_uint16_t(buf, 8, echoDelay);
+	_mav_put_uint16_t(buf, 10, framesSent);
+	_mav_put_uint8_t(buf, 12, ack);
+	_mav_put_uint8_t(buf, 13, data);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 14);
 #else
 	mavlink_heartbeat_t packet;
+	packet.time = time;
+	packet.echoTime = echoTime;
+	packet.echoDelay = echoDelay;
+	packet.framesSent = framesSent;
 	packet.ack = ack;
 	packet.data = data;
 
-        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 2);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 14);
 #endif
 
 	msg->msgid = MAVLINK_MSG_ID_HEARTBEAT;
-	return mavlink_finalize_message(msg, system_id, component_id, 2, 213);
+	return mavlink_finalize_message(msg, system_id, component_id, 14, 215);
 }
 
 /**
@@ -60,29 +80,41 @@ static inline uint16_t mavlink_msg_heartbeat_pack(uint8_t system_id, uint8_t com
  * @param chan The MAVLink channel this message was sent over
  * @param msg The MAVLink message to compress the data into
  * @param ack TRUE or FALSE if acknowledgement required.
- * @param data Holds raw data for use in testing
+ * @param data Bit 0 is always set. Bit 1 is set if the sender fills out payloads with their trailing zeros dropped.
+ * @param time Time (ms) of the sender when sent.
+ * @param echoTime Time from the last heartbeat received from the other end.
+ * @param echoDelay Time (ms) since that heartbeat arrived, or 0xFFFF if there is none.
+ * @param framesSent Frames sent by the sender so far, modulo 65536.
  * @return length of the message in bytes (excluding serial stream start sign)
  */
 static inline uint16_t mavlink_msg_heartbeat_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
 							   mavlink_message_t* msg,
-						           uint8_t ack,uint8_t data)
+						           uint8_t ack,uint8_t data,uint32_t time,uint32_t echoTime,uint16_t echoDelay,uint16_t framesSent)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
-	char buf[2];
-	_mav_put_uint8_t(buf, 0, ack);
-	_mav_put_uint8_t(buf, 1, data);
-
-        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 2);
+	char buf[14];
+	_mav_put_uint32_t(buf, 0, time);
+	_mav_put_uint32_t(buf, 4, echoTime);
+	_mav_put_uint16_t(buf, 8, echoDelay);
+	_mav_put_uint16_t(buf, 10, framesSent);
+	_mav_put_uint8_t(buf, 12, ack);
+	_mav_put_uint8_t(buf, 13, data);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 14);
 #else
 	mavlink_heartbeat_t packet;
+	packet.time = time;
+	packet.echoTime = echoTime;
+	packet.echoDelay = echoDelay;
+	packet.framesSent = framesSent;
 	packet.ack = ack;
 	packet.data = data;
 
-        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 2);
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 14);
 #endif
 
 	msg->msgid = MAVLINK_MSG_ID_HEARTBEAT;
-	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 2, 213);
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 14, 215);
 }
 
 /**
@@ -95,7 +127,7 @@ static inline uint16_t mavlink_msg_heartbeat_pack_chan(uint8_t system_id, uint8_
  */
 static inline uint16_t mavlink_msg_heartbeat_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_heartbeat_t* heartbeat)
 {
-	return mavlink_msg_heartbeat_pack(system_id, component_id, msg, heartbeat->ack, heartbeat->data);
+	return mavlink_msg_heartbeat_pack(system_id, component_id, msg, heartbeat->ack, heartbeat->data, heartbeat->time, heartbeat->echoTime, heartbeat->echoDelay, heartbeat->framesSent);
 }
 
 /**
@@ -103,24 +135,36 @@ static inline uint16_t mavlink_msg_heartbeat_encode(uint8_t system_id, uint8_t c
  * @param chan MAVLink channel to send the message
  *
  * @param ack TRUE or FALSE if acknowledgement required.
- * @param data Holds raw data for use in testing
+ * @param data Bit 0 is always set. Bit 1 is set if the sender fills out payloads with their trailing zeros dropped.
+ * @param time Time (ms) of the sender when sent.
+ * @param echoTime Time from the last heartbeat received from the other end.
+ * @param echoDelay Time (ms) since that heartbeat arrived, or 0xFFFF if there is none.
+ * @param framesSent Frames sent by the sender so far, modulo 65536.
  */
 #ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
 
-static inline void mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t ack, uint8_t data)
+static inline void mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t ack, uint8_t data, uint32_t time, uint32_t echoTime, uint16_t echoDelay, uint16_t framesSent)
 {
 #if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
-	char buf[2];
-	_mav_put_uint8_t(buf, 0, ack);
-	_mav_put_uint8_t(buf, 1, data);
-
-	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, buf, 2, 213);
+	char buf[14];
+	_mav_put_uint32_t(buf, 0, time);
+	_mav_put_uint32_t(buf, 4, echoTime);
+	_mav_put_uint16_t(buf, 8, echoDelay);
+	_mav_put_uint16_t(buf, 10, framesSent);
+	_mav_put_uint8_t(buf, 12, ack);
+	_mav_put_uint8_t(buf, 13, data);
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, buf, 14, 215);
 #else
 	mavlink_heartbeat_t packet;
+	packet.time = time;
+	packet.echoTime = echoTime;
+	packet.echoDelay = echoDelay;
+	packet.framesSent = framesSent;
 	packet.ack = ack;
 	packet.data = data;
 
-	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, (const char *)&packet, 2, 213);
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_HEARTBEAT, (const char *)&packet, 14, 215);
 #endif
 }
 
@@ -136,17 +180,57 @@ static inline void mavlink_msg_heartbeat_send(mavlink_channel_t chan, uint8_t ac
  */
 static inline uint8_t mavlink_msg_heartbeat_get_ack(const mavlink_message_t* msg)
 {
-	return _MAV_RETURN_uint8_t(msg,  0);
+	return _MAV_RETURN_uint8_t(msg,  12);
 }
 
 /**
  * @brief Get field data from heartbeat message
  *
- * @return Holds raw data for use in testing
+ * @return Bit 0 is always set. Bit 1 is set if the sender fills out payloads with their trailing zeros dropped.
  */
 static inline uint8_t mavlink_msg_heartbeat_get_data(const mavlink_message_t* msg)
 {
-	return _MAV_RETURN_uint8_t(msg,  1);
+	return _MAV_RETURN_uint8_t(msg,  13);
+}
+
+/**
+ * @brief Get field time from heartbeat message
+ *
+ * @return Time (ms) of the sender when sent.
+ */
+static inline uint32_t mavlink_msg_heartbeat_get_time(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  0);
+}
+
+/**
+ * @brief Get field echoTime from heartbeat message
+ *
+ * @return Time from the last heartbeat received from the other end.
+ */
+static inline uint32_t mavlink_msg_heartbeat_get_echoTime(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  4);
+}
+
+/**
+ * @brief Get field echoDelay from heartbeat message
+ *
+ * @return Time (ms) since that heartbeat arrived, or 0xFFFF if there is none.
+ */
+static inline uint16_t mavlink_msg_heartbeat_get_echoDelay(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  8);
+}
+
+/**
+ * @brief Get field framesSent from heartbeat message
+ *
+ * @return Frames sent by the sender so far, modulo 65536.
+ */
+static inline uint16_t mavlink_msg_heartbeat_get_framesSent(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  10);
 }
 
 /**
@@ -158,9 +242,13 @@ static inline uint8_t mavlink_msg_heartbeat_get_data(const mavlink_message_t* ms
 static inline void mavlink_msg_heartbeat_decode(const mavlink_message_t* msg, mavlink_heartbeat_t* heartbeat)
 {
 #if MAVLINK_NEED_BYTE_SWAP
+	heartbeat->time = mavlink_msg_heartbeat_get_time(msg);
+	heartbeat->echoTime = mavlink_msg_heartbeat_get_echoTime(msg);
+	heartbeat->echoDelay = mavlink_msg_heartbeat_get_echoDelay(msg);
+	heartbeat->framesSent = mavlink_msg_heartbeat_get_framesSent(msg);
 	heartbeat->ack = mavlink_msg_heartbeat_get_ack(msg);
 	heartbeat->data = mavlink_msg_heartbeat_get_data(msg);
 #else
-	memcpy(heartbeat, _MAV_PAYLOAD(msg), 2);
+	memcpy(heartbeat, _MAV_PAYLOAD(msg), 14);
 #endif
 }
@@ -0,0 +1,342 @@
+// MESSAGE UART_STATS PACKING
+
+#define MAVLINK_MSG_ID_UART_STATS 244
+
+typedef struct __mavlink_uart_stats_t
+{
+ uint32_t bytesIn; ///< Bytes received since the statistics were cleared.
+ uint32_t bytesOut; ///< Bytes transmitted since the statistics were cleared.
+ uint32_t receiveDropped; ///< Received bytes dropped because the receive buffer was full.
+ uint32_t transmitDropped; ///< Bytes dropped because the transmit buffer was full.
+ uint32_t interruptCount; ///< Number of UART interrupts.
+ uint32_t interruptTicks; ///< Core timer ticks (SYSCLK/2) spent in the UART interrupt.
+ uint16_t receivePeak; ///< Peak receive buffer occupancy in bytes.
+ uint16_t transmitPeak; ///< Peak transmit buffer occupancy in bytes.
+ uint8_t ack; ///< Always FALSE.
+ uint8_t uartId; ///< UART module the statistics are for.
+} mavlink_uart_stats_t;
+
+#define MAVLINK_MSG_ID_UART_STATS_LEN 30
+#define MAVLINK_MSG_ID_244_LEN 30
+
+
+
+#define MAVLINK_MESSAGE_INFO_UART_STATS { \
+	"UART_STATS", \
+	10, \
+	{  { "bytesIn", NULL, MAVLINK_TYPE_UINT32_T, 0, 0, offsetof(mavlink_uart_stats_t, bytesIn) }, \
+         { "bytesOut", NULL, MAVLINK_TYPE_UINT32_T, 0, 4, offsetof(mavlink_uart_stats_t, bytesOut) }, \
+         { "receiveDropped", NULL, MAVLINK_TYPE_UINT32_T, 0, 8, offsetof(mavlink_uart_stats_t, receiveDropped) }, \
+         { "transmitDropped", NULL, MAVLINK_TYPE_UINT32_T, 0, 12, offsetof(mavlink_uart_stats_t, transmitDropped) }, \
+         { "interruptCount", NULL, MAVLINK_TYPE_UINT32_T, 0, 16, offsetof(mavlink_uart_stats_t, interruptCount) }, \
+         { "interruptTicks", NULL, MAVLINK_TYPE_UINT32_T, 0, 20, offsetof(mavlink_uart_stats_t, interruptTicks) }, \
+         { "receivePeak", NULL, MAVLINK_TYPE_UINT16_T, 0, 24, offsetof(mavlink_uart_stats_t, receivePeak) }, \
+         { "transmitPeak", NULL, MAVLINK_TYPE_UINT16_T, 0, 26, offsetof(mavlink_uart_stats_t, transmitPeak) }, \
+         { "ack", NULL, MAVLINK_TYPE_UINT8_T, 0, 28, offsetof(mavlink_uart_stats_t, ack) }, \
+         { "uartId", NULL, MAVLINK_TYPE_UINT8_T, 0, 29, offsetof(mavlink_uart_stats_t, uartId) }, \
+         } \
+}
+
+
+/**
+ * @brief Pack a uart_stats message
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ *
+ * @param ack Always FALSE.
+ * @param uartId UART module the statistics are for.
+ * @param bytesIn Bytes received since the statistics were cleared.
+ * @param bytesOut Bytes transmitted since the statistics were cleared.
+ * @param receiveDropped Received bytes dropped because the receive buffer was full.
+ * @param transmitDropped Bytes dropped because the transmit buffer was full.
+ * @param interruptCount Number of UART interrupts.
+ * @param interruptTicks Core timer ticks (SYSCLK/2) spent in the UART interrupt.
+ * @param receivePeak Peak receive buffer occupancy in bytes.
+ * @param transmitPeak Peak transmit buffer occupancy in bytes.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_uart_stats_pack(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg,
+						       uint8_t ack, uint8_t uartId, uint32_t bytesIn, uint32_t bytesOut, uint32_t receiveDropped, uint32_t transmitDropped, uint32_t interruptCount, uint32_t interruptTicks, uint16_t receivePeak, uint16_t transmitPeak)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[30];
+	_mav_put_uint32_t(buf, 0, bytesIn);
+	_mav_put_uint32_t(buf, 4, bytesOut);
+	_mav_put_uint32_t(buf, 8, receiveDropped);
+	_mav_put_uint32_t(buf, 12, transmitDropped);
+	_mav_put_uint32_t(buf, 16, interruptCount);
+	_mav_put_uint32_t(buf, 20, interruptTicks);
+	_mav_put_uint16_t(buf, 24, receivePeak);
+	_mav_put_uint16_t(buf, 26, transmitPeak);
+	_mav_put_uint8_t(buf, 28, ack);
+	_mav_put_uint8_t(buf, 29, uartId);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 30);
+#else
+	mavlink_uart_stats_t packet;
+	packet.bytesIn = bytesIn;
+	packet.bytesOut = bytesOut;
+	packet.receiveDropped = receiveDropped;
+	packet.transmitDropped = transmitDropped;
+	packet.interruptCount = interruptCount;
+	packet.interruptTicks = interruptTicks;
+	packet.receivePeak = receivePeak;
+	packet.transmitPeak = transmitPeak;
+	packet.ack = ack;
+	packet.uartId = uartId;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 30);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_UART_STATS;
+	return mavlink_finalize_message(msg, system_id, component_id, 30, 14);
+}
+
+/**
+ * @brief Pack a uart_stats message on a channel
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param chan The MAVLink channel this message was sent over
+ * @param msg The MAVLink message to compress the data into
+ * @param ack Always FALSE.
+ * @param uartId UART module the statistics are for.
+ * @param bytesIn Bytes received since the statistics were cleared.
+ * @param bytesOut Bytes transmitted since the statistics were cleared.
+ * @param receiveDropped Received bytes dropped because the receive buffer was full.
+ * @param transmitDropped Bytes dropped because the transmit buffer was full.
+ * @param interruptCount Number of UART interrupts.
+ * @param interruptTicks Core timer ticks (SYSCLK/2) spent in the UART interrupt.
+ * @param receivePeak Peak receive buffer occupancy in bytes.
+ * @param transmitPeak Peak transmit buffer occupancy in bytes.
+ * @return length of the message in bytes (excluding serial stream start sign)
+ */
+static inline uint16_t mavlink_msg_uart_stats_pack_chan(uint8_t system_id, uint8_t component_id, uint8_t chan,
+							   mavlink_message_t* msg,
+						           uint8_t ack,uint8_t uartId,uint32_t bytesIn,uint32_t bytesOut,uint32_t receiveDropped,uint32_t transmitDropped,uint32_t interruptCount,uint32_t interruptTicks,uint16_t receivePeak,uint16_t transmitPeak)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[30];
+	_mav_put_uint32_t(buf, 0, bytesIn);
+	_mav_put_uint32_t(buf, 4, bytesOut);
+	_mav_put_uint32_t(buf, 8, receiveDropped);
+	_mav_put_uint32_t(buf, 12, transmitDropped);
+	_mav_put_uint32_t(buf, 16, interruptCount);
+	_mav_put_uint32_t(buf, 20, interruptTicks);
+	_mav_put_uint16_t(buf, 24, receivePeak);
+	_mav_put_uint16_t(buf, 26, transmitPeak);
+	_mav_put_uint8_t(buf, 28, ack);
+	_mav_put_uint8_t(buf, 29, uartId);
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), buf, 30);
+#else
+	mavlink_uart_stats_t packet;
+	packet.bytesIn = bytesIn;
+	packet.bytesOut = bytesOut;
+	packet.receiveDropped = receiveDropped;
+	packet.transmitDropped = transmitDropped;
+	packet.interruptCount = interruptCount;
+	packet.interruptTicks = interruptTicks;
+	packet.receivePeak = receivePeak;
+	packet.transmitPeak = transmitPeak;
+	packet.ack = ack;
+	packet.uartId = uartId;
+
+        memcpy(_MAV_PAYLOAD_NON_CONST(msg), &packet, 30);
+#endif
+
+	msg->msgid = MAVLINK_MSG_ID_UART_STATS;
+	return mavlink_finalize_message_chan(msg, system_id, component_id, chan, 30, 14);
+}
+
+/**
+ * @brief Encode a uart_stats struct into a message
+ *
+ * @param system_id ID of this system
+ * @param component_id ID of this component (e.g. 200 for IMU)
+ * @param msg The MAVLink message to compress the data into
+ * @param uart_stats C-struct to read the message contents from
+ */
+static inline uint16_t mavlink_msg_uart_stats_encode(uint8_t system_id, uint8_t component_id, mavlink_message_t* msg, const mavlink_uart_stats_t* uart_stats)
+{
+	return mavlink_msg_uart_stats_pack(system_id, component_id, msg, uart_stats->ack, uart_stats->uartId, uart_stats->bytesIn, uart_stats->bytesOut, uart_stats->receiveDropped, uart_stats->transmitDropped, uart_stats->interruptCount, uart_stats->interruptTicks, uart_stats->receivePeak, uart_stats->transmitPeak);
+}
+
+/**
+ * @brief Send a uart_stats message
+ * @param chan MAVLink channel to send the message
+ *
+ * @param ack Always FALSE.
+ * @param uartId UART module the statistics are for.
+ * @param bytesIn Bytes received since the statistics were cleared.
+ * @param bytesOut Bytes transmitted since the statistics were cleared.
+ * @param receiveDropped Received bytes dropped because the receive buffer was full.
+ * @param transmitDropped Bytes dropped because the transmit buffer was full.
+ * @param interruptCount Number of UART interrupts.
+ * @param interruptTicks Core timer ticks (SYSCLK/2) spent in the UART interrupt.
+ * @param receivePeak Peak receive buffer occupancy in bytes.
+ * @param transmitPeak Peak transmit buffer occupancy in bytes.
+ */
+#ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
+
+static inline void mavlink_msg_uart_stats_send(mavlink_channel_t chan, uint8_t ack, uint8_t uartId, uint32_t bytesIn, uint32_t bytesOut, uint32_t receiveDropped, uint32_t transmitDropped, uint32_t interruptCount, uint32_t interruptTicks, uint16_t receivePeak, uint16_t transmitPeak)
+{
+#if MAVLINK_NEED_BYTE_SWAP || !MAVLINK_ALIGNED_FIELDS
+	char buf[30];
+	_mav_put_uint32_t(buf, 0, bytesIn);
+	_mav_put_uint32_t(buf, 4, bytesOut);
+	_mav_put_uint32_t(buf, 8, receiveDropped);
+	_mav_put_uint32_t(buf, 12, transmitDropped);
+	_mav_put_uint32_t(buf, 16, interruptCount);
+	_mav_put_uint32_t(buf, 20, interruptTicks);
+	_mav_put_uint16_t(buf, 24, receivePeak);
+	_mav_put_uint16_t(buf, 26, transmitPeak);
+	_mav_put_uint8_t(buf, 28, ack);
+	_mav_put_uint8_t(buf, 29, uartId);
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_UART_STATS, buf, 30, 14);
+#else
+	mavlink_uart_stats_t packet;
+	packet.bytesIn = bytesIn;
+	packet.bytesOut = bytesOut;
+	packet.receiveDropped = receiveDropped;
+	packet.transmitDropped = transmitDropped;
+	packet.interruptCount = interruptCount;
+	packet.interruptTicks = interruptTicks;
+	packet.receivePeak = receivePeak;
+	packet.transmitPeak = transmitPeak;
+	packet.ack = ack;
+	packet.uartId = uartId;
+
+	_mav_finalize_message_chan_send(chan, MAVLINK_MSG_ID_UART_STATS, (const char *)&packet, 30, 14);
+#endif
+}
+
+#endif
+
+// MESSAGE UART_STATS UNPACKING
+
+
+/**
+ * @brief Get field ack from uart_stats message
+ *
+ * @return Always FALSE.
+ */
+static inline uint8_t mavlink_msg_uart_stats_get_ack(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  28);
+}
+
+/**
+ * @brief Get field uartId from uart_stats message
+ *
+ * @return UART module the statistics are for.
+ */
+static inline uint8_t mavlink_msg_uart_stats_get_uartId(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint8_t(msg,  29);
+}
+
+/**
+ * @brief Get field bytesIn from uart_stats message
+ *
+ * @return Bytes received since the statistics were cleared.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_bytesIn(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  0);
+}
+
+/**
+ * @brief Get field bytesOut from uart_stats message
+ *
+ * @return Bytes transmitted since the statistics were cleared.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_bytesOut(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  4);
+}
+
+/**
+ * @brief Get field receiveDropped from uart_stats message
+ *
+ * @return Received bytes dropped because the receive buffer was full.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_receiveDropped(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  8);
+}
+
+/**
+ * @brief Get field transmitDropped from uart_stats message
+ *
+ * @return Bytes dropped because the transmit buffer was full.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_transmitDropped(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  12);
+}
+
+/**
+ * @brief Get field interruptCount from uart_stats message
+ *
+ * @return Number of UART interrupts.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_interruptCount(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  16);
+}
+
+/**
+ * @brief Get field interruptTicks from uart_stats message
+ *
+ * @return Core timer ticks (SYSCLK/2) spent in the UART interrupt.
+ */
+static inline uint32_t mavlink_msg_uart_stats_get_interruptTicks(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint32_t(msg,  20);
+}
+
+/**
+ * @brief Get field receivePeak from uart_stats message
+ *
+ * @return Peak receive buffer occupancy in bytes.
+ */
+static inline uint16_t mavlink_msg_uart_stats_get_receivePeak(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  24);
+}
+
+/**
+ * @brief Get field transmitPeak from uart_stats message
+ *
+ * @return Peak transmit buffer occupancy in bytes.
+ */
+static inline uint16_t mavlink_msg_uart_stats_get_transmitPeak(const mavlink_message_t* msg)
+{
+	return _MAV_RETURN_uint16_t(msg,  26);
+}
+
+/**
+ * @brief Decode a uart_stats message into a struct
+ *
+ * @param msg The message to decode
+ * @param uart_stats C-struct to decode the message contents into
+ */
+static inline void mavlink_msg_uart_stats_decode(const mavlink_message_t* msg, mavlink_uart_stats_t* uart_stats)
+{
+#if MAVLINK_NEED_BYTE_SWAP
+	uart_stats->bytesIn = mavlink_msg_uart_stats_get_bytesIn(msg);
+	uart_stats->bytesOut = mavlink_msg_uart_stats_get_bytesOut(msg);
+	uart_stats->receiveDropped = mavlink_msg_uart_stats_get_receiveDropped(msg);
+	uart_stats->transmitDropped = mavlink_msg_uart_stats_get_transmitDropped(msg);
+	uart_stats->interruptCount = mavlink_msg_uart_stats_get_interruptCount(msg);
+	uart_stats->interruptTicks = mavlink_msg_uart_stats_get_interruptTicks(msg);
+	uart_stats->receivePeak = mavlink_msg_uart_stats_get_receivePeak(msg);
+	uart_stats->transmitPeak = mavlink_msg_uart_stats_get_transmitPeak(msg);
+	uart_stats->ack = mavlink_msg_uart_stats_get_ack(msg);
+	uart_stats->uartId = mavlink_msg_uart_stats_get_uartId(msg);
+#else
+	memcpy(uart_stats, _MAV_PAYLOAD(msg), 30);
+#endif
+}
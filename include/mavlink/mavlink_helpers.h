@@ -89,6 +89,43 @@ MAVLINK_HELPER uint16_t mavlink_finalize_message_chan(mavlink_message_t* msg, ui
 }
 
 
+#if MAVLINK_CRC_EXTRA
+/**
+ * @brief Change the payload length of a finalized message
+ *
+ * A longer length fills the payload out with zeros, which undoes
+ * mavlink_msg_trim. The checksum is calculated again.
+ *
+ * @param msg Message to resize
+ * @param length New payload length
+ * @param crc_extra Extra CRC of the message
+ */
+MAVLINK_HELPER void mavlink_resize_message(mavlink_message_t* msg, uint8_t length, uint8_t crc_extra)
+{
+	uint16_t checksum;
+	if (length > msg->len)
+		memset(&_MAV_PAYLOAD_NON_CONST(msg)[msg->len], 0, length - msg->len);
+	msg->len = length;
+	checksum = crc_calculate((uint8_t*)&msg->len, length + MAVLINK_CORE_HEADER_LEN);
+	crc_accumulate(crc_extra, &checksum);
+	mavlink_ck_a(msg) = (uint8_t)(checksum & 0xFF);
+	mavlink_ck_b(msg) = (uint8_t)(checksum >> 8);
+}
+
+/**
+ * @brief Drop the trailing zero bytes of a finalized message's payload
+ *
+ * @param msg Message to trim
+ * @param crc_extra Extra CRC of the message
+ * @return Length of the message to send
+ */
+MAVLINK_HELPER uint16_t mavlink_msg_trim(mavlink_message_t* msg, uint8_t crc_extra)
+{
+	mavlink_resize_message(msg, _mav_trim_payload(_MAV_PAYLOAD(msg), msg->len), crc_extra);
+	return msg->len + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+}
+#endif
+
 /**
  * @brief Finalize a MAVLink message with MAVLINK_COMM_0 as default channel
  */
@@ -248,11 +285,9 @@ MAVLINK_HELPER uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_messa
  and out). Only use if the channel will only contain messages types listed in
  the headers.
 */
-#if MAVLINK_CHECK_MESSAGE_LENGTH
 #ifndef MAVLINK_MESSAGE_LENGTH
 	static const uint8_t mavlink_message_lengths[256] = MAVLINK_MESSAGE_LENGTHS;
 #define MAVLINK_MESSAGE_LENGTH(msgid) mavlink_message_lengths[msgid]
-#endif
 #endif
 
 	mavlink_message_t* rxmsg = mavlink_get_channel_buffer(chan); ///< The currently decoded message
@@ -318,7 +353,8 @@ MAVLINK_HELPER uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_messa
 
 	case MAVLINK_PARSE_STATE_GOT_COMPID:
 #if MAVLINK_CHECK_MESSAGE_LENGTH
-	        if (rxmsg->len != MAVLINK_MESSAGE_LENGTH(c))
+		// Shorter payloads had their trailing zeros dropped
+	        if (rxmsg->len > MAVLINK_MESSAGE_LENGTH(c))
 		{
 			status->parse_error++;
 			status->parse_state = MAVLINK_PARSE_STATE_IDLE;
@@ -393,6 +429,12 @@ MAVLINK_HELPER uint8_t mavlink_parse_char(uint8_t chan, uint8_t c, mavlink_messa
 			status->msg_received = 1;
 			status->parse_state = MAVLINK_PARSE_STATE_IDLE;
 			_MAV_PAYLOAD_NON_CONST(rxmsg)[status->packet_idx+1] = (char)c;
+#if MAVLINK_CRC_EXTRA
+			// Put back the zeros dropped from a trimmed payload
+			if (rxmsg->len < MAVLINK_MESSAGE_LENGTH(rxmsg->msgid))
+				mavlink_resize_message(rxmsg, MAVLINK_MESSAGE_LENGTH(rxmsg->msgid),
+					MAVLINK_MESSAGE_CRC(rxmsg->msgid));
+#endif
 			memcpy(r_message, rxmsg, sizeof(mavlink_message_t));
 		}
 		break;
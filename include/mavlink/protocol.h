@@ -34,6 +34,20 @@
 #define MAVLINK_END_UART_SEND(chan, length)
 #endif
 
+/**
+ * @brief Get the payload length without its trailing zero bytes
+ *
+ * Like MAVLink 2, at least one byte is kept. The receiver puts the zeros
+ * back, so only send a trimmed payload to a receiver that says it can
+ * take one (see the HEARTBEAT data bits).
+ */
+static inline uint8_t _mav_trim_payload(const char *payload, uint8_t length)
+{
+	while (length > 1 && payload[length - 1] == 0)
+		length--;
+	return length;
+}
+
 #ifdef MAVLINK_SEPARATE_HELPERS
 #define MAVLINK_HELPER
 #else
@@ -51,6 +65,8 @@ MAVLINK_HELPER uint16_t mavlink_finalize_message_chan(mavlink_message_t* msg, ui
 						      uint8_t chan, uint8_t length, uint8_t crc_extra);
 MAVLINK_HELPER uint16_t mavlink_finalize_message(mavlink_message_t* msg, uint8_t system_id, uint8_t component_id, 
 						 uint8_t length, uint8_t crc_extra);
+MAVLINK_HELPER void mavlink_resize_message(mavlink_message_t* msg, uint8_t length, uint8_t crc_extra);
+MAVLINK_HELPER uint16_t mavlink_msg_trim(mavlink_message_t* msg, uint8_t crc_extra);
 #ifdef MAVLINK_USE_CONVENIENCE_FUNCTIONS
 MAVLINK_HELPER void _mav_finalize_message_chan_send(mavlink_channel_t chan, uint8_t msgid, const char *packet, 
 						    uint8_t length, uint8_t crc_extra);
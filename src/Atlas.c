@@ -31,6 +31,7 @@
 #include "Error.h"
 #include "TiltCompass.h"
 #include "Uart.h"
+#include "Console.h"
 
 
 /***********************************************************************
@@ -87,6 +88,7 @@
 #define TIMER_DATA_SEND             TIMER_BACKGROUND
 #define TIMER_GPS_CORRECTION_LOST   TIMER_BACKGROUND2
 #define TIMER_HEARTBEAT             TIMER_BACKGROUND3
+#define TIMER_BOAT_STATE            TIMER_BACKGROUND4
 
 // Timer delays
 #define STARTUP_DELAY               2500 // (ms) time to wait before starting up
@@ -95,6 +97,7 @@
 #define RESEND_MESSAGE_DELAY        4000 // (ms) resend a message
 #define GPS_CORRECTION_LOST_DELAY   5000 // (ms) throw out gps error corrections now
 #define HEARTBEAT_SEND_DELAY        3000 // (ms) between heart being sent to CC
+#define BOAT_STATE_SEND_DELAY       250 // (ms) between boat state frames
 #define DEBUG_PRINT_DELAY           1200
 #define RETRY_ORIGIN_DELAY          3000
 
@@ -199,6 +202,7 @@ static bool rescueShutdown = FALSE;
 
 static LocalCoordinate nedStation; // NED coordinate with station location
 static LocalCoordinate nedRescue; // NED coordinate of drowning person
+static GeocentricCoordinate ecefErrorMessage; // last GPS correction received
 
 static int lastMavlinkMessageID; // ID of most recently received Mavlink message
 static int lastMavlinkCommandID; // Command code of last message (for ACK)
@@ -212,6 +216,7 @@ static error_t lastErrorCode = ERROR_NONE;
  * PRIVATE PROTOTYPES                                                  *
  ***********************************************************************/
 static void checkEvents();
+static bool hasMavlinkCommand();
 static void doSetStationSM();
 static void doSetOriginSM();
 static void doStationKeepSM();
@@ -230,6 +235,7 @@ static void setError(error_t errorCode);
 static void clearError();
 static void gpsCorrectionUpdate();
 static void doDataMessage();
+static void doBoatStateMessage();
 static uint16_t getBatteryVoltage(unsigned int pin);
 static void doHeartbeatMessage();
 static void checkOverride();
@@ -265,8 +271,10 @@ static void checkEvents() {
         event.flags.receiverDetected = TRUE;
 
 
-    // XBee messages (from command center)
-    if (Mavlink_hasNewMessage()) {
+    /* XBee messages (from command center). Stop after a command, so that it
+        stays in Mavlink_newMessage until its handler has read it, and leave
+        the rest queued for the next pass. */
+    while (!hasMavlinkCommand() && Mavlink_hasNewMessage()) {
         lastMavlinkMessageID = Mavlink_getNewMessageID();
         lastMavlinkCommandID = MAVLINK_NO_COMMAND;
         lastMavlinkMessageWantsAck = FALSE;
@@ -308,8 +316,12 @@ static void checkEvents() {
                 if (Mavlink_newMessage.gpsGeocentricData.status == MAVLINK_GEOCENTRIC_ORIGIN) {
                     event.flags.haveSetOriginMessage = TRUE;
                 }
-                else if (Mavlink_newMessage.gpsGeocentricData.status == MAVLINK_GEOCENTRIC_ERROR)
+                else if (Mavlink_newMessage.gpsGeocentricData.status == MAVLINK_GEOCENTRIC_ERROR) {
                     event.flags.haveGeocentricErrorMessage = TRUE;
+                    ecefErrorMessage.x = Mavlink_newMessage.gpsGeocentricData.x;
+                    ecefErrorMessage.y = Mavlink_newMessage.gpsGeocentricData.y;
+                    ecefErrorMessage.z = Mavlink_newMessage.gpsGeocentricData.z;
+                }
                 break;
             case MAVLINK_MSG_ID_GPS_NED:
                 lastMavlinkMessageWantsAck = Mavlink_newMessage.gpsLocalData.ack == WANT_ACK;
@@ -339,6 +351,18 @@ static void checkEvents() {
 } //  checkEvents()
 
 
+/**********************************************************************
+ * Function: hasMavlinkCommand
+ * @return TRUE if a command message was received in this pass.
+ * @remark Commands are handled one per pass of the state machine.
+ **********************************************************************/
+static bool hasMavlinkCommand() {
+    return event.flags.haveResetMessage || event.flags.haveReturnStationMessage
+        || event.flags.haveSetStationMessage || event.flags.haveSetOriginMessage
+        || event.flags.haveOverrideMessage || event.flags.haveStartRescueMessage;
+}
+
+
 /**********************************************************************
  * Function: doSetOriginSM
  * @return None
@@ -358,7 +382,8 @@ static void doSetOriginSM() {
         haveOrigin = TRUE;
         event.flags.setOriginDone = TRUE;
 
-        DBPRINT("Set new origin: X=%.1f, Y=%.1f, Z=%.1f\n",ecefOrigin.x, ecefOrigin.y, ecefOrigin.z);
+        DBPRINT("Set new origin: X=%ld, Y=%ld, Z=%ld (cm)\n",(long)ecefOrigin.x,
+            (long)ecefOrigin.y, (long)ecefOrigin.z);
     }
     else {
         // Resend request if timer expires
@@ -563,6 +588,11 @@ static void doMasterSM() {
 
     // Send telemetry data message
     doDataMessage(); 
+    doBoatStateMessage();
+
+    #if defined(DEBUG) && defined(USE_SERIAL)
+    Console_runSM();
+    #endif
 
     #ifdef DEBUG_VERBOSE
     if (Timer_isExpired(TIMER_TEST2)) {
@@ -575,7 +605,10 @@ static void doMasterSM() {
     #ifdef DEBUG_XBEE
     // Sending XBee debug message
     if (Timer_isExpired(TIMER_TEST3)) {
-        Mavlink_sendDebug(MAVLINK_SENDER_ATLAS, Drive_getDebugString());
+        uint32_t args[CONSOLE_MAX_ARGS];
+        uint8_t count = Drive_getDebugEvent(args);
+        if (count > 0)
+            Mavlink_sendDebugEvent(MAVLINK_SENDER_ATLAS, CONSOLE_DRIVE_TRACK, args, count);
         Timer_new(TIMER_TEST3, DEBUG_PRINT_DELAY);
     }
     #endif
@@ -971,12 +1004,50 @@ static void doDataMessage() {
         uint16_t nimhV = getBatteryVoltage(NIMH_BATTERY);
 
         Mavlink_sendBoatData(tempC, altM, nimhV, lipoV);
+
+        // Report how the serial links are coping
+        Mavlink_sendUartStatistics(XBEE_UART_ID);
+        #ifdef USE_GPS
+        Mavlink_sendUartStatistics(GPS_UART_ID);
+        #endif
         #endif
 
         Timer_new(TIMER_DATA_SEND, DATA_SEND_DELAY);
     }
 }
 
+/**********************************************************************
+ * Function: doBoatStateMessage
+ * @return None.
+ * @remark Sends the boat's position, heading, speed, state, error and
+ *  battery voltages on a timer, once the position is known. Most of these
+ *  go out as small delta frames (see Telemetry.h).
+ * @author David Goodman
+ * @date 2026.10.18
+ **********************************************************************/
+static void doBoatStateMessage() {
+    if (Timer_isExpired(TIMER_BOAT_STATE) || !Timer_isActive(TIMER_BOAT_STATE)) {
+
+        #if defined(USE_XBEE) && defined(USE_NAVIGATION)
+        if (Navigation_isReady()) {
+            LocalCoordinate nedPosition;
+            Navigation_getLocalPosition(&nedPosition);
+            #ifdef USE_TILTCOMPASS
+            float heading = TiltCompass_getHeading();
+            #else
+            float heading = GPS_getHeading();
+            #endif
+
+            Mavlink_sendBoatState(&nedPosition, heading, GPS_getVelocity(),
+                state, lastErrorCode, getBatteryVoltage(NIMH_BATTERY),
+                getBatteryVoltage(LIPO_BATTERY));
+        }
+        #endif
+
+        Timer_new(TIMER_BOAT_STATE, BOAT_STATE_SEND_DELAY);
+    }
+}
+
 /**********************************************************************
  * Function: doHeartbeatMessage
  * @return None.
@@ -1034,11 +1105,7 @@ static void checkOverride() {
 static void gpsCorrectionUpdate() {
     #ifdef USE_ERROR_CORRECTION
     if (event.flags.haveGeocentricErrorMessage) {
-        GeocentricCoordinate ecefError;
-        ecefError.x = Mavlink_newMessage.gpsGeocentricData.x;
-        ecefError.y = Mavlink_newMessage.gpsGeocentricData.y;
-        ecefError.z = Mavlink_newMessage.gpsGeocentricData.z;
-        Navigation_setGeocentricError(&ecefError);
+        Navigation_setGeocentricError(&ecefErrorMessage);
         if (!Navigation_isUsingErrorCorrection())
             DBPRINT("Error corrections enabled.\n");
 
@@ -1096,6 +1163,7 @@ static void initializeAtlas() {
 #if defined(DEBUG) && defined(USE_SERIAL) //&& !defined(USE_GPS)
     Serial_init();
     DBPRINT("Initializing serial.\n");
+    Console_init(CONSOLE_MODE_TEXT);
 #endif
     Timer_init();
 
@@ -1223,9 +1291,9 @@ static void printTiltCompass();
 static void printBattery();
 
 
-#define ECEF_X_ORIGIN -2707534.0f
-#define ECEF_Y_ORIGIN -4322167.0f
-#define ECEF_Z_ORIGIN  3817539.0f
+#define ECEF_X_ORIGIN -270753400 // (cm)
+#define ECEF_Y_ORIGIN -432216700 // (cm)
+#define ECEF_Z_ORIGIN  381753900 // (cm)
 
 int main() {
     initializeAtlas();
@@ -1328,8 +1396,8 @@ static void printGps() {
     else if (GPS_hasFix() && GPS_hasPosition()) {
         GeocentricCoordinate ecefPos;
         GPS_getPosition(&ecefPos);
-        printf("Position: x=%.2f, y=%.2f, z=%.2f (m)\n", ecefPos.x,
-            ecefPos.y, ecefPos.z);
+        printf("Position: x=%ld, y=%ld, z=%ld (cm)\n", (long)ecefPos.x,
+            (long)ecefPos.y, (long)ecefPos.z);
 
         printf("Velocity: %.2f (m/s), Heading: %.2f (deg)",
             GPS_getVelocity(), GPS_getHeading());
@@ -17,6 +17,7 @@
  When                   Who         What/Why
  --------------         ---         --------
 4/29/2013   3:08PM      dagoodma    Started new Compas module.
+10-18-26                dagoodma    Send heartbeats, show link statistics.
 ***********************************************************************/
 #include <xc.h>
 #include <stdio.h>
@@ -78,10 +79,6 @@
  
 // Timer allocation
 #define TIMER_CALIBRATE     TIMER_MAIN
-#define TIMER_RESCUE        TIMER_MAIN
-#define TIMER_STOP          TIMER_MAIN
-#define TIMER_SETORIGIN     TIMER_MAIN
-#define TIMER_SETSTATION    TIMER_MAIN
 #define TIMER_DEBOUNCE      TIMER_MAIN2
 #define TIMER_CANCEL        TIMER_MAIN3
 
@@ -89,12 +86,13 @@
 #define TIMER_BAROMETER_LOST            TIMER_BACKGROUND
 #define TIMER_HEARTBEAT_CHECK           TIMER_BACKGROUND2
 #define TIMER_GPS_CORRECTION            TIMER_BACKGROUND3
+#define TIMER_HEARTBEAT                 TIMER_BACKGROUND4
 
 // Timer delays
 #define CALIBRATE_HOLD_DELAY        3000 // (ms) time to hold calibration
 #define BAROMETER_LOST_DELAY	    20000 // (ms) time before timeout error
 #define HEARTBEAT_LOST_DELAY         10000// (ms) before timeout error
-#define RESEND_MESSAGE_DELAY        4000 // (ms) resend a message
+#define HEARTBEAT_SEND_DELAY        3000 // (ms) boat echoes it for the RTT
 #define GPS_CORRECTION_SEND_DELAY   3750
 #define LCD_HOLD_DELAY              3000 // (ms) time for lcd message to linger
 #define LED_HOLD_DELAY              1000 // (ms) time for led to stay lit
@@ -112,23 +110,21 @@
 #define BLINK_ON_DELAY              1500
 #define DEBUG_PRINT_DELAY           1000
 
-#define RESEND_MESSAGE_LIMIT        5 // times to resend before failing
-
 #define EVENT_BYTE_COUNT 10 // total number of bytes in event flag union
 
 // Hard-coded geocentric origin location // TODO replace this
 // --------------- Center of west lake -------------
 /*
-#define ECEF_X_ORIGIN -2706922.0f
-#define ECEF_Y_ORIGIN -4324246.0f
-#define ECEF_Z_ORIGIN 3815364.0f
+#define ECEF_X_ORIGIN -270692200 // (cm)
+#define ECEF_Y_ORIGIN -432424600 // (cm)
+#define ECEF_Z_ORIGIN 381536400 // (cm)
  * */
 
 // ------- In front of GSH parking lot entrance ------
 
-#define ECEF_X_ORIGIN -2707534.0f
-#define ECEF_Y_ORIGIN -4322167.0f
-#define ECEF_Z_ORIGIN  3817539.0f
+#define ECEF_X_ORIGIN -270753400 // (cm)
+#define ECEF_Y_ORIGIN -432216700 // (cm)
+#define ECEF_Z_ORIGIN  381753900 // (cm)
 
 #define I2C_CLOCK_FREQ  80000 // (Hz)
 
@@ -238,8 +234,8 @@ static union EVENTS {
 static GeocentricCoordinate ecefPosition; // TODO consider adding position averaging
 
 static LocalCoordinate nedRescueTarget;
-static uint8_t resendMessageCount;
 static float compasHeight;
+static float boatAltitude; // from the last barometer message
 static int lastMessageID;
 static error_t lastErrorCode;
 static error_t lastBoatErrorCode;
@@ -274,6 +270,7 @@ static void doBarometerUpdate();
 static void gpsCorrectionUpdate();
 static void getTargetLocation(LocalCoordinate *targetNed);
 static void checkBoatConnection();
+static void doHeartbeatMessage();
 static void updatePosition();
 static void resetCompas();
 static void resetAll();
@@ -338,8 +335,8 @@ static void checkEvents() {
     if (Interface_isResetPressed())
         event.flags.resetButtonPressed = TRUE;
 
-    // XBee messages (from command center)
-    if (Mavlink_hasNewMessage()) {
+    // XBee messages (from the boat), all of them since the last pass
+    while (Mavlink_hasNewMessage()) {
         lastMessageID = Mavlink_getNewMessageID();
         switch (lastMessageID) {
             /*--------------------  Acknowledgement messages ------------------ */
@@ -384,6 +381,10 @@ static void checkEvents() {
                 if (Mavlink_newMessage.gpsLocalData.status == MAVLINK_LOCAL_BOAT_POSITION)
                     event.flags.haveBoatPositionMessage = TRUE;
                 break;
+            case MAVLINK_MSG_ID_BOAT_STATE:
+                // Boat state stream, includes its position
+                event.flags.haveBoatPositionMessage = TRUE;
+                break;
             /*---------------- Status and Error messages ---------- */
             case MAVLINK_MSG_ID_STATUS_AND_ERROR:
                 // ---------- Boat error messages ------------------
@@ -408,6 +409,20 @@ static void checkEvents() {
             /*----------------  Barometer altitude message ----------------*/
             case MAVLINK_MSG_ID_DATA:
                 event.flags.haveBarometerMessage = TRUE;
+                boatAltitude = Mavlink_newMessage.telemetryData.altitude;
+                break;
+            /*----------------  Boat UART statistics ----------------------*/
+            case MAVLINK_MSG_ID_UART_STATS:
+                DBPRINT("Boat UART%u: %u in, %u out, %u/%u dropped, peak %u/%u, %u ints (%u ticks)\n",
+                    (unsigned int)Mavlink_newMessage.uartStatsData.uartId,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.bytesIn,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.bytesOut,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.receiveDropped,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.transmitDropped,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.receivePeak,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.transmitPeak,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.interruptCount,
+                    (unsigned int)Mavlink_newMessage.uartStatsData.interruptTicks);
                 break;
             default:
                 // Unknown message ID
@@ -489,7 +504,6 @@ static void doRescueSM() {
                 //Interface_clearDisplay();
                 Interface_showMessage(STARTED_RESCUE_MESSAGE);
                 Interface_waitLightOff();
-                resendMessageCount = 0;
                 Interface_readyLightOn();
                 #ifdef DEBUG_RESCUE
                 LCD_setPosition(2,0);
@@ -500,18 +514,10 @@ static void doRescueSM() {
                 LCD_writeString(debug);
                 #endif
             }
-            else if (Timer_isExpired(TIMER_RESCUE)) {
-                // Resend start rescue message on timer
-                if (resendMessageCount >= RESEND_MESSAGE_LIMIT) {
-                    // Sent too many times
-                    setError(ERROR_NO_ACKNOWLEDGEMENT);
-                    return;
-                }
-                else {
-                    Mavlink_sendStartRescue(WANT_ACK, &nedRescueTarget);
-                    Timer_new(TIMER_RESCUE, RESEND_MESSAGE_DELAY);
-                    resendMessageCount++;
-                }
+            else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_GPS_NED, MAVLINK_LOCAL_START_RESCUE) == ACK_STATUS_DEAD) {
+                // Gave up resending
+                setError(ERROR_NO_ACKNOWLEDGEMENT);
+                return;
             }
             else if (event.flags.cancelButtonPressed
                     && Timer_isExpired(TIMER_DEBOUNCE)) {
@@ -555,20 +561,11 @@ static void doRescueSM() {
                 Interface_showMessageOnTimer(RETURNING_MESSAGE,LCD_HOLD_DELAY);
                 Interface_waitLightOff();
                 Interface_readyLightOn();
-                resendMessageCount = 0;
             }
-            else if (Timer_isExpired(TIMER_RESCUE)) {
-                // Resend return to station message on timer
-                if (resendMessageCount >= RESEND_MESSAGE_LIMIT) {
-                    // Sent too many times
-                    setError(ERROR_NO_ACKNOWLEDGEMENT);
-                    return;
-                }
-                else {
-                    Mavlink_sendReturnStation(WANT_ACK);
-                    Timer_new(TIMER_RESCUE, RESEND_MESSAGE_DELAY);
-                    resendMessageCount++;
-                }
+            else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_CMD_OTHER, MAVLINK_RETURN_STATION) == ACK_STATUS_DEAD) {
+                // Gave up resending
+                setError(ERROR_NO_ACKNOWLEDGEMENT);
+                return;
             }
             else if (event.flags.cancelButtonPressed
                     && Timer_isExpired(TIMER_DEBOUNCE)) {
@@ -598,9 +595,7 @@ static void doRescueSM() {
                 Interface_showMessage(START_RETURN_MESSAGE);
                 Interface_readyLightOff();
                 Interface_waitLightOn();
-                resendMessageCount = 0;
                 Mavlink_sendReturnStation(WANT_ACK);
-                Timer_new(TIMER_RESCUE, RESEND_MESSAGE_DELAY);
                  */
                 startStopSM();
             }
@@ -644,20 +639,11 @@ static void doStopSM() {
                 Interface_showMessage(STOPPED_BOAT_MESSAGE);
                 Interface_waitLightOff();
                 Interface_readyLightOn();
-                resendMessageCount = 0;
             }
-            else if (Timer_isExpired(TIMER_STOP)) {
-                // Resend start rescue message on timer
-                if (resendMessageCount >= RESEND_MESSAGE_LIMIT) {
-                    // Sent too many times
-                    setError(ERROR_NO_ACKNOWLEDGEMENT);
-                    return;
-                }
-                else {
-                    Mavlink_sendOverride(WANT_ACK);
-                    Timer_new(TIMER_STOP, RESEND_MESSAGE_DELAY);
-                    resendMessageCount++;
-                }
+            else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_CMD_OTHER, MAVLINK_OVERRIDE) == ACK_STATUS_DEAD) {
+                // Gave up resending
+                setError(ERROR_NO_ACKNOWLEDGEMENT);
+                return;
             }
             else if (event.flags.cancelButtonPressed
                     && Timer_isExpired(TIMER_DEBOUNCE)) {
@@ -695,20 +681,11 @@ static void doStopSM() {
                 Interface_showMessageOnTimer(RETURNING_MESSAGE, LCD_HOLD_DELAY);
                 Interface_waitLightOff();
                 Interface_readyLightOn();
-                resendMessageCount = 0;
             }
-            else if (Timer_isExpired(TIMER_STOP)) {
-                // Resend return to station message on timer
-                if (resendMessageCount >= RESEND_MESSAGE_LIMIT) {
-                    // Sent too many times
-                    setError(ERROR_NO_ACKNOWLEDGEMENT);
-                    return;
-                }
-                else {
-                    Mavlink_sendReturnStation(WANT_ACK);
-                    Timer_new(TIMER_STOP, RESEND_MESSAGE_DELAY);
-                    resendMessageCount++;
-                }
+            else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_CMD_OTHER, MAVLINK_RETURN_STATION) == ACK_STATUS_DEAD) {
+                // Gave up resending
+                setError(ERROR_NO_ACKNOWLEDGEMENT);
+                return;
             }
             else if (event.flags.cancelButtonPressed
                     && Timer_isExpired(TIMER_DEBOUNCE)) {
@@ -733,9 +710,8 @@ static void doStopSM() {
                     Interface_showMessage(START_RETURN_MESSAGE);
                     Interface_readyLightOff();
                     Interface_waitLightOn();
-                    resendMessageCount = 0;
+                    Mavlink_cancelResends();
                     Mavlink_sendReturnStation(WANT_ACK);
-                    Timer_new(TIMER_STOP, RESEND_MESSAGE_DELAY);
                 }
                 else if (lastSubState == STATE_STOP_SEND)
                     startReadySM();
@@ -779,20 +755,11 @@ static void doSetStationSM() {
                 Interface_waitLightOff();
                 Interface_readyLightOn();
                 event.flags.setStationDone = TRUE;
-                resendMessageCount = 0;
             }
-            else if (Timer_isExpired(TIMER_SETSTATION)) {
-                // Resend start rescue message on timer
-                if (resendMessageCount >= RESEND_MESSAGE_LIMIT) {
-                    // Sent too many times
-                    setError(ERROR_NO_ACKNOWLEDGEMENT);
-                    return;
-                }
-                else {
-                    Mavlink_sendSaveStation(WANT_ACK);
-                    Timer_new(TIMER_SETSTATION, RESEND_MESSAGE_DELAY);
-                    resendMessageCount++;
-                }
+            else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_CMD_OTHER, MAVLINK_SAVE_STATION) == ACK_STATUS_DEAD) {
+                // Gave up resending
+                setError(ERROR_NO_ACKNOWLEDGEMENT);
+                return;
             }
             else if (event.flags.cancelButtonPressed
                     && Timer_isExpired(TIMER_DEBOUNCE)) {
@@ -832,7 +799,8 @@ static void doSetOriginSM() {
         //Interface_showMessageOnTimer(SET_ORIGIN_MESSAGE, LCD_HOLD_DELAY);
         Interface_showMessageOnTimer(BOAT_ONLINE_MESSAGE, LCD_HOLD_DELAY);
         event.flags.setOriginDone = TRUE;
-    } else if (Timer_isExpired(TIMER_SETORIGIN)) {
+    } else if (Mavlink_getAckStatus(MAVLINK_MSG_ID_GPS_ECEF,
+            MAVLINK_GEOCENTRIC_ORIGIN) == ACK_STATUS_DEAD) {
         setError(ERROR_NO_ACKNOWLEDGEMENT);
     }
 }
@@ -880,6 +848,7 @@ static void doMasterSM() {
     #endif
 
     #ifdef USE_XBEE
+    doHeartbeatMessage();
     Xbee_runSM();
     #endif
 
@@ -920,7 +889,10 @@ static void doMasterSM() {
 
             break;
         case STATE_READY:
-            // Do nothing special
+            #ifdef USE_XBEE
+            if (event.flags.haveBoatHeartbeat)
+                Interface_showLinkStats(Mavlink_getLinkStats());
+            #endif
 
             break;
         case STATE_ERROR:
@@ -1001,7 +973,6 @@ static void doMasterSM() {
 static void startCalibrateSM() {
 	state = STATE_CALIBRATE;
 	subState = STATE_CALIBRATE_PITCH;
-	resendMessageCount = 0;
 	Interface_clearAll();
         DELAY(5);
 	Interface_showMessage(CALIBRATE_PITCH_MESSAGE);
@@ -1016,7 +987,7 @@ static void startCalibrateSM() {
 static void startReadySM() {
 	state = STATE_READY;
 	subState = STATE_NONE; // no sub-states in Ready
-	resendMessageCount = 0;
+	Mavlink_cancelResends();
 	Interface_readyLightOn();
 	Interface_errorLightOff();
 	Interface_waitLightOff();
@@ -1051,9 +1022,8 @@ static void startSetStationSM() {
     subState = STATE_SETSTATION_SEND;
     Timer_new(TIMER_DEBOUNCE, RESCUE_DEBOUNCE_DELAY);
  
+    Mavlink_cancelResends();
     Mavlink_sendSaveStation(WANT_ACK);
-    Timer_new(TIMER_SETSTATION, RESEND_MESSAGE_DELAY);
-    resendMessageCount = 0;
 
     Interface_clearAll();
     Interface_waitLightOn();
@@ -1073,9 +1043,8 @@ static void startSetOriginSM() {
     if (event.flags.haveError)
         return;
 
+    Mavlink_cancelResends();
     Mavlink_sendOrigin(WANT_ACK, &ecefPosition);
-    Timer_new(TIMER_SETORIGIN, RESEND_MESSAGE_DELAY);
-    resendMessageCount = 0;
 
     Interface_clearAll();
     Interface_waitLightOn();
@@ -1092,11 +1061,10 @@ static void startRescueSM() {
     subState = STATE_RESCUE_SEND;
     Timer_new(TIMER_DEBOUNCE, RESCUE_DEBOUNCE_DELAY);
 
-    // Send the target location to the boat and start the resend timer
+    // Send the target location to the boat, resent until acked
     getTargetLocation(&nedRescueTarget);
+    Mavlink_cancelResends();
     Mavlink_sendStartRescue(WANT_ACK, &nedRescueTarget);
-    Timer_new(TIMER_RESCUE, RESEND_MESSAGE_DELAY);
-    resendMessageCount = 0;
 
     Interface_clearAll();
     Interface_waitLightOn();
@@ -1123,10 +1091,9 @@ static void startStopSM() {
     subState = STATE_STOP_SEND;
     Timer_new(TIMER_DEBOUNCE, RESCUE_DEBOUNCE_DELAY);
 
-    // Send a stop message and resend on timer
+    // Send a stop message, resent until acked
+    Mavlink_cancelResends();
     Mavlink_sendOverride(WANT_ACK);
-    Timer_new(TIMER_STOP, RESEND_MESSAGE_DELAY);
-    resendMessageCount = 0;
 
     Interface_clearAll();
     Interface_waitLightOn();
@@ -1190,7 +1157,7 @@ static void doBarometerUpdate() {
         compasHeight = DEFAULT_COMPAS_HEIGHT;
 #else
         compasHeight = Barometer_getAltitude();
-            - Mavlink_newMessage.telemetryData.altitude;
+            - boatAltitude;
 #endif
 
         haveCompasHeight = TRUE;
@@ -1280,6 +1247,19 @@ static void checkBoatConnection() {
     }
 }
 
+/**********************************************************************
+ * Function: doHeartbeatMessage
+ * @return None.
+ * @remark Occasionally sends a heartbeat message to the boat, which echoes
+ *  the time in it back for the round trip time.
+ **********************************************************************/
+static void doHeartbeatMessage() {
+    if (Timer_isExpired(TIMER_HEARTBEAT) || !Timer_isActive(TIMER_HEARTBEAT)) {
+        Mavlink_sendHeartbeat();
+        Timer_new(TIMER_HEARTBEAT, HEARTBEAT_SEND_DELAY);
+    }
+}
+
 /**********************************************************************
  * Function: restartCompas
  * @return None
@@ -1453,7 +1433,6 @@ static void initializeCompas() {
 
     // Start calibrating before use
     startCalibrateSM();
-    resendMessageCount = 0;
 
 }
 
@@ -0,0 +1,306 @@
+/**********************************************************************
+ Module
+   Console.c
+
+ Author: David Goodman
+
+ Description
+    Deferred console messages. The logging side only records a message ID
+    and raw arguments into a ring buffer; Console_runSM formats or forwards
+    them when the serial port has room.
+
+ Notes
+    Formats come from the table in ConsoleMessages.h. Each conversion is
+    rendered with its own snprintf call, using the recorded word as an int,
+    unsigned or float depending on the conversion character.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+ 10-18-26               dagoodma    Added Console_format.
+***********************************************************************/
+
+#include <xc.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "Board.h"
+#include "Serial.h"
+#include "Uart.h"
+#include "Timer.h"
+#include "RingBuffer.h"
+#include "Console.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define CONSOLE_BUFFER_SIZE     512 // (bytes) must be a power of two
+#define CONSOLE_LINE_SIZE       128 // (bytes) longest formatted message
+#define CONSOLE_SPEC_SIZE       16  // (bytes) longest conversion spec
+
+#define RECORD_HEADER_SIZE      7 // sync, id, count, time
+#define RECORD_MAX_SIZE         (RECORD_HEADER_SIZE + 4*CONSOLE_MAX_ARGS)
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static uint16_t formatMessage(char *line, uint16_t size, uint8_t id,
+    const uint32_t *args, uint8_t count);
+static bool sendPending();
+
+/**********************************************************************
+ * PRIVATE VARIABLES                                                  *
+ **********************************************************************/
+
+static const char * const formats[CONSOLE_MESSAGE_COUNT] = {
+#define CONSOLE_MESSAGE(name, format) format,
+    CONSOLE_MESSAGES
+#undef CONSOLE_MESSAGE
+};
+
+static uint8_t storage[CONSOLE_BUFFER_SIZE];
+static RingBuffer records;
+static bool isInitialized = FALSE;
+static uint8_t consoleMode = CONSOLE_MODE_TEXT;
+static uint32_t droppedCount = 0;
+
+// Output waiting for room in the serial transmit buffer
+static char pending[CONSOLE_LINE_SIZE];
+static uint16_t pendingLength = 0;
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+char Console_init(uint8_t mode) {
+    if (mode != CONSOLE_MODE_TEXT && mode != CONSOLE_MODE_BINARY)
+        return FAILURE;
+    if (RingBuffer_init(&records, storage, CONSOLE_BUFFER_SIZE) != SUCCESS)
+        return FAILURE;
+
+    consoleMode = mode;
+    droppedCount = 0;
+    pendingLength = 0;
+    isInitialized = TRUE;
+    return SUCCESS;
+}
+
+void Console_log(uint8_t id, const uint32_t *args, uint8_t count) {
+    uint8_t record[RECORD_MAX_SIZE];
+    uint32_t time;
+    uint16_t length;
+
+    if (id >= CONSOLE_MESSAGE_COUNT)
+        return;
+    if (count > CONSOLE_MAX_ARGS)
+        count = CONSOLE_MAX_ARGS;
+
+    if (!isInitialized) {
+        // Nothing will run the console, so print it now
+        char line[CONSOLE_LINE_SIZE];
+        length = formatMessage(line, sizeof(line), id, args, count);
+        UART_write(Serial_getUartId(), (const uint8_t*)line, length,
+            UART_WRITE_TRUNCATE, 0);
+        return;
+    }
+
+    length = RECORD_HEADER_SIZE + 4*count;
+    if (RingBuffer_getSpace(&records) < length) {
+        droppedCount++;
+        return;
+    }
+
+    time = Timer_isInitialized()? get_time() : 0;
+    record[0] = CONSOLE_SYNC;
+    record[1] = id;
+    record[2] = count;
+    memcpy(&record[3], &time, sizeof(time));
+    memcpy(&record[RECORD_HEADER_SIZE], args, 4*count);
+    RingBuffer_write(&records, record, length);
+}
+
+void Console_runSM() {
+    uint8_t record[RECORD_MAX_SIZE];
+    uint32_t args[CONSOLE_MAX_ARGS];
+    uint8_t count;
+
+    if (!isInitialized)
+        return;
+
+    while (sendPending() && RingBuffer_getLength(&records) >= RECORD_HEADER_SIZE) {
+        // Records are written whole, so the arguments are there too
+        RingBuffer_read(&records, record, RECORD_HEADER_SIZE);
+        count = record[2];
+        RingBuffer_read(&records, &record[RECORD_HEADER_SIZE], 4*count);
+
+        if (consoleMode == CONSOLE_MODE_BINARY) {
+            pendingLength = RECORD_HEADER_SIZE + 4*count;
+            memcpy(pending, record, pendingLength);
+        }
+        else {
+            memcpy(args, &record[RECORD_HEADER_SIZE], 4*count);
+            pendingLength = formatMessage(pending, sizeof(pending),
+                record[1], args, count);
+        }
+    }
+}
+
+uint32_t Console_getDropped() {
+    return droppedCount;
+}
+
+uint16_t Console_format(char *line, uint16_t size, uint16_t id,
+        const uint32_t *args, uint8_t count) {
+    if (size == 0)
+        return 0;
+    line[0] = '\0';
+    if (id >= CONSOLE_MESSAGE_COUNT)
+        return 0;
+    if (count > CONSOLE_MAX_ARGS)
+        count = CONSOLE_MAX_ARGS;
+    return formatMessage(line, size, (uint8_t)id, args, count);
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: sendPending
+ * @return TRUE if nothing is left waiting to be sent.
+ * @remark Queues the pending output to the serial port if it fits.
+ **********************************************************************/
+static bool sendPending() {
+    if (pendingLength == 0)
+        return TRUE;
+    if (UART_write(Serial_getUartId(), (const uint8_t*)pending, pendingLength,
+            UART_WRITE_REJECT, 0) == 0)
+        return FALSE;
+    pendingLength = 0;
+    return TRUE;
+}
+
+/**********************************************************************
+ * Function: formatMessage
+ * @param Array to save the formatted message into.
+ * @param Size of the array.
+ * @param Message ID.
+ * @param Raw arguments.
+ * @param Number of arguments.
+ * @return Length of the formatted message.
+ * @remark Renders the message's format with the recorded arguments. Missing
+ *  arguments are printed as zero and %s is printed as '?'.
+ **********************************************************************/
+static uint16_t formatMessage(char *line, uint16_t size, uint8_t id,
+        const uint32_t *args, uint8_t count) {
+    const char *format = formats[id];
+    char spec[CONSOLE_SPEC_SIZE];
+    uint16_t length = 0, specLength;
+    uint8_t argIndex = 0;
+    uint32_t arg;
+    int written;
+    union {
+        uint32_t w;
+        float f;
+    } convert;
+
+    while (*format != '\0' && length < size - 1) {
+        if (*format != '%') {
+            line[length++] = *format++;
+            continue;
+        }
+        if (format[1] == '%') {
+            line[length++] = '%';
+            format += 2;
+            continue;
+        }
+
+        // Copy the spec up to its conversion, dropping length modifiers
+        specLength = 0;
+        spec[specLength++] = *format++;
+        while (*format != '\0' && strchr("diuxXcfeEgGs", *format) == NULL) {
+            if (strchr("hlLqjzt", *format) == NULL && specLength < CONSOLE_SPEC_SIZE - 2)
+                spec[specLength++] = *format;
+            format++;
+        }
+        if (*format == '\0')
+            break;
+        spec[specLength++] = *format;
+        spec[specLength] = '\0';
+
+        arg = (argIndex < count)? args[argIndex] : 0;
+        argIndex++;
+        switch (*format++) {
+            case 'd': case 'i': case 'c':
+                written = snprintf(&line[length], size - length, spec, (int)(int32_t)arg);
+                break;
+            case 'u': case 'x': case 'X':
+                written = snprintf(&line[length], size - length, spec, (unsigned int)arg);
+                break;
+            case 's':
+                written = snprintf(&line[length], size - length, "?");
+                break;
+            default:
+                convert.w = arg;
+                written = snprintf(&line[length], size - length, spec, (double)convert.f);
+                break;
+        }
+        if (written > 0)
+            length += written;
+        if (length > size - 1)
+            length = size - 1;
+    }
+    line[length] = '\0';
+    return length;
+}
+
+
+//#define CONSOLE_TEST
+#ifdef CONSOLE_TEST
+#include <plib.h>
+
+/* Compares printing the navigation debug line with printf against logging
+ * it with the console, then lets the console print the logged copies. */
+
+#define TEST_MESSAGES       20
+#define PRINT_DELAY         1000 // (ms) time to let the console drain
+#define CORE_TICKS_PER_US   (40) // core timer runs at SYSCLK/2
+
+int main(void)
+{
+    Board_init();
+    Board_configure(USE_SERIAL | USE_TIMER);
+    printf("\nConsole test harness\n");
+
+    float north = 12.34f, east = -5.67f, down = 0.89f;
+    uint32_t startTicks, printfTicks, logTicks;
+    int i;
+
+    startTicks = ReadCoreTimer();
+    printf("My position: N=%.2f, E=%.2f, D=%.2f\n", north, east, down);
+    printfTicks = ReadCoreTimer() - startTicks;
+
+    Console_init(CONSOLE_MODE_TEXT);
+    startTicks = ReadCoreTimer();
+    CONSOLE_LOG(CONSOLE_NAVIGATION_POSITION, CONSOLE_FLOAT(north),
+        CONSOLE_FLOAT(east), CONSOLE_FLOAT(down));
+    logTicks = ReadCoreTimer() - startTicks;
+
+    for (i = 1; i < TEST_MESSAGES; i++)
+        CONSOLE_LOG(CONSOLE_DRIVE_RUDDER, CONSOLE_INT(1000 + i));
+
+    Timer_new(TIMER_TEST, PRINT_DELAY);
+    while (!Timer_isExpired(TIMER_TEST))
+        Console_runSM();
+
+    printf("printf: %d us, log: %d us, dropped: %d\n",
+        (int)(printfTicks / CORE_TICKS_PER_US),
+        (int)(logTicks / CORE_TICKS_PER_US), (int)Console_getDropped());
+    while (1);
+    return 0;
+}
+#endif
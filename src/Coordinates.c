@@ -0,0 +1,272 @@
+/**********************************************************************
+ Module
+   Coordinates.c
+
+ Author: David Goodman
+
+ Description
+    Coordinate conversions (see Coordinates.h).
+
+ Notes
+    Geodetic and ECEF conversions use doubles, which XC32 makes 64 bits,
+    since a float can't hold an ECEF coordinate to the centimeter. They
+    are run once per fix or origin. convertECEF2LocalNED, run every
+    update, only subtracts integers and rotates the small result with
+    floats. Its rotation is worked out in setLocalOrigin, since the
+    PIC32MX has no FPU and each sinf or cosf takes thousands of cycles.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 03-10-13               dagoodma    Written in Gps.c.
+ 10-18-26               dagoodma    Moved from Gps.c, with ECEF in integer
+                                    centimeters.
+ 10-18-26               dagoodma    Added LocalOrigin, so the rotation to
+                                    NED is only worked out once.
+***********************************************************************/
+
+#include <stdio.h>
+#include <math.h>
+#include "Coordinates.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+// Ellipsoid (olbate) constants for coordinate conversions
+#define ECC     0.0818191908426 // eccentricity
+#define ECC2    (ECC*ECC)
+#define ECCP2   (ECC2 / (1.0 - ECC2)) // square of second eccentricity
+#define FLATR   (ECC2 / (1.0 + sqrt(1.0 - ECC2))) // flattening ratio
+
+// Radius of earth's curviture on semi-major and minor axes respectively
+#define R_EN    6378137.0     // (m) prime vertical radius (semi-major axis)
+#define R_EM    (R_EN * (1.0 - FLATR)) // meridian radius (semi-minor axis)
+
+#define DEGREE_TO_RADIAN_D  (M_PI/180.0)
+#define FIXED_TO_DEGREE     1e-7 // from the receiver's 1e-7 degrees
+#define MM_PER_METER        1000.0
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static void convertRadians2ECEF(GeocentricCoordinate *ecef, double lat, double lon,
+    double alt);
+static int32_t roundToECEF(double meters);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void convertGeodetic2ECEF(GeocentricCoordinate *ecef, GeodeticCoordinate *lla) {
+    convertRadians2ECEF(ecef, lla->lat * DEGREE_TO_RADIAN_D,
+        lla->lon * DEGREE_TO_RADIAN_D, lla->alt);
+}
+
+void convertFixedGeodetic2ECEF(GeocentricCoordinate *ecef, int32_t lat, int32_t lon,
+        int32_t height) {
+    convertRadians2ECEF(ecef, lat * FIXED_TO_DEGREE * DEGREE_TO_RADIAN_D,
+        lon * FIXED_TO_DEGREE * DEGREE_TO_RADIAN_D, height / MM_PER_METER);
+}
+
+
+void convertECEF2Geodetic(GeodeticCoordinate *lla, GeocentricCoordinate *ecef) {
+    double x = (double)ecef->x / ECEF_PER_METER;
+    double y = (double)ecef->y / ECEF_PER_METER;
+    double z = (double)ecef->z / ECEF_PER_METER;
+    double lat, lon;
+
+    lon = atan2(y, x);
+
+    double rho = sqrt((x*x) + (y*y));
+    if (rho < 0.1) rho = 0.1;
+
+    double beta = atan2(z, (1.0 - FLATR) * rho);
+
+    lat = atan2(z + R_EM * ECCP2 * (sin(beta)*sin(beta)*sin(beta)),
+        rho - R_EN * ECC2 * (cos(beta)*cos(beta)*cos(beta)));
+
+    double betaNew = atan2((1.0 - FLATR)*sin(lat), cos(lat));
+    int count = 0;
+    while (beta != betaNew && count < 5) {
+        beta = betaNew;
+        lat = atan2(z  + R_EM * ECCP2 * (sin(beta)*sin(beta)*sin(beta)),
+            rho - R_EN * ECC2 * (cos(beta)*cos(beta)*cos(beta)));
+
+        betaNew = atan2((1.0 - FLATR)*sin(lat), cos(lat));
+        count++;
+    }
+
+    double sinlat = sin(lat);
+    double rad_ne = R_EN / sqrt(1.0 - (ECC2 * sinlat * sinlat));
+
+    lla->alt = rho * cos(lat) + (z + ECC2 * rad_ne * sinlat) * sinlat - rad_ne;
+
+    // Convert radian geodetic to degrees
+    lla->lat = lat / DEGREE_TO_RADIAN_D;
+    lla->lon = lon / DEGREE_TO_RADIAN_D;
+}
+
+
+
+void convertECEF2NED(LocalCoordinate *ned, GeocentricCoordinate *ecef_cur,
+    GeocentricCoordinate *ecef_ref, GeodeticCoordinate *geo_ref) {
+    // Offset vector from reference, exact in centimeters, then in meters
+    float x = ECEF_TO_METERS(ecef_cur->x - ecef_ref->x);
+    float y = ECEF_TO_METERS(ecef_cur->y - ecef_ref->y);
+    float z = ECEF_TO_METERS(ecef_cur->z - ecef_ref->z);
+
+    float cosLat = cosf(geo_ref->lat * DEGREE_TO_RADIAN);
+    float sinLat = sinf(geo_ref->lat * DEGREE_TO_RADIAN);
+    float cosLon = cosf(geo_ref->lon * DEGREE_TO_RADIAN);
+    float sinLon = sinf(geo_ref->lon * DEGREE_TO_RADIAN);
+
+    // Rotate
+    float t =  cosLon * x + sinLon * y;
+
+    ned->north = -sinLat * t + cosLat * z;
+    ned->east = -sinLon * x + cosLon * y;
+    ned->down = -(cosLat * t + sinLat * z);
+    //ned->down = 0;
+}
+
+
+void setLocalOrigin(LocalOrigin *origin, GeocentricCoordinate *ecef) {
+    origin->ecef = *ecef;
+    convertECEF2Geodetic(&origin->lla, ecef);
+
+    // Once per origin, so in doubles
+    double lat = origin->lla.lat * DEGREE_TO_RADIAN_D;
+    double lon = origin->lla.lon * DEGREE_TO_RADIAN_D;
+    double sinLat = sin(lat), cosLat = cos(lat);
+    double sinLon = sin(lon), cosLon = cos(lon);
+
+    // Same rotation as convertECEF2NED
+    origin->rotation[0][0] = -sinLat * cosLon;
+    origin->rotation[0][1] = -sinLat * sinLon;
+    origin->rotation[0][2] = cosLat;
+    origin->rotation[1][0] = -sinLon;
+    origin->rotation[1][1] = cosLon;
+    origin->rotation[1][2] = 0.0f;
+    origin->rotation[2][0] = -cosLat * cosLon;
+    origin->rotation[2][1] = -cosLat * sinLon;
+    origin->rotation[2][2] = -sinLat;
+}
+
+
+void convertECEF2LocalNED(LocalCoordinate *ned, GeocentricCoordinate *ecef,
+        const LocalOrigin *origin) {
+    float x = ECEF_TO_METERS(ecef->x - origin->ecef.x);
+    float y = ECEF_TO_METERS(ecef->y - origin->ecef.y);
+    float z = ECEF_TO_METERS(ecef->z - origin->ecef.z);
+    const float (*r)[3] = origin->rotation;
+
+    ned->north = r[0][0] * x + r[0][1] * y + r[0][2] * z;
+    ned->east = r[1][0] * x + r[1][1] * y; // r[1][2] is 0
+    ned->down = r[2][0] * x + r[2][1] * y + r[2][2] * z;
+}
+
+
+void projectEulerToNED(LocalCoordinate *ned, float yaw, float pitch, float height) {
+    //printf("At angle: %.3f and pitch: %.3f\n",yaw,pitch);
+
+    float mag = height * tan((90.0-pitch)*DEGREE_TO_RADIAN);
+    #ifdef DEBUG
+    printf("\tMagnitude: %.3f\n",mag);
+    #endif
+
+    //printf("At mag: %.3f\n",mag);
+
+    if (yaw <= 90.0) {
+        //First quadrant
+        ned->north = mag * cosf(yaw*DEGREE_TO_RADIAN);
+        ned->east = mag * sinf(yaw*DEGREE_TO_RADIAN);
+    }
+    else if (yaw > 90.0 && yaw <= 180.0) {
+        // Second quadrant
+        yaw = yaw - 270.0;
+        ned->north = mag * sinf(yaw*DEGREE_TO_RADIAN);
+        ned->east = -mag * cosf(yaw*DEGREE_TO_RADIAN);
+    }
+    else if (yaw > 180.0 && yaw <= 270.0) {
+        // Third quadrant
+        yaw = yaw - 180.0;
+        ned->north = -mag * cosf(yaw*DEGREE_TO_RADIAN);
+        ned->east = -mag * sinf(yaw*DEGREE_TO_RADIAN);
+    }
+    else if (yaw > 270.0 && yaw < 360.0) {
+        // Fourth quadrant
+        yaw = yaw - 90.0;
+        ned->north = -mag * sinf(yaw*DEGREE_TO_RADIAN);
+        ned->east = mag * cosf(yaw*DEGREE_TO_RADIAN);
+    }
+
+    ned->down = height;
+    //printf("Desired coordinate -- N:%.2f, E: %.2f, D: %.2f (m)\n",
+    //    ned->north, ned->east, ned->down);
+}
+
+
+void getCourseVector(CourseVector *course, LocalCoordinate *ned_cur,
+        LocalCoordinate *ned_des) {
+    LocalCoordinate ned_path;
+    ned_path.north = ned_des->north - ned_cur->north;
+    ned_path.east = ned_des->east - ned_cur->east;
+    //ned_path.down = ned_des->down - ned_cur->down;
+
+    // Calculate heading (in degrees from North) of path
+    if (ned_path.north > 0.0 && ned_path.east > 0.0) {
+        course->heading = atanf(fabsf(ned_path.east)/fabsf(ned_path.north))*RADIAN_TO_DEGREE;
+    }
+    else if (ned_path.north < 0.0 && ned_path.east > 0.0) {
+        course->heading = atanf(fabsf(ned_path.north)/fabsf(ned_path.east))*RADIAN_TO_DEGREE;
+        course->heading += 90.0;
+    }
+    else if (ned_path.north < 0.0 && ned_path.east< 0.0) {
+        course->heading = atanf(fabsf(ned_path.east)/fabsf(ned_path.north))*RADIAN_TO_DEGREE;
+        course->heading += 180.0;
+    }
+    else if (ned_path.north > 0.0 && ned_path.east< 0.0) {
+        course->heading = atanf(fabsf(ned_path.north)/fabsf(ned_path.east))*RADIAN_TO_DEGREE;
+        course->heading += 270.0;
+    }
+
+    // Calculate distance to point
+    course->distance = sqrtf((ned_path.north)*(ned_path.north) + (ned_path.east)*(ned_path.east));
+
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: convertRadians2ECEF
+ * @param A pointer to a new ECEF coordinate variable to save result into.
+ * @param Latitude in radians.
+ * @param Longitude in radians.
+ * @param Height above the ellipsoid in meters.
+ * @return None.
+ **********************************************************************/
+static void convertRadians2ECEF(GeocentricCoordinate *ecef, double lat, double lon,
+        double alt) {
+    double sinlat = sin(lat);
+    double coslat = cos(lat);
+
+    double rad_ne = R_EN / sqrt(1.0 - (ECC2 * sinlat * sinlat));
+    ecef->x = roundToECEF((rad_ne + alt) * coslat * cos(lon));
+    ecef->y = roundToECEF((rad_ne + alt) * coslat * sin(lon));
+    ecef->z = roundToECEF((rad_ne*(1.0 - ECC2) + alt) * sinlat);
+}
+
+/**********************************************************************
+ * Function: roundToECEF
+ * @param Coordinate in meters.
+ * @return Nearest whole ECEF unit.
+ **********************************************************************/
+static int32_t roundToECEF(double meters) {
+    double units = meters * ECEF_PER_METER;
+    return (int32_t)((units < 0.0) ? units - 0.5 : units + 0.5);
+}
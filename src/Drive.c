@@ -9,6 +9,7 @@
 
 #include <xc.h>
 #include <stdio.h>
+#include <string.h>
 #include <plib.h>
 #include <math.h>
 #include "Drive.h"
@@ -20,6 +21,7 @@
 #include "Drive.h"
 #include "I2C.h"
 #include "TiltCompass.h"
+#include "Console.h"
 
 
 /***********************************************************************
@@ -41,6 +43,13 @@
 #define DBPRINT(...)   ((int)0)
 #endif
 
+// Deferred debug messages from the control loop (see ConsoleMessages.h)
+#ifdef DEBUG
+#define DBLOG(...)     CONSOLE_LOG(__VA_ARGS__)
+#else
+#define DBLOG(...)     ((int)0)
+#endif
+
 
 // --------------------- Acutator ports -----------------------------
 #define MOTOR_LEFT              RC_PORTY07  //RD10, J5-01            //RC_PORTW08 // RB2 -- J7-01
@@ -110,7 +119,9 @@ static uint8_t desiredSpeed = 0; // (percent) from 0 to 100%
 static uint16_t desiredHeading = 0; // (degrees) from North
 
 #ifdef USE_PUBLIC_DEBUG
-char debugString[100];
+#define DEBUG_ARG_COUNT     8 // of CONSOLE_DRIVE_TRACK
+static uint32_t debugArgs[DEBUG_ARG_COUNT];
+static bool hasDebugEvent = FALSE;
 #endif
 
 
@@ -235,17 +246,23 @@ void Drive_stop() {
 
 
 /**********************************************************************
- * Function: Drive_getDebugString
- * @return None
- * @remark 
+ * Function: Drive_getDebugEvent
+ * @param Array for the arguments, with room for CONSOLE_MAX_ARGS.
+ * @return Number of arguments, or 0 if nothing new.
+ * @remark Arguments of a CONSOLE_DRIVE_TRACK message from the last rudder
+ *  update, if there was one since the last call.
  * @author David Goodman
- * @date 2013.05.25 
+ * @date 2026.10.18 
  **********************************************************************/
-char *Drive_getDebugString() {
+uint8_t Drive_getDebugEvent(uint32_t *args) {
     #ifdef USE_PUBLIC_DEBUG
-    return debugString;
+    if (!hasDebugEvent)
+        return 0;
+    memcpy(args, debugArgs, sizeof(debugArgs));
+    hasDebugEvent = FALSE;
+    return DEBUG_ARG_COUNT;
     #else
-    return "";
+    return 0;
     #endif
 }
 
@@ -313,7 +330,7 @@ static void setLeftMotor(uint8_t speed) {
     if (rc_time < RC_MOTOR_MIN)
         rc_time = RC_MOTOR_MIN;
 
-    DBPRINT("Setting left motor to RC_TIME=%d\n",rc_time);
+    DBLOG(CONSOLE_DRIVE_LEFT_MOTOR, CONSOLE_INT(rc_time));
     #ifndef DISABLE_MOTORS
     RC_setPulseTime(MOTOR_LEFT, rc_time);
     #endif
@@ -333,7 +350,7 @@ static void setRightMotor(uint8_t speed) {
     if (rc_time < RC_MOTOR_MIN)
         rc_time = RC_MOTOR_MIN;
 
-    DBPRINT("Setting right motor to RC_TIME=%d\n",rc_time);
+    DBLOG(CONSOLE_DRIVE_RIGHT_MOTOR, CONSOLE_INT(rc_time));
     #ifndef DISABLE_MOTORS
     RC_setPulseTime(MOTOR_RIGHT, rc_time);
     #endif
@@ -358,7 +375,7 @@ static void setRudder(char direction, uint8_t percentAngle) {
     if (rc_time < RC_RUDDER_MIN)
         rc_time = RC_RUDDER_MIN;
 
-    DBPRINT("Setting rudder to RC_TIME=%d\n",rc_time);
+    DBLOG(CONSOLE_DRIVE_RUDDER, CONSOLE_INT(rc_time));
     RC_setPulseTime(RUDDER, rc_time);
 }
 
@@ -413,12 +430,12 @@ static void updateRudder() {
     uPercent = (uPercent > 100.0)? 100.0f : uPercent;
     uPercent = (uPercent < 0.0)? 0.0f : uPercent;
 
-    char *bangbang = "";
+    bool bangbang = FALSE;
     // Bang-bang control to force rudder all the way if speed is low
     if (desiredSpeed < RUDDER_BANGBANG_SPEED_THRESHOLD
             && thetaError > RUDDER_BANGBANG_THETA_DEADBAND_THRESHOLD) {
         uPercent = 100.0f;
-        bangbang = " BB";
+        bangbang = TRUE;
     }
     
     // Command the rudder and save 
@@ -429,13 +446,22 @@ static void updateRudder() {
     dir = (rudderDirection == RUDDER_TURN_RIGHT)? "R" : "L";
         
     #ifdef DEBUG_VERBOSE
-    DBPRINT("Rudder control: rDegrees=%d, yDegrees=%d, eDegrees=%d, uDegrees=%.2f, uPercent=%d[%s]\n\n",
-        desiredHeading, currentHeading, thetaError, uDegrees, (uint8_t)uPercent, dir);
+    DBLOG(CONSOLE_DRIVE_RUDDER_CONTROL, CONSOLE_INT(desiredHeading),
+        CONSOLE_INT(currentHeading), CONSOLE_INT(thetaError), CONSOLE_FLOAT(uDegrees),
+        CONSOLE_INT((uint8_t)uPercent), CONSOLE_INT(dir[0]));
     #endif
 
     #ifdef USE_PUBLIC_DEBUG
-    sprintf(debugString, "R=%d, Y=%d, e=%d, U=%.2f, Up=%d[%s]%s, S=%d\n",
-        desiredHeading, currentHeading, thetaError, uDegrees, (uint8_t)uPercent, dir, bangbang, desiredSpeed);
+    // Formatted by whoever receives it, not here
+    debugArgs[0] = CONSOLE_INT(desiredHeading);
+    debugArgs[1] = CONSOLE_INT(currentHeading);
+    debugArgs[2] = CONSOLE_INT(thetaError);
+    debugArgs[3] = CONSOLE_FLOAT(uDegrees);
+    debugArgs[4] = CONSOLE_INT((uint8_t)uPercent);
+    debugArgs[5] = CONSOLE_INT(dir[0]);
+    debugArgs[6] = CONSOLE_INT(bangbang);
+    debugArgs[7] = CONSOLE_INT(desiredSpeed);
+    hasDebugEvent = TRUE;
     #endif
 }
 
@@ -14,7 +14,10 @@
 #include "Timer.h"
 #include "Board.h"
 #include "Uart.h"
+#include "UbxParser.h"
+#include "UbxConfig.h"
 #include "Gps.h"
+#include "GpsHistory.h"
 
 
 
@@ -25,64 +28,29 @@
 //#define DEBUG_STATE
 
 
-#define START_BAUDRATE      38400 // (baud)
-#define DESIRED_BAUDRATE    START_BAUDRATE
+#define START_BAUDRATE      38400 // (baud) LEA-6 default, tried first
+#define DESIRED_BAUDRATE    115200 // (baud) set by UbxConfig
 
 #define GPS_UART_BAUDRATE   START_BAUDRATE
 
-
-#define RAW_BUFFER_SIZE         255 // (bytes) maximum gps message size
-#define CHECKSUM_BYTES          2 // (bytes) number in checksum
-
-// Field indexes ( see pg. 60 in ublox UBX protocol specifications)
-#define SYNC1_INDEX             0 // index of first sync byte
-#define SYNC2_INDEX             1 // index of second sync byte
-#define CLASS_INDEX             2 // index of class byte
-#define ID_INDEX                3 // index of id byte
-#define LENGTH1_INDEX           4 // start of length field (2 bytes long)
-#define LENGTH2_INDEX           5 // end of length field (2 bytes long)
-#define PAYLOAD_INDEX           6 // start of the payload
-
-// Field constants
-#define SYNC1_CHAR              0xB5 // first byte in message
-#define SYNC2_CHAR              0x62 // second byte in message
-// Message Classes
-#define NAV_CLASS               0x01 // navigation message class
-// Navgation message IDs
-#define NAV_POSLLH_ID           0x02 // geodetic postion message id
-#define NAV_STATUS_ID           0x03 // receiver navigation status (fix/nofix)
-#define NAV_SOL_ID              0x06 // navigation solution message id
-#define NAV_VELOCITY_ID         0x12 // velocity NED navigation message
+#define NAVIGATION_RATE     5 // (Hz) 5 to 10, set by UbxConfig
 
 #define NOFIX_STATUS            0x00
 
+// Messages of an epoch that are in epochFix
+#define EPOCH_POSITION          0x1
+#define EPOCH_VELOCITY          0x2
+#define EPOCH_ADDED             0x4 // to the history
+
 // GPS connection timeout for packet not seen
 #define DELAY_TIMEOUT           15000
 
-// unpacking functions
-#define UNPACK_LITTLE_ENDIAN_32(data, start) \
-    ((uint32_t)(data[start] + ((uint32_t)data[start+1] << 8) \
-    + ((uint32_t)data[start+2] << 16) + ((uint32_t)data[start+3] << 24)))
-
+#define MM_TO_CM(unit)                  ((unit)/10)
 #define MM_TO_M(unit)                   ((float)unit/1000)
 #define CM_TO_M(unit)                   ((float)unit/100)
 #define GEODETIC_1E7_TO_DECIMAL(coord)  ((float)coord/10000000)
 #define HEADING_1E5_TO_DEGREE(heading)  ((float)heading/100000)
 
-// Cooordinate conversion constants
-
-// Ellipsoid (olbate) constants for coordinate conversions
-#define ECC     0.0818191908426f // eccentricity
-#define ECC2    (ECC*ECC)
-#define ECCP2   (ECC2 / (1.0 - ECC2)) // square of second eccentricity
-#define FLATR   (ECC2 / (1.0 + sqrtf(1.0 - ECC2))) // flattening ratio
-
-// Radius of earth's curviture on semi-major and minor axes respectively
-#define R_EN    6378137.0f     // (m) prime vertical radius (semi-major axis)
-#define R_EM    (R_EN * (1.0f - FLATR)) // meridian radius (semi-minor axis)
-
-
-
 /**********************************************************************
  * PRIVATE VARIABLES                                                  *
  **********************************************************************/
@@ -90,32 +58,43 @@ bool gpsInitialized = FALSE;
 
 static enum {
     STATE_IDLE      = 0x0,
-    STATE_READ      = 0x1, // Reading GPS packet from UART
-    STATE_PARSE     = 0x2, // Parsing a received GPS packet
+    STATE_READ      = 0x1, // Reading and decoding GPS packets from UART
 } state;
 
-uint8_t rawMessage[RAW_BUFFER_SIZE];
-uint8_t byteIndex = 0, messageLength = LENGTH2_INDEX + 1,
-        messageClass = 0, messageId = 0, gpsStatus = NOFIX_STATUS;
+// Checks frames from the receiver, and holds the one being parsed
+static UbxParser ubxParser;
+static GpsStatistics statistics;
+
+// Sets up the receiver's baud rate and messages
+static UbxConfig ubxConfig;
+
+uint8_t gpsStatus = NOFIX_STATUS;
 
 
 bool hasNewMessage = FALSE, isConnected = FALSE, hasPosition = FALSE;
 
+// (ms) arrival of the message being read, and of the last position
+static uint32_t messageTime = 0, fixTime = 0;
+
 // Variables read from the GPS
 
 
+// Replaced whole by each decoded frame (see decodeMessage)
 #ifndef USE_GEOCENTRIC_COORDINATES
 GeodeticCoordinate myPosition;
-GeodeticCoordinate myTempPosition;
 #else
 GeocentricCoordinate myPosition;
-GeocentricCoordinate myTempPosition;
 #endif
 
 struct {
     int32_t northVelocity, eastVelocity, heading;
 } myCourse;
 
+// Fixes by time, each put together from the messages of one epoch
+static GpsHistory history;
+static GpsFix epochFix;
+static uint8_t epochParts = 0;
+
 
 
 
@@ -128,12 +107,17 @@ struct {
 static bool hasNewByte();
 static void startReadState();
 static void startIdleState();
-static void startParseState();
-static int8_t readMessageByte();
-static int8_t parseMessage();
-static void parsePayloadField();
+static void readMessageSpan();
+static void decodeMessage();
+static void startEpoch(uint32_t iTow);
+static void addEpochPart(uint8_t part);
+static uint16_t sendToGps(const uint8_t *frame, uint16_t length);
+static bool isSentToGps();
+static void setGpsBaudRate(uint32_t baudRate);
 static uint8_t gpsUartID;
 
+static const UbxConfigPort configPort = { sendToGps, isSentToGps, setGpsBaudRate };
+
 /**********************************************************************
  * PUBLIC FUNCTIONS                                                   *
  **********************************************************************/
@@ -149,6 +133,10 @@ bool GPS_init(uint8_t uartId) {
 #endif
     gpsUartID = uartId;
     UART_init(gpsUartID,GPS_UART_BAUDRATE);
+    UbxParser_init(&ubxParser);
+    GpsHistory_init(&history);
+    epochParts = 0;
+    UbxConfig_init(&ubxConfig, &configPort, DESIRED_BAUDRATE, NAVIGATION_RATE);
 
     startIdleState();
     gpsInitialized = TRUE;
@@ -175,38 +163,41 @@ void GPS_runSM() {
         // Waiting for data
         case STATE_IDLE:
             // check for a new packet to start reading
-            if (hasNewByte())
-                startReadState();
-            break;
-        // Reading the message in and verifying sync, length, and checksum
+            if (!hasNewByte())
+                break;
+            startReadState();
+            // fall through and start reading now
+        // Reading the message in, verifying it, and decoding the payload
         case STATE_READ:
+            readMessageSpan();
             if (hasNewMessage) {
-                startParseState(); // finished reading, start parsing the payload
-            }
-            else if (hasNewByte() && (readMessageByte() != SUCCESS)) {
-                #ifdef DEBUG
-                printf("Failed reading GPS message at byte %d.\n", byteIndex);
-                while (!Serial_isTransmitEmpty()) { asm("nop"); }
-                #endif
+                decodeMessage(); // whole frame, as soon as it is checked
                 startIdleState();
             }
             break;
-        // Parsing the new message's payload
-        case STATE_PARSE:
-            if (hasNewMessage)
-                parseMessage();
-            else
-                startIdleState();
-           break;
             // Should not be here!
     } // switch
 
+    // Find the receiver's baud rate and set it up, after reading its answers
+    if (!UbxConfig_isDone(&ubxConfig) && !UbxConfig_hasFailed(&ubxConfig))
+        UbxConfig_run(&ubxConfig, get_time());
+
     // Update connected variable
     if (Timer_isExpired(TIMER_GPS))
         isConnected = FALSE;
 }
 
 
+/**********************************************************************
+ * Function: GPS_isConfigured
+ * @return TRUE once the receiver's baud rate, rate and messages are set.
+ * @remark Positions can arrive before then, at the rate the receiver was
+ *  left at.
+ **********************************************************************/
+bool GPS_isConfigured() {
+    return UbxConfig_isDone(&ubxConfig);
+}
+
 /**********************************************************************
  * Function: GPS_hasFix
  * @return TRUE if a lock has been obtained.
@@ -242,7 +233,7 @@ bool GPS_isConnected() {
  * Function: GPS_getPosition
  * @param New geocentric coordinate to copy position into.
  * @return none
- * @remark  Copies the measured geocentric (ECEF) position in meters into the
+ * @remark  Copies the measured geocentric (ECEF) position in centimeters into the
  *  given coordinate object.
  **********************************************************************/
 void GPS_getPosition(GeocentricCoordinate *ecefPos) {
@@ -306,6 +297,74 @@ float GPS_getHeading() {
     return HEADING_1E5_TO_DEGREE(myCourse.heading);
 }
 
+/**********************************************************************
+ * Function: GPS_getFixTime
+ * @return Time in milliseconds when the message with the current position
+ *  started arriving, or 0 if it is not known.
+ * @remark Compare with get_time() to find how old the position is.
+ **********************************************************************/
+uint32_t GPS_getFixTime() {
+    return fixTime;
+}
+
+/**********************************************************************
+ * Function: GPS_getStatistics
+ * @return Frame, checksum error and resync counters, read only.
+ * @remark Counted since GPS_init.
+ **********************************************************************/
+const GpsStatistics *GPS_getStatistics() {
+    statistics.frames = ubxParser.frameCount;
+    statistics.checksumErrors = ubxParser.errorCount;
+    statistics.resyncBytes = ubxParser.skippedCount;
+    return &statistics;
+}
+
+/**********************************************************************
+ * Function: GPS_getLatestFix
+ * @return The newest fix with a position and velocity, or NULL if there
+ *  are none yet.
+ * @remark Read only, and replaced by the next fix.
+ **********************************************************************/
+const GpsFix *GPS_getLatestFix() {
+    return GpsHistory_getLatest(&history);
+}
+
+/**********************************************************************
+ * Function: GPS_getFixAt
+ * @param Time in milliseconds, from get_time.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is within the last GPS_HISTORY_LENGTH fixes.
+ * @remark Interpolated between the fixes before and after the time.
+ **********************************************************************/
+bool GPS_getFixAt(uint32_t time, GpsFix *fix) {
+    return GpsHistory_getAt(&history, time, fix);
+}
+
+/**********************************************************************
+ * Function: GPS_getFixAtTow
+ * @param GPS time of week in milliseconds.
+ * @param Fix to copy the result into.
+ * @return TRUE if the time is within the last GPS_HISTORY_LENGTH fixes.
+ * @remark Like GPS_getFixAt, for data stamped with GPS time.
+ **********************************************************************/
+bool GPS_getFixAtTow(uint32_t iTow, GpsFix *fix) {
+    return GpsHistory_getAtTow(&history, iTow, fix);
+}
+
+/**********************************************************************
+ * Function: GPS_isFixUsable
+ * @param Fix, e.g. from GPS_getLatestFix.
+ * @param Oldest it can be, in milliseconds.
+ * @param Worst horizontal accuracy it can have, in millimeters.
+ * @return TRUE if the fix is recent and accurate enough.
+ * @remark FALSE for NULL, so the result of GPS_getLatestFix can be passed
+ *  straight in.
+ **********************************************************************/
+bool GPS_isFixUsable(const GpsFix *fix, uint32_t maxAge, uint32_t maxAccuracy) {
+    return fix != NULL && fix->fixType != NOFIX_STATUS
+        && (get_time() - fix->time) <= maxAge && fix->hAcc <= maxAccuracy;
+}
+
 
 /**********************************************************************
  * PRIVATE FUNCTIONS                                                  *
@@ -342,8 +401,6 @@ static void startIdleState() {
  **********************************************************************/
 static void startReadState() {
     state = STATE_READ;
-    byteIndex = 0;
-    messageLength = PAYLOAD_INDEX;
     hasNewMessage = FALSE;
     
 #ifdef DEBUG_STATE
@@ -352,21 +409,6 @@ static void startReadState() {
 #endif
 }
 
-/**********************************************************************
- * Function: startParseState
- * @return None
- * @remark Switches into the GPS parse state.
- **********************************************************************/
-static void startParseState() {
-    state = STATE_PARSE;
-    byteIndex = PAYLOAD_INDEX;
-    
-#ifdef DEBUG_STATE
-    printf("Entered parse state.\n");
-    while (!Serial_isTransmitEmpty()) { asm("nop"); }
-#endif
-}
-
 /**********************************************************************
  * Function: setConnected
  * @return None
@@ -383,457 +425,240 @@ static void setConnected() {
 }
 
 /**********************************************************************
- * Function: parseMessageByte
- * @return SUCCESS, FAILURE, or ERROR.
- * @remark Reads a GPS packet from the UART. This function will return
- *  SUCCESS every time a valid byte is read (interpets the sync, length,
- *  and checksum fields). The hasNewMessage field will be set to TRUE
- *  when a new message is received and ready for parsing.
+ * Function: readMessageSpan
+ * @return None
+ * @remark Reads the GPS packet from the UART one contiguous span at a time,
+ *  passing the bytes to the UBX parser in place. Stops at the end of a
+ *  packet with a good checksum, so bytes from the next packet are left in
+ *  the UART for the next read state. Corrupted packets are dropped by the
+ *  parser, which resyncs on the bytes it already holds.
  **********************************************************************/
-static int8_t readMessageByte() {
-    // Read a new byte from the UART or return FAILURE
-    if (hasNewByte())
-        rawMessage[byteIndex] = UART_getChar(gpsUartID);
-    else
-        return FAILURE;
-
-    // Look at the new byte
-    switch(byteIndex) {
-        case SYNC1_INDEX:
-            if (rawMessage[byteIndex] != SYNC1_CHAR)
-                return FAILURE;
-            break;
-        case SYNC2_INDEX:
-            if (rawMessage[byteIndex] != SYNC2_CHAR)
-                return FAILURE;
-            // Two sync packets mean we see the GPS
-            setConnected();
-            break;
-        case CLASS_INDEX:
-            messageClass = rawMessage[byteIndex];
-            break;
-        case ID_INDEX:
-            messageId = rawMessage[byteIndex];
-            break;
-        case LENGTH1_INDEX:
-            messageLength = rawMessage[byteIndex];
-            break;
-        case LENGTH2_INDEX:
-            messageLength += rawMessage[byteIndex] << 8;
-            // Make length total for whole message
-            messageLength += PAYLOAD_INDEX + CHECKSUM_BYTES;
-            break;
-        default:
-            // Just reading payload and checksum (look these later)
-            if (byteIndex >= (messageLength - 1)) {
-                hasNewMessage = TRUE;
-            }
-    } // switch
-
-    byteIndex++;
-    return SUCCESS;
+static void readMessageSpan() {
+    const uint8_t *data;
+    uint16_t length, taken;
+
+    if (!UART_peekContiguous(gpsUartID, &data, &length))
+        return; // nothing new yet
+
+    taken = UbxParser_read(&ubxParser, data, length);
+    if (ubxParser.start >= 0)
+        messageTime = UART_getReceiveTime(gpsUartID, ubxParser.start);
+    UART_consume(gpsUartID, taken);
+
+    if (ubxParser.hasFrame) {
+        UbxConfig_handleFrame(&ubxConfig, &ubxParser);
+        hasNewMessage = TRUE;
+        // A checked packet means we see the GPS
+        setConnected();
+    }
 }
 
 /**********************************************************************
- * Function: parseMessageByte()
- * @return SUCCESS, FAILURE, or ERROR.
- * @remark Parses the payload fields of a newly received GPS message.
+ * Function: sendToGps
+ * @param UBX frame for the receiver.
+ * @param Length of the frame.
+ * @return Length if the frame was written, else 0.
+ * @remark For UbxConfig. Nothing is written unless the whole frame fits.
  **********************************************************************/
-static int8_t parseMessage() {
-    //for (byteIndex = 0; byteIndex < RAW_BUFFER_SIZE; byteIndex++) {
-
-    // interpret message by parsing payload fields
-    if (byteIndex < (messageLength - CHECKSUM_BYTES)) {
-        parsePayloadField(); // Processing payload field by field
-    }
-    /*
-    else if (byteIndex > (messageLength - CHECKSUM_BYTES) < messageLength) {
-        //if (verifyChecksum() != SUCCESS) return FAILURE;
-        startIdleState();
-        return SUCCESS;
-    }*/
-    else {
-        // Done parsing the message
-        hasNewMessage = FALSE;
-    }
+static uint16_t sendToGps(const uint8_t *frame, uint16_t length) {
+    return UART_write(gpsUartID, frame, length, UART_WRITE_REJECT, 0);
+}
 
-    return SUCCESS; // ready to parse next byte
+/**********************************************************************
+ * Function: isSentToGps
+ * @return TRUE once everything written to the receiver has gone out.
+ * @remark For UbxConfig, before changing the baud rate.
+ **********************************************************************/
+static bool isSentToGps() {
+    return UART_isTransmitEmpty(gpsUartID);
 }
 
+/**********************************************************************
+ * Function: setGpsBaudRate
+ * @param Baud rate to talk to the receiver at.
+ * @return None
+ * @remark For UbxConfig.
+ **********************************************************************/
+static void setGpsBaudRate(uint32_t baudRate) {
+#ifdef DEBUG
+    printf("Trying the GPS at %lu baud.\n", (unsigned long)baudRate);
+#endif
+    UART_setBaudRate(gpsUartID, baudRate);
+}
 
 /**********************************************************************
- * Function: parsePayloadField()
+ * Function: decodeMessage
  * @return None
- * @remark Parses one field of the payload for the new GPS message.
+ * @remark Decodes the payload of the checked message in the UBX parser,
+ *  all at once. A fix is replaced in the one call, so nothing else in the
+ *  main loop sees part of an old fix and part of a new one.
  **********************************************************************/
-static void parsePayloadField() {
+static void decodeMessage() {
+    uint8_t messageClass = ubxParser.frame[UBX_CLASS_INDEX];
+    uint8_t messageId = ubxParser.frame[UBX_ID_INDEX];
+#ifndef USE_GEOCENTRIC_COORDINATES
+    UbxNavPosllh posllh;
+    GeodeticCoordinate position;
+#else
+    UbxNavSol sol;
+    GeocentricCoordinate position;
+#endif
+    UbxNavStatus status;
+    UbxNavVelned velned;
+    UbxNavPvt pvt;
+
     switch (messageClass) {
         // #################### Navigation Message #######################
-        case NAV_CLASS:
+        case UBX_NAV_CLASS:
             switch (messageId) {
+                // ------------- NAV-PVT (0x01 0x07) --------------
+                case UBX_NAV_PVT_ID:
+                    if (!UbxParser_getPayload(&ubxParser, &pvt, sizeof(pvt)))
+                        break;
+                    gpsStatus = pvt.fixType;
+#ifndef USE_GEOCENTRIC_COORDINATES
+                    position.lat = GEODETIC_1E7_TO_DECIMAL(pvt.lat);
+                    position.lon = GEODETIC_1E7_TO_DECIMAL(pvt.lon);
+                    position.alt = MM_TO_M(pvt.hMsl);
+#else
+                    // ECEF is from the ellipsoid, in whole cm like NAV-SOL
+                    convertFixedGeodetic2ECEF(&position, pvt.lat, pvt.lon, pvt.height);
+#endif
+                    myCourse.northVelocity = MM_TO_CM(pvt.velN);
+                    myCourse.eastVelocity = MM_TO_CM(pvt.velE);
+                    myCourse.heading = pvt.headMot;
+                    if (GPS_hasFix()) {
+                        myPosition = position;
+                        fixTime = messageTime;
+                        hasPosition = TRUE;
+                    }
+                    else
+                        hasPosition = FALSE;
+                    startEpoch(pvt.iTow);
+                    epochFix.hAcc = pvt.hAcc;
+                    epochFix.vAcc = pvt.vAcc;
+                    epochFix.numSv = pvt.numSv;
+                    addEpochPart(EPOCH_POSITION | EPOCH_VELOCITY);
+                    break;
 #ifndef USE_GEOCENTRIC_COORDINATES
                 // ------------- NAV-POSLLH (0x01 0x02) --------------
-                case NAV_POSLLH_ID:
-                    switch (byteIndex - PAYLOAD_INDEX) {
-                        case 0: // iTow (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 4: // lon
-                            myPosition.lon = GEODETIC_1E7_TO_DECIMAL(
-                                    (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            //(int32_t)UNPACK_LITTLE_ENDIAN_32(rawMessage,byteIndex);
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 8: // lat
-                            myPosition.lat = GEODETIC_1E7_TO_DECIMAL(
-                                    (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 12: // height (not implemented)
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 16: // hMSL
-                            myPosition.alt = MM_TO_M(
-                                    (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            // copy to myPosition
-                            myPosition.lat = myTempPosition.lat;
-                            myPosition.lon = myTempPosition.lon;
-                            myPosition.alt = myTempPosition.alt;
-                            hasPosition = TRUE;
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 20: // hAcc (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 24: // vAcc (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                    } // NAV_POSLLH_ID byte
+                case UBX_NAV_POSLLH_ID:
+                    if (!UbxParser_getPayload(&ubxParser, &posllh, sizeof(posllh)))
+                        break;
+                    position.lat = GEODETIC_1E7_TO_DECIMAL(posllh.lat);
+                    position.lon = GEODETIC_1E7_TO_DECIMAL(posllh.lon);
+                    position.alt = MM_TO_M(posllh.hMsl);
+                    myPosition = position;
+                    fixTime = messageTime;
+                    hasPosition = TRUE;
+                    startEpoch(posllh.iTow);
+                    epochFix.hAcc = posllh.hAcc;
+                    epochFix.vAcc = posllh.vAcc;
+                    addEpochPart(EPOCH_POSITION);
                     break;
 #endif
                 // ------------- NAV-STATUS (0x01 0x03) --------------
-                case NAV_STATUS_ID:
-                    switch (byteIndex - PAYLOAD_INDEX) {
-                        case 0: // iTow (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 4: // gpsFix
-                            gpsStatus = rawMessage[byteIndex];
-                            if (!GPS_hasFix() && hasPosition)
-                                hasPosition = FALSE;
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 5: // flags (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 6: // diffStat (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 7: // res (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 8: // ttff (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 12: // msss (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                    } //  NAV_STATUS_ID byte
+                case UBX_NAV_STATUS_ID:
+                    if (!UbxParser_getPayload(&ubxParser, &status, sizeof(status)))
+                        break;
+                    gpsStatus = status.gpsFix;
+                    if (!GPS_hasFix() && hasPosition)
+                        hasPosition = FALSE;
+                    startEpoch(status.iTow);
                     break;
 #ifdef USE_GEOCENTRIC_COORDINATES
                 // ------------- NAV-SOL (0x01 0x06) --------------
-                case NAV_SOL_ID:
-                    switch (byteIndex - PAYLOAD_INDEX) {
-                        case 0: // iTow (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 4: // fTow (not implemented)
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 8: // week (not implemented)
-                            byteIndex += sizeof(int16_t);
-                            break;
-                        case 10: // gpsFix (not implemented -- see NAV_STATUS)
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 11: // flags (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                            break;
-                        case 12: // ecefX
-                            myTempPosition.x = CM_TO_M((int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 16: // ecefY
-                            myTempPosition.y = CM_TO_M((int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 20: // ecefZ
-                            myTempPosition.z = CM_TO_M((int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24)));
-                            // copy to myPosition
-                            myPosition.x = myTempPosition.x;
-                            myPosition.y = myTempPosition.y;
-                            myPosition.z = myTempPosition.z;
-                            hasPosition = TRUE;
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 24: // pAcc (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 28: // ecefVX (not implemented)
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 32: // ecefVY (not implemented)
-                            byteIndex += sizeof(int32_t);
-                        case 36: // ecefVZ (not implemented)
-                            byteIndex += sizeof(int32_t);
-                        case 40: // sAcc (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                        case 44: // pDOP (not implemented)
-                            byteIndex += sizeof(uint16_t);
-                        case 46: // res1 (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                        case 47: // numSV (not implemented)
-                            byteIndex += sizeof(uint8_t);
-                        case 48: // res2 (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                    } // NAV_SOL_ID byte
+                case UBX_NAV_SOL_ID:
+                    if (!UbxParser_getPayload(&ubxParser, &sol, sizeof(sol)))
+                        break;
+                    // gpsFix is left to NAV-STATUS
+                    position.x = sol.ecefX; // (cm) as sent
+                    position.y = sol.ecefY;
+                    position.z = sol.ecefZ;
+                    myPosition = position;
+                    fixTime = messageTime;
+                    hasPosition = TRUE;
+                    startEpoch(sol.iTow);
+                    epochFix.hAcc = sol.pAcc * 10; // 3D, in mm
+                    epochFix.vAcc = sol.pAcc * 10;
+                    epochFix.numSv = sol.numSv;
+                    addEpochPart(EPOCH_POSITION);
                     break;
 #endif
                 // ------------- NAV-VELNED (0x01 0x12) --------------
-                case NAV_VELOCITY_ID:
-                    switch (byteIndex - PAYLOAD_INDEX) {
-                        case 0: // iTow (not implemented)
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 4: // velN
-                            myCourse.northVelocity = (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 8: // velE
-                            myCourse.eastVelocity = (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 12: // velD
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 16: // speed
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 20: // gSpeed
-                            byteIndex += sizeof(uint32_t);
-                            break;
-                        case 24: // heading
-                            myCourse.heading = (int32_t)(rawMessage[byteIndex]
-                                    + ((int32_t)rawMessage[byteIndex + 1] << 8)
-                                    + ((int32_t)rawMessage[byteIndex + 2] << 16)
-                                    + ((int32_t)rawMessage[byteIndex + 3] << 24));
-                            byteIndex += sizeof(int32_t);
-                            break;
-                        case 28: // sAcc
-                            byteIndex += sizeof(uint32_t);
-                        case 32: // cAcc
-                            byteIndex += sizeof(uint32_t);
-                    } //  NAV_VELOCITY_ID byte
+                case UBX_NAV_VELNED_ID:
+                    if (!UbxParser_getPayload(&ubxParser, &velned, sizeof(velned)))
+                        break;
+                    myCourse.northVelocity = velned.velN;
+                    myCourse.eastVelocity = velned.velE;
+                    myCourse.heading = velned.heading;
+                    startEpoch(velned.iTow);
+                    addEpochPart(EPOCH_VELOCITY);
                     break;// ------------- End of Valid NAV message IDs --------------
                 default:
-                    byteIndex = messageLength; // skip rest of message
                 #ifdef DEBUG
                     printf("Received unhandled navigation message id: 0x%X.\n", messageId);
                     while (!Serial_isTransmitEmpty()) { asm("nop"); }
                 #endif
-            } // switch messageID = NAV_CLASS
+                    break;
+            } // switch messageID = UBX_NAV_CLASS
             break;
         // #################### End of NAV messages #######################
         default:
-            byteIndex = messageLength; // skip rest of message
         #ifdef DEBUG
             printf("Received unhandled message class: 0x%X.\n", messageClass);
             while (!Serial_isTransmitEmpty()) { asm("nop"); }
         #endif
+            break;
     } // switch messageClass
 }
 
-
-
-
-/*******************************************************************************
- * LIBRARY FUNCTIONS                                                           *
- ******************************************************************************/
-
-
-void convertGeodetic2ECEF(GeocentricCoordinate *ecef, GeodeticCoordinate *lla) {
-    float sinlat = sinf(DEGREE_TO_RADIAN*lla->lat);
-    float coslat = cosf(DEGREE_TO_RADIAN*lla->lat);
-
-    float rad_ne = R_EN / sqrt(1.0 - (ECC2 * sinlat * sinlat));
-    ecef->x = (rad_ne + lla->alt) * coslat * cosf(lla->lon*DEGREE_TO_RADIAN);
-    ecef->y = (rad_ne + lla->alt) * coslat * sinf(lla->lon*DEGREE_TO_RADIAN);
-    ecef->z = (rad_ne*(1.0 - ECC2) + lla->alt) * sinlat;
-}
-
-
-/**
- * Function: convertECEF2Geodetic
- * @param A pointer to a new geodetic position.
- * @param A pointer to an ECEF coordinate.
- * @return None.
- * @remark Converts the given ECEF coordinates into a geodetic coordinate in degrees.
- * @author David Goodman
- * @date 2013.03.10 */
-void convertECEF2Geodetic(GeodeticCoordinate *lla, GeocentricCoordinate *ecef) {
-    float x = ecef->x, y = ecef->y, z = ecef->z;
-
-    lla->lon = atan2f(y, x);
-
-    float rho = sqrtf((x*x) + (y*y));
-    if (rho < 0.1) rho = 0.1;
-
-    float beta = atan2f(z, (1.0 - FLATR) * rho);
-
-    lla->lat = atan2f(z + R_EM * ECCP2 * (sinf(beta)*sinf(beta)*sinf(beta)),
-        rho - R_EN * ECC2 * (cosf(beta)*cosf(beta)*cosf(beta)));
-
-    float betaNew = atan2f((1.0 - FLATR)*sinf(lla->lat), cosf(lla->lat));
-    int count = 0;
-    while (beta != betaNew && count < 5) {
-        beta = betaNew;
-        lla->lat = atan2f(z  + R_EM * ECCP2 * (sinf(beta)*sinf(beta)*sinf(beta)),
-            rho - R_EN * ECC2 * (cosf(beta)*cosf(beta)*cosf(beta)));
-
-        betaNew = atan2f((1.0 - FLATR)*sinf(lla->lat), cosf(lla->lat));
-        count++;
-    }
-
-    float sinlat = sinf(lla->lat);
-    float rad_ne = R_EN / sqrtf(1.0 - (ECC2 * sinlat * sinlat));
-
-    lla->alt = rho * cosf(lla->lat) + (z + ECC2 * rad_ne * sinlat) * sinlat - rad_ne;
-
-    // Convert radian geodetic to degrees
-    lla->lat = lla->lat * RADIAN_TO_DEGREE;
-    lla->lon = lla->lon * RADIAN_TO_DEGREE;
-}
-
-
-
-void convertECEF2NED(LocalCoordinate *ned, GeocentricCoordinate *ecef_cur,
-    GeocentricCoordinate *ecef_ref, GeodeticCoordinate *geo_ref) {
-    GeocentricCoordinate ecef_path;
-    ecef_path.x = ecef_cur->x - ecef_ref->x;
-    ecef_path.y = ecef_cur->y - ecef_ref->y;
-    ecef_path.z = ecef_cur->z - ecef_ref->z;
-
-    float cosLat = cosf(geo_ref->lat * DEGREE_TO_RADIAN);
-    float sinLat = sinf(geo_ref->lat * DEGREE_TO_RADIAN);
-    float cosLon = cosf(geo_ref->lon * DEGREE_TO_RADIAN);
-    float sinLon = sinf(geo_ref->lon * DEGREE_TO_RADIAN);
-
-    // Offset vector from reference and rotate
-    float t =  cosLon * ecef_path.x + sinLon * ecef_path.y;
-
-    ned->north = -sinLat * t + cosLat * ecef_path.z;
-    ned->east = -sinLon * ecef_path.x + cosLon * ecef_path.y;
-    ned->down = -(cosLat * t + sinLat * ecef_path.z);
-    //ned->down = 0;
-}
-
-
-void projectEulerToNED(LocalCoordinate *ned, float yaw, float pitch, float height) {
-    //printf("At angle: %.3f and pitch: %.3f\n",yaw,pitch);
-
-    float mag = height * tan((90.0-pitch)*DEGREE_TO_RADIAN);
-    #ifdef DEBUG
-    printf("\tMagnitude: %.3f\n",mag);
-    #endif
-
-    //printf("At mag: %.3f\n",mag);
-
-    if (yaw <= 90.0) {
-        //First quadrant
-        ned->north = mag * cosf(yaw*DEGREE_TO_RADIAN);
-        ned->east = mag * sinf(yaw*DEGREE_TO_RADIAN);
-    }
-    else if (yaw > 90.0 && yaw <= 180.0) {
-        // Second quadrant
-        yaw = yaw - 270.0;
-        ned->north = mag * sinf(yaw*DEGREE_TO_RADIAN);
-        ned->east = -mag * cosf(yaw*DEGREE_TO_RADIAN);
-    }
-    else if (yaw > 180.0 && yaw <= 270.0) {
-        // Third quadrant
-        yaw = yaw - 180.0;
-        ned->north = -mag * cosf(yaw*DEGREE_TO_RADIAN);
-        ned->east = -mag * sinf(yaw*DEGREE_TO_RADIAN);
-    }
-    else if (yaw > 270 < 360.0) {
-        // Fourth quadrant
-        yaw = yaw - 90.0;
-        ned->north = -mag * sinf(yaw*DEGREE_TO_RADIAN);
-        ned->east = mag * cosf(yaw*DEGREE_TO_RADIAN);
-    }
-
-    ned->down = height;
-    //printf("Desired coordinate -- N:%.2f, E: %.2f, D: %.2f (m)\n",
-    //    ned->north, ned->east, ned->down);
+/**********************************************************************
+ * Function: startEpoch
+ * @param GPS time of week of the message being decoded.
+ * @return None
+ * @remark Starts a new fix in epochFix if the message is from a new
+ *  navigation solution, dropping whatever part of the last one was left.
+ **********************************************************************/
+static void startEpoch(uint32_t iTow) {
+    if (epochParts != 0 && epochFix.iTow == iTow)
+        return;
+    epochFix.iTow = iTow;
+    epochFix.hAcc = 0;
+    epochFix.vAcc = 0;
+    epochFix.numSv = 0;
+    epochParts = 0;
 }
 
-
-void getCourseVector(CourseVector *course, LocalCoordinate *ned_cur,
-        LocalCoordinate *ned_des) {
-    LocalCoordinate ned_path;
-    ned_path.north = ned_des->north - ned_cur->north;
-    ned_path.east = ned_des->east - ned_cur->east;
-    //ned_path.down = ned_des->down - ned_cur->down;
-
-    // Calculate heading (in degrees from North) of path
-    if (ned_path.north > 0.0 && ned_path.east > 0.0) {
-        course->heading = atanf(fabsf(ned_path.east)/fabsf(ned_path.north))*RADIAN_TO_DEGREE;
-    }
-    else if (ned_path.north < 0.0 && ned_path.east > 0.0) {
-        course->heading = atanf(fabsf(ned_path.north)/fabsf(ned_path.east))*RADIAN_TO_DEGREE;
-        course->heading += 90.0;
-    }
-    else if (ned_path.north < 0.0 && ned_path.east< 0.0) {
-        course->heading = atanf(fabsf(ned_path.east)/fabsf(ned_path.north))*RADIAN_TO_DEGREE;
-        course->heading += 180.0;
+/**********************************************************************
+ * Function: addEpochPart
+ * @param Part of the fix that was just decoded, e.g. EPOCH_POSITION.
+ * @return None
+ * @remark Copies the part from myPosition or myCourse, and adds the fix
+ *  to the history once it has both, if the receiver has a fix.
+ **********************************************************************/
+static void addEpochPart(uint8_t part) {
+    if (part & EPOCH_POSITION) {
+        epochFix.position = myPosition;
+        epochFix.time = messageTime;
     }
-    else if (ned_path.north > 0.0 && ned_path.east< 0.0) {
-        course->heading = atanf(fabsf(ned_path.north)/fabsf(ned_path.east))*RADIAN_TO_DEGREE;
-        course->heading += 270.0;
+    if (part & EPOCH_VELOCITY) {
+        epochFix.northVelocity = myCourse.northVelocity;
+        epochFix.eastVelocity = myCourse.eastVelocity;
+        epochFix.heading = myCourse.heading;
     }
-
-    // Calculate distance to point
-    course->distance = sqrtf((ned_path.north)*(ned_path.north) + (ned_path.east)*(ned_path.east));
-
+    epochParts |= part;
+    if ((epochParts & (EPOCH_POSITION | EPOCH_VELOCITY)) != (EPOCH_POSITION | EPOCH_VELOCITY)
+            || (epochParts & EPOCH_ADDED) || !GPS_hasFix())
+        return;
+    epochFix.fixType = gpsStatus;
+    GpsHistory_add(&history, &epochFix);
+    epochParts |= EPOCH_ADDED;
 }
 
 
 
 
-
-
 /****************************** TESTS ************************************/
 // Test harness that spits out GPS packets over the serial port
 //#define GPS_TEST
@@ -860,8 +685,8 @@ int main() {
 #else
                 GeocentricCoordinate ecefPos;
                 GPS_getPosition(&ecefPos);
-                printf("Position: x=%.2f, y=%.2f, z=%.2f (m)\n", ecefPos.x,
-                    ecefPos.y, ecefPos.z);
+                printf("Position: x=%ld, y=%ld, z=%ld (cm)\n", (long)ecefPos.x,
+                    (long)ecefPos.y, (long)ecefPos.z);
 #endif
                 
                 printf("Velocity: %.2f (m/s), Heading: %.2f (deg)\n",
@@ -870,6 +695,14 @@ int main() {
             else {
                 printf("No fix!\n");
             }
+            const GpsStatistics *stats = GPS_getStatistics();
+            printf("Frames: %u good, %u bad, %u resync bytes\n",
+                stats->frames, stats->checksumErrors, stats->resyncBytes);
+            const GpsFix *fix = GPS_getLatestFix();
+            if (fix != NULL)
+                printf("Fix: iTow=%u, age=%u ms, hAcc=%u mm, %u satellites%s\n",
+                    fix->iTow, get_time() - fix->time, fix->hAcc, fix->numSv,
+                    GPS_isFixUsable(fix, 1000, 5000) ? "" : " (not usable)");
 
             Timer_new(TIMER_TEST,1000);
         }
@@ -915,8 +748,8 @@ int main() {
 #else
                 GeocentricCoordinate ecefPos;
                 GPS_getPosition(&ecefPos);
-                printf("GPS Position: x=%.2f, y=%.2f, z=%.2f (m)\n", ecefPos.x,
-                    ecefPos.y, ecefPos.z);
+                printf("GPS Position: x=%ld, y=%ld, z=%ld (cm)\n", (long)ecefPos.x,
+                    (long)ecefPos.y, (long)ecefPos.z);
 #endif
 
                 printf("\tVelocity: %.2f (m/s), Heading: %.2f (deg)\n",
@@ -961,10 +794,10 @@ int main() {
     timer = get_time();
     convertGeodetic2ECEF(&ecef1, &lla1);
     timer = get_time() - timer;
-    printf("\t x = %.2f, y = %.2f, z = %.1f [m]\n",ecef1.x,ecef1.y,ecef1.z);
-    const char *result1 = ( (ecef1.x < (-1854786.87f + 1.0) && ecef1.x > (-1854786.87f - 1.0))
-        && (ecef1.y < (2921286.75f + 1.0) && ecef1.y > (2921286.75f - 1.0))
-        && (ecef1.z < (5339891.0f + 1.0) && ecef1.z > (5339891.0f - 1.0)))?
+    printf("\t x = %ld, y = %ld, z = %ld [cm]\n",(long)ecef1.x,(long)ecef1.y,(long)ecef1.z);
+    const char *result1 = ( (ecef1.x < (-185478687 + 100) && ecef1.x > (-185478687 - 100))
+        && (ecef1.y < (292128675 + 100) && ecef1.y > (292128675 - 100))
+        && (ecef1.z < (533989100 + 100) && ecef1.z > (533989100 - 100)))?
             "Passed" : "Failed";
     printf("\t %s -- Elapsed: %d [ms]\n\n", result1, timer);
 
@@ -974,23 +807,23 @@ int main() {
     GeocentricCoordinate ecef2_cur, ecef2_ref;
     GeodeticCoordinate lla2_ref;
     LocalCoordinate ned2;
-    // boat location (m)
-    ecef2_cur.x = -1854793.0f;
-    ecef2_cur.y = 2921293.00f;
-    ecef2_cur.z = 5339865.0f;
-    // command center location (m and deg)
-    ecef2_ref.x = -1854786.87f;
-    ecef2_ref.y = 2921286.75f;
-    ecef2_ref.z = 5339891.0f;
+    // boat location (cm)
+    ecef2_cur.x = -185479300;
+    ecef2_cur.y = 292129300;
+    ecef2_cur.z = 533986500;
+    // command center location (cm and deg)
+    ecef2_ref.x = -185478687;
+    ecef2_ref.y = 292128675;
+    ecef2_ref.z = 533989100;
     lla2_ref.lat = 57.23125421f;
     lla2_ref.lon = 122.412334f;
     lla2_ref.alt = 10.0f;
 
     printf("Converting ECEF to NED...\n");
-    printf("\t Reference: Lat = %.6f, lon = %.6f [deg]\n\t\t x = %.2f, y = %.2f, z = %2.f [m]\n",
-        lla2_ref.lat,lla2_ref.lon,ecef2_ref.x, ecef2_ref.y, ecef2_ref.z );
-    printf("\t Current: x = %.2f, y = %.2f, z = %2.f [m]\n",
-        ecef2_cur.x, ecef2_cur.y, ecef2_cur.z );
+    printf("\t Reference: Lat = %.6f, lon = %.6f [deg]\n\t\t x = %ld, y = %ld, z = %ld [cm]\n",
+        lla2_ref.lat,lla2_ref.lon,(long)ecef2_ref.x, (long)ecef2_ref.y, (long)ecef2_ref.z );
+    printf("\t Current: x = %ld, y = %ld, z = %ld [cm]\n",
+        (long)ecef2_cur.x, (long)ecef2_cur.y, (long)ecef2_cur.z );
     timer = get_time();
     convertECEF2NED(&ned2, &ecef2_cur, &ecef2_ref, &lla2_ref);
     timer = get_time() - timer;
@@ -1002,22 +835,47 @@ int main() {
     printf("\t %s -- Elapsed: %d [ms]\n\n", result2, timer);
 
 
+    // convertECEF2LocalNED, with the rotation worked out once
+    DELAY(10);
+    LocalOrigin origin2;
+    LocalCoordinate ned2_local;
+    uint32_t ticks, localTicks;
+
+    printf("Converting ECEF to NED from a local origin...\n");
+    setLocalOrigin(&origin2, &ecef2_ref);
+    ticks = ReadCoreTimer();
+    convertECEF2NED(&ned2, &ecef2_cur, &ecef2_ref, &lla2_ref);
+    ticks = ReadCoreTimer() - ticks;
+    localTicks = ReadCoreTimer();
+    convertECEF2LocalNED(&ned2_local, &ecef2_cur, &origin2);
+    localTicks = ReadCoreTimer() - localTicks;
+    printf("\t N = %.3f, E = %.3f, D = %.3f [m]\n",
+        ned2_local.north,ned2_local.east,ned2_local.down);
+    const char *result2b = ( (ned2_local.north < (ned2.north + 0.01) && ned2_local.north > (ned2.north - 0.01))
+        && (ned2_local.east < (ned2.east + 0.01) && ned2_local.east > (ned2.east - 0.01))
+        && (ned2_local.down < (ned2.down + 0.01) && ned2_local.down > (ned2.down - 0.01)))?
+            "Passed" : "Failed";
+    // Core timer counts every other cycle
+    printf("\t %s -- Cycles: %lu, was %lu\n\n", result2b,
+        (unsigned long)localTicks * 2, (unsigned long)ticks * 2);
+
+
      // convertECEF2LLA
     DELAY(10);
     GeocentricCoordinate ecef3_cur;
     GeodeticCoordinate lla3_cur, lla3_want;
-    // boat location (m)
-    ecef3_cur.x = -2707517.0f;
-    ecef3_cur.y = -4323806.0f;
-    ecef3_cur.z = 3815467.0f;
+    // boat location (cm)
+    ecef3_cur.x = -270751700;
+    ecef3_cur.y = -432380600;
+    ecef3_cur.z = 381546700;
     /* should read: */
     lla3_want.lat = 36.977624f;
     lla3_want.lon = -122.054318f;
     lla3_want.alt = 95.5f;
 
     printf("Converting ECEF to LLA...\n");
-    printf("\t Current: x = %.2f, y = %.2f, z = %2.f [m]\n",
-        ecef3_cur.x, ecef3_cur.y, ecef3_cur.z );
+    printf("\t Current: x = %ld, y = %ld, z = %ld [cm]\n",
+        (long)ecef3_cur.x, (long)ecef3_cur.y, (long)ecef3_cur.z );
     timer = get_time();
     convertECEF2Geodetic(&lla3_cur, &ecef3_cur);
     timer = get_time() - timer;
@@ -1105,8 +963,8 @@ int main() {
             else if (GPS_hasFix() && GPS_hasPosition()) {
                 GeocentricCoordinate ecefPos;
                 GPS_getPosition(&ecefPos);
-                printf("Position: x=%.2f, y=%.2f, z=%.2f (m)\n", ecefPos.x,
-                    ecefPos.y, ecefPos.z);
+                printf("Position: x=%ld, y=%ld, z=%ld (cm)\n", (long)ecefPos.x,
+                    (long)ecefPos.y, (long)ecefPos.z);
 
                 printf("Velocity: %.2f (m/s), Heading: %.2f (deg)\n",
                     GPS_getVelocity(), GPS_getHeading());
@@ -1158,8 +1016,8 @@ int main() {
             else if (GPS_hasFix() && GPS_hasPosition()) {
                 GeocentricCoordinate ecefPos;
                 GPS_getPosition(&ecefPos);
-                printf("Position: x=%.2f, y=%.2f, z=%.2f (m)\n", ecefPos.x,
-                    ecefPos.y, ecefPos.z);
+                printf("Position: x=%ld, y=%ld, z=%ld (cm)\n", (long)ecefPos.x,
+                    (long)ecefPos.y, (long)ecefPos.z);
 
                 printf("Velocity: %.2f (m/s), Heading: %.2f (deg)\n",
                     GPS_getVelocity(), GPS_getHeading());
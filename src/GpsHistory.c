@@ -0,0 +1,230 @@
+/**********************************************************************
+ Module
+   GpsHistory.c
+
+ Author: David Goodman
+
+ Description
+    Ring buffer of the last GPS fixes (see GpsHistory.h).
+
+ Notes
+    Fixes are found by age, where 0 is the newest, so the search doesn't
+    have to care where the ring wraps. Local times are compared by their
+    signed difference, so they work across the wrap of get_time, and GPS
+    times by their difference within half a week.
+
+    Geodetic longitudes are interpolated without wrapping at 180 degrees,
+    which the boat is nowhere near.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "GpsHistory.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define HEADING_FULL_CIRCLE     36000000L // (1e-5 deg)
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static bool findFix(const GpsHistory *history, uint32_t target, bool byTow,
+    GpsFix *fix);
+static const GpsFix *getFixByAge(const GpsHistory *history, uint8_t age);
+static int32_t getDifference(const GpsFix *fix, uint32_t target, bool byTow);
+static int32_t getTowDifference(uint32_t iTow, uint32_t otherTow);
+static void interpolateFix(const GpsFix *before, const GpsFix *after,
+    float fraction, GpsFix *fix);
+static int32_t interpolateInt(int32_t before, int32_t after, float fraction);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void GpsHistory_init(GpsHistory *history) {
+    history->latest = 0;
+    history->count = 0;
+}
+
+void GpsHistory_add(GpsHistory *history, const GpsFix *fix) {
+    if (history->count > 0
+            && getTowDifference(fix->iTow, history->fixes[history->latest].iTow) <= 0)
+        GpsHistory_init(history); // out of order, so start over
+
+    if (history->count > 0)
+        history->latest = (history->latest + 1) % GPS_HISTORY_LENGTH;
+    history->fixes[history->latest] = *fix;
+    if (history->count < GPS_HISTORY_LENGTH)
+        history->count++;
+}
+
+const GpsFix *GpsHistory_getLatest(const GpsHistory *history) {
+    if (history->count == 0)
+        return NULL;
+    return &history->fixes[history->latest];
+}
+
+bool GpsHistory_getAt(const GpsHistory *history, uint32_t time, GpsFix *fix) {
+    return findFix(history, time, false, fix);
+}
+
+bool GpsHistory_getAtTow(const GpsHistory *history, uint32_t iTow, GpsFix *fix) {
+    return findFix(history, iTow, true, fix);
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: findFix
+ * @param History.
+ * @param Local time, or GPS time of week.
+ * @param TRUE if the target is a GPS time of week.
+ * @param Fix to copy the result into.
+ * @return TRUE if the target is between the oldest and newest fixes.
+ * @remark Binary search for the newest fix at or before the target.
+ **********************************************************************/
+static bool findFix(const GpsHistory *history, uint32_t target, bool byTow,
+        GpsFix *fix) {
+    uint8_t low = 0, high, middle;
+    const GpsFix *before, *after;
+    int32_t beforeDifference, afterDifference;
+
+    if (history->count == 0)
+        return false;
+    high = history->count - 1;
+    if (getDifference(getFixByAge(history, 0), target, byTow) < 0
+            || getDifference(getFixByAge(history, high), target, byTow) > 0)
+        return false;
+
+    // Fixes get older with age, so their differences get smaller
+    while (low < high) {
+        middle = (low + high) / 2;
+        if (getDifference(getFixByAge(history, middle), target, byTow) <= 0)
+            high = middle;
+        else
+            low = middle + 1;
+    }
+
+    before = getFixByAge(history, low);
+    beforeDifference = getDifference(before, target, byTow);
+    if (beforeDifference == 0) {
+        *fix = *before;
+        return true;
+    }
+    after = getFixByAge(history, low - 1);
+    afterDifference = getDifference(after, target, byTow);
+    interpolateFix(before, after, (float)-beforeDifference
+        / (float)(afterDifference - beforeDifference), fix);
+    return true;
+}
+
+/**********************************************************************
+ * Function: getFixByAge
+ * @param History.
+ * @param Age, from 0 for the newest fix to count - 1.
+ * @return The fix.
+ **********************************************************************/
+static const GpsFix *getFixByAge(const GpsHistory *history, uint8_t age) {
+    return &history->fixes[(history->latest + GPS_HISTORY_LENGTH - age)
+        % GPS_HISTORY_LENGTH];
+}
+
+/**********************************************************************
+ * Function: getDifference
+ * @param Fix.
+ * @param Local time, or GPS time of week.
+ * @param TRUE if the target is a GPS time of week.
+ * @return Milliseconds from the target to the fix, negative if the fix
+ *  is earlier.
+ **********************************************************************/
+static int32_t getDifference(const GpsFix *fix, uint32_t target, bool byTow) {
+    if (byTow)
+        return getTowDifference(fix->iTow, target);
+    return (int32_t)(fix->time - target);
+}
+
+/**********************************************************************
+ * Function: getTowDifference
+ * @param GPS time of week.
+ * @param Another GPS time of week.
+ * @return Milliseconds from the second to the first, within half a week.
+ **********************************************************************/
+static int32_t getTowDifference(uint32_t iTow, uint32_t otherTow) {
+    int32_t difference = (int32_t)(iTow - otherTow);
+    if (difference > (int32_t)(GPS_WEEK_MS / 2))
+        difference -= GPS_WEEK_MS;
+    else if (difference < -(int32_t)(GPS_WEEK_MS / 2))
+        difference += GPS_WEEK_MS;
+    return difference;
+}
+
+/**********************************************************************
+ * Function: interpolateFix
+ * @param Fix before.
+ * @param Fix after.
+ * @param Fraction of the way from before to after, 0 to 1.
+ * @param Fix to save the result into.
+ * @return None.
+ * @remark The heading goes the short way around. Accuracies, satellites
+ *  and fix type are the worse of the two.
+ **********************************************************************/
+static void interpolateFix(const GpsFix *before, const GpsFix *after,
+        float fraction, GpsFix *fix) {
+    int32_t turn = after->heading - before->heading;
+
+    fix->iTow = before->iTow + interpolateInt(0,
+        getTowDifference(after->iTow, before->iTow), fraction);
+    if (fix->iTow >= GPS_WEEK_MS)
+        fix->iTow -= GPS_WEEK_MS;
+    fix->time = before->time + interpolateInt(0,
+        (int32_t)(after->time - before->time), fraction);
+#ifdef USE_GEOCENTRIC_COORDINATES
+    fix->position.x = interpolateInt(before->position.x, after->position.x, fraction);
+    fix->position.y = interpolateInt(before->position.y, after->position.y, fraction);
+    fix->position.z = interpolateInt(before->position.z, after->position.z, fraction);
+#else
+    fix->position.lat = before->position.lat + (after->position.lat - before->position.lat) * fraction;
+    fix->position.lon = before->position.lon + (after->position.lon - before->position.lon) * fraction;
+    fix->position.alt = before->position.alt + (after->position.alt - before->position.alt) * fraction;
+#endif
+    fix->northVelocity = interpolateInt(before->northVelocity, after->northVelocity, fraction);
+    fix->eastVelocity = interpolateInt(before->eastVelocity, after->eastVelocity, fraction);
+
+    if (turn > HEADING_FULL_CIRCLE / 2)
+        turn -= HEADING_FULL_CIRCLE;
+    else if (turn < -HEADING_FULL_CIRCLE / 2)
+        turn += HEADING_FULL_CIRCLE;
+    fix->heading = before->heading + interpolateInt(0, turn, fraction);
+    if (fix->heading < 0)
+        fix->heading += HEADING_FULL_CIRCLE;
+    else if (fix->heading >= HEADING_FULL_CIRCLE)
+        fix->heading -= HEADING_FULL_CIRCLE;
+
+    fix->hAcc = (before->hAcc > after->hAcc) ? before->hAcc : after->hAcc;
+    fix->vAcc = (before->vAcc > after->vAcc) ? before->vAcc : after->vAcc;
+    fix->numSv = (before->numSv < after->numSv) ? before->numSv : after->numSv;
+    fix->fixType = (before->fixType < after->fixType) ? before->fixType : after->fixType;
+}
+
+/**********************************************************************
+ * Function: interpolateInt
+ * @param Value before.
+ * @param Value after.
+ * @param Fraction of the way from before to after, 0 to 1.
+ * @return Rounded value between them.
+ **********************************************************************/
+static int32_t interpolateInt(int32_t before, int32_t after, float fraction) {
+    float difference = (float)(after - before) * fraction;
+    return before + (int32_t)(difference + ((difference < 0) ? -0.5f : 0.5f));
+}
@@ -13,6 +13,7 @@
  When                   Who         What/Why
  --------------         ---         --------
  5-1-13 2:10  PM      jash        Created file.
+ 10-18-26               dagoodma    Show link statistics.
 ***********************************************************************/
 //#define DEBUG
 
@@ -20,12 +21,14 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <plib.h>
 #include "ports.h"
 #include "Board.h"
 #include "Timer.h"
 #include "Interface.h"
 #include "Lcd.h"
+#include "LinkStats.h"
 #include "Error.h"
 #include "Accelerometer.h"
 #include "Magnetometer.h"
@@ -77,6 +80,7 @@
  **********************************************************************/
 
 static void showMessage(message_t msgCode);
+static char *padLine(char *line);
 
 /**********************************************************************
  * PRIVATE VARIABLES                                                  *
@@ -572,6 +576,32 @@ void Interface_showBoatErrorMessage(error_t errorCode) {
     currentMsgCode = errorCode;
 }
 
+/**********************************************************************
+ * Function: Interface_showLinkStats
+ * @param Link statistics to print.
+ * @return None.
+ * @remark Prints the link statistics on the last two lines, under the
+ *  ready message. Values too long for a line are cut short.
+ **********************************************************************/
+void Interface_showLinkStats(const LinkStats *stats) {
+    char line[LCD_LINE_LENGTH + 1];
+    if (currentMsgCode != READY_MESSAGE || Timer_isActive(TIMER_LCD_HOLD))
+        return;
+
+    if (stats->rttCount > 0)
+        snprintf(line, sizeof(line), "RTT %u/%u/%ums", stats->rttMin,
+            stats->rttAverage, stats->rttMax);
+    else
+        snprintf(line, sizeof(line), "RTT --");
+    LCD_setPosition(2,0);
+    LCD_writeString(padLine(line));
+
+    snprintf(line, sizeof(line), "%u.%u%% %ucrc %uB/s", stats->lossRate / 10,
+        stats->lossRate % 10, stats->crcErrorCount, stats->bytesInRate);
+    LCD_setPosition(3,0);
+    LCD_writeString(padLine(line));
+}
+
 /**********************************************************************
  * Function: Interface_clearAll
  * @param None.
@@ -618,6 +648,21 @@ static void showMessage(message_t msgCode){
     currentMsgCode = msgCode;
 }
 
+/**********************************************************************
+ * Function: padLine
+ * @param String of up to LCD_LINE_LENGTH characters.
+ * @return The string.
+ * @remark Pads the string with spaces to a full line, to write over the
+ *  last one.
+ **********************************************************************/
+static char *padLine(char *line) {
+    uint8_t i = strlen(line);
+    for (; i < LCD_LINE_LENGTH; i++)
+        line[i] = ' ';
+    line[LCD_LINE_LENGTH] = '\0';
+    return line;
+}
+
 /**********************************************************************
  * Function: getMessage
  * @param None.
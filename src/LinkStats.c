@@ -0,0 +1,201 @@
+/**********************************************************************
+ Module
+   LinkStats.c
+
+ Author: David Goodman
+
+ Description
+    Round trip time, loss and rates of the XBee link (see LinkStats.h).
+
+ Notes
+    The round trip is the arrival of the echoing heartbeat, less the time
+    we sent ours and how long the other end held it. It includes the time
+    both heartbeats waited in the scheduler and the UART, which is what
+    other frames of the same priority wait too.
+
+    The frame count in a heartbeat is taken when it is packed, and covers
+    frames written before it. Frames received are counted up to and
+    including the heartbeat, so both sides of a difference count exactly
+    one heartbeat. Frames written between packing a heartbeat and sending
+    it arrive ahead of the count they are in, so a surplus is carried to
+    the next heartbeat rather than counting them lost there.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "LinkStats.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define MAX_RATE            UINT16_MAX
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static void addRtt(LinkStats *stats, uint16_t rtt);
+static void countPeerFrames(LinkStats *stats, uint16_t framesSent);
+static uint16_t getRate(uint32_t count, uint32_t elapsed);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void LinkStats_init(LinkStats *stats) {
+    memset(stats, 0, sizeof(LinkStats));
+}
+
+void LinkStats_received(LinkStats *stats, uint16_t length) {
+    stats->framesReceived++;
+    stats->bytesIn += length;
+    stats->windowBytesIn += length;
+}
+
+void LinkStats_sent(LinkStats *stats, uint16_t length) {
+    stats->framesSent++;
+    stats->bytesOut += length;
+    stats->windowBytesOut += length;
+}
+
+void LinkStats_fillHeartbeat(LinkStats *stats, mavlink_heartbeat_t *heartbeat,
+        uint32_t time) {
+    uint32_t held = time - stats->peerArrival;
+    heartbeat->time = time;
+    heartbeat->framesSent = (uint16_t)stats->framesSent;
+    if (stats->hasPeerTime && held < LINK_STATS_NO_ECHO) {
+        heartbeat->echoTime = stats->peerTime;
+        heartbeat->echoDelay = (uint16_t)held;
+    }
+    else {
+        heartbeat->echoTime = 0;
+        heartbeat->echoDelay = LINK_STATS_NO_ECHO;
+    }
+}
+
+bool LinkStats_handleHeartbeat(LinkStats *stats, const mavlink_heartbeat_t *heartbeat,
+        uint32_t arrival) {
+    int32_t rtt;
+
+    stats->peerTime = heartbeat->time;
+    stats->peerArrival = arrival;
+    stats->hasPeerTime = true;
+    countPeerFrames(stats, heartbeat->framesSent);
+
+    if (heartbeat->echoDelay == LINK_STATS_NO_ECHO)
+        return false;
+    rtt = (int32_t)(arrival - heartbeat->echoTime - heartbeat->echoDelay);
+    if (rtt < 0 || rtt > LINK_STATS_MAX_RTT)
+        return false; // from before a reset, or garbled
+    addRtt(stats, (uint16_t)rtt);
+    return true;
+}
+
+void LinkStats_runSM(LinkStats *stats, uint32_t crcErrors, uint32_t time) {
+    uint32_t elapsed;
+
+    stats->windowCrcErrors += crcErrors - stats->crcErrors;
+    stats->crcErrors = crcErrors;
+    if (!stats->hasWindow) {
+        stats->windowStart = time;
+        stats->hasWindow = true;
+        return;
+    }
+    elapsed = time - stats->windowStart;
+    if (elapsed < LINK_STATS_WINDOW)
+        return;
+
+    stats->lossRate = (stats->windowPeerSent > 0) ?
+        (uint16_t)((stats->windowLost * 1000) / stats->windowPeerSent) : 0;
+    stats->crcErrorCount = (stats->windowCrcErrors > UINT16_MAX) ?
+        UINT16_MAX : (uint16_t)stats->windowCrcErrors;
+    stats->bytesInRate = getRate(stats->windowBytesIn, elapsed);
+    stats->bytesOutRate = getRate(stats->windowBytesOut, elapsed);
+
+    stats->windowStart = time;
+    stats->windowPeerSent = 0;
+    stats->windowLost = 0;
+    stats->windowBytesIn = 0;
+    stats->windowBytesOut = 0;
+    stats->windowCrcErrors = 0;
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: addRtt
+ * @param Statistics.
+ * @param Round trip time (ms).
+ * @return None.
+ * @remark Replaces the oldest sample and works out min, average and max.
+ **********************************************************************/
+static void addRtt(LinkStats *stats, uint16_t rtt) {
+    uint32_t total = 0;
+    uint8_t i;
+
+    stats->rttSamples[stats->rttNext] = rtt;
+    stats->rttNext = (stats->rttNext + 1) % LINK_STATS_RTT_SAMPLES;
+    if (stats->rttCount < LINK_STATS_RTT_SAMPLES)
+        stats->rttCount++;
+
+    stats->rttMin = stats->rttMax = rtt;
+    for (i = 0; i < stats->rttCount; i++) {
+        total += stats->rttSamples[i];
+        if (stats->rttSamples[i] < stats->rttMin)
+            stats->rttMin = stats->rttSamples[i];
+        if (stats->rttSamples[i] > stats->rttMax)
+            stats->rttMax = stats->rttSamples[i];
+    }
+    stats->rttAverage = (uint16_t)((total + stats->rttCount / 2) / stats->rttCount);
+}
+
+/**********************************************************************
+ * Function: countPeerFrames
+ * @param Statistics.
+ * @param Frame count from a heartbeat.
+ * @return None.
+ * @remark Frames the other end sent since its last heartbeat that we got,
+ *  less the ones that arrived, were lost. A lost heartbeat only makes the
+ *  next difference longer.
+ **********************************************************************/
+static void countPeerFrames(LinkStats *stats, uint16_t framesSent) {
+    uint16_t sent, received;
+    int32_t lost;
+    if (stats->hasPeerCount) {
+        sent = framesSent - stats->peerFramesSent;
+        received = (uint16_t)(stats->framesReceived - stats->receivedAtPeerCount);
+        stats->windowPeerSent += sent;
+        lost = (int32_t)sent - received - stats->frameSurplus;
+        if (lost > 0) {
+            stats->windowLost += lost;
+            stats->framesLost += lost;
+            stats->frameSurplus = 0;
+        }
+        else {
+            stats->frameSurplus = -lost;
+        }
+    }
+    stats->peerFramesSent = framesSent;
+    stats->receivedAtPeerCount = stats->framesReceived;
+    stats->hasPeerCount = true;
+}
+
+/**********************************************************************
+ * Function: getRate
+ * @param Count over a window.
+ * @param Length of the window (ms).
+ * @return Count per second.
+ **********************************************************************/
+static uint16_t getRate(uint32_t count, uint32_t elapsed) {
+    uint32_t rate = (uint32_t)(((uint64_t)count * 1000) / elapsed);
+    return (rate > MAX_RATE) ? MAX_RATE : (uint16_t)rate;
+}
@@ -44,8 +44,6 @@
 /*******************************************************************************
  * PRIVATE FUNCTIONS PROTOTYPES                                                *
  ******************************************************************************/
-static bool hasNewByte();
-static uint8_t readByte();
 static void resetLogger();
 
 /*******************************************************************************
@@ -78,25 +76,28 @@ char Logger_init() {
 
     /* Clear the buffer until we get the UART initialized message
         or until timeout. */
-    uint16_t in; uint8_t index = 0;
+    const uint8_t *data;
+    uint16_t length, i;
+    uint8_t index = 0;
     Timer_new(TIMER_LOGGER, STARTUP_TIMEOUT_DELAY);
     resetLogger();
     while (index < STARTUP_CHARACTERS) {
-        while (((char)in) != expect[index]) {
-            if (hasNewByte()) {
-                in = readByte();
-                while (!Serial_isTransmitEmpty()) { asm("nop"); }
-                //printf("Got %x\n", in);
-            }
-            if (Timer_isExpired(TIMER_LOGGER)) {
-                #ifdef DEBUG
-                printf("Logger failed initializing %s.\n", error[index]);
-                #endif
-                return FAILURE;
+        // Scan the received span in place for the expected characters
+        if (UART_peekContiguous(LOGGER_UART_ID, &data, &length)) {
+            for (i = 0; i < length && index < STARTUP_CHARACTERS; i++) {
+                if ((char)data[i] == expect[index]) {
+                    Timer_new(TIMER_LOGGER, STARTUP_TIMEOUT_DELAY);
+                    index++;
+                }
             }
+            UART_consume(LOGGER_UART_ID, i);
+        }
+        if (index < STARTUP_CHARACTERS && Timer_isExpired(TIMER_LOGGER)) {
+            #ifdef DEBUG
+            printf("Logger failed initializing %s.\n", error[index]);
+            #endif
+            return FAILURE;
         }
-        Timer_new(TIMER_LOGGER, STARTUP_TIMEOUT_DELAY);
-        index++;
     }
 
     #ifdef DEBUG
@@ -119,28 +120,6 @@ void Logger_write(char *str) {
 
 
 
-/**********************************************************************
- * Function: hasNewMessage
- * @return Returns true if a new message is ready to be read
- * @remark
- **********************************************************************/
-static bool hasNewByte() {
-    return !UART_isReceiveEmpty(LOGGER_UART_ID);
-}
-
-/**********************************************************************
- * Function: readByte
- * @return SUCCESS, FAILURE, or ERROR.
- * @remark Reads a byte if one is available.
- **********************************************************************/
-static uint8_t readByte() {
-    // Read a new byte from the UART or return FAILURE
-    if (hasNewByte())
-        return UART_getChar(LOGGER_UART_ID);
-
-    return FALSE;
-}
-
 static void resetLogger() {
     LOGGER_RESET = 0;
     DELAY(1);
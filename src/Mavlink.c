@@ -6,25 +6,66 @@
 
 ***********************************************************************/
 #include <xc.h>
+#include <string.h>
+#include <math.h>
 #include "Mavlink.h"
+#include "MavlinkParser.h"
+#include "MavlinkQueue.h"
+#include "Transport.h"
+#include "Telemetry.h"
+#include "Scheduler.h"
+#include "LinkStats.h"
 #include "Uart.h"
 #include "Board.h"
+#include "Timer.h"
 #include "Xbee.h"
 
-static int packet_drops = 0;
-static mavlink_message_t msg;
-static mavlink_status_t status;
+static MavlinkParser parser;
+static Transport transport;
+static TelemetryEncoder telemetryEncoder;
+static TelemetryDecoder telemetryDecoder;
+static Scheduler scheduler;
+static LinkStats linkStats;
+static mavlink_boat_state_t pendingBoatState;
+static bool hasPendingBoatState = FALSE;
+static bool isInitialized = FALSE;
 
 
-static uint8_t newMsgID = 0;
-static BOOL hasNewMsg = FALSE;
+static uint8_t newMsgID = 0, newMsgSysID = 0, newMsgSeq = 0;
+static uint32_t pendingTime = 0, newMsgTime = 0;
+static uint32_t spanTime = 0; // of the span given to Mavlink_parse
+static bool isParsingSpan = FALSE;
 
-static BOOL hasHeartbeat = FALSE;
+static bool hasHeartbeat = FALSE;
+static bool peerTakesTrimmed = FALSE; // from the last heartbeat received
 
 #define MAV_NUMBER 15 // defines the MAV number, arbitrary
 #define COMP_ID 15
 
 #define DEBUG_MSG_SIZE      100
+#define DEBUG_EVENT_MAX_ARGS (MAVLINK_MSG_DEBUG_EVENT_FIELD_ARGS_LEN / sizeof(uint32_t))
+
+// Outgoing link, the scheduler paces everything but commands to this
+#ifdef XBEE_API_MODE
+#define LINK_RATE           500 // (bytes/s) of MAVLink, the API frames around it take the rest
+#else
+#define LINK_RATE           864 // (bytes/s) 90% of 9600 baud
+#endif
+#define LINK_BURST          64 // (bytes)
+
+// Scheduler keys, a queued frame is replaced by a newer one with its key
+#define KEY_BOAT_STATE      1
+#define KEY_BOAT_POSITION   2
+#define KEY_GEOCENTRIC_ERROR 3
+#define KEY_DATA            4
+#define KEY_UART_STATS      5 // plus the UART's ID
+
+// Decoded messages waiting for the state machines
+static MavlinkQueue queue;
+
+// Fails to compile if a queue entry can't hold every message
+typedef char checkQueuePayload[sizeof(union MAVLINK_MESSAGE)
+    <= MAVLINK_QUEUE_PAYLOAD_SIZE ? 1 : -1];
 
 
 /********************************************************************
@@ -35,115 +76,147 @@ static void sendStatusAndError(uint16_t status, uint16_t error);
 static void sendCmdOther(bool ack, uint8_t command);
 static void sendGpsEcef(bool ack, uint8_t status, GeocentricCoordinate *ecef);
 static void sendBarometer(float temperatureCelsius, float altitude);
+static void handleFrame(const MavlinkFrame *frame);
+static uint32_t getFrameTime(const MavlinkFrame *frame);
+static bool getAckRequest(uint8_t msgid, const union MAVLINK_MESSAGE *data,
+    uint16_t *msgStatus);
+static void sendPayload(uint8_t msgid, const void *payload, uint8_t length,
+    bool ack, uint16_t msgStatus);
+static uint8_t getPriority(uint8_t msgid, const void *payload, uint16_t msgStatus,
+    uint8_t *key);
+static void sendAck(uint8_t msgID, uint16_t msgStatus);
+static uint8_t nextSequence();
+static void sendBoatState(const mavlink_boat_state_t *state);
+static uint16_t writeXbee(const uint8_t *data, uint16_t length);
+static void writeCommand(const uint8_t *data, uint16_t length);
+static void initialize();
+static uint32_t getTime();
 
 /********************************************************************
  * Public Functions
  ********************************************************************/
 
 void Mavlink_recieve(){
-    while(UART_isReceiveEmpty(Xbee_getUartId()) == FALSE) {
-        uint8_t c = UART_getChar(Xbee_getUartId());
-        //if a message can be deciphered
-        if(mavlink_parse_char(MAVLINK_COMM_0, c, &msg, &status)) {
-            switch(msg.msgid) {
-                case MAVLINK_MSG_ID_HEARTBEAT:
-                {
-                    mavlink_msg_heartbeat_decode(&msg, &Mavlink_heartbeatData);
-                    hasHeartbeat = TRUE;
-
-                    break;
-                }
-                #ifdef XBEE_TEST
-                case MAVLINK_MSG_ID_TEST_DATA:
-                {
-                    mavlink_test_data_t data;
-                    mavlink_msg_test_data_decode(&msg, &data);
-                    //call outside function to handle data
-                    Xbee_message_data_test(&data);
-                }
-                    break;
-                #endif
-                case MAVLINK_MSG_ID_MAVLINK_ACK:
-                    mavlink_msg_mavlink_ack_decode(&msg, &Mavlink_newMessage.ackData);
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;  
-                case MAVLINK_MSG_ID_CMD_OTHER:
-                    mavlink_msg_cmd_other_decode(&msg, &(Mavlink_newMessage.commandOtherData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_STATUS_AND_ERROR:
-                    mavlink_msg_status_and_error_decode(&msg, &(Mavlink_newMessage.statusAndErrorData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_GPS_GEO:
-                    mavlink_msg_gps_geo_decode(&msg, &(Mavlink_newMessage.gpsGeodeticData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_GPS_ECEF:
-                    mavlink_msg_gps_ecef_decode(&msg, &(Mavlink_newMessage.gpsGeocentricData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_GPS_NED:
-                    mavlink_msg_gps_ned_decode(&msg,&(Mavlink_newMessage.gpsLocalData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_DATA:
-                    mavlink_msg_data_decode(&msg, &(Mavlink_newMessage.telemetryData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-                case MAVLINK_MSG_ID_DEBUG:
-                    mavlink_msg_debug_decode(&msg, &(Mavlink_newMessage.debugData));
-                    hasNewMsg = TRUE;
-                    newMsgID = msg.msgid;
-                    break;
-            } // switch
-        }
-    } // while
-    packet_drops += status.packet_rx_drop_count;
+    const uint8_t *data;
+    uint16_t length;
+    initialize();
+    // Scan each contiguous span of the receive buffer in place
+    while (UART_peekContiguous(Xbee_getUartId(), &data, &length)) {
+        MavlinkParser_parse(&parser, data, length, handleFrame);
+        // remember when a frame cut off by the end of the span started
+        if (parser.pendingStart >= 0)
+            pendingTime = UART_getReceiveTime(Xbee_getUartId(), parser.pendingStart);
+        UART_consume(Xbee_getUartId(), length);
+    }
+}
+
+void Mavlink_parse(const uint8_t *data, uint16_t length, uint32_t time) {
+    initialize();
+    spanTime = time;
+    isParsingSpan = TRUE;
+    MavlinkParser_parse(&parser, data, length, handleFrame);
+    if (parser.pendingStart >= 0)
+        pendingTime = time;
+    isParsingSpan = FALSE;
 }
 
 /*------------------------- Receive Messages ----------------------------*/
 
 bool Mavlink_hasNewMessage() {
-    uint8_t result = hasNewMsg;
-    hasNewMsg = FALSE;
-    return result;
+    const MavlinkQueueEntry *entry = MavlinkQueue_pop(&queue);
+    if (entry == NULL)
+        return FALSE;
+
+    // Copy the oldest message out so its slot can be reused
+    memcpy(&Mavlink_newMessage, entry->payload, sizeof(Mavlink_newMessage));
+    newMsgID = entry->msgid;
+    newMsgSysID = entry->sysid;
+    newMsgSeq = entry->seq;
+    newMsgTime = entry->time;
+    if (entry->wantsAck)
+        Transport_delivered(&transport, entry->sysid, entry->msgid, entry->seq);
+    return TRUE;
 }
 
 int Mavlink_getNewMessageID() {
     return newMsgID;
 }
 
+uint8_t Mavlink_getNewMessageSysID() {
+    return newMsgSysID;
+}
+
+uint32_t Mavlink_getNewMessageTime() {
+    return newMsgTime;
+}
+
+uint32_t Mavlink_getQueueDropped() {
+    return queue.droppedCount;
+}
+
 bool Mavlink_hasHeartbeat() {
-    BOOL result = hasHeartbeat;
+    bool result = hasHeartbeat;
     hasHeartbeat = FALSE;
     return result;
 }
 
 
+/*------------------------- Acknowledgements ----------------------------*/
+
+uint8_t Mavlink_getAckStatus(uint8_t msgID, uint16_t msgStatus) {
+    initialize();
+    return Transport_getStatus(&transport, msgID, msgStatus);
+}
+
+void Mavlink_cancelResends() {
+    initialize();
+    Transport_cancel(&transport);
+}
+
+void Mavlink_runSM() {
+    initialize();
+    Transport_runSM(&transport, getTime());
+    Scheduler_runSM(&scheduler, getTime());
+    LinkStats_runSM(&linkStats, parser.errorCount, getTime());
+
+    // The newest boat state waited for the last one to go out
+    if (hasPendingBoatState && !Scheduler_isQueued(&scheduler, KEY_BOAT_STATE)) {
+        hasPendingBoatState = FALSE;
+        sendBoatState(&pendingBoatState);
+    }
+}
+
+const Transport *Mavlink_getTransport() {
+    return &transport;
+}
+
+const Scheduler *Mavlink_getScheduler() {
+    return &scheduler;
+}
+
+const LinkStats *Mavlink_getLinkStats() {
+    return &linkStats;
+}
+
+
 /*------------------------- Send Messages ----------------------------*/
 
 void Mavlink_sendAck(uint8_t msgID, uint16_t msgStatus){
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_mavlink_ack_pack(MAV_NUMBER, COMP_ID, &msg, msgID, msgStatus);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    sendAck(msgID, msgStatus);
+
+    // So a resent copy of the message can be acked again, the ACK is for
+    // the message being handled
+    if (msgID == newMsgID)
+        Transport_sentAck(&transport, newMsgSysID, msgID, newMsgSeq, msgStatus);
 }
 void Mavlink_sendHeartbeat(){
-    uint8_t data = 0x1;
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_heartbeat_pack(MAV_NUMBER, COMP_ID, &msg, NO_ACK, data);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_heartbeat_t payload;
+    initialize();
+    payload.ack = NO_ACK;
+    payload.data = MAVLINK_HEARTBEAT_ALIVE | MAVLINK_HEARTBEAT_TRIMMED;
+    LinkStats_fillHeartbeat(&linkStats, &payload, getTime());
+    sendPayload(MAVLINK_MSG_ID_HEARTBEAT, &payload, MAVLINK_MSG_ID_HEARTBEAT_LEN,
+        NO_ACK, MAVLINK_NO_COMMAND);
 }
 
 
@@ -222,60 +295,460 @@ void Mavlink_sendBoatPosition(LocalCoordinate *nedPos){
 
 
 void Mavlink_sendBoatData(float temperature, float altitude, uint16_t batVolt1, uint16_t batVolt2) {
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_data_pack(MAV_NUMBER, COMP_ID, &msg, NO_ACK, temperature, altitude, batVolt1, batVolt2);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_data_t payload;
+    payload.ack = NO_ACK;
+    payload.temperature = temperature;
+    payload.altitude = altitude;
+    payload.batVolt1 = batVolt1;
+    payload.batVolt2 = batVolt2;
+    sendPayload(MAVLINK_MSG_ID_DATA, &payload, MAVLINK_MSG_ID_DATA_LEN, NO_ACK,
+        MAVLINK_NO_COMMAND);
+}
+
+void Mavlink_sendBoatState(LocalCoordinate *nedPos, float heading, float speed,
+        uint8_t navState, uint8_t error, uint16_t batVolt1, uint16_t batVolt2) {
+    mavlink_boat_state_t state;
+    state.north = (int32_t)(nedPos->north * 100.0f);
+    state.east = (int32_t)(nedPos->east * 100.0f);
+    state.down = (int16_t)(nedPos->down * 100.0f);
+    heading = fmodf(heading, 360.0f);
+    if (heading < 0.0f)
+        heading += 360.0f;
+    state.heading = (uint16_t)(heading * 100.0f) % 36000;
+    state.speed = (speed > 0.0f) ? (uint16_t)(speed * 100.0f) : 0;
+    state.navState = navState;
+    state.error = error;
+    state.batVolt1 = batVolt1;
+    state.batVolt2 = batVolt2;
+
+    initialize();
+    // Keep only the newest until the one waiting has gone out
+    if (Scheduler_isQueued(&scheduler, KEY_BOAT_STATE)) {
+        memcpy(&pendingBoatState, &state, sizeof(state));
+        hasPendingBoatState = TRUE;
+        return;
+    }
+    hasPendingBoatState = FALSE;
+    sendBoatState(&state);
 }
 
 void Mavlink_sendDebug(char sender, char *message) {
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    mavlink_debug_t payload;
+    payload.ack = NO_ACK;
+    payload.sender = sender;
+    // Pads with zeros, the string needn't end in one if it fills the field
+    strncpy(payload.message, message, DEBUG_MSG_SIZE);
+    sendPayload(MAVLINK_MSG_ID_DEBUG, &payload, MAVLINK_MSG_ID_DEBUG_LEN, NO_ACK,
+        MAVLINK_NO_COMMAND);
+}
 
-    char str[DEBUG_MSG_SIZE];
-    strncpy(str,message,DEBUG_MSG_SIZE - 1);
-    str[DEBUG_MSG_SIZE - 1] = '\0';
+void Mavlink_sendDebugEvent(uint8_t sender, uint16_t id, const uint32_t *args,
+        uint8_t count) {
+    mavlink_debug_event_t payload;
+    if (count > DEBUG_EVENT_MAX_ARGS)
+        count = DEBUG_EVENT_MAX_ARGS;
+    // Unused arguments stay zero, so they are trimmed off
+    memset(&payload, 0, sizeof(payload));
+    payload.ack = NO_ACK;
+    payload.sender = sender;
+    payload.message = id;
+    payload.count = count;
+    memcpy(payload.args, args, count * sizeof(uint32_t)); // little endian
+    sendPayload(MAVLINK_MSG_ID_DEBUG_EVENT, &payload, MAVLINK_MSG_ID_DEBUG_EVENT_LEN,
+        NO_ACK, MAVLINK_NO_COMMAND);
+}
 
-    mavlink_msg_debug_pack(MAV_NUMBER, COMP_ID, &msg, NO_ACK, sender, message);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+void Mavlink_sendUartStatistics(uint8_t uartId) {
+    mavlink_uart_stats_t payload;
+    UartStatistics stats;
+    if (!UART_getStatistics(uartId, &stats))
+        return;
+
+    payload.ack = NO_ACK;
+    payload.uartId = uartId;
+    payload.bytesIn = stats.bytesIn;
+    payload.bytesOut = stats.bytesOut;
+    payload.receiveDropped = stats.receiveDropped;
+    payload.transmitDropped = stats.transmitDropped;
+    payload.interruptCount = stats.interruptCount;
+    payload.interruptTicks = stats.interruptTicks;
+    payload.receivePeak = stats.receivePeak;
+    payload.transmitPeak = stats.transmitPeak;
+    sendPayload(MAVLINK_MSG_ID_UART_STATS, &payload, MAVLINK_MSG_ID_UART_STATS_LEN,
+        NO_ACK, MAVLINK_NO_COMMAND);
 }
 
 /************************************************************************
  * PRIVATE FUNCTIONS                                                    *
  ************************************************************************/
 
+/**********************************************************************
+ * Function: handleFrame
+ * @param A newly received MAVLink frame.
+ * @return None
+ * @remark Copies the payload into the next free slot of the receive queue
+ *  (or the heartbeat data) for the state machines. The message is dropped
+ *  and counted if the queue is full. Payloads are little endian like the
+ *  PIC32, and the parser has checked their length, so they are copied
+ *  straight into the message structs.
+ **********************************************************************/
+static void handleFrame(const MavlinkFrame *frame) {
+    MavlinkQueueEntry *entry;
+    uint16_t msgStatus;
+    LinkStats_received(&linkStats, frame->wireLen + MAVLINK_NUM_NON_PAYLOAD_BYTES);
+    switch(frame->msgid) {
+        case MAVLINK_MSG_ID_HEARTBEAT:
+            memcpy(&Mavlink_heartbeatData, frame->payload, frame->len);
+            LinkStats_handleHeartbeat(&linkStats, &Mavlink_heartbeatData,
+                getFrameTime(frame));
+            peerTakesTrimmed = (Mavlink_heartbeatData.data & MAVLINK_HEARTBEAT_TRIMMED) != 0;
+            hasHeartbeat = TRUE;
+            return;
+        #ifdef XBEE_TEST
+        case MAVLINK_MSG_ID_TEST_DATA:
+        {
+            mavlink_test_data_t data;
+            memcpy(&data, frame->payload, frame->len);
+            //call outside function to handle data
+            Xbee_message_data_test(&data);
+        }
+            return;
+        #endif
+        case MAVLINK_MSG_ID_MAVLINK_ACK:
+        {
+            mavlink_mavlink_ack_t ack;
+            memcpy(&ack, frame->payload, frame->len);
+            Transport_handleAck(&transport, ack.msgID, ack.msgStatus, getTime());
+        }
+            break;
+        case MAVLINK_MSG_ID_CMD_OTHER:
+        case MAVLINK_MSG_ID_STATUS_AND_ERROR:
+        case MAVLINK_MSG_ID_GPS_GEO:
+        case MAVLINK_MSG_ID_GPS_ECEF:
+        case MAVLINK_MSG_ID_GPS_NED:
+        case MAVLINK_MSG_ID_DATA:
+        case MAVLINK_MSG_ID_DEBUG:
+        case MAVLINK_MSG_ID_DEBUG_EVENT:
+        case MAVLINK_MSG_ID_UART_STATS:
+            break;
+        case MAVLINK_MSG_ID_BOAT_STATE:
+        case MAVLINK_MSG_ID_BOAT_STATE_DELTA:
+        {
+            // Rebuild the full state even if the queue is full
+            mavlink_boat_state_t state;
+            if (!Telemetry_unpack(&telemetryDecoder, frame->msgid, frame->payload,
+                    frame->len, &state))
+                return; // missed its keyframe
+            entry = MavlinkQueue_reserve(&queue);
+            if (entry == NULL)
+                return;
+            memcpy(entry->payload, &state, sizeof(state));
+            entry->msgid = MAVLINK_MSG_ID_BOAT_STATE;
+            entry->sysid = frame->sysid;
+            entry->seq = frame->seq;
+            entry->wantsAck = FALSE;
+            entry->time = getFrameTime(frame);
+            MavlinkQueue_commit(&queue);
+        }
+            return;
+        default:
+            return; // not for us
+    } // switch
+
+    entry = MavlinkQueue_reserve(&queue);
+    if (entry == NULL)
+        return;
+    memcpy(entry->payload, frame->payload, frame->len);
+    entry->wantsAck = getAckRequest(frame->msgid,
+        (const union MAVLINK_MESSAGE *)entry->payload, &msgStatus);
+    if (entry->wantsAck) {
+        // Drop copies resent because our ACK was lost or late
+        switch (Transport_receive(&transport, frame->sysid, frame->msgid,
+                frame->seq, getTime(), &msgStatus)) {
+            case TRANSPORT_DUPLICATE_ACKED:
+                sendAck(frame->msgid, msgStatus);
+                return;
+            case TRANSPORT_DUPLICATE:
+                return;
+        }
+    }
+    entry->msgid = frame->msgid;
+    entry->sysid = frame->sysid;
+    entry->seq = frame->seq;
+    entry->time = getFrameTime(frame);
+    MavlinkQueue_commit(&queue);
+}
+
+/**********************************************************************
+ * Function: getFrameTime
+ * @param A received frame.
+ * @return Time (ms) when the frame's first byte arrived.
+ **********************************************************************/
+static uint32_t getFrameTime(const MavlinkFrame *frame) {
+    if (isParsingSpan)
+        return (frame->start >= 0) ? spanTime : pendingTime;
+    return (frame->start >= 0) ?
+        UART_getReceiveTime(Xbee_getUartId(), frame->start) : pendingTime;
+}
+
+/**********************************************************************
+ * Function: getAckRequest
+ * @param Message ID.
+ * @param Message payload.
+ * @param Set to the status code an ACK would carry.
+ * @return TRUE if the sender wants an ACK.
+ **********************************************************************/
+static bool getAckRequest(uint8_t msgid, const union MAVLINK_MESSAGE *data,
+        uint16_t *msgStatus) {
+    switch (msgid) {
+        case MAVLINK_MSG_ID_CMD_OTHER:
+            *msgStatus = data->commandOtherData.command;
+            return data->commandOtherData.ack == WANT_ACK;
+        case MAVLINK_MSG_ID_GPS_ECEF:
+            *msgStatus = data->gpsGeocentricData.status;
+            return data->gpsGeocentricData.ack == WANT_ACK;
+        case MAVLINK_MSG_ID_GPS_NED:
+            *msgStatus = data->gpsLocalData.status;
+            return data->gpsLocalData.ack == WANT_ACK;
+        default:
+            return FALSE;
+    }
+}
+
+/**********************************************************************
+ * Function: sendPayload
+ * @param Message ID.
+ * @param Payload struct, e.g. a mavlink_gps_ned_t.
+ * @param Payload length.
+ * @param WANT_ACK to resend the message until it is acked.
+ * @param Status code the ACK will carry.
+ * @return None
+ * @remark Packs the frame straight into space reserved in the scheduler's
+ *  queue for its priority, so there's no mavlink_message_t or second
+ *  buffer on the stack. The frame is dropped, and counted by the scheduler,
+ *  if its queue is full. Then sends what the link allows, so a command goes
+ *  out before any waiting telemetry. The payload's trailing zeros are
+ *  dropped if the other end's heartbeat says it puts them back.
+ **********************************************************************/
+static void sendPayload(uint8_t msgid, const void *payload, uint8_t length,
+        bool ack, uint16_t msgStatus) {
+    uint8_t frame[TRANSPORT_FRAME_SIZE];
+    uint8_t *space, priority, key;
+    uint16_t frameLength;
+    initialize();
+#ifdef MAVLINK_TRIM_PAYLOADS
+    if (peerTakesTrimmed)
+        length = _mav_trim_payload((const char *)payload, length);
+#endif
+    frameLength = length + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+    if (ack == WANT_ACK && frameLength <= TRANSPORT_FRAME_SIZE) {
+        // The transport keeps its own copy for resending
+        MavlinkParser_pack(frame, nextSequence(), MAV_NUMBER, COMP_ID, msgid,
+            payload, length);
+        Transport_send(&transport, frame, frameLength, msgid, msgStatus, getTime());
+    }
+    else {
+        priority = getPriority(msgid, payload, msgStatus, &key);
+        space = Scheduler_reserve(&scheduler, priority, key, frameLength, getTime());
+        if (space != NULL) {
+            MavlinkParser_pack(space, nextSequence(), MAV_NUMBER, COMP_ID, msgid,
+                payload, length);
+            Scheduler_commit(&scheduler);
+        }
+    }
+    Scheduler_runSM(&scheduler, getTime());
+}
+
+/**********************************************************************
+ * Function: getPriority
+ * @param Message ID of a message that doesn't want an ACK.
+ * @param Its payload.
+ * @param Its status code.
+ * @param Set to the scheduler key, for telemetry only the newest of which
+ *  matters.
+ * @return Scheduler priority class of the message.
+ **********************************************************************/
+static uint8_t getPriority(uint8_t msgid, const void *payload, uint16_t msgStatus,
+        uint8_t *key) {
+    *key = SCHEDULER_KEY_NONE;
+    switch (msgid) {
+        case MAVLINK_MSG_ID_MAVLINK_ACK:
+        case MAVLINK_MSG_ID_CMD_OTHER:
+            return SCHEDULER_PRIORITY_COMMAND;
+        case MAVLINK_MSG_ID_GPS_NED:
+            if (msgStatus != MAVLINK_LOCAL_BOAT_POSITION)
+                return SCHEDULER_PRIORITY_COMMAND;
+            *key = KEY_BOAT_POSITION;
+            return SCHEDULER_PRIORITY_TELEMETRY;
+        case MAVLINK_MSG_ID_GPS_ECEF:
+            if (msgStatus != MAVLINK_GEOCENTRIC_ERROR)
+                return SCHEDULER_PRIORITY_COMMAND;
+            *key = KEY_GEOCENTRIC_ERROR;
+            return SCHEDULER_PRIORITY_TELEMETRY;
+        case MAVLINK_MSG_ID_BOAT_STATE:
+        case MAVLINK_MSG_ID_BOAT_STATE_DELTA:
+            *key = KEY_BOAT_STATE;
+            return SCHEDULER_PRIORITY_TELEMETRY;
+        case MAVLINK_MSG_ID_DATA:
+            *key = KEY_DATA;
+            return SCHEDULER_PRIORITY_TELEMETRY;
+        case MAVLINK_MSG_ID_UART_STATS:
+            *key = KEY_UART_STATS + ((const mavlink_uart_stats_t*)payload)->uartId;
+            return SCHEDULER_PRIORITY_TELEMETRY;
+        case MAVLINK_MSG_ID_DEBUG:
+        case MAVLINK_MSG_ID_DEBUG_EVENT:
+            return SCHEDULER_PRIORITY_DEBUG;
+        default:
+            return SCHEDULER_PRIORITY_STATE; // status, errors and heartbeats
+    }
+}
+
+/**********************************************************************
+ * Function: sendBoatState
+ * @param State of the boat.
+ * @return None
+ * @remark Packs the state as a keyframe or delta right before queueing it,
+ *  so a waiting frame never has to be replaced and break the delta chain.
+ **********************************************************************/
+static void sendBoatState(const mavlink_boat_state_t *state) {
+    TelemetryPayload payload;
+    uint8_t msgid, length;
+    length = Telemetry_encode(&telemetryEncoder, state, &payload, &msgid);
+    sendPayload(msgid, &payload, length, NO_ACK, MAVLINK_NO_COMMAND);
+}
+
+static void sendAck(uint8_t msgID, uint16_t msgStatus) {
+    mavlink_mavlink_ack_t payload;
+    payload.msgID = msgID;
+    payload.msgStatus = msgStatus;
+    sendPayload(MAVLINK_MSG_ID_MAVLINK_ACK, &payload, MAVLINK_MSG_ID_MAVLINK_ACK_LEN,
+        NO_ACK, msgStatus);
+}
+
+// Shared with the mavlink_msg_*_pack functions
+static uint8_t nextSequence() {
+    return mavlink_get_channel_status(MAVLINK_COMM_0)->current_tx_seq++;
+}
+
+static uint16_t writeXbee(const uint8_t *data, uint16_t length) {
+    uint16_t written;
+#ifdef XBEE_API_MODE
+    written = Xbee_send(data, length);
+#else
+    written = UART_write(Xbee_getUartId(), data, length, UART_WRITE_REJECT, 0);
+#endif
+    if (written == length)
+        LinkStats_sent(&linkStats, length);
+    return written;
+}
+
+// Sends and resends for the transport go ahead of everything else
+static void writeCommand(const uint8_t *data, uint16_t length) {
+    Scheduler_queue(&scheduler, SCHEDULER_PRIORITY_COMMAND, SCHEDULER_KEY_NONE,
+        data, length, getTime());
+}
+
+static void initialize() {
+    if (isInitialized)
+        return;
+    MavlinkParser_init(&parser);
+    MavlinkQueue_init(&queue);
+    Transport_init(&transport, writeCommand);
+    Scheduler_init(&scheduler, writeXbee, LINK_RATE, LINK_BURST);
+    Telemetry_initEncoder(&telemetryEncoder);
+    Telemetry_initDecoder(&telemetryDecoder);
+    LinkStats_init(&linkStats);
+    isInitialized = TRUE;
+}
+
+static uint32_t getTime() {
+    return Timer_isInitialized()? get_time() : 0;
+}
+
 static void sendGpsNed(bool ack, uint8_t status, LocalCoordinate *nedPos){
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_gps_ned_pack(MAV_NUMBER, COMP_ID, &msg, ack,status,
-            nedPos->north, nedPos->east, nedPos->down);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_gps_ned_t payload;
+    payload.ack = ack;
+    payload.status = status;
+    payload.north = nedPos->north;
+    payload.east = nedPos->east;
+    payload.down = nedPos->down;
+    sendPayload(MAVLINK_MSG_ID_GPS_NED, &payload, MAVLINK_MSG_ID_GPS_NED_LEN, ack, status);
 }
 
 static void sendStatusAndError(uint16_t status, uint16_t error){
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_status_and_error_pack(MAV_NUMBER, COMP_ID, &msg, NO_ACK, status, error);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_status_and_error_t payload;
+    payload.ack = NO_ACK;
+    payload.status = status;
+    payload.error = error;
+    sendPayload(MAVLINK_MSG_ID_STATUS_AND_ERROR, &payload,
+        MAVLINK_MSG_ID_STATUS_AND_ERROR_LEN, NO_ACK, MAVLINK_NO_COMMAND);
 }
 
 static void sendCmdOther(bool ack, uint8_t command){
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_cmd_other_pack(MAV_NUMBER, COMP_ID, &msg, ack, command);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_cmd_other_t payload;
+    payload.ack = ack;
+    payload.command = command;
+    sendPayload(MAVLINK_MSG_ID_CMD_OTHER, &payload, MAVLINK_MSG_ID_CMD_OTHER_LEN, ack, command);
 }
 
 static void sendGpsEcef(bool ack, uint8_t status, GeocentricCoordinate *ecef){
-    mavlink_message_t msg;
-    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
-    mavlink_msg_gps_ecef_pack(MAV_NUMBER, COMP_ID, &msg, ack, status,ecef->x,ecef->y,ecef->z);
-    uint16_t length = mavlink_msg_to_send_buffer(buf, &msg);
-    UART_putString(Xbee_getUartId(), buf, length);
+    mavlink_gps_ecef_t payload;
+    payload.ack = ack;
+    payload.status = status;
+    payload.x = ecef->x;
+    payload.y = ecef->y;
+    payload.z = ecef->z;
+    sendPayload(MAVLINK_MSG_ID_GPS_ECEF, &payload, MAVLINK_MSG_ID_GPS_ECEF_LEN, ack, status);
 }
 
+
+
+//#define MAVLINK_QUEUE_TEST
+#ifdef MAVLINK_QUEUE_TEST
+#include <stdio.h>
+#include "Serial.h"
+
+/* Parses rounds of back-to-back frames, a full queue at a time, as if they
+ * arrived in one receive pass, then checks that every message comes out of
+ * the queue in order. */
+
+#define TEST_ROUNDS         100
+#define TEST_FRAME_SIZE     (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_GPS_NED_LEN)
+
+int main(void)
+{
+    Board_init();
+    Serial_init();
+    printf("\nMavlink queue test harness\n");
+    initialize();
+
+    uint8_t stream[MAVLINK_QUEUE_SIZE * TEST_FRAME_SIZE];
+    mavlink_message_t message;
+    uint16_t length;
+    uint32_t sent = 0, received = 0, outOfOrder = 0;
+    int round, n;
+
+    for (round = 0; round < TEST_ROUNDS; round++) {
+        length = 0;
+        for (n = 0; n < MAVLINK_QUEUE_SIZE; n++) {
+            mavlink_msg_gps_ned_pack(MAV_NUMBER, COMP_ID, &message, NO_ACK,
+                MAVLINK_LOCAL_BOAT_POSITION, (float)sent++, 0.0f, 0.0f);
+            length += mavlink_msg_to_send_buffer(&stream[length], &message);
+        }
+        MavlinkParser_parse(&parser, stream, length, handleFrame);
+        while (Mavlink_hasNewMessage()) {
+            if (Mavlink_getNewMessageID() != MAVLINK_MSG_ID_GPS_NED
+                    || Mavlink_newMessage.gpsLocalData.north != (float)received)
+                outOfOrder++;
+            received++;
+        }
+    }
+
+    printf("Sent %u, received %u, out of order %u, dropped %u\n",
+        (unsigned int)sent, (unsigned int)received, (unsigned int)outOfOrder,
+        (unsigned int)Mavlink_getQueueDropped());
+    printf("%s\n", (received == sent && outOfOrder == 0)? "PASSED" : "FAILED");
+    while (1);
+    return 0;
+}
+#endif
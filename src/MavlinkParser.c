@@ -0,0 +1,262 @@
+/**********************************************************************
+ Module
+   MavlinkParser.c
+
+ Author: David Goodman
+
+ Description
+    Span-based MAVLink 1.0 frame parser and packer (see MavlinkParser.h).
+
+ Notes
+    Frame layout: STX, len, seq, sysid, compid, msgid, payload[len], then
+    the X.25 checksum (low byte first) over everything after the STX and
+    the message's crc_extra. Messages the dialect knows can't be longer
+    than the dialect's payload length. The checksum is worked out by
+    MavlinkCrc a span at a time.
+
+    The length is checked as soon as the header is in, before a cut off
+    frame is saved or filled. Otherwise a corrupt length byte would hold
+    back up to 255 bytes, and the good frames in them, until the checksum
+    failed.
+
+    The checksum covers the payload as sent, so a trimmed payload is only
+    filled out with zeros after it checks out.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+ 10-18-26               dagoodma    Checksum with MavlinkCrc.
+ 10-18-26               dagoodma    Fill out trimmed payloads.
+ 10-18-26               dagoodma    Reject a bad length from the header.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "MavlinkParser.h"
+#include "MavlinkCrc.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define LENGTH_INDEX        1
+#define SEQ_INDEX           2
+#define SYSID_INDEX         3
+#define COMPID_INDEX        4
+#define MSGID_INDEX         5
+
+#define FRAME_LENGTH(len)   ((uint16_t)(len) + MAVLINK_NUM_NON_PAYLOAD_BYTES)
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static bool isTooLong(const uint8_t *header);
+static bool checkFrame(MavlinkParser *parser, const uint8_t *bytes,
+    int16_t start, MavlinkFrameHandler handler);
+static uint16_t completePending(MavlinkParser *parser, const uint8_t *data,
+    uint16_t length, MavlinkFrameHandler handler);
+
+/**********************************************************************
+ * PRIVATE VARIABLES                                                  *
+ **********************************************************************/
+
+static const uint8_t messageLengths[256] = MAVLINK_MESSAGE_LENGTHS;
+static const uint8_t messageCrcs[256] = MAVLINK_MESSAGE_CRCS;
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void MavlinkParser_init(MavlinkParser *parser) {
+    parser->pendingLength = 0;
+    parser->pendingStart = -1;
+    parser->frameCount = 0;
+    parser->errorCount = 0;
+    parser->skippedCount = 0;
+}
+
+uint16_t MavlinkParser_parse(MavlinkParser *parser, const uint8_t *data,
+        uint16_t length, MavlinkFrameHandler handler) {
+    uint32_t startCount = parser->frameCount;
+    const uint8_t *found;
+    uint16_t i = 0, start, frameLength;
+
+    parser->pendingStart = -1;
+    if (parser->pendingLength > 0)
+        i = completePending(parser, data, length, handler);
+
+    while (i < length) {
+        found = memchr(&data[i], MAVLINK_STX, length - i);
+        if (found == NULL) {
+            parser->skippedCount += length - i;
+            break;
+        }
+        start = found - data;
+        parser->skippedCount += start - i;
+
+        if (length - start > MSGID_INDEX && isTooLong(&data[start])) {
+            parser->errorCount++;
+            i = start + 1; // resync on the next start byte
+            continue;
+        }
+
+        // Save a frame that runs past the end of the span
+        if (length - start <= LENGTH_INDEX
+                || length - start < FRAME_LENGTH(data[start + LENGTH_INDEX])) {
+            parser->pendingLength = length - start;
+            parser->pendingStart = start;
+            memcpy(parser->pending, &data[start], parser->pendingLength);
+            break;
+        }
+
+        frameLength = FRAME_LENGTH(data[start + LENGTH_INDEX]);
+        if (checkFrame(parser, &data[start], start, handler)) {
+            i = start + frameLength;
+        }
+        else {
+            parser->errorCount++;
+            i = start + 1; // resync on the next start byte
+        }
+    }
+    return (uint16_t)(parser->frameCount - startCount);
+}
+
+uint16_t MavlinkParser_pack(uint8_t *frame, uint8_t seq, uint8_t sysid,
+        uint8_t compid, uint8_t msgid, const void *payload, uint8_t length) {
+    uint8_t *end = &frame[MAVLINK_NUM_HEADER_BYTES + length];
+    uint16_t crc;
+
+    frame[0] = MAVLINK_STX;
+    frame[LENGTH_INDEX] = length;
+    frame[SEQ_INDEX] = seq;
+    frame[SYSID_INDEX] = sysid;
+    frame[COMPID_INDEX] = compid;
+    frame[MSGID_INDEX] = msgid;
+    memcpy(&frame[MAVLINK_NUM_HEADER_BYTES], payload, length);
+
+    crc = MavlinkCrc_update(MAVLINK_CRC_INIT, &frame[LENGTH_INDEX],
+        MAVLINK_CORE_HEADER_LEN + length);
+    crc = MavlinkCrc_update(crc, &messageCrcs[msgid], 1);
+    end[0] = (uint8_t)(crc & 0xFF);
+    end[1] = (uint8_t)(crc >> 8);
+    return FRAME_LENGTH(length);
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: isTooLong
+ * @param Frame header, starting with the STX.
+ * @return TRUE if the payload is longer than the dialect's for the message.
+ **********************************************************************/
+static bool isTooLong(const uint8_t *header) {
+    uint8_t maxLength = messageLengths[header[MSGID_INDEX]];
+    return maxLength != 0 && header[LENGTH_INDEX] > maxLength;
+}
+
+/**********************************************************************
+ * Function: checkFrame
+ * @param Parser.
+ * @param Complete frame, starting with the STX, whose length was checked.
+ * @param Offset of the frame in the span, or -1.
+ * @param Function to call if the frame is good.
+ * @return TRUE if the frame was good and handled.
+ * @remark Checks the checksum, then puts back the zeros of a trimmed
+ *  payload.
+ **********************************************************************/
+static bool checkFrame(MavlinkParser *parser, const uint8_t *bytes,
+        int16_t start, MavlinkFrameHandler handler) {
+    MavlinkFrame frame;
+    uint8_t len = bytes[LENGTH_INDEX];
+    uint8_t msgid = bytes[MSGID_INDEX];
+    const uint8_t *end = &bytes[MAVLINK_NUM_HEADER_BYTES + len];
+    uint16_t crc;
+
+    crc = MavlinkCrc_update(MAVLINK_CRC_INIT, &bytes[LENGTH_INDEX],
+        MAVLINK_CORE_HEADER_LEN + len);
+    crc = MavlinkCrc_update(crc, &messageCrcs[msgid], 1);
+    if (end[0] != (uint8_t)(crc & 0xFF) || end[1] != (uint8_t)(crc >> 8))
+        return false;
+
+    frame.msgid = msgid;
+    frame.sysid = bytes[SYSID_INDEX];
+    frame.compid = bytes[COMPID_INDEX];
+    frame.seq = bytes[SEQ_INDEX];
+    frame.len = len;
+    frame.wireLen = len;
+    frame.payload = &bytes[MAVLINK_NUM_HEADER_BYTES];
+    frame.start = start;
+    if (len < messageLengths[msgid]) {
+        memcpy(parser->payload, frame.payload, len);
+        memset(&parser->payload[len], 0, messageLengths[msgid] - len);
+        frame.len = messageLengths[msgid];
+        frame.payload = parser->payload;
+    }
+    parser->frameCount++;
+    handler(&frame);
+    return true;
+}
+
+/**********************************************************************
+ * Function: completePending
+ * @param Parser.
+ * @param Span of received bytes.
+ * @param Number of bytes in the span.
+ * @param Function to call with each good frame.
+ * @return Number of bytes taken from the span.
+ * @remark Fills the pending frame from the start of the span, the header
+ *  first. If it turns out bad, looks for another start byte in the saved
+ *  bytes and carries on with that frame instead.
+ **********************************************************************/
+static uint16_t completePending(MavlinkParser *parser, const uint8_t *data,
+        uint16_t length, MavlinkFrameHandler handler) {
+    uint16_t i = 0, needed, count;
+    const uint8_t *found;
+
+    while (parser->pendingLength > 0) {
+        // Drop saved bytes up to the next start byte
+        found = memchr(parser->pending, MAVLINK_STX, parser->pendingLength);
+        count = (found == NULL) ? parser->pendingLength : found - parser->pending;
+        if (count > 0) {
+            parser->skippedCount += count;
+            parser->pendingLength -= count;
+            memmove(parser->pending, &parser->pending[count], parser->pendingLength);
+            continue;
+        }
+
+        if (parser->pendingLength > MSGID_INDEX && isTooLong(parser->pending)) {
+            count = 0; // don't wait for the rest of it
+        }
+        else {
+            needed = (parser->pendingLength <= MSGID_INDEX) ? MSGID_INDEX + 1
+                : FRAME_LENGTH(parser->pending[LENGTH_INDEX]);
+            if (parser->pendingLength < needed) {
+                count = needed - parser->pendingLength;
+                if (count > length - i)
+                    count = length - i;
+                memcpy(&parser->pending[parser->pendingLength], &data[i], count);
+                parser->pendingLength += count;
+                i += count;
+                if (parser->pendingLength < needed)
+                    break; // wait for the next span
+                if (needed == MSGID_INDEX + 1)
+                    continue; // have the header now
+            }
+            count = checkFrame(parser, parser->pending, -1, handler) ? needed : 0;
+        }
+
+        if (count == 0) {
+            // Bad frame, so restart from the next start byte already saved
+            parser->errorCount++;
+            count = 1;
+        }
+        parser->pendingLength -= count;
+        memmove(parser->pending, &parser->pending[count], parser->pendingLength);
+    }
+    return i;
+}
@@ -0,0 +1,72 @@
+/**********************************************************************
+ Module
+   MavlinkQueue.c
+
+ Author: David Goodman
+
+ Description
+    Ring of received MAVLink messages for the state machines (see
+    MavlinkQueue.h).
+
+ Notes
+    The head and tail run free and wrap at 256, so the queue size must
+    divide 256. Both are changed by the main loop only, the parser filling
+    the queue and the state machines emptying it, so nothing is locked.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file, from the queue in Mavlink.c.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "MavlinkQueue.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define INDEX(n)            ((n) & (MAVLINK_QUEUE_SIZE - 1))
+
+// Fails to compile if the size doesn't divide the free-running counters
+typedef char checkQueueSize[(MAVLINK_QUEUE_SIZE & (MAVLINK_QUEUE_SIZE - 1)) == 0
+    && MAVLINK_QUEUE_SIZE <= 128 ? 1 : -1];
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void MavlinkQueue_init(MavlinkQueue *queue) {
+    memset(queue, 0, sizeof(MavlinkQueue));
+}
+
+MavlinkQueueEntry *MavlinkQueue_reserve(MavlinkQueue *queue) {
+    if (MavlinkQueue_getLength(queue) >= MAVLINK_QUEUE_SIZE) {
+        queue->droppedCount++;
+        return NULL;
+    }
+    queue->isReserved = true;
+    return &queue->entries[INDEX(queue->tail)];
+}
+
+void MavlinkQueue_commit(MavlinkQueue *queue) {
+    if (!queue->isReserved)
+        return;
+    queue->isReserved = false;
+    queue->tail++;
+}
+
+const MavlinkQueueEntry *MavlinkQueue_pop(MavlinkQueue *queue) {
+    const MavlinkQueueEntry *entry;
+    if (queue->head == queue->tail)
+        return NULL;
+    entry = &queue->entries[INDEX(queue->head)];
+    queue->head++;
+    return entry;
+}
+
+uint8_t MavlinkQueue_getLength(const MavlinkQueue *queue) {
+    return (uint8_t)(queue->tail - queue->head);
+}
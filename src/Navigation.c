@@ -21,6 +21,7 @@
 #include "Drive.h"
 #include "Logger.h"
 #include "Error.h"
+#include "Console.h"
 
 
 /***********************************************************************
@@ -31,6 +32,10 @@
 
 #define USE_DRIVE
 
+// Move the GPS position forward by its age using the GPS velocity
+// (untested on the boat)
+//#define USE_LATENCY_COMPENSATION
+
 
 #ifdef DEBUG
 #ifdef USE_SD_LOGGER
@@ -42,6 +47,13 @@
 #define DBPRINT(...)   ((int)0)
 #endif
 
+// Deferred debug messages from the control loop (see ConsoleMessages.h)
+#ifdef DEBUG
+#define DBLOG(...)     CONSOLE_LOG(__VA_ARGS__)
+#else
+#define DBLOG(...)     ((int)0)
+#endif
+
 
 #define UPDATE_DELAY        1500 // (ms)
 #define TIMEOUT_DELAY       7000 // (ms)
@@ -49,6 +61,9 @@
 // don't change heading unless calculated is this much away from last
 #define HEADING_TOLERANCE   10 // (deg)
 
+// don't extrapolate positions older than this
+#define LATENCY_MAX_AGE     1000 // (ms)
+
 
 #define DISTANCE_SPEED_OFFSET   30
 #define DISTANCE_SPEED_KP       2.7f
@@ -68,8 +83,8 @@ static enum {
 static LocalCoordinate nedDestination;
 static float destinationTolerance = 0.0, lastHeading = 0.0;
 
-static GeocentricCoordinate ecefError, ecefOrigin;
-static GeodeticCoordinate llaOrigin;
+static GeocentricCoordinate ecefError;
+static LocalOrigin origin; // rotation to NED worked out in setOrigin
 static bool isDone = FALSE;
 static bool hasOrigin = FALSE;
 static bool hasErrorCorrection = FALSE;
@@ -222,17 +237,13 @@ void Navigation_getLocalPosition(LocalCoordinate *nedPosition) {
  * @param A pointer to geocentric coordinate location.
  * @return None
  * @remark Sets the geodetic and ECEF origin point (generally the location
- *  of the command center), by calculating the geodetic from the given
- *  ECEF coordinate.
+ *  of the command center), by calculating the geodetic, and the rotation
+ *  to local (NED) coordinates, from the given ECEF coordinate.
  **********************************************************************/
 void Navigation_setOrigin(GeocentricCoordinate *ecefRef) {
 /*, GeodeticCoordinate *llaRef) { */
-    ecefOrigin.x = ecefRef->x;
-    ecefOrigin.y = ecefRef->y;
-    ecefOrigin.z = ecefRef->z;
-
-    // calculate lla origin from ecef
-    convertECEF2Geodetic(&llaOrigin, ecefRef);
+    // calculate lla origin and its rotation from ecef
+    setLocalOrigin(&origin, ecefRef);
     
 
     hasOrigin = TRUE;
@@ -464,7 +475,17 @@ static void getLocalPosition(LocalCoordinate *nedVar) {
     if (useErrorCorrection)
         applyGeocentricErrorCorrection(&ecefMine);
 
-    convertECEF2NED(nedVar, &ecefMine, &ecefOrigin, &llaOrigin);
+    convertECEF2LocalNED(nedVar, &ecefMine, &origin);
+
+#ifdef USE_LATENCY_COMPENSATION
+    // Account for the time since the fix started arriving (cm/s * ms to m)
+    uint32_t fixTime = GPS_getFixTime();
+    uint32_t age = get_time() - fixTime;
+    if (fixTime != 0 && age < LATENCY_MAX_AGE) {
+        nedVar->north += (float)GPS_getNorthVelocity() * age / 100000.0f;
+        nedVar->east += (float)GPS_getEastVelocity() * age / 100000.0f;
+    }
+#endif
 }
 
 /**********************************************************************
@@ -479,13 +500,15 @@ static void updateHeading() {
     LocalCoordinate nedMine;
     getLocalPosition(&nedMine);
 
-    DBPRINT("My position: N=%.2f, E=%.2f, D=%.2f\n",nedMine.north, nedMine.east, nedMine.down);
+    DBLOG(CONSOLE_NAVIGATION_POSITION, CONSOLE_FLOAT(nedMine.north),
+        CONSOLE_FLOAT(nedMine.east), CONSOLE_FLOAT(nedMine.down));
 
     // Determine needed course
     CourseVector course;
     getCourseVector(&course, &nedMine, &nedDestination);
 
-    DBPRINT("\tCourse: distance=%.2f, heading=%.2f\n",course.distance, course.heading);
+    DBLOG(CONSOLE_NAVIGATION_COURSE, CONSOLE_FLOAT(course.distance),
+        CONSOLE_FLOAT(course.heading));
 
     // Check tolerance
     if (course.distance < destinationTolerance) {
@@ -504,8 +527,8 @@ static void updateHeading() {
     Drive_forwardHeading(speed, (uint16_t)newHeading);
 #endif
 
-    DBPRINT("\tDriving: distance=%.2f [m], speed=%d [\%], heading=%.2f [deg]\n",
-        course.distance, speed, newHeading);
+    DBLOG(CONSOLE_NAVIGATION_DRIVING, CONSOLE_FLOAT(course.distance),
+        CONSOLE_INT(speed), CONSOLE_FLOAT(newHeading));
 
     lastHeading = newHeading;
 }
@@ -563,9 +586,9 @@ static error_t findNavigationError() {
 #define I2C_CLOCK_FREQ  100000 // (Hz)
 
 // Location is BE1 parkinglot bench
-#define ECEF_X_ORIGIN  -2707571.0f
-#define ECEF_Y_ORIGIN -4322145.0f
-#define ECEF_Z_ORIGIN 3817542.0f
+#define ECEF_X_ORIGIN  -270757100 // (cm)
+#define ECEF_Y_ORIGIN -432214500 // (cm)
+#define ECEF_Z_ORIGIN 381754200 // (cm)
 #define GEO_LAT_ORIGIN 37.000042165168395f
 #define GEO_LON_ORIGIN -122.06473588943481f
 #define GEO_ALT_ORIGIN 241.933f
@@ -667,15 +690,15 @@ int main() {
 #define I2C_CLOCK_FREQ  100000 // (Hz)
 
 // --------------- Center of west lake -------------
-#define ECEF_X_ORIGIN -2706922.0f
-#define ECEF_Y_ORIGIN -4324246.0f
-#define ECEF_Z_ORIGIN 3815364.0f
+#define ECEF_X_ORIGIN -270692200 // (cm)
+#define ECEF_Y_ORIGIN -432424600 // (cm)
+#define ECEF_Z_ORIGIN 381536400 // (cm)
 
 // ------- In front of GSH parking lot entrance ------
 /*
-#define ECEF_X_ORIGIN -2707534.0f
-#define ECEF_Y_ORIGIN -4322167.0f
-#define ECEF_Z_ORIGIN  3817539.0f
+#define ECEF_X_ORIGIN -270753400 // (cm)
+#define ECEF_Y_ORIGIN -432216700 // (cm)
+#define ECEF_Z_ORIGIN  381753900 // (cm)
  * */
 ///
 
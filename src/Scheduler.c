@@ -0,0 +1,219 @@
+/**********************************************************************
+ Module
+   Scheduler.c
+
+ Author: David Goodman
+
+ Description
+    Queues outgoing MAVLink frames by priority and sends them as the token
+    bucket allows (see Scheduler.h).
+
+ Notes
+    Each queue is a byte buffer of records packed end to end: the frame's
+    length, its key, the time it was queued, then the frame. Records are
+    removed from the front and replaced in the middle with memmove, which
+    is cheap for queues this small.
+
+    Tokens are kept in thousandths of a byte, so the bucket fills by the
+    rate times the ms passed.
+
+    The writer must take a whole frame or none of it. When the UART's
+    transmit buffer is full, the frame stays at the head of its queue and
+    sending stops until the next Scheduler_runSM.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "Scheduler.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define RECORD_LENGTH       0
+#define RECORD_KEY          1
+#define RECORD_TIME         2
+#define RECORD_FRAME        6 // header size
+
+#define MAX_REFILL_TIME     60000 // (ms) so the refill can't overflow
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static int16_t findRecord(SchedulerQueue *queue, uint8_t key);
+static bool sendFirst(Scheduler *scheduler, SchedulerQueue *queue, uint32_t time);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void Scheduler_init(Scheduler *scheduler, SchedulerWriter write, uint16_t rate,
+        uint16_t burst) {
+    memset(scheduler, 0, sizeof(Scheduler));
+    scheduler->queues[SCHEDULER_PRIORITY_COMMAND].buffer = scheduler->commandBuffer;
+    scheduler->queues[SCHEDULER_PRIORITY_COMMAND].size = SCHEDULER_COMMAND_SIZE;
+    scheduler->queues[SCHEDULER_PRIORITY_STATE].buffer = scheduler->stateBuffer;
+    scheduler->queues[SCHEDULER_PRIORITY_STATE].size = SCHEDULER_STATE_SIZE;
+    scheduler->queues[SCHEDULER_PRIORITY_TELEMETRY].buffer = scheduler->telemetryBuffer;
+    scheduler->queues[SCHEDULER_PRIORITY_TELEMETRY].size = SCHEDULER_TELEMETRY_SIZE;
+    scheduler->queues[SCHEDULER_PRIORITY_DEBUG].buffer = scheduler->debugBuffer;
+    scheduler->queues[SCHEDULER_PRIORITY_DEBUG].size = SCHEDULER_DEBUG_SIZE;
+    scheduler->write = write;
+    scheduler->rate = rate;
+    scheduler->burst = burst;
+    scheduler->tokens = (int32_t)burst * 1000;
+}
+
+bool Scheduler_queue(Scheduler *scheduler, uint8_t priority, uint8_t key,
+        const uint8_t *frame, uint16_t length, uint32_t time) {
+    uint8_t *space = Scheduler_reserve(scheduler, priority, key, length, time);
+    if (space == NULL)
+        return false;
+    memcpy(space, frame, length);
+    Scheduler_commit(scheduler);
+    return true;
+}
+
+uint8_t *Scheduler_reserve(Scheduler *scheduler, uint8_t priority, uint8_t key,
+        uint16_t length, uint32_t time) {
+    SchedulerQueue *queue = &scheduler->queues[priority];
+    uint16_t recordSize = length + RECORD_FRAME, oldSize = 0;
+    int16_t index = -1;
+    uint8_t *record;
+
+    if (key != SCHEDULER_KEY_NONE)
+        index = findRecord(queue, key);
+    if (index >= 0)
+        oldSize = queue->buffer[index + RECORD_LENGTH] + RECORD_FRAME;
+    else
+        index = queue->used;
+    if (scheduler->reserved != NULL || length > UINT8_MAX
+            || queue->used - oldSize + recordSize > queue->size) {
+        queue->droppedCount++;
+        return NULL;
+    }
+
+    // Make room in place of the old record, or at the end
+    record = &queue->buffer[index];
+    memmove(record + recordSize, record + oldSize, queue->used - index - oldSize);
+    queue->used = queue->used - oldSize + recordSize;
+    if (oldSize > 0)
+        queue->replacedCount++;
+
+    record[RECORD_LENGTH] = length;
+    record[RECORD_KEY] = key;
+    memcpy(&record[RECORD_TIME], &time, sizeof(time));
+    queue->queuedCount++;
+    scheduler->reserved = &record[RECORD_FRAME];
+    return scheduler->reserved;
+}
+
+void Scheduler_commit(Scheduler *scheduler) {
+    scheduler->reserved = NULL;
+}
+
+void Scheduler_runSM(Scheduler *scheduler, uint32_t time) {
+    SchedulerQueue *queue;
+    uint32_t elapsed;
+    uint16_t cost;
+    uint8_t i;
+
+    if (scheduler->hasTime) {
+        elapsed = time - scheduler->lastTime;
+        if (elapsed > MAX_REFILL_TIME)
+            elapsed = MAX_REFILL_TIME;
+        scheduler->tokens += (int32_t)(elapsed * scheduler->rate);
+        if (scheduler->tokens > (int32_t)scheduler->burst * 1000)
+            scheduler->tokens = (int32_t)scheduler->burst * 1000;
+    }
+    scheduler->lastTime = time;
+    scheduler->hasTime = true;
+    if (scheduler->reserved != NULL)
+        return; // a frame is still being written
+
+    for (i = 0; i < SCHEDULER_PRIORITIES; i++) {
+        queue = &scheduler->queues[i];
+        while (queue->used > 0) {
+            // A frame bigger than the burst goes once the bucket is full
+            cost = queue->buffer[RECORD_LENGTH];
+            if (cost > scheduler->burst)
+                cost = scheduler->burst;
+            // Lower classes wait too, so they can't starve this one
+            if (i != SCHEDULER_PRIORITY_COMMAND
+                    && scheduler->tokens < (int32_t)cost * 1000)
+                return;
+            if (!sendFirst(scheduler, queue, time))
+                return; // link is full, try again next time
+        }
+    }
+}
+
+bool Scheduler_isQueued(Scheduler *scheduler, uint8_t key) {
+    uint8_t i;
+    for (i = 0; i < SCHEDULER_PRIORITIES; i++) {
+        if (findRecord(&scheduler->queues[i], key) >= 0)
+            return true;
+    }
+    return false;
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: findRecord
+ * @param Queue.
+ * @param Key of a frame.
+ * @return Offset of the frame's record in the queue, or -1.
+ **********************************************************************/
+static int16_t findRecord(SchedulerQueue *queue, uint8_t key) {
+    uint16_t index = 0;
+    while (index < queue->used) {
+        if (queue->buffer[index + RECORD_KEY] == key)
+            return index;
+        index += queue->buffer[index + RECORD_LENGTH] + RECORD_FRAME;
+    }
+    return -1;
+}
+
+/**********************************************************************
+ * Function: sendFirst
+ * @param Scheduler.
+ * @param Queue that isn't empty.
+ * @param Current time (ms).
+ * @return TRUE if the frame was written, FALSE if the link refused it.
+ * @remark Writes the oldest frame in the queue and pays for it. A refused
+ *  frame is left in the queue and costs nothing.
+ **********************************************************************/
+static bool sendFirst(Scheduler *scheduler, SchedulerQueue *queue, uint32_t time) {
+    uint8_t *record = queue->buffer;
+    uint16_t recordSize = record[RECORD_LENGTH] + RECORD_FRAME;
+    uint32_t queuedTime;
+
+    if (scheduler->write(&record[RECORD_FRAME], record[RECORD_LENGTH])
+            < record[RECORD_LENGTH]) {
+        queue->refusedCount++;
+        return false;
+    }
+    queue->sentCount++;
+    memcpy(&queuedTime, &record[RECORD_TIME], sizeof(queuedTime));
+    if (time - queuedTime > queue->maxWait)
+        queue->maxWait = time - queuedTime;
+
+    // Commands can run the bucket into debt, but only by one burst
+    scheduler->tokens -= (int32_t)record[RECORD_LENGTH] * 1000;
+    if (scheduler->tokens < -(int32_t)scheduler->burst * 1000)
+        scheduler->tokens = -(int32_t)scheduler->burst * 1000;
+
+    memmove(record, record + recordSize, queue->used - recordSize);
+    queue->used -= recordSize;
+    return true;
+}
@@ -13,6 +13,7 @@
 #include <xc.h>
 #include <peripheral/uart.h>
 #include <stdint.h>
+#include <string.h>
 #include "Board.h"
 #include "Serial.h"
 #include "Uart.h"
@@ -22,6 +23,7 @@
 
 #define SERIAL_UART_ID         UART1_ID
 #define SERIAL_UART_BAUDRATE   115200
+#define SERIAL_BLOCK_TIMEOUT   50 // (ms) longest printf waits for buffer space
 
 
 /*******************************************************************************
@@ -159,6 +161,29 @@ char Serial_getChar(void)
     return UART_getChar(SERIAL_UART_ID);
 }
 
+/****************************************************************************
+ Function
+     Serial_getUartId
+
+ Parameters
+     None.
+
+ Returns
+    The UART module used by the serial console.
+
+ Description
+    Lets other modules (e.g. the console) write to the serial port directly.
+ Notes
+
+
+ Author
+ David Goodman, 2026.10.18
+ ****************************************************************************/
+uint8_t Serial_getUartId(void)
+{
+    return SERIAL_UART_ID;
+}
+
 /****************************************************************************
  Function
      _mon_putc
@@ -180,7 +205,10 @@ char Serial_getChar(void)
  ****************************************************************************/
 void _mon_putc(char c)
 {
-    Serial_putChar(c);
+    if (canBlock)
+        UART_write(SERIAL_UART_ID, (const uint8_t*)&c, 1, UART_WRITE_WAIT, SERIAL_BLOCK_TIMEOUT);
+    else
+        Serial_putChar(c);
 }
 
 /****************************************************************************
@@ -204,10 +232,9 @@ void _mon_putc(char c)
  ****************************************************************************/
 void _mon_puts(const char* s)
 {
-    int i;
     if (canBlock) {
-        for (i = 0; i<sizeof (s); i++)
-            Serial_putChar(s[i]);
+        UART_write(SERIAL_UART_ID, (const uint8_t*)s, strlen(s), UART_WRITE_WAIT,
+            SERIAL_BLOCK_TIMEOUT);
     }
     else {
         bufferIndex = 0;
@@ -0,0 +1,118 @@
+/**********************************************************************
+ Module
+   Telemetry.c
+
+ Author: David Goodman
+
+ Description
+    Packs the boat's state as BOAT_STATE keyframes and BOAT_STATE_DELTA
+    frames, and rebuilds it on the receiving side (see Telemetry.h).
+
+ Notes
+    Deltas carry heading in whole degrees, so a rebuilt heading can be off
+    by half a degree. Everything else is exact.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "Telemetry.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define HEADING_FULL_CIRCLE     36000 // (0.01 degrees)
+#define HEADING_DELTA_SCALE     100 // (0.01 degrees) per delta unit
+
+#define FITS_INT8(x)            ((x) >= INT8_MIN && (x) <= INT8_MAX)
+#define FITS_INT16(x)           ((x) >= INT16_MIN && (x) <= INT16_MAX)
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void Telemetry_initEncoder(TelemetryEncoder *encoder) {
+    memset(encoder, 0, sizeof(TelemetryEncoder));
+}
+
+uint8_t Telemetry_encode(TelemetryEncoder *encoder, const mavlink_boat_state_t *state,
+        TelemetryPayload *payload, uint8_t *msgid) {
+    mavlink_boat_state_t *key = &encoder->keyframe;
+    int32_t north = state->north - key->north;
+    int32_t east = state->east - key->east;
+    int32_t speed = (int32_t)state->speed - key->speed;
+    int32_t heading = (int32_t)state->heading - key->heading;
+    uint8_t number = key->keyframe + 1;
+
+    // Shortest way around, rounded to whole degrees
+    if (heading > HEADING_FULL_CIRCLE/2)
+        heading -= HEADING_FULL_CIRCLE;
+    else if (heading <= -HEADING_FULL_CIRCLE/2)
+        heading += HEADING_FULL_CIRCLE;
+    heading = (heading + ((heading >= 0) ? 1 : -1)*HEADING_DELTA_SCALE/2)
+        / HEADING_DELTA_SCALE;
+
+    encoder->frameCount++;
+    if (encoder->hasKeyframe && encoder->frameCount < TELEMETRY_KEYFRAME_INTERVAL
+            && state->navState == key->navState && state->error == key->error
+            && FITS_INT16(north) && FITS_INT16(east) && FITS_INT8(speed)
+            && FITS_INT8(heading)) {
+        payload->delta.ack = 0;
+        payload->delta.keyframe = key->keyframe;
+        payload->delta.north = north;
+        payload->delta.east = east;
+        payload->delta.heading = heading;
+        payload->delta.speed = speed;
+        *msgid = MAVLINK_MSG_ID_BOAT_STATE_DELTA;
+        return MAVLINK_MSG_ID_BOAT_STATE_DELTA_LEN;
+    }
+
+    memcpy(key, state, sizeof(mavlink_boat_state_t));
+    key->ack = 0;
+    key->keyframe = encoder->hasKeyframe ? number : 0;
+    encoder->frameCount = 0;
+    encoder->hasKeyframe = true;
+    memcpy(&payload->keyframe, key, sizeof(mavlink_boat_state_t));
+    *msgid = MAVLINK_MSG_ID_BOAT_STATE;
+    return MAVLINK_MSG_ID_BOAT_STATE_LEN;
+}
+
+void Telemetry_initDecoder(TelemetryDecoder *decoder) {
+    memset(decoder, 0, sizeof(TelemetryDecoder));
+}
+
+bool Telemetry_unpack(TelemetryDecoder *decoder, uint8_t msgid,
+        const uint8_t *payload, uint8_t length, mavlink_boat_state_t *state) {
+    mavlink_boat_state_delta_t delta;
+    int32_t heading;
+
+    if (msgid == MAVLINK_MSG_ID_BOAT_STATE) {
+        memcpy(&decoder->keyframe, payload, length);
+        memcpy(state, &decoder->keyframe, sizeof(mavlink_boat_state_t));
+        decoder->hasKeyframe = true;
+        return true;
+    }
+
+    memcpy(&delta, payload, length);
+    if (!decoder->hasKeyframe || delta.keyframe != decoder->keyframe.keyframe) {
+        decoder->droppedCount++;
+        return false;
+    }
+    memcpy(state, &decoder->keyframe, sizeof(mavlink_boat_state_t));
+    state->north += delta.north;
+    state->east += delta.east;
+    state->speed += delta.speed;
+    heading = state->heading + (int32_t)delta.heading*HEADING_DELTA_SCALE;
+    if (heading < 0)
+        heading += HEADING_FULL_CIRCLE;
+    else if (heading >= HEADING_FULL_CIRCLE)
+        heading -= HEADING_FULL_CIRCLE;
+    state->heading = heading;
+    return true;
+}
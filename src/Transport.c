@@ -0,0 +1,281 @@
+/**********************************************************************
+ Module
+   Transport.c
+
+ Author: David Goodman
+
+ Description
+    Resends MAVLink messages until they are acked, and drops repeated
+    frames on the receiving side (see Transport.h).
+
+ Notes
+    Timeouts are kept in whole ms. The smoothed RTT and its deviation are
+    updated with gains of 1/8 and 1/4, and the timeout for a new message is
+    the smoothed RTT plus four deviations, within TRANSPORT_MIN_TIMEOUT and
+    TRANSPORT_MAX_TIMEOUT.
+
+    Sequence numbers are only 8 bits, so a repeat is only recognized within
+    TRANSPORT_RECENT_AGE of the first copy. A sender must not get through
+    256 frames in that time, or a new frame could be taken for a repeat.
+
+    A repeat is only dropped while the first copy waits in the receive
+    queue. Once delivered and not acked, the state machine passed on it,
+    so the repeat is handed over again instead of dropped until the
+    sender gives up.
+
+    When every slot is waiting for an ACK, a new message takes the slot of
+    the one sent first, which is given up on. Its ID and status are kept,
+    so Transport_getStatus reports it as ACK_STATUS_DEAD until it is sent
+    again or another message is evicted.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "Transport.h"
+
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static TransportSlot *findSlot(Transport *transport, uint8_t msgID,
+    uint16_t msgStatus);
+static void addRttSample(Transport *transport, uint32_t rtt);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void Transport_init(Transport *transport, TransportWriter write) {
+    memset(transport, 0, sizeof(Transport));
+    transport->write = write;
+    transport->timeout = TRANSPORT_INITIAL_TIMEOUT;
+}
+
+bool Transport_send(Transport *transport, const uint8_t *frame, uint16_t length,
+        uint8_t msgID, uint16_t msgStatus, uint32_t time) {
+    TransportSlot *slot = findSlot(transport, msgID, msgStatus);
+    TransportSlot *other, *oldest = NULL, *oldestWaiting = NULL;
+    uint8_t i;
+
+    transport->write(frame, length);
+    transport->sentCount++;
+    if (transport->hasEvicted && transport->evictedMsgID == msgID
+            && transport->evictedMsgStatus == msgStatus)
+        transport->hasEvicted = false; // sent again
+    if (length > TRANSPORT_FRAME_SIZE) {
+        if (slot != NULL)
+            slot->ackStatus = ACK_STATUS_NO_ACK;
+        return false;
+    }
+
+    // Take a free slot, or else the one that finished longest ago
+    for (i = 0; slot == NULL && i < TRANSPORT_SLOTS; i++) {
+        other = &transport->slots[i];
+        if (other->ackStatus == ACK_STATUS_NO_ACK)
+            slot = other;
+        else if (other->ackStatus != ACK_STATUS_WAIT) {
+            if (oldest == NULL
+                    || (int32_t)(other->lastSendTime - oldest->lastSendTime) < 0)
+                oldest = other;
+        }
+        else if (oldestWaiting == NULL
+                || (int32_t)(other->firstSendTime - oldestWaiting->firstSendTime) < 0)
+            oldestWaiting = other;
+    }
+    if (slot == NULL)
+        slot = oldest;
+    if (slot == NULL) {
+        // All waiting, so give up on the one sent first, and remember it
+        slot = oldestWaiting;
+        transport->hasEvicted = true;
+        transport->evictedMsgID = slot->msgID;
+        transport->evictedMsgStatus = slot->msgStatus;
+        transport->failedCount++;
+    }
+
+    memcpy(slot->frame, frame, length);
+    slot->length = length;
+    slot->msgID = msgID;
+    slot->msgStatus = msgStatus;
+    slot->ackStatus = ACK_STATUS_WAIT;
+    slot->sendCount = 1;
+    slot->firstSendTime = time;
+    slot->lastSendTime = time;
+    slot->timeout = transport->timeout;
+    return true;
+}
+
+bool Transport_handleAck(Transport *transport, uint8_t msgID, uint16_t msgStatus,
+        uint32_t time) {
+    TransportSlot *slot = findSlot(transport, msgID, msgStatus);
+    if (slot == NULL || slot->ackStatus != ACK_STATUS_WAIT)
+        return false;
+
+    // Can't tell which copy a resent message's ACK is for
+    if (slot->sendCount == 1)
+        addRttSample(transport, time - slot->lastSendTime);
+    slot->ackStatus = ACK_STATUS_RECIEVED;
+    transport->deliveredCount++;
+    return true;
+}
+
+void Transport_runSM(Transport *transport, uint32_t time) {
+    TransportSlot *slot;
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_SLOTS; i++) {
+        slot = &transport->slots[i];
+        if (slot->ackStatus != ACK_STATUS_WAIT
+                || time - slot->lastSendTime < slot->timeout)
+            continue;
+
+        if (time - slot->firstSendTime >= TRANSPORT_DELIVERY_TIMEOUT) {
+            slot->ackStatus = ACK_STATUS_DEAD;
+            transport->failedCount++;
+            continue;
+        }
+        transport->write(slot->frame, slot->length);
+        transport->resentCount++;
+        slot->sendCount++;
+        slot->lastSendTime = time;
+        slot->timeout *= 2;
+        if (slot->timeout > TRANSPORT_MAX_TIMEOUT)
+            slot->timeout = TRANSPORT_MAX_TIMEOUT;
+    }
+}
+
+uint8_t Transport_getStatus(Transport *transport, uint8_t msgID, uint16_t msgStatus) {
+    TransportSlot *slot = findSlot(transport, msgID, msgStatus);
+    if (slot != NULL)
+        return slot->ackStatus;
+    if (transport->hasEvicted && transport->evictedMsgID == msgID
+            && transport->evictedMsgStatus == msgStatus)
+        return ACK_STATUS_DEAD;
+    return ACK_STATUS_NO_ACK;
+}
+
+void Transport_cancel(Transport *transport) {
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_SLOTS; i++)
+        transport->slots[i].ackStatus = ACK_STATUS_NO_ACK;
+    transport->hasEvicted = false;
+}
+
+uint8_t Transport_receive(Transport *transport, uint8_t sysID, uint8_t msgID,
+        uint8_t seq, uint32_t time, uint16_t *ackStatus) {
+    TransportRecent *recent;
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_RECENT_SIZE; i++) {
+        recent = &transport->recent[i];
+        // Sequence numbers wrap, so forget frames older than any resend
+        if (recent->sysID != sysID || recent->msgID != msgID || recent->seq != seq
+                || recent->time == 0 || time - recent->time > TRANSPORT_RECENT_AGE)
+            continue;
+        if (recent->isAcked) {
+            transport->duplicateCount++;
+            *ackStatus = recent->ackStatus;
+            return TRANSPORT_DUPLICATE_ACKED;
+        }
+        if (!recent->isDelivered) {
+            transport->duplicateCount++;
+            return TRANSPORT_DUPLICATE; // first copy is still queued
+        }
+        recent->isDelivered = false; // ignored, so try again
+        return TRANSPORT_NEW_FRAME;
+    }
+
+    recent = &transport->recent[transport->recentNext];
+    transport->recentNext = (transport->recentNext + 1) % TRANSPORT_RECENT_SIZE;
+    recent->sysID = sysID;
+    recent->msgID = msgID;
+    recent->seq = seq;
+    recent->isDelivered = false;
+    recent->isAcked = false;
+    recent->time = (time != 0) ? time : 1;
+    return TRANSPORT_NEW_FRAME;
+}
+
+void Transport_delivered(Transport *transport, uint8_t sysID, uint8_t msgID,
+        uint8_t seq) {
+    TransportRecent *recent;
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_RECENT_SIZE; i++) {
+        recent = &transport->recent[i];
+        if (recent->time != 0 && recent->sysID == sysID && recent->msgID == msgID
+                && recent->seq == seq) {
+            recent->isDelivered = true;
+            return;
+        }
+    }
+}
+
+void Transport_sentAck(Transport *transport, uint8_t sysID, uint8_t msgID, uint8_t seq,
+        uint16_t msgStatus) {
+    TransportRecent *recent;
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_RECENT_SIZE; i++) {
+        recent = &transport->recent[i];
+        if (recent->time != 0 && recent->sysID == sysID && recent->msgID == msgID
+                && recent->seq == seq) {
+            recent->isAcked = true;
+            recent->ackStatus = msgStatus;
+            return;
+        }
+    }
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: findSlot
+ * @param Transport.
+ * @param Message ID.
+ * @param Message status.
+ * @return Slot tracking the message, or NULL.
+ **********************************************************************/
+static TransportSlot *findSlot(Transport *transport, uint8_t msgID,
+        uint16_t msgStatus) {
+    uint8_t i;
+    for (i = 0; i < TRANSPORT_SLOTS; i++) {
+        if (transport->slots[i].ackStatus != ACK_STATUS_NO_ACK
+                && transport->slots[i].msgID == msgID
+                && transport->slots[i].msgStatus == msgStatus)
+            return &transport->slots[i];
+    }
+    return NULL;
+}
+
+/**********************************************************************
+ * Function: addRttSample
+ * @param Transport.
+ * @param Measured round trip time (ms).
+ * @return None.
+ * @remark Updates the smoothed RTT and the timeout for new messages.
+ **********************************************************************/
+static void addRttSample(Transport *transport, uint32_t rtt) {
+    uint32_t error;
+    if (!transport->hasRtt) {
+        transport->smoothedRtt = rtt;
+        transport->rttVariance = rtt / 2;
+        transport->hasRtt = true;
+    }
+    else {
+        error = (rtt > transport->smoothedRtt) ? rtt - transport->smoothedRtt
+            : transport->smoothedRtt - rtt;
+        transport->rttVariance = (3*transport->rttVariance + error) / 4;
+        transport->smoothedRtt = (7*transport->smoothedRtt + rtt) / 8;
+    }
+
+    transport->timeout = transport->smoothedRtt + 4*transport->rttVariance;
+    if (transport->timeout < TRANSPORT_MIN_TIMEOUT)
+        transport->timeout = TRANSPORT_MIN_TIMEOUT;
+    else if (transport->timeout > TRANSPORT_MAX_TIMEOUT)
+        transport->timeout = TRANSPORT_MAX_TIMEOUT;
+}
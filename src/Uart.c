@@ -3,12 +3,31 @@
    Uart.c
 
  Revision
-   1.0.0
+   1.1.0
 
  Description
  Code for initilazing and running the UART
 
  Notes
+ Each UART module is described by an entry in the port table, indexed by
+ its id, with its own transmit and receive ring buffers. Buffer sizes are
+ set per port with UARTn_TX_BUFFER_SIZE and UARTn_RX_BUFFER_SIZE (powers of
+ two), which a project can override, e.g. a large receive buffer for the
+ GPS and a small transmit buffer for the debug console. The PIC32MX320F128H
+ only has UART1 and UART2; UART3 to UART6 are built on parts that have them.
+
+ The ISR empties the receive FIFO and fills the transmit FIFO on every entry.
+ The receive interrupt fires at UART_RX_INTERRUPT_MODE, so a few bytes can sit
+ in the FIFO below the threshold when the line goes idle; the reading
+ functions flush those into the receive buffer first. The transmit interrupt
+ is only enabled while there is data waiting to be sent.
+
+ The ISR also timestamps received data. When bytes arrive after the line has
+ been idle for UART_IDLE_BYTES byte times, it records a mark with the receive
+ buffer index of the first byte and its arrival time, worked back from the
+ number of bytes found in the FIFO. UART_getReceiveTime finds the latest mark
+ at or before a byte and adds one byte time per byte after it, so a parser
+ can learn when the first byte of a frame arrived.
 
  History
  When           Who         What/Why
@@ -16,14 +35,25 @@
  1-18-13 8:10 PM jash    Used file from Max Dunne/ created
  1-22-13 5:24 PM jash    Move functions from Serial.c to Uart.c
  1-23-13 11:20AM jash    Make two circular buffers
+ 10-18-26        dagoodma Bulk UART_write, no per-byte delay in putString
+ 10-18-26        dagoodma Replace CircBuffer with lock-free RingBuffer
+ 10-18-26        dagoodma Zero-copy receive spans with peek and consume
+ 10-18-26        dagoodma Table-driven ports with per-port buffer sizes
+ 10-18-26        dagoodma Batch bytes through the hardware FIFOs per interrupt
+ 10-18-26        dagoodma Byte, drop, peak and interrupt time statistics
+ 10-18-26        dagoodma Receive timestamps on idle-to-active transitions
+ 10-18-26        dagoodma Change the baud rate without resetting the buffers
 ***********************************************************************/
 
 
 #include <xc.h>
 #include <peripheral/uart.h>
 #include <stdint.h>
+#include <string.h>
 #include "Uart.h"
 #include "Board.h"
+#include "Timer.h"
+#include "RingBuffer.h"
 #include <ports.h>
 
 
@@ -31,44 +61,174 @@
  * PRIVATE DEFINITIONS                                                 *
  ***********************************************************************/
 #define F_PB (Board_GetPBClock())
-#define QUEUESIZE 512
+#define QUEUESIZE 512 // default buffer size, must be a power of two
+
+#define UART_INTERRUPT_PRIORITY     INT_PRIORITY_LEVEL_4 // must match the ISRs
+
+// Receive FIFO level that raises the interrupt, one of UART_INTERRUPT_ON_RX_*
+#ifndef UART_RX_INTERRUPT_MODE
+#define UART_RX_INTERRUPT_MODE      UART_INTERRUPT_ON_RX_HALF_FULL
+#endif
+
+#define INTERRUPT_RATE_PERIOD       1000 // (ms) window for the interrupt rate
+
+// Idle gap that starts a new receive timestamp mark (byte times)
+#ifndef UART_IDLE_BYTES
+#define UART_IDLE_BYTES             4
+#endif
+
+#define RECEIVE_MARKS               8 // marks kept per port, power of two
+#define BITS_PER_BYTE               10 // start, 8 data and stop bits
+#define CORE_TICKS_PER_US           40 // core timer runs at SYSCLK/2
+
+// Buffer sizes for each port (bytes)
+#ifndef UART1_TX_BUFFER_SIZE
+#define UART1_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART1_RX_BUFFER_SIZE
+#define UART1_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART2_TX_BUFFER_SIZE
+#define UART2_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART2_RX_BUFFER_SIZE
+#define UART2_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART3_TX_BUFFER_SIZE
+#define UART3_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART3_RX_BUFFER_SIZE
+#define UART3_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART4_TX_BUFFER_SIZE
+#define UART4_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART4_RX_BUFFER_SIZE
+#define UART4_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART5_TX_BUFFER_SIZE
+#define UART5_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART5_RX_BUFFER_SIZE
+#define UART5_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART6_TX_BUFFER_SIZE
+#define UART6_TX_BUFFER_SIZE    QUEUESIZE
+#endif
+#ifndef UART6_RX_BUFFER_SIZE
+#define UART6_RX_BUFFER_SIZE    QUEUESIZE
+#endif
+
+// Number of UART modules on this part
+#if defined(_UART6)
+#define UART_PORTS  6
+#elif defined(_UART5)
+#define UART_PORTS  5
+#elif defined(_UART4)
+#define UART_PORTS  4
+#elif defined(_UART3)
+#define UART_PORTS  3
+#else
+#define UART_PORTS  2
+#endif
+
+// Fails to compile if a buffer size is not a usable power of two
+#define CHECK_BUFFER_SIZE(name, size) \
+    typedef char name[RINGBUFFER_IS_VALID_SIZE(size) ? 1 : -1]
 
 /*******************************************************************************
  * PRIVATE DATATYPES                                                           *
  ******************************************************************************/
-typedef struct CircBuffer {
-    unsigned char buffer[QUEUESIZE];
-    int head;
-    int tail;
-    unsigned int size;
-    unsigned char overflowCount;
-} CircBuffer;
-typedef struct CircBuffer* CBRef;
-
+// Arrival time of the first byte after an idle line
+typedef struct ReceiveMark {
+    uint16_t index;     // free-running receive buffer index of the byte
+    uint32_t time;      // (ms) arrival time of the byte
+} ReceiveMark;
+
+typedef struct UartPort {
+    UART_MODULE module;
+    uint8_t *transmitData;
+    uint16_t transmitSize;
+    uint8_t *receiveData;
+    uint16_t receiveSize;
+    bool isInitialized;
+    RingBuffer transmitBuffer;
+    RingBuffer receiveBuffer;
+    volatile UartStatistics stats; // receiveDropped is kept by the ring buffer
+    uint32_t lastInterruptCount;
+    uint32_t lastRateTime;
+    uint32_t interruptRate;
+    uint16_t byteMicros;            // (us) time to receive one byte
+    uint32_t lastReceiveTicks;      // core timer when the last byte was drained
+    ReceiveMark marks[RECEIVE_MARKS];
+    uint8_t markHead, markTail;     // free-running, changed with the ISR held off
+} UartPort;
 
 /*******************************************************************************
  * PRIVATE FUNCTIONS PROTOTYPES                                                *
  ******************************************************************************/
-void newCircBuffer(CBRef cB);
-void freeCircBuffer(CBRef* cB);
-unsigned int getLength(CBRef cB);
-int readHead(CBRef cB);
-int readTail(CBRef cB);
-unsigned char peak(CBRef cB);
-unsigned char readFront(CBRef cB);
-unsigned char writeBack(CBRef cB, unsigned char data);
+static UartPort *getPort(uint8_t id);
+static void startTransmit(UartPort *port);
+static void flushReceive(UartPort *port);
+static void receiveBytes(UartPort *port, bool isInterrupt);
+static void addReceiveMark(UartPort *port, uint16_t index, uint32_t time);
+static void updateTransmitPeak(UartPort *port);
+static void updateReceivePeak(UartPort *port);
+static void handleInterrupt(UartPort *port);
 
 /*******************************************************************************
  * PRIVATE VARIABLES                                                           *
  ******************************************************************************/
-static struct CircBuffer outgoingUart1;
-static CBRef transmitBufferUart1;
-static struct CircBuffer incomingUart1;
-static CBRef receiveBufferUart1;
-static struct CircBuffer outgoingUart2;
-static CBRef transmitBufferUart2;
-static struct CircBuffer incomingUart2;
-static CBRef receiveBufferUart2;
+CHECK_BUFFER_SIZE(checkUart1Transmit, UART1_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart1Receive, UART1_RX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart2Transmit, UART2_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart2Receive, UART2_RX_BUFFER_SIZE);
+static uint8_t outgoingUart1[UART1_TX_BUFFER_SIZE];
+static uint8_t incomingUart1[UART1_RX_BUFFER_SIZE];
+static uint8_t outgoingUart2[UART2_TX_BUFFER_SIZE];
+static uint8_t incomingUart2[UART2_RX_BUFFER_SIZE];
+#if UART_PORTS >= 3
+CHECK_BUFFER_SIZE(checkUart3Transmit, UART3_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart3Receive, UART3_RX_BUFFER_SIZE);
+static uint8_t outgoingUart3[UART3_TX_BUFFER_SIZE];
+static uint8_t incomingUart3[UART3_RX_BUFFER_SIZE];
+#endif
+#if UART_PORTS >= 4
+CHECK_BUFFER_SIZE(checkUart4Transmit, UART4_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart4Receive, UART4_RX_BUFFER_SIZE);
+static uint8_t outgoingUart4[UART4_TX_BUFFER_SIZE];
+static uint8_t incomingUart4[UART4_RX_BUFFER_SIZE];
+#endif
+#if UART_PORTS >= 5
+CHECK_BUFFER_SIZE(checkUart5Transmit, UART5_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart5Receive, UART5_RX_BUFFER_SIZE);
+static uint8_t outgoingUart5[UART5_TX_BUFFER_SIZE];
+static uint8_t incomingUart5[UART5_RX_BUFFER_SIZE];
+#endif
+#if UART_PORTS >= 6
+CHECK_BUFFER_SIZE(checkUart6Transmit, UART6_TX_BUFFER_SIZE);
+CHECK_BUFFER_SIZE(checkUart6Receive, UART6_RX_BUFFER_SIZE);
+static uint8_t outgoingUart6[UART6_TX_BUFFER_SIZE];
+static uint8_t incomingUart6[UART6_RX_BUFFER_SIZE];
+#endif
+
+// Port table, indexed by (id - 1)
+static UartPort ports[UART_PORTS] = {
+    { UART1, outgoingUart1, UART1_TX_BUFFER_SIZE, incomingUart1, UART1_RX_BUFFER_SIZE },
+    { UART2, outgoingUart2, UART2_TX_BUFFER_SIZE, incomingUart2, UART2_RX_BUFFER_SIZE },
+#if UART_PORTS >= 3
+    { UART3, outgoingUart3, UART3_TX_BUFFER_SIZE, incomingUart3, UART3_RX_BUFFER_SIZE },
+#endif
+#if UART_PORTS >= 4
+    { UART4, outgoingUart4, UART4_TX_BUFFER_SIZE, incomingUart4, UART4_RX_BUFFER_SIZE },
+#endif
+#if UART_PORTS >= 5
+    { UART5, outgoingUart5, UART5_TX_BUFFER_SIZE, incomingUart5, UART5_RX_BUFFER_SIZE },
+#endif
+#if UART_PORTS >= 6
+    { UART6, outgoingUart6, UART6_TX_BUFFER_SIZE, incomingUart6, UART6_RX_BUFFER_SIZE },
+#endif
+};
 
 
 
@@ -89,156 +249,257 @@ static CBRef receiveBufferUart2;
  **********************************************************************/
 
 void UART_init(uint8_t id, uint32_t baudRate){
+    UartPort *port;
+    if (id < UART1_ID || id > UART_PORTS)
+        return;
+    port = &ports[id - 1];
+
+    RingBuffer_init(&port->transmitBuffer, port->transmitData, port->transmitSize);
+    RingBuffer_init(&port->receiveBuffer, port->receiveData, port->receiveSize);
+
+    UARTConfigure(port->module, 0x00);
+    UARTSetDataRate(port->module, F_PB, baudRate);
+    UARTSetFifoMode(port->module, UART_INTERRUPT_ON_TX_BUFFER_EMPTY | UART_RX_INTERRUPT_MODE);
+
+    //set the interrupt priority
+    INTSetVectorPriority(INT_VECTOR_UART(port->module), UART_INTERRUPT_PRIORITY);
+    INTSetVectorSubPriority(INT_VECTOR_UART(port->module), INT_SUB_PRIORITY_LEVEL_0);
+
+    UARTEnable(port->module, UART_ENABLE_FLAGS(UART_PERIPHERAL | UART_TX | UART_RX));
+    port->isInitialized = TRUE;
+    memset((void*)&port->stats, 0, sizeof(port->stats));
+    port->lastInterruptCount = 0;
+    port->lastRateTime = 0;
+    port->interruptRate = 0;
+    port->byteMicros = (BITS_PER_BYTE * 1000000UL + baudRate / 2) / baudRate;
+    port->lastReceiveTicks = ReadCoreTimer();
+    port->markHead = 0;
+    port->markTail = 0;
+    // transmit interrupt is enabled by startTransmit when there is data
+    INTEnable(INT_SOURCE_UART_TX(port->module), INT_DISABLED);
+    INTEnable(INT_SOURCE_UART_RX(port->module), INT_ENABLED);
+}
 
-    //will need buffers for both the UARTS
-    if(id == UART1_ID){
-        transmitBufferUart1 = (struct CircBuffer*) &outgoingUart1; //set up buffer for receive
-        newCircBuffer(transmitBufferUart1);
-
-        receiveBufferUart1 = (struct CircBuffer*) &incomingUart1; //set up buffer for transmit
-        newCircBuffer(receiveBufferUart1);
-
-        UARTConfigure(UART1, 0x00);
-        UARTSetDataRate(UART1, F_PB, baudRate);
-        UARTSetFifoMode(UART1, UART_INTERRUPT_ON_RX_NOT_EMPTY);
+void UART_setBaudRate(uint8_t id, uint32_t baudRate)
+{
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return;
 
-        mU1SetIntPriority(4); //set the interrupt priority
+    UARTEnable(port->module, UART_DISABLE_FLAGS(UART_PERIPHERAL | UART_TX | UART_RX));
+    UARTSetDataRate(port->module, F_PB, baudRate);
+    port->byteMicros = (BITS_PER_BYTE * 1000000UL + baudRate / 2) / baudRate;
+    UARTEnable(port->module, UART_ENABLE_FLAGS(UART_PERIPHERAL | UART_TX | UART_RX));
+}
 
-        UARTEnable(UART1, UART_ENABLE_FLAGS(UART_PERIPHERAL | UART_TX | UART_RX));
-        mU1RXIntEnable(1);
-        mU1TXIntEnable(1);
-    }else if(id == UART2_ID){
-        transmitBufferUart2 = (struct CircBuffer*) &outgoingUart2; //set up buffer for receive
-        newCircBuffer(transmitBufferUart2);
+void UART_putChar(uint8_t id, char ch)
+{
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return;
+    if (RingBuffer_put(&port->transmitBuffer, ch)) {
+        updateTransmitPeak(port);
+        startTransmit(port);
+    }
+    else {
+        port->stats.transmitDropped++;
+    }
+}
 
-        receiveBufferUart2 = (struct CircBuffer*) &incomingUart2; //set up buffer for transmit
-        newCircBuffer(receiveBufferUart2);
+void UART_putString(uint8_t id, char* Data, int Length){
+    if (Length <= 0)
+        return;
+    UART_write(id, (const uint8_t*)Data, (uint16_t)Length, UART_WRITE_REJECT, 0);
+}
 
-        UARTConfigure(UART2, 0x00);
-        UARTSetDataRate(UART2, F_PB, baudRate);
-        UARTSetFifoMode(UART2, UART_INTERRUPT_ON_RX_NOT_EMPTY);
+uint16_t UART_write(uint8_t id, const uint8_t *data, uint16_t length,
+    uint8_t policy, uint16_t timeout) {
+    UartPort *port = getPort(id);
+    uint16_t written;
+    uint32_t startTime;
 
-        mU2SetIntPriority(4); //set the interrupt priority
+    if (port == NULL || data == NULL || length == 0)
+        return 0;
 
-        UARTEnable(UART2, UART_ENABLE_FLAGS(UART_PERIPHERAL | UART_TX | UART_RX));
-        mU2RXIntEnable(1);
-        mU2TXIntEnable(1);
+    if (policy == UART_WRITE_REJECT && RingBuffer_getSpace(&port->transmitBuffer) < length) {
+        port->stats.transmitDropped += length;
+        return 0;
     }
-}
 
-void UART_putChar(uint8_t id, char ch)
-{
-    if(id == UART1_ID){
-        if (getLength(transmitBufferUart1) != QUEUESIZE) {
-            writeBack(transmitBufferUart1, ch);
-            if (U1STAbits.TRMT) {
-                IFS0bits.U1TXIF = 1;
-            }
-        }
-    }else if(id == UART2_ID){
-        if (getLength(transmitBufferUart2) != QUEUESIZE) {
-            writeBack(transmitBufferUart2, ch);
-            if (U2STAbits.TRMT) {
-                IFS1bits.U2TXIF = 1;
-            }
+    written = RingBuffer_write(&port->transmitBuffer, data, length);
+    updateTransmitPeak(port);
+    startTransmit(port);
+
+    if (policy == UART_WRITE_WAIT && written < length && Timer_isInitialized()) {
+        // Let the ISR drain until the rest fits or we run out of time
+        startTime = get_time();
+        while (written < length && (get_time() - startTime) < timeout) {
+            written += RingBuffer_write(&port->transmitBuffer, data + written, length - written);
+            startTransmit(port);
         }
     }
+    port->stats.transmitDropped += length - written;
+    return written;
 }
 
-void UART_putString(uint8_t id, char* Data, int Length){
-    int x;
-    for(x = 0; x < Length; x++){
-        UART_putChar(id, Data[x]);
-        DELAY(10);
-    }
+uint16_t UART_getTransmitSpace(uint8_t id) {
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return 0;
+    return RingBuffer_getSpace(&port->transmitBuffer);
 }
 
 
 uint16_t UART_getChar(uint8_t id)
 {
-    uint16_t ch;
-    if(id == UART1_ID){
-        if (getLength(receiveBufferUart1) == 0) {
-            ch = 0xFF00;
-        } else {
-            ch = (readFront(receiveBufferUart1) & 0x00FF);
-        }
-        return ch;
-    }else if(id == UART2_ID){
-        if (getLength(receiveBufferUart2) == 0) {
-            ch = 0xFF00;
-        } else {
-            ch = (readFront(receiveBufferUart2) & 0x00FF);
-        }
-        return ch;
-    }
+    UartPort *port = getPort(id);
+    uint8_t ch;
+    if (port == NULL)
+        return 0xFF00;
+    flushReceive(port);
+    if (!RingBuffer_get(&port->receiveBuffer, &ch))
+        return 0xFF00;
+    return ch;
 }
 
 char UART_isTransmitEmpty(uint8_t id)
 {
-    if(id == UART1_ID){
-        if (getLength(transmitBufferUart1) == 0)
-            return TRUE;
-        return FALSE;
-    } else if(id == UART2_ID){
-        if (getLength(transmitBufferUart2) == 0)
-            return TRUE;
-        return FALSE;
-    }
+    UartPort *port = getPort(id);
+    if (port == NULL || RingBuffer_isEmpty(&port->transmitBuffer))
+        return TRUE;
+    return FALSE;
 }
 
 char UART_isReceiveEmpty(uint8_t id)
 {
-    if(id == UART1_ID){
-        if (getLength(receiveBufferUart1) == 0)
-            return TRUE;
-        return FALSE;
-    } else if(id == UART2_ID){
-        if (getLength(receiveBufferUart2) == 0)
-            return TRUE;
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return TRUE;
+    flushReceive(port);
+    if (RingBuffer_isEmpty(&port->receiveBuffer))
+        return TRUE;
+    return FALSE;
+}
+
+bool UART_peekContiguous(uint8_t id, const uint8_t **data, uint16_t *length)
+{
+    UartPort *port = getPort(id);
+    if (port == NULL) {
+        *length = 0;
         return FALSE;
     }
+    flushReceive(port);
+    *length = RingBuffer_peekContiguous(&port->receiveBuffer, data);
+    return *length > 0;
 }
 
+void UART_consume(uint8_t id, uint16_t length)
+{
+    UartPort *port = getPort(id);
+    if (port != NULL)
+        RingBuffer_consume(&port->receiveBuffer, length);
+}
 
-/***************************************************
- *              Uno32/Pic Functions
- ***************************************************/
+uint32_t UART_getReceiveOverflow(uint8_t id)
+{
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return 0;
+    return RingBuffer_getOverflow(&port->receiveBuffer);
+}
 
+uint32_t UART_getReceiveTime(uint8_t id, uint16_t offset)
+{
+    UartPort *port = getPort(id);
+    unsigned int status;
+    uint16_t head, index;
+    uint32_t time = 0;
+    uint8_t i;
+    ReceiveMark *mark;
+    if (port == NULL)
+        return 0;
 
-/****************************************************************************
- Function
-    IntUart1Handler
+    status = INTDisableInterrupts();
+    head = port->receiveBuffer.head;
+    index = head + offset;
+    // forget marks for bytes that were already read
+    while ((uint8_t)(port->markTail - port->markHead) > 1
+            && (int16_t)(head - port->marks[(port->markHead + 1)
+                & (RECEIVE_MARKS - 1)].index) >= 0)
+        port->markHead++;
+    // newest mark at or before the byte
+    for (i = port->markTail; i != port->markHead; i--) {
+        mark = &port->marks[(uint8_t)(i - 1) & (RECEIVE_MARKS - 1)];
+        if ((int16_t)(index - mark->index) >= 0) {
+            time = mark->time + ((uint32_t)(uint16_t)(index - mark->index)
+                * port->byteMicros) / 1000;
+            break;
+        }
+    }
+    INTRestoreInterrupts(status);
+    return time;
+}
 
- Parameters
-    None.
+uint32_t UART_getInterruptCount(uint8_t id)
+{
+    UartPort *port = getPort(id);
+    if (port == NULL)
+        return 0;
+    return port->stats.interruptCount;
+}
 
- Returns
-    None.
+uint32_t UART_getInterruptRate(uint8_t id)
+{
+    UartPort *port = getPort(id);
+    uint32_t time, elapsed, count;
+    if (port == NULL || !Timer_isInitialized())
+        return 0;
 
- Description
-    Interrupt Handle for the uart. with the PIC32 architecture both send and receive are handled within the same interrupt
+    time = get_time();
+    elapsed = time - port->lastRateTime;
+    if (elapsed >= INTERRUPT_RATE_PERIOD) {
+        count = port->stats.interruptCount;
+        port->interruptRate = (count - port->lastInterruptCount) * 1000 / elapsed;
+        port->lastInterruptCount = count;
+        port->lastRateTime = time;
+    }
+    return port->interruptRate;
+}
 
- Notes
+bool UART_getStatistics(uint8_t id, UartStatistics *stats)
+{
+    UartPort *port = getPort(id);
+    unsigned int status;
+    if (port == NULL)
+        return FALSE;
 
+    status = INTDisableInterrupts();
+    memcpy(stats, (const void*)&port->stats, sizeof(UartStatistics));
+    stats->receiveDropped = RingBuffer_getOverflow(&port->receiveBuffer);
+    INTRestoreInterrupts(status);
+    return TRUE;
+}
 
- Author
- Max Dunne, 2011.11.10
- ****************************************************************************/
-void __ISR(_UART1_VECTOR, ipl4) IntUart1Handler(void)
+void UART_clearStatistics(uint8_t id)
 {
-    if (mU1RXGetIntFlag()) {
-        mU1RXClearIntFlag();
-        writeBack(receiveBufferUart1, (unsigned char) U1RXREG);
-    }
-    if (mU1TXGetIntFlag()) {
-        mU1TXClearIntFlag();
-        if (!(getLength(transmitBufferUart1) == 0)) {
-            U1TXREG = readFront(transmitBufferUart1);
-        }
-    }
+    UartPort *port = getPort(id);
+    unsigned int status;
+    if (port == NULL)
+        return;
+
+    status = INTDisableInterrupts();
+    memset((void*)&port->stats, 0, sizeof(port->stats));
+    port->receiveBuffer.overflowCount = 0;
+    port->lastInterruptCount = 0;
+    INTRestoreInterrupts(status);
 }
 
+
+/***************************************************
+ *              Uno32/Pic Functions
+ ***************************************************/
+
+
 /****************************************************************************
  Function
     IntUart1Handler
@@ -253,191 +514,152 @@ void __ISR(_UART1_VECTOR, ipl4) IntUart1Handler(void)
     Interrupt Handle for the uart. with the PIC32 architecture both send and receive are handled within the same interrupt
 
  Notes
-
+    Each vector hands its port table entry to handleInterrupt().
 
  Author
  Max Dunne, 2011.11.10
  ****************************************************************************/
-void __ISR(_UART2_VECTOR, ipl4) IntUart2Handler(void)
+void __ISR(_UART1_VECTOR, ipl4) IntUart1Handler(void)
 {
-    if (mU2RXGetIntFlag()) {
-        mU2RXClearIntFlag();
-        writeBack(receiveBufferUart2, (unsigned char) U2RXREG);
-    }
-    if (mU2TXGetIntFlag()) {
-        mU2TXClearIntFlag();
-        if (!(getLength(transmitBufferUart2) == 0)) {
-            U2TXREG = readFront(transmitBufferUart2);
-        }
-    }
+    handleInterrupt(&ports[UART1_ID - 1]);
 }
-/*******************************************************************************
- * PRIVATE FUNCTIONS                                                          *
- ******************************************************************************/
 
-void newCircBuffer(CBRef cB)
+void __ISR(_UART2_VECTOR, ipl4) IntUart2Handler(void)
 {
-
-    // initialize to zero
-    int i;
-    for (i = 0; i < QUEUESIZE; i++) {
-        cB->buffer[i] = 0;
-    }
-
-    // initialize the data members
-    cB->head = 0;
-    cB->tail = 0;
-    cB->size = QUEUESIZE;
-    cB->overflowCount = 0;
-
+    handleInterrupt(&ports[UART2_ID - 1]);
 }
 
-// this function frees the Circular Buffer CB Ref
-
-void freeCircBuffer(CBRef* cB)
+#if UART_PORTS >= 3
+void __ISR(_UART_3_VECTOR, ipl4) IntUart3Handler(void)
 {
-    // if it is already null, nothing to free
-    if (cB == NULL || *cB == NULL) {
-        return;
-    }
-
-    // free and nil the pointer
-    //free(*cB);
-    *cB = NULL;
+    handleInterrupt(&ports[UART3_ID - 1]);
 }
+#endif
 
-
-
-
-// Accesor Methods
-// ===============
-
-// returns the amount of unread bytes in the circular buffer
-
-unsigned int getLength(CBRef cB)
+#if UART_PORTS >= 4
+void __ISR(_UART_4_VECTOR, ipl4) IntUart4Handler(void)
 {
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        if (cB->head <= cB->tail) {
-            return (cB->tail - cB->head);
-        } else {
-            return (cB->size + cB->tail - cB->head);
-        }
-    } else {
-        return 0;
-    }
-
-
+    handleInterrupt(&ports[UART4_ID - 1]);
 }
+#endif
 
-// returns the actual index of the head
-
-int readHead(CBRef cB)
+#if UART_PORTS >= 5
+void __ISR(_UART_5_VECTOR, ipl4) IntUart5Handler(void)
 {
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        return (cB->head);
-    } else {
-        return 0;
-    }
-
+    handleInterrupt(&ports[UART5_ID - 1]);
 }
+#endif
 
-// returns the actual index of the tail
-
-int readTail(CBRef cB)
+#if UART_PORTS >= 6
+void __ISR(_UART_6_VECTOR, ipl4) IntUart6Handler(void)
 {
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        return (cB->tail);
-    } else {
-        return 0;
-    }
-
+    handleInterrupt(&ports[UART6_ID - 1]);
 }
+#endif
 
-// returns the byte (actual value) that the head points to. this
-// does not mark the byte as read, so succesive calls to peak will
-// always return the same value
+/*******************************************************************************
+ * PRIVATE FUNCTIONS                                                          *
+ ******************************************************************************/
 
-unsigned char peak(CBRef cB)
-{
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        // if there are bytes in the buffer
-        if (getLength(cB) > 0) {
-            return cB->buffer[cB->head];
-        }
-    }
-    return 0;
+// returns the port for the given id, or NULL if invalid or not initialized
+static UartPort *getPort(uint8_t id) {
+    UartPort *port;
+    if (id < UART1_ID || id > UART_PORTS)
+        return NULL;
+    port = &ports[id - 1];
+    return port->isInitialized ? port : NULL;
 }
 
-
-// Manipulation Procedures
-// ======================
-// returns the front of the circular buffer and marks the byte as read
-
-unsigned char readFront(CBRef cB)
-{
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        char retVal;
-        // if there are bytes in the buffer
-        if (getLength(cB) > 0) {
-            retVal = cB->buffer[cB->head];
-            cB->head = cB->head < (cB->size - 1) ? cB->head + 1 : 0;
-            return retVal;
-        }
-        return 128;
+// enables the transmit interrupt if the uart has gone idle
+static void startTransmit(UartPort *port) {
+    if (!INTGetEnable(INT_SOURCE_UART_TX(port->module))) {
+        INTEnable(INT_SOURCE_UART_TX(port->module), INT_ENABLED);
+        INTSetFlag(INT_SOURCE_UART_TX(port->module));
     }
-    return 254;
 }
 
-// writes one byte at the end of the circular buffer,
-// increments overflow count if overflow occurs
+// moves bytes left below the receive threshold into the receive buffer
+static void flushReceive(UartPort *port) {
+    unsigned int status;
+    if (!UARTReceivedDataIsAvailable(port->module))
+        return;
+    // the ISR is the only other producer, so keep it out while we drain
+    status = INTDisableInterrupts();
+    receiveBytes(port, FALSE);
+    INTRestoreInterrupts(status);
+}
 
-unsigned char writeBack(CBRef cB, unsigned char data)
-{
-    // if the circular buffer is not null
-    if (cB != NULL) {
-        if (getLength(cB) == (cB->size - 1)) {
-            cB->overflowCount++;
-            //return 1;
-        } else {
-            cB->buffer[cB->tail] = data;
-            cB->tail = cB->tail < (cB->size - 1) ? cB->tail + 1 : 0;
-            //return 0;
-        }
-        //return 0;
-    } else {
-        return 1;
+/* Drains the receive fifo, marking the time of the first byte if the line was
+ * idle. The fifo only interrupts at its threshold, so the first byte arrived
+ * one byte time before each of the ones after it. Bytes flushed by the main
+ * loop are the tail of a burst that stopped below the threshold, so they
+ * never start a mark and keep the last interrupt's time. */
+static void receiveBytes(UartPort *port, bool isInterrupt) {
+    uint32_t ticks = ReadCoreTimer();
+    uint32_t byteTicks = (uint32_t)port->byteMicros * CORE_TICKS_PER_US;
+    uint16_t index = port->receiveBuffer.tail;
+    uint16_t count = 0;
+    while (UARTReceivedDataIsAvailable(port->module)) {
+        RingBuffer_put(&port->receiveBuffer, UARTGetDataByte(port->module));
+        port->stats.bytesIn++;
+        count++;
     }
-    return 0;
+    updateReceivePeak(port);
+    if (!isInterrupt || count == 0)
+        return;
+
+    if ((int32_t)(ticks - (count - 1) * byteTicks - port->lastReceiveTicks)
+            > (int32_t)(UART_IDLE_BYTES * byteTicks) && Timer_isInitialized())
+        addReceiveMark(port, index,
+            get_time() - ((uint32_t)(count - 1) * port->byteMicros) / 1000);
+    port->lastReceiveTicks = ticks;
 }
 
-// empties the circular buffer. It does not change the size. use with caution!!
+// records a mark, replacing the oldest if all are in use
+static void addReceiveMark(UartPort *port, uint16_t index, uint32_t time) {
+    ReceiveMark *mark = &port->marks[port->markTail & (RECEIVE_MARKS - 1)];
+    mark->index = index;
+    mark->time = time;
+    port->markTail++;
+    if ((uint8_t)(port->markTail - port->markHead) > RECEIVE_MARKS)
+        port->markHead++;
+}
 
-void makeEmpty(CBRef cB)
-{
-    if (cB != NULL) {
-        int i;
-        for (i = 0; i < cB->size; ++i) {
-            cB->buffer[i] = 0;
-        }
-        cB->head = 0;
-        cB->tail = 0;
-        cB->overflowCount = 0;
-    }
+// called by the writer after queueing bytes
+static void updateTransmitPeak(UartPort *port) {
+    uint16_t length = RingBuffer_getLength(&port->transmitBuffer);
+    if (length > port->stats.transmitPeak)
+        port->stats.transmitPeak = length;
 }
 
-// returns the amount of times the CB has overflown;
+// called by the ISR (or with it disabled) after receiving bytes
+static void updateReceivePeak(UartPort *port) {
+    uint16_t length = RingBuffer_getLength(&port->receiveBuffer);
+    if (length > port->stats.receivePeak)
+        port->stats.receivePeak = length;
+}
 
-unsigned char getOverflow(CBRef cB)
-{
-    if (cB != NULL) {
-        return cB->overflowCount;
+// empties the receive fifo and fills the transmit fifo
+static void handleInterrupt(UartPort *port) {
+    uint32_t startTicks = ReadCoreTimer();
+    uint8_t ch;
+    if (INTGetFlag(INT_SOURCE_UART_RX(port->module))) {
+        receiveBytes(port, TRUE);
+        INTClearFlag(INT_SOURCE_UART_RX(port->module));
     }
-    return 0;
+    if (INTGetFlag(INT_SOURCE_UART_TX(port->module))
+            && INTGetEnable(INT_SOURCE_UART_TX(port->module))) {
+        while (!UARTTransmitBufferIsFull(port->module)
+                && RingBuffer_get(&port->transmitBuffer, &ch)) {
+            UARTSendDataByte(port->module, ch);
+            port->stats.bytesOut++;
+        }
+        INTClearFlag(INT_SOURCE_UART_TX(port->module));
+        if (RingBuffer_isEmpty(&port->transmitBuffer))
+            INTEnable(INT_SOURCE_UART_TX(port->module), INT_DISABLED);
+    }
+    port->stats.interruptCount++;
+    port->stats.interruptTicks += ReadCoreTimer() - startTicks;
 }
 
 
@@ -484,4 +706,208 @@ int main(void)
     }
     return 0;
 }
-#endif
\ No newline at end of file
+#endif
+
+//#define UART_WRITE_TEST
+#ifdef UART_WRITE_TEST
+#include "Serial.h"
+#include "Board.h"
+#include "Timer.h"
+#include <stdio.h>
+#include <plib.h>
+
+/* Measures how long one superloop pass spends handing a burst of telemetry
+ * (heartbeat, position and debug sized frames) to UART2, first with the old
+ * per-byte putChar plus DELAY(10), then with UART_write. Connect the XBee
+ * to UART2 and watch the results on the serial console. */
+
+#define CORE_TICKS_PER_US   40 // core timer runs at SYSCLK/2
+#define BENCHMARK_LOOPS     20
+#define HEARTBEAT_LENGTH    10
+#define POSITION_LENGTH     22
+#define DEBUG_LENGTH        110
+
+static uint8_t frame[DEBUG_LENGTH];
+
+static void putStringSlow(uint8_t id, uint8_t *data, int length) {
+    int x;
+    for (x = 0; x < length; x++) {
+        UART_putChar(id, data[x]);
+        DELAY(10);
+    }
+}
+
+static uint32_t sendBurst(bool useWrite) {
+    uint32_t startTicks = ReadCoreTimer();
+    if (useWrite) {
+        UART_write(UART2_ID, frame, HEARTBEAT_LENGTH, UART_WRITE_REJECT, 0);
+        UART_write(UART2_ID, frame, POSITION_LENGTH, UART_WRITE_REJECT, 0);
+        UART_write(UART2_ID, frame, DEBUG_LENGTH, UART_WRITE_REJECT, 0);
+    }
+    else {
+        putStringSlow(UART2_ID, frame, HEARTBEAT_LENGTH);
+        putStringSlow(UART2_ID, frame, POSITION_LENGTH);
+        putStringSlow(UART2_ID, frame, DEBUG_LENGTH);
+    }
+    return (ReadCoreTimer() - startTicks) / CORE_TICKS_PER_US;
+}
+
+int main(void)
+{
+    Board_init();
+    Board_configure(USE_SERIAL | USE_TIMER);
+    UART_init(UART2_ID, 9600);
+    int i, pass;
+    for (i = 0; i < DEBUG_LENGTH; i++)
+        frame[i] = 'A' + (i % 26);
+
+    printf("\nUART bulk write benchmark (%d bursts of %d bytes)\n",
+        BENCHMARK_LOOPS, HEARTBEAT_LENGTH + POSITION_LENGTH + DEBUG_LENGTH);
+    for (pass = 0; pass < 2; pass++) {
+        uint32_t worst = 0, total = 0;
+        for (i = 0; i < BENCHMARK_LOOPS; i++) {
+            uint32_t elapsed = sendBurst(pass == 1);
+            total += elapsed;
+            if (elapsed > worst)
+                worst = elapsed;
+            // let the ISR drain the buffer before the next burst
+            while (!UART_isTransmitEmpty(UART2_ID))
+                ;
+        }
+        printf("%s: average %d us, worst %d us per loop\n",
+            (pass == 1)? "UART_write" : "putChar+DELAY", (int)(total / BENCHMARK_LOOPS), (int)worst);
+    }
+    while (1);
+    return 0;
+}
+#endif
+
+
+//#define UART_LOOPBACK_TEST
+#ifdef UART_LOOPBACK_TEST
+#include "Serial.h"
+#include "Board.h"
+#include "Timer.h"
+#include <stdio.h>
+#include <plib.h>
+
+/* Stress test for the ring buffers. Wire UART2's TX pin to its RX pin. The
+ * main loop streams a counting sequence through the transmit ring while the
+ * ISR moves it through the hardware and back into the receive ring, so both
+ * rings are hammered from both sides at once. Any lost, repeated or
+ * reordered byte breaks the sequence. Results go to the serial console. */
+
+#define LOOPBACK_BAUDRATE   115200
+#define LOOPBACK_SPAN       64
+#define REPORT_DELAY        1000 // (ms)
+
+int main(void)
+{
+    Board_init();
+    Board_configure(USE_SERIAL | USE_TIMER);
+    UART_init(UART2_ID, LOOPBACK_BAUDRATE);
+    printf("\nUART loopback stress test (connect U2TX to U2RX)\n");
+
+    uint8_t span[LOOPBACK_SPAN];
+    uint8_t nextSent = 0, nextExpected = 0;
+    uint32_t received = 0, errors = 0;
+    uint32_t lastReceived = 0;
+    int i;
+    Timer_new(TIMER_TEST, REPORT_DELAY);
+    while (1) {
+        // producer side of the transmit ring
+        uint16_t space = UART_getTransmitSpace(UART2_ID);
+        if (space > LOOPBACK_SPAN)
+            space = LOOPBACK_SPAN;
+        for (i = 0; i < space; i++)
+            span[i] = nextSent + i;
+        nextSent += UART_write(UART2_ID, span, space, UART_WRITE_TRUNCATE, 0);
+
+        // consumer side of the receive ring
+        while (!UART_isReceiveEmpty(UART2_ID)) {
+            uint8_t ch = (uint8_t)UART_getChar(UART2_ID);
+            if (ch != nextExpected)
+                errors++;
+            nextExpected = ch + 1;
+            received++;
+        }
+
+        if (Timer_isExpired(TIMER_TEST)) {
+            printf("%d bytes/s, %d total, %d errors, %d overflowed, %d interrupts/s\n",
+                (int)(received - lastReceived), (int)received, (int)errors,
+                (int)UART_getReceiveOverflow(UART2_ID),
+                (int)UART_getInterruptRate(UART2_ID));
+            lastReceived = received;
+            Timer_new(TIMER_TEST, REPORT_DELAY);
+        }
+    }
+    return 0;
+}
+#endif
+
+
+//#define UART_SPAN_TEST
+#ifdef UART_SPAN_TEST
+#include "Serial.h"
+#include "Board.h"
+#include <stdio.h>
+#include <plib.h>
+
+/* Compares the cost of draining the receive buffer one byte at a time with
+ * UART_getChar against scanning it in place with UART_peekContiguous. UART2
+ * is left uninitialized, so the test fills its receive ring directly and
+ * nothing else touches it. Results go to the serial console. */
+
+#define CORE_TICKS_PER_US   40 // core timer runs at SYSCLK/2
+#define SPAN_TEST_BYTES     (UART2_RX_BUFFER_SIZE - 1)
+#define SPAN_TEST_PASSES    100
+
+static void fillReceiveBuffer() {
+    uint8_t data[SPAN_TEST_BYTES];
+    int i;
+    for (i = 0; i < SPAN_TEST_BYTES; i++)
+        data[i] = i;
+    UartPort *port = &ports[UART2_ID - 1];
+    RingBuffer_init(&port->receiveBuffer, port->receiveData, port->receiveSize);
+    port->isInitialized = TRUE;
+    // start mid-buffer so the data wraps around the end
+    port->receiveBuffer.head = port->receiveBuffer.tail = port->receiveSize / 2;
+    RingBuffer_write(&port->receiveBuffer, data, SPAN_TEST_BYTES);
+}
+
+int main(void)
+{
+    Board_init();
+    Board_configure(USE_SERIAL);
+    uint32_t getCharTicks = 0, spanTicks = 0, startTicks;
+    uint32_t sum1 = 0, sum2 = 0;
+    const uint8_t *data;
+    uint16_t length, i;
+    int pass;
+
+    for (pass = 0; pass < SPAN_TEST_PASSES; pass++) {
+        fillReceiveBuffer();
+        startTicks = ReadCoreTimer();
+        while (!UART_isReceiveEmpty(UART2_ID))
+            sum1 += UART_getChar(UART2_ID);
+        getCharTicks += ReadCoreTimer() - startTicks;
+
+        fillReceiveBuffer();
+        startTicks = ReadCoreTimer();
+        while (UART_peekContiguous(UART2_ID, &data, &length)) {
+            for (i = 0; i < length; i++)
+                sum2 += data[i];
+            UART_consume(UART2_ID, length);
+        }
+        spanTicks += ReadCoreTimer() - startTicks;
+    }
+
+    printf("\nUART receive span test (%d bytes x %d passes)\n",
+        SPAN_TEST_BYTES, SPAN_TEST_PASSES);
+    printf("UART_getChar: %d us, peek/consume: %d us, checksums %s\n",
+        (int)(getCharTicks / CORE_TICKS_PER_US), (int)(spanTicks / CORE_TICKS_PER_US),
+        (sum1 == sum2)? "match" : "DIFFER");
+    while (1);
+    return 0;
+}
+#endif
@@ -0,0 +1,354 @@
+/**********************************************************************
+ Module
+   UbxConfig.c
+
+ Author: David Goodman
+
+ Description
+    Sets up a u-blox receiver over UBX (see UbxConfig.h).
+
+ Notes
+    The receiver answers CFG-PRT at its old baud rate and then switches,
+    so that answer is often lost. Instead the host waits for the command to
+    go out, gives the receiver PORT_SETTLE_TIME to switch, switches itself,
+    and polls CFG-PRT at the new rate.
+
+    While detecting, any frame with a good checksum means the baud rate is
+    right, since UbxParser drops everything else.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "UbxConfig.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define STATE_DETECT        0
+#define STATE_PORT          1 // switching baud rates
+#define STATE_VERIFY        2 // polling the port at the new rate
+#define STATE_RATE          3
+#define STATE_MESSAGES      4
+#define STATE_DONE          5
+#define STATE_FAILED        6
+
+#define DETECT_TIMEOUT      300 // (ms) for a frame at a baud rate
+#define ANSWER_TIMEOUT      500 // (ms) for an acknowledgement or poll
+#define PORT_SETTLE_TIME    100 // (ms) after CFG-PRT, before switching
+#define COMMAND_TRIES       3
+
+#define RECEIVER_PORT       1 // UART1 on the receiver
+#define PORT_MODE_8N1       0x000008D0
+#define PROTOCOL_UBX        0x0001
+#define TIME_REF_GPS        1
+
+#define PRT_LEN             20
+#define RATE_LEN            6
+#define MSG_LEN             3
+#define ACK_LEN             2
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static void runCommand(UbxConfig *config, uint32_t time);
+static bool getMessage(const UbxConfig *config, uint8_t *id, uint8_t *rate);
+static bool sendCommand(UbxConfig *config, uint8_t id, const uint8_t *payload,
+    uint16_t length, uint32_t time);
+static void startState(UbxConfig *config, uint8_t state);
+static void pack16(uint8_t *data, uint16_t value);
+static void pack32(uint8_t *data, uint32_t value);
+
+/**********************************************************************
+ * PRIVATE VARIABLES                                                  *
+ **********************************************************************/
+
+// Tried in turn while detecting, after the desired rate
+static const uint32_t baudRates[] = { 38400, 9600, 115200, 57600, 19200 };
+#define BAUD_RATE_COUNT     (sizeof(baudRates) / sizeof(baudRates[0]))
+
+// CFG-MSG steps as (NAV ID, rate), with and without NAV-PVT
+static const uint8_t pvtMessages[][2] = {
+    { UBX_NAV_PVT_ID, 1 },
+    { UBX_NAV_POSLLH_ID, 0 },
+    { UBX_NAV_SOL_ID, 0 },
+    { UBX_NAV_VELNED_ID, 0 },
+    { UBX_NAV_STATUS_ID, 0 },
+};
+static const uint8_t solMessages[][2] = {
+    { UBX_NAV_SOL_ID, 1 },
+    { UBX_NAV_VELNED_ID, 1 },
+    { UBX_NAV_STATUS_ID, 1 },
+    { UBX_NAV_POSLLH_ID, 0 },
+};
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void UbxConfig_init(UbxConfig *config, const UbxConfigPort *port,
+        uint32_t baudRate, uint8_t navigationRate) {
+    if (navigationRate < UBX_CONFIG_MIN_RATE)
+        navigationRate = UBX_CONFIG_MIN_RATE;
+    else if (navigationRate > UBX_CONFIG_MAX_RATE)
+        navigationRate = UBX_CONFIG_MAX_RATE;
+    config->port = port;
+    config->desiredBaudRate = baudRate;
+    config->measureRate = 1000 / navigationRate;
+    config->baudRate = 0;
+    config->hasPvt = false;
+    config->baudIndex = 0;
+    startState(config, STATE_DETECT);
+}
+
+void UbxConfig_run(UbxConfig *config, uint32_t time) {
+    uint8_t payload[PRT_LEN];
+    uint32_t baudRate;
+
+    switch (config->state) {
+        case STATE_DETECT:
+            if (config->hasAnswer) {
+                config->baudRate = (config->baudIndex == 0) ? config->desiredBaudRate
+                    : baudRates[config->baudIndex - 1];
+                startState(config, (config->baudRate == config->desiredBaudRate)
+                    ? STATE_VERIFY : STATE_PORT);
+            }
+            else if (config->isWaiting && (time - config->sentTime) < DETECT_TIMEOUT)
+                break;
+            else {
+                if (config->isWaiting)
+                    config->baudIndex = (config->baudIndex + 1) % (BAUD_RATE_COUNT + 1);
+                baudRate = (config->baudIndex == 0) ? config->desiredBaudRate
+                    : baudRates[config->baudIndex - 1];
+                config->port->setBaudRate(baudRate);
+                payload[0] = RECEIVER_PORT;
+                sendCommand(config, UBX_CFG_PRT_ID, payload, 1, time);
+            }
+            break;
+        case STATE_PORT:
+            if (!config->isWaiting) {
+                memset(payload, 0, PRT_LEN);
+                payload[0] = RECEIVER_PORT;
+                pack32(&payload[4], PORT_MODE_8N1);
+                pack32(&payload[8], config->desiredBaudRate);
+                pack16(&payload[12], PROTOCOL_UBX);
+                pack16(&payload[14], PROTOCOL_UBX); // no more NMEA
+                sendCommand(config, UBX_CFG_PRT_ID, payload, PRT_LEN, time);
+            }
+            else if (config->port->isSent() && (time - config->sentTime) >= PORT_SETTLE_TIME) {
+                config->port->setBaudRate(config->desiredBaudRate);
+                startState(config, STATE_VERIFY);
+            }
+            break;
+        case STATE_VERIFY:
+            if (config->hasAnswer) {
+                config->baudRate = config->desiredBaudRate;
+                startState(config, STATE_RATE);
+            }
+            else if (!config->isWaiting || (time - config->sentTime) >= ANSWER_TIMEOUT) {
+                if (config->tries++ < COMMAND_TRIES) {
+                    payload[0] = RECEIVER_PORT;
+                    sendCommand(config, UBX_CFG_PRT_ID, payload, 1, time);
+                }
+                else {
+                    config->baudRate = 0; // lost it, so find it again
+                    config->baudIndex = 0;
+                    startState(config, STATE_DETECT);
+                }
+            }
+            break;
+        case STATE_RATE:
+        case STATE_MESSAGES:
+            runCommand(config, time);
+            break;
+        default:
+            break;
+    }
+}
+
+void UbxConfig_handleFrame(UbxConfig *config, const UbxParser *parser) {
+    const uint8_t *frame = parser->frame;
+    uint8_t messageClass = frame[UBX_CLASS_INDEX], messageId = frame[UBX_ID_INDEX];
+
+    switch (config->state) {
+        case STATE_DETECT:
+            config->hasAnswer = config->isWaiting;
+            break;
+        case STATE_VERIFY:
+            if (messageClass == UBX_CFG_CLASS && messageId == UBX_CFG_PRT_ID
+                    && UbxParser_getPayloadLength(parser) == PRT_LEN
+                    && frame[UBX_PAYLOAD_INDEX] == RECEIVER_PORT)
+                config->hasAnswer = config->isWaiting;
+            break;
+        case STATE_RATE:
+        case STATE_MESSAGES:
+            if (messageClass == UBX_ACK_CLASS && config->isWaiting
+                    && UbxParser_getPayloadLength(parser) == ACK_LEN
+                    && frame[UBX_PAYLOAD_INDEX] == UBX_CFG_CLASS
+                    && frame[UBX_PAYLOAD_INDEX + 1] == config->commandId) {
+                config->hasAnswer = true;
+                config->hasNak = (messageId == UBX_ACK_NAK_ID);
+            }
+            break;
+    }
+}
+
+bool UbxConfig_isDone(const UbxConfig *config) {
+    return config->state == STATE_DONE;
+}
+
+bool UbxConfig_hasFailed(const UbxConfig *config) {
+    return config->state == STATE_FAILED;
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: runCommand
+ * @param Configuration in the rate or messages state.
+ * @param Time in milliseconds.
+ * @return None.
+ * @remark Sends CFG-RATE or the next CFG-MSG, and moves on when it is
+ *  acknowledged. A NAK for NAV-PVT switches to the NAV-SOL messages.
+ **********************************************************************/
+static void runCommand(UbxConfig *config, uint32_t time) {
+    uint8_t payload[RATE_LEN], id, rate;
+
+    if (config->hasAnswer) {
+        if (config->hasNak && config->state == STATE_MESSAGES && config->step == 0
+                && config->hasPvt) {
+            config->hasPvt = false; // no NAV-PVT on this receiver
+            startState(config, STATE_MESSAGES);
+            config->step = 0;
+        }
+        else if (config->hasNak)
+            startState(config, STATE_FAILED);
+        else if (config->state == STATE_RATE) {
+            startState(config, STATE_MESSAGES);
+            config->hasPvt = true; // until it says otherwise
+            config->step = 0;
+        }
+        else {
+            startState(config, STATE_MESSAGES);
+            config->step++;
+        }
+        if (config->state == STATE_MESSAGES && !getMessage(config, &id, &rate))
+            startState(config, STATE_DONE);
+        return;
+    }
+    if (config->isWaiting && (time - config->sentTime) < ANSWER_TIMEOUT)
+        return;
+    if (config->tries++ >= COMMAND_TRIES) {
+        startState(config, STATE_FAILED);
+        return;
+    }
+
+    if (config->state == STATE_RATE) {
+        pack16(&payload[0], config->measureRate);
+        pack16(&payload[2], 1); // a solution every measurement
+        pack16(&payload[4], TIME_REF_GPS);
+        sendCommand(config, UBX_CFG_RATE_ID, payload, RATE_LEN, time);
+    }
+    else if (getMessage(config, &id, &rate)) {
+        payload[0] = UBX_NAV_CLASS;
+        payload[1] = id;
+        payload[2] = rate;
+        sendCommand(config, UBX_CFG_MSG_ID, payload, MSG_LEN, time);
+    }
+}
+
+/**********************************************************************
+ * Function: getMessage
+ * @param Configuration in the messages state.
+ * @param NAV message ID of the step.
+ * @param Rate to set it to, in navigation solutions.
+ * @return FALSE if there are no more steps.
+ **********************************************************************/
+static bool getMessage(const UbxConfig *config, uint8_t *id, uint8_t *rate) {
+    if (config->hasPvt) {
+        if (config->step >= sizeof(pvtMessages) / sizeof(pvtMessages[0]))
+            return false;
+        *id = pvtMessages[config->step][0];
+        *rate = pvtMessages[config->step][1];
+    }
+    else {
+        if (config->step >= sizeof(solMessages) / sizeof(solMessages[0]))
+            return false;
+        *id = solMessages[config->step][0];
+        *rate = solMessages[config->step][1];
+    }
+    return true;
+}
+
+/**********************************************************************
+ * Function: sendCommand
+ * @param Configuration.
+ * @param CFG message ID.
+ * @param Payload.
+ * @param Payload length.
+ * @param Time in milliseconds.
+ * @return TRUE if the frame was written. If not, it is tried again on the
+ *  next run, as if it timed out.
+ **********************************************************************/
+static bool sendCommand(UbxConfig *config, uint8_t id, const uint8_t *payload,
+        uint16_t length, uint32_t time) {
+    uint8_t frame[UBX_HEADER_LEN + PRT_LEN + UBX_CHECKSUM_LEN];
+    uint16_t frameLength = UbxParser_pack(frame, UBX_CFG_CLASS, id, payload, length);
+
+    config->commandId = id;
+    config->hasAnswer = false;
+    config->hasNak = false;
+    config->isWaiting = true;
+    config->sentTime = time;
+    if (config->port->send(frame, frameLength) == frameLength)
+        return true;
+    config->sentTime = time - ANSWER_TIMEOUT - DETECT_TIMEOUT;
+    return false;
+}
+
+/**********************************************************************
+ * Function: startState
+ * @param Configuration.
+ * @param State to start, with nothing sent yet.
+ * @return None.
+ **********************************************************************/
+static void startState(UbxConfig *config, uint8_t state) {
+    config->state = state;
+    config->tries = 0;
+    config->isWaiting = false;
+    config->hasAnswer = false;
+    config->hasNak = false;
+}
+
+/**********************************************************************
+ * Function: pack16
+ * @param Buffer for the value.
+ * @param Value to write little endian.
+ * @return None.
+ **********************************************************************/
+static void pack16(uint8_t *data, uint16_t value) {
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+/**********************************************************************
+ * Function: pack32
+ * @param Buffer for the value.
+ * @param Value to write little endian.
+ * @return None.
+ **********************************************************************/
+static void pack32(uint8_t *data, uint32_t value) {
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
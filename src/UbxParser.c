@@ -0,0 +1,218 @@
+/**********************************************************************
+ Module
+   UbxParser.c
+
+ Author: David Goodman
+
+ Description
+    Checked UBX frame assembly (see UbxParser.h).
+
+ Notes
+    Bytes are copied into the frame buffer only as far as the next check
+    needs: the two sync bytes, then the header for the length, then the
+    rest of the frame for the checksum. Bytes before a sync byte are
+    skipped in the span without copying.
+
+    After a bad frame only its first byte is dropped, and the rest of the
+    buffer is searched for the next sync byte. The buffer holds a whole
+    frame of the longest length, so a good frame that was taken in as the
+    payload of a corrupted one is always still there to be found.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "UbxParser.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define SYNC_LEN            2
+#define CHECKSUM_START      UBX_CLASS_INDEX // first byte in the checksum
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static void dropBytes(UbxParser *parser, uint16_t count, uint16_t *carried);
+static uint16_t getFrameLength(const uint8_t *frame);
+static bool hasGoodChecksum(const uint8_t *frame, uint16_t frameLength);
+static void getChecksum(const uint8_t *data, uint16_t length, uint8_t *checksum);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void UbxParser_init(UbxParser *parser) {
+    parser->held = 0;
+    parser->length = 0;
+    parser->hasFrame = false;
+    parser->start = -1;
+    parser->frameCount = 0;
+    parser->errorCount = 0;
+    parser->skippedCount = 0;
+}
+
+uint16_t UbxParser_read(UbxParser *parser, const uint8_t *data, uint16_t length) {
+    uint16_t i = 0, carried = parser->held, needed, count;
+    const uint8_t *found;
+
+    if (parser->hasFrame) {
+        dropBytes(parser, parser->length, &carried); // the caller is done with it
+        parser->hasFrame = false;
+    }
+
+    while (true) {
+        if (parser->held == 0) {
+            found = memchr(&data[i], UBX_SYNC1, length - i);
+            count = (found == NULL) ? length - i : (found - data) - i;
+            parser->skippedCount += count;
+            i += count;
+            if (i == length)
+                break;
+        }
+        else if (parser->frame[0] != UBX_SYNC1) {
+            // Left by a dropped frame, so look for the next one in it
+            found = memchr(parser->frame, UBX_SYNC1, parser->held);
+            count = (found == NULL) ? parser->held : found - parser->frame;
+            parser->skippedCount += count;
+            dropBytes(parser, count, &carried);
+            continue;
+        }
+        else if (parser->held >= SYNC_LEN && parser->frame[1] != UBX_SYNC2) {
+            parser->skippedCount++;
+            dropBytes(parser, 1, &carried);
+            continue;
+        }
+
+        // Take in what the next check needs
+        if (parser->held < SYNC_LEN)
+            needed = SYNC_LEN;
+        else if (parser->held < UBX_HEADER_LEN)
+            needed = UBX_HEADER_LEN;
+        else
+            needed = getFrameLength(parser->frame);
+        if (needed > UBX_MAX_FRAME_LEN) {
+            parser->errorCount++;
+            dropBytes(parser, 1, &carried);
+            continue;
+        }
+        if (parser->held < needed) {
+            count = needed - parser->held;
+            if (count > length - i)
+                count = length - i;
+            memcpy(&parser->frame[parser->held], &data[i], count);
+            parser->held += count;
+            i += count;
+            if (parser->held < needed)
+                break; // wait for the next span
+            continue;
+        }
+
+        // Have the whole frame
+        if (hasGoodChecksum(parser->frame, needed)) {
+            parser->length = needed;
+            parser->hasFrame = true;
+            parser->frameCount++;
+            break;
+        }
+        parser->errorCount++;
+        dropBytes(parser, 1, &carried);
+    }
+
+    parser->start = (parser->held > 0 && carried == 0) ? (int16_t)(i - parser->held) : -1;
+    return i;
+}
+
+uint16_t UbxParser_getPayloadLength(const UbxParser *parser) {
+    return parser->frame[UBX_LENGTH_INDEX] | ((uint16_t)parser->frame[UBX_LENGTH_INDEX + 1] << 8);
+}
+
+bool UbxParser_getPayload(const UbxParser *parser, void *payload, uint16_t size) {
+    if (UbxParser_getPayloadLength(parser) < size)
+        return false;
+    memcpy(payload, &parser->frame[UBX_PAYLOAD_INDEX], size);
+    return true;
+}
+
+uint16_t UbxParser_pack(uint8_t *frame, uint8_t messageClass, uint8_t messageId,
+        const uint8_t *payload, uint16_t length) {
+    frame[0] = UBX_SYNC1;
+    frame[1] = UBX_SYNC2;
+    frame[UBX_CLASS_INDEX] = messageClass;
+    frame[UBX_ID_INDEX] = messageId;
+    frame[UBX_LENGTH_INDEX] = (uint8_t)length;
+    frame[UBX_LENGTH_INDEX + 1] = (uint8_t)(length >> 8);
+    memcpy(&frame[UBX_PAYLOAD_INDEX], payload, length);
+    getChecksum(&frame[CHECKSUM_START], UBX_PAYLOAD_INDEX - CHECKSUM_START + length,
+        &frame[UBX_PAYLOAD_INDEX + length]);
+    return UBX_HEADER_LEN + length + UBX_CHECKSUM_LEN;
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: dropBytes
+ * @param Parser.
+ * @param Number of bytes to drop from the front of the buffer.
+ * @param Bytes at the front that came from earlier spans, updated.
+ * @return None.
+ **********************************************************************/
+static void dropBytes(UbxParser *parser, uint16_t count, uint16_t *carried) {
+    parser->held -= count;
+    memmove(parser->frame, &parser->frame[count], parser->held);
+    *carried = (*carried > count) ? *carried - count : 0;
+}
+
+/**********************************************************************
+ * Function: getFrameLength
+ * @param Frame with at least the header.
+ * @return Length of the whole frame, from its length field.
+ **********************************************************************/
+static uint16_t getFrameLength(const uint8_t *frame) {
+    uint16_t payloadLength = frame[UBX_LENGTH_INDEX]
+        | ((uint16_t)frame[UBX_LENGTH_INDEX + 1] << 8);
+    if (payloadLength > UBX_MAX_PAYLOAD_LEN)
+        return UBX_MAX_FRAME_LEN + 1;
+    return UBX_HEADER_LEN + payloadLength + UBX_CHECKSUM_LEN;
+}
+
+/**********************************************************************
+ * Function: hasGoodChecksum
+ * @param Whole frame.
+ * @param Length of the frame.
+ * @return TRUE if the frame's checksum matches its contents.
+ **********************************************************************/
+static bool hasGoodChecksum(const uint8_t *frame, uint16_t frameLength) {
+    uint8_t checksum[UBX_CHECKSUM_LEN];
+    getChecksum(&frame[CHECKSUM_START], frameLength - CHECKSUM_START - UBX_CHECKSUM_LEN,
+        checksum);
+    return checksum[0] == frame[frameLength - 2] && checksum[1] == frame[frameLength - 1];
+}
+
+/**********************************************************************
+ * Function: getChecksum
+ * @param Bytes from the class to the end of the payload.
+ * @param Number of bytes.
+ * @param Array for CK_A and CK_B.
+ * @return None.
+ * @remark 8-bit Fletcher checksum, see the u-blox protocol specification.
+ **********************************************************************/
+static void getChecksum(const uint8_t *data, uint16_t length, uint8_t *checksum) {
+    uint8_t a = 0, b = 0;
+    uint16_t i;
+    for (i = 0; i < length; i++) {
+        a += data[i];
+        b += a;
+    }
+    checksum[0] = a;
+    checksum[1] = b;
+}
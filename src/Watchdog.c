@@ -8,6 +8,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <string.h>
 #include "Board.h"
 #include "Mavlink.h"
 #include "Xbee.h"
@@ -19,6 +20,7 @@
 #include "Serial.h"
 #include "Uart.h"
 #include "Interface.h"
+#include "Console.h"
 
 
 /***********************************************************************
@@ -32,12 +34,15 @@
 
 #define EVENT_BYTE_SIZE     10 // provides 80 event bits
 
+#define DEBUG_LINE_SIZE     128 // longest rendered debug event
+
 /**********************************************************************
  * PRIVATE PROTOTYPES                                                 *
  **********************************************************************/
 
 static void Watchdog_init();
 static void doWatchdog();
+static char *getSenderName(char sender);
 
 
 /**********************************************************************
@@ -133,7 +138,7 @@ static void doWatchdog(void) {
     for (i=0; i < EVENT_BYTE_SIZE; i++)
         event.bytes[i] = 0x0;
 
-    if (Mavlink_hasNewMessage()) {
+    while (Mavlink_hasNewMessage()) {
         lastMavlinkMessageID = Mavlink_getNewMessageID();
         lastMavlinkCommandID = MAVLINK_NO_COMMAND;
         lastMavlinkMessageWantsAck = FALSE;
@@ -223,13 +228,13 @@ static void doWatchdog(void) {
                 if (Mavlink_newMessage.gpsGeocentricData.status == MAVLINK_GEOCENTRIC_ORIGIN) {
                     event.flags.haveSetOriginMessage = TRUE;
                     DBPRINT("C: Sending boat origin.\n");
-                    DBPRINT("   X=%.0f, Y=%.0f, Z=%.0f\n", Mavlink_newMessage.gpsGeocentricData.x,
-                     Mavlink_newMessage.gpsGeocentricData.y, Mavlink_newMessage.gpsGeocentricData.z );
+                    DBPRINT("   X=%ld, Y=%ld, Z=%ld (cm)\n", (long)Mavlink_newMessage.gpsGeocentricData.x,
+                     (long)Mavlink_newMessage.gpsGeocentricData.y, (long)Mavlink_newMessage.gpsGeocentricData.z );
                 }
                 else if (Mavlink_newMessage.gpsGeocentricData.status == MAVLINK_GEOCENTRIC_ERROR) {
                     event.flags.haveGeocentricErrorMessage = TRUE;
-                    DBPRINT("C: gps err X=%.0f, Y=%.0f, Z=%.0f\n", Mavlink_newMessage.gpsGeocentricData.x,
-                     Mavlink_newMessage.gpsGeocentricData.y, Mavlink_newMessage.gpsGeocentricData.z );
+                    DBPRINT("C: gps err X=%ld, Y=%ld, Z=%ld (cm)\n", (long)Mavlink_newMessage.gpsGeocentricData.x,
+                     (long)Mavlink_newMessage.gpsGeocentricData.y, (long)Mavlink_newMessage.gpsGeocentricData.z );
                 }
                 // ----  Messages from AtLAs to ComPAS (from Compas.c) --------
                 break;
@@ -257,6 +262,15 @@ static void doWatchdog(void) {
                         Mavlink_newMessage.gpsLocalData.east);
                 }
                 break;
+            case MAVLINK_MSG_ID_BOAT_STATE:
+                // Boat state stream, positions in cm
+                event.flags.haveBoatPositionMessage = TRUE;
+                DBPRINT("A: state=%d pos N=%.2f, E=%.2f, hdg=%.1f\n",
+                    Mavlink_newMessage.boatStateData.navState,
+                    (float)Mavlink_newMessage.boatStateData.north / 100,
+                    (float)Mavlink_newMessage.boatStateData.east / 100,
+                    (float)Mavlink_newMessage.boatStateData.heading / 100);
+                break;
             /*---------------- Status and Error messages ---------- */
             case MAVLINK_MSG_ID_STATUS_AND_ERROR:
                 // ---------- Boat error messages ------------------
@@ -301,16 +315,24 @@ static void doWatchdog(void) {
                     (float)Mavlink_newMessage.telemetryData.batVolt2/1000);
                 break;
             case MAVLINK_MSG_ID_DEBUG:
+                DBPRINT("%s: debug=%s\n", getSenderName(Mavlink_newMessage.debugData.sender),
+                    Mavlink_newMessage.debugData.message);
+                break;
+            case MAVLINK_MSG_ID_DEBUG_EVENT:
             {
-                char *sender = "";
-                if (Mavlink_newMessage.debugData.sender == MAVLINK_SENDER_ATLAS)
-                    sender = "A";
-                else if (Mavlink_newMessage.debugData.sender == MAVLINK_SENDER_COMPAS)
-                    sender = "C";
+                // Render it with the format table the sender was built with
+                mavlink_debug_event_t *debugEvent = &Mavlink_newMessage.debugEventData;
+                uint32_t args[CONSOLE_MAX_ARGS];
+                char line[DEBUG_LINE_SIZE];
+                uint8_t count = (debugEvent->count < CONSOLE_MAX_ARGS)?
+                    debugEvent->count : CONSOLE_MAX_ARGS;
+
+                memcpy(args, debugEvent->args, count * sizeof(uint32_t));
+                if (Console_format(line, sizeof(line), debugEvent->message, args, count) > 0)
+                    DBPRINT("%s: %s", getSenderName(debugEvent->sender), line);
                 else
-                    sender = "?";
-
-                DBPRINT("%s: debug=%s\n", sender, Mavlink_newMessage.debugData.message);
+                    DBPRINT("%s: debug event %u\n", getSenderName(debugEvent->sender),
+                        debugEvent->message);
                 break;
             }
             default:
@@ -322,6 +344,21 @@ static void doWatchdog(void) {
     }
 } // doWatchdog()
 
+/**********************************************************************
+ * Function: getSenderName
+ * @param Sender of a debug message.
+ * @return "A" for AtLAs, "C" for ComPAS, or "?".
+ * @author David Goodman
+ * @date 2026.10.18
+ **********************************************************************/
+static char *getSenderName(char sender) {
+    if (sender == MAVLINK_SENDER_ATLAS)
+        return "A";
+    else if (sender == MAVLINK_SENDER_COMPAS)
+        return "C";
+    return "?";
+}
+
 /**********************************************************************
  * Function: init
  * @return None.
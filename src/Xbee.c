@@ -17,6 +17,7 @@
  2-1-13   2:50  AM      jash        Complete functions and add comments.
  2-9-13   5:08  PM      jash        Added Mavlink functionality
  2-9-15   12:40 PM      jash        MAVLink test up and running, and set channel
+ 10-18-26               dagoodma    API mode with XBEE_API_MODE.
 ***********************************************************************/
 
 #include <xc.h>
@@ -28,6 +29,10 @@
 #include "Mavlink.h"
 #include "Timer.h"
 #include "Xbee.h"
+#ifdef XBEE_API_MODE
+#include <string.h>
+#include "XbeeApi.h"
+#endif
 
 
 /***********************************************************************
@@ -44,18 +49,42 @@
 //#define XBEE_REPROGRAM_SETTINGS
 //#define UNICAST_MSG
 
+#define OK_TIMEOUT          2000 // (ms) for the radio to answer a command
+#define RSSI_DELAY          1000 // (ms) between reading DB for the RSSI
+#define AT_FRAME_SIZE       8
+
 
 /**********************************************************************
  * PRIVATE PROTOTYPES                                                 *
  **********************************************************************/
 
 static uint8_t programMode();
+#ifdef XBEE_API_MODE
+static uint8_t setApiMode();
+static uint8_t sendCommand(char *command);
+static void readFrames();
+static void handleFrame(const XbeeApiFrame *frame);
+static void requestRssi(uint32_t time);
+static uint8_t nextFrameId();
+#endif
 
 /**********************************************************************
  * PRIVATE VARIABLES                                                  *
  **********************************************************************/
 static uint8_t xbeeUartId;
 
+#ifdef XBEE_API_MODE
+static XbeeApiParser apiParser;
+static XbeeStatistics statistics;
+static uint8_t frameId = XBEE_API_NO_FRAME_ID;
+static uint8_t rssiFrameId = XBEE_API_NO_FRAME_ID;
+static uint32_t rssiTime = 0;
+static uint32_t pendingTime = 0; // when a frame cut off by a span started
+
+static const uint8_t broadcastAddress[XBEE_API_ADDRESS_LEN] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF };
+#endif
+
 /**********************************************************************
  * PUBLIC FUNCTIONS                                                   *
  **********************************************************************/
@@ -68,6 +97,11 @@ uint8_t Xbee_init(uint8_t uartId){
         while(1);
         return FAILURE;
     }
+#elif defined(XBEE_API_MODE)
+    XbeeApi_init(&apiParser);
+    memset(&statistics, 0, sizeof(statistics));
+    if (setApiMode() == FAILURE)
+        return FAILURE;
 #else
     /*
     int i = 0;
@@ -92,16 +126,45 @@ uint8_t Xbee_init(uint8_t uartId){
 
 
 void Xbee_runSM(){
+#ifdef XBEE_API_MODE
+    readFrames();
+#else
     //Recieve bytes if they are available
     if(UART_isReceiveEmpty(xbeeUartId) == FALSE){
         Mavlink_recieve(xbeeUartId);
     }
+#endif
+    Mavlink_runSM();
 }
 
 uint8_t Xbee_getUartId() {
     return xbeeUartId;
 }
 
+#ifdef XBEE_API_MODE
+uint16_t Xbee_send(const uint8_t *data, uint16_t length) {
+    uint8_t header[XBEE_API_TRANSMIT_HEADER_LEN], checksum;
+    const uint8_t *address = statistics.hasPeerAddress ?
+        statistics.peerAddress : broadcastAddress;
+
+    if (length > XBEE_API_MAX_DATA || UART_getTransmitSpace(xbeeUartId)
+            < length + XBEE_API_TRANSMIT_OVERHEAD)
+        return 0;
+    // The whole request fits, so each part is written
+    XbeeApi_packTransmitHeader(header, nextFrameId(), address, data, length,
+        &checksum);
+    UART_write(xbeeUartId, header, sizeof(header), UART_WRITE_REJECT, 0);
+    UART_write(xbeeUartId, data, length, UART_WRITE_REJECT, 0);
+    UART_write(xbeeUartId, &checksum, 1, UART_WRITE_REJECT, 0);
+    return length;
+}
+
+const XbeeStatistics *Xbee_getStatistics() {
+    statistics.frameErrors = apiParser.errorCount;
+    return &statistics;
+}
+#endif
+
 
 /**********************************************************************
  * PRIVATE FUNCTIONS                                                  *
@@ -161,6 +224,141 @@ static uint8_t programMode(){
 #endif
 
 
+#ifdef XBEE_API_MODE
+/**********************************************************************
+ * Function: setApiMode
+ * @return Success or Failure based on weather the mode could be set.
+ * @remark Switches the radio to API mode (AP=1) from command mode. The
+ *  setting isn't written, so the radio starts in transparent mode again.
+ *  Needs the timer.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static uint8_t setApiMode() {
+    DELAY(API_DELAY); // guard time before +++
+    if (sendCommand("+++") == FAILURE
+            || sendCommand("ATAP1\r") == FAILURE
+            || sendCommand("ATCN\r") == FAILURE)
+        return FAILURE;
+    return SUCCESS;
+}
+
+/**********************************************************************
+ * Function: sendCommand
+ * @param Command to send, with its carriage return.
+ * @return Success, or Failure if the radio didn't answer OK in time.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static uint8_t sendCommand(char *command) {
+    const char *ok = "OK\r";
+    uint8_t matched = 0;
+    uint32_t start = get_time();
+    UART_putString(xbeeUartId, command, strlen(command));
+    while (get_time() - start < OK_TIMEOUT) {
+        if (UART_isReceiveEmpty(xbeeUartId))
+            continue;
+        if ((char)UART_getChar(xbeeUartId) == ok[matched])
+            matched++;
+        else
+            matched = 0;
+        if (ok[matched] == '\0')
+            return SUCCESS;
+    }
+    return FAILURE;
+}
+
+/**********************************************************************
+ * Function: readFrames
+ * @return None.
+ * @remark Parses API frames from each span of the receive buffer in place.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static void readFrames() {
+    const uint8_t *data;
+    uint16_t length;
+    while (UART_peekContiguous(xbeeUartId, &data, &length)) {
+        XbeeApi_parse(&apiParser, data, length, handleFrame);
+        if (apiParser.pendingStart >= 0)
+            pendingTime = UART_getReceiveTime(xbeeUartId, apiParser.pendingStart);
+        UART_consume(xbeeUartId, length);
+    }
+}
+
+/**********************************************************************
+ * Function: handleFrame
+ * @param API frame from the radio.
+ * @return None.
+ * @remark Passes the RF data of received packets to MAVLink, learning the
+ *  other radio's address from them, and counts transmit statuses and
+ *  RSSI readings.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static void handleFrame(const XbeeApiFrame *frame) {
+    uint32_t time = (frame->start >= 0) ?
+        UART_getReceiveTime(xbeeUartId, frame->start) : pendingTime;
+    switch (frame->type) {
+        case XBEE_API_RECEIVE_PACKET:
+            statistics.packetsReceived++;
+            memcpy(statistics.peerAddress, frame->address, XBEE_API_ADDRESS_LEN);
+            statistics.hasPeerAddress = TRUE;
+            Mavlink_parse(frame->data, frame->length, time);
+            requestRssi(time);
+            break;
+        case XBEE_API_TRANSMIT_STATUS:
+            if (frame->status == XBEE_API_DELIVERED)
+                statistics.delivered++;
+            else
+                statistics.failed++;
+            statistics.retries += frame->retries;
+            break;
+        case XBEE_API_AT_RESPONSE:
+            if (frame->frameId == rssiFrameId && frame->status == XBEE_API_AT_OK
+                    && frame->length > 0)
+                statistics.rssi = frame->data[0];
+            break;
+    }
+}
+
+/**********************************************************************
+ * Function: requestRssi
+ * @param Time (ms) a packet arrived.
+ * @return None.
+ * @remark Reads DB, the RSSI of the last packet, at most every RSSI_DELAY.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static void requestRssi(uint32_t time) {
+    uint8_t command[AT_FRAME_SIZE];
+    uint16_t length;
+    uint8_t id;
+    if (rssiFrameId != XBEE_API_NO_FRAME_ID && time - rssiTime < RSSI_DELAY)
+        return;
+    id = nextFrameId();
+    length = XbeeApi_packAtCommand(command, id, "DB");
+    if (UART_write(xbeeUartId, command, length, UART_WRITE_REJECT, 0) == length) {
+        rssiFrameId = id;
+        rssiTime = time;
+    }
+}
+
+/**********************************************************************
+ * Function: nextFrameId
+ * @return Frame ID for a transmit request or AT command, never
+ *  XBEE_API_NO_FRAME_ID so a status always comes back.
+ * @author David Goodman
+ * @date October 18, 2026
+ **********************************************************************/
+static uint8_t nextFrameId() {
+    if (++frameId == XBEE_API_NO_FRAME_ID)
+        frameId++;
+    return frameId;
+}
+#endif // XBEE_API_MODE
+
+
 /*************************************************************
  * This test function will program two Xbees, Master & Slave.
  * The Master will send data packets 1-255. However before
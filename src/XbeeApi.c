@@ -0,0 +1,240 @@
+/**********************************************************************
+ Module
+   XbeeApi.c
+
+ Author: David Goodman
+
+ Description
+    Packs and parses XBee API frames (see XbeeApi.h).
+
+ Notes
+    Frames are read a field at a time, and the frame data is copied in
+    runs, so a frame can be split over any number of spans. A frame with a
+    bad length or checksum is dropped, and the parser looks for the next
+    start byte after it. Without escaping (AP=1) a start byte in the data
+    of a dropped frame can be taken for a new frame, but its checksum will
+    almost always be wrong too.
+
+ History
+ When                   Who         What/Why
+ --------------         ---         --------
+ 10-18-26               dagoodma    Created file.
+***********************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#include "XbeeApi.h"
+
+
+/***********************************************************************
+ * PRIVATE DEFINITIONS                                                 *
+ ***********************************************************************/
+
+#define STATE_START         0
+#define STATE_LENGTH_HIGH   1
+#define STATE_LENGTH_LOW    2
+#define STATE_DATA          3
+#define STATE_CHECKSUM      4
+
+#define CHECKSUM_GOOD       0xFF // sum of the frame data and checksum
+
+// Offsets in the frame data
+#define TYPE_INDEX          0
+#define FRAME_ID_INDEX      1
+#define TRANSMIT_RETRIES_INDEX  4
+#define TRANSMIT_STATUS_INDEX   5
+#define RECEIVE_ADDRESS_INDEX   1
+#define RECEIVE_OPTIONS_INDEX   11
+#define AT_COMMAND_INDEX    2
+#define AT_STATUS_INDEX     4
+#define AT_DATA_INDEX       5
+
+#define TRANSMIT_STATUS_LEN 7
+#define AT_RESPONSE_LEN     5 // without a value
+
+#define UNKNOWN_ADDRESS     0xFFFE // 16 bit address, for 64 bit addressing
+
+/**********************************************************************
+ * PRIVATE PROTOTYPES                                                 *
+ **********************************************************************/
+
+static bool handleFrame(XbeeApiParser *parser, int16_t start,
+    XbeeApiFrameHandler handler);
+static uint8_t sum(const uint8_t *data, uint16_t length);
+
+/**********************************************************************
+ * PUBLIC FUNCTIONS                                                   *
+ **********************************************************************/
+
+void XbeeApi_init(XbeeApiParser *parser) {
+    parser->state = STATE_START;
+    parser->pendingStart = -1;
+    parser->frameCount = 0;
+    parser->errorCount = 0;
+    parser->skippedCount = 0;
+}
+
+uint16_t XbeeApi_parse(XbeeApiParser *parser, const uint8_t *data, uint16_t length,
+        XbeeApiFrameHandler handler) {
+    uint32_t startCount = parser->frameCount;
+    int16_t start = (parser->state == STATE_START) ? 0 : -1;
+    uint16_t i = 0, run;
+    const uint8_t *found;
+
+    while (i < length) {
+        switch (parser->state) {
+            case STATE_START:
+                found = memchr(&data[i], XBEE_API_START, length - i);
+                if (found == NULL) {
+                    parser->skippedCount += length - i;
+                    i = length;
+                    break;
+                }
+                parser->skippedCount += (found - data) - i;
+                i = found - data;
+                start = i++;
+                parser->state = STATE_LENGTH_HIGH;
+                break;
+            case STATE_LENGTH_HIGH:
+                parser->length = (uint16_t)data[i++] << 8;
+                parser->state = STATE_LENGTH_LOW;
+                break;
+            case STATE_LENGTH_LOW:
+                parser->length |= data[i++];
+                parser->index = 0;
+                parser->sum = 0;
+                if (parser->length == 0 || parser->length > XBEE_API_MAX_FRAME_DATA) {
+                    parser->errorCount++;
+                    parser->state = STATE_START;
+                }
+                else
+                    parser->state = STATE_DATA;
+                break;
+            case STATE_DATA:
+                run = parser->length - parser->index;
+                if (run > length - i)
+                    run = length - i;
+                memcpy(&parser->frame[parser->index], &data[i], run);
+                parser->sum += sum(&data[i], run);
+                parser->index += run;
+                i += run;
+                if (parser->index == parser->length)
+                    parser->state = STATE_CHECKSUM;
+                break;
+            case STATE_CHECKSUM:
+                if ((uint8_t)(parser->sum + data[i++]) != CHECKSUM_GOOD
+                        || !handleFrame(parser, start, handler))
+                    parser->errorCount++;
+                parser->state = STATE_START;
+                break;
+        }
+    }
+    parser->pendingStart = (parser->state == STATE_START) ? -1 : start;
+    return (uint16_t)(parser->frameCount - startCount);
+}
+
+uint16_t XbeeApi_pack(uint8_t *frame, uint8_t type, const uint8_t *data,
+        uint16_t length) {
+    frame[0] = XBEE_API_START;
+    frame[1] = (uint8_t)((length + 1) >> 8);
+    frame[2] = (uint8_t)(length + 1);
+    frame[3] = type;
+    memcpy(&frame[4], data, length);
+    frame[4 + length] = CHECKSUM_GOOD - (uint8_t)(type + sum(data, length));
+    return length + 5;
+}
+
+uint8_t XbeeApi_packTransmitHeader(uint8_t *header, uint8_t frameId,
+        const uint8_t *address, const uint8_t *data, uint16_t length, uint8_t *checksum) {
+    uint16_t frameLength = length + XBEE_API_TRANSMIT_HEADER_LEN - 3;
+
+    header[0] = XBEE_API_START;
+    header[1] = (uint8_t)(frameLength >> 8);
+    header[2] = (uint8_t)frameLength;
+    header[3] = XBEE_API_TRANSMIT_REQUEST;
+    header[4] = frameId;
+    memcpy(&header[5], address, XBEE_API_ADDRESS_LEN);
+    header[13] = (uint8_t)(UNKNOWN_ADDRESS >> 8);
+    header[14] = (uint8_t)UNKNOWN_ADDRESS;
+    header[15] = 0; // broadcast radius, the most hops
+    header[16] = 0; // options, from TO
+    *checksum = CHECKSUM_GOOD - (uint8_t)(sum(&header[3], XBEE_API_TRANSMIT_HEADER_LEN - 3)
+        + sum(data, length));
+    return XBEE_API_TRANSMIT_HEADER_LEN;
+}
+
+uint16_t XbeeApi_packAtCommand(uint8_t *frame, uint8_t frameId, const char *command) {
+    uint8_t data[3];
+    data[0] = frameId;
+    data[1] = (uint8_t)command[0];
+    data[2] = (uint8_t)command[1];
+    return XbeeApi_pack(frame, XBEE_API_AT_COMMAND, data, sizeof(data));
+}
+
+/**********************************************************************
+ * PRIVATE FUNCTIONS                                                  *
+ **********************************************************************/
+
+/**********************************************************************
+ * Function: handleFrame
+ * @param Parser with a complete frame.
+ * @param Offset of the frame in the span, or -1.
+ * @param Function to call if the frame is good.
+ * @return TRUE if the frame was long enough for its type and was handled.
+ * @remark Decodes the fields of the frame types in XbeeApi.h.
+ **********************************************************************/
+static bool handleFrame(XbeeApiParser *parser, int16_t start,
+        XbeeApiFrameHandler handler) {
+    XbeeApiFrame frame;
+    const uint8_t *bytes = parser->frame;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.type = bytes[TYPE_INDEX];
+    frame.data = &bytes[TYPE_INDEX + 1];
+    frame.length = parser->length - 1;
+    frame.start = start;
+    switch (frame.type) {
+        case XBEE_API_TRANSMIT_STATUS:
+            if (parser->length < TRANSMIT_STATUS_LEN)
+                return false;
+            frame.frameId = bytes[FRAME_ID_INDEX];
+            frame.retries = bytes[TRANSMIT_RETRIES_INDEX];
+            frame.status = bytes[TRANSMIT_STATUS_INDEX];
+            break;
+        case XBEE_API_RECEIVE_PACKET:
+            if (parser->length < XBEE_API_RECEIVE_HEADER_LEN)
+                return false;
+            frame.address = &bytes[RECEIVE_ADDRESS_INDEX];
+            frame.options = bytes[RECEIVE_OPTIONS_INDEX];
+            frame.data = &bytes[XBEE_API_RECEIVE_HEADER_LEN];
+            frame.length = parser->length - XBEE_API_RECEIVE_HEADER_LEN;
+            break;
+        case XBEE_API_AT_RESPONSE:
+            if (parser->length < AT_RESPONSE_LEN)
+                return false;
+            frame.frameId = bytes[FRAME_ID_INDEX];
+            frame.command[0] = (char)bytes[AT_COMMAND_INDEX];
+            frame.command[1] = (char)bytes[AT_COMMAND_INDEX + 1];
+            frame.status = bytes[AT_STATUS_INDEX];
+            frame.data = &bytes[AT_DATA_INDEX];
+            frame.length = parser->length - AT_DATA_INDEX;
+            break;
+    }
+    parser->frameCount++;
+    handler(&frame);
+    return true;
+}
+
+/**********************************************************************
+ * Function: sum
+ * @param Bytes to add.
+ * @param Number of bytes.
+ * @return Sum of the bytes, modulo 256.
+ **********************************************************************/
+static uint8_t sum(const uint8_t *data, uint16_t length) {
+    uint8_t total = 0;
+    uint16_t i;
+    for (i = 0; i < length; i++)
+        total += data[i];
+    return total;
+}
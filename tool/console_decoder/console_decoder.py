@@ -0,0 +1,200 @@
+#!/usr/bin/env python
+"""\
+console_decoder.py renders a binary console stream (CONSOLE_MODE_BINARY) as
+text, using the format strings in include/ConsoleMessages.h. With --mavlink
+it renders the DEBUG_EVENT messages in a MAVLink stream from the XBee
+instead, which use the same table.
+
+Author: David Goodman (dagoodma@ucsc.edu)
+
+Usage:
+    python console_decoder.py [-m messages_header] [-b baud_rate] [--mavlink] source
+
+The source is either a file holding a captured stream, or a serial port
+(needs pyserial). Each record is printed as "[time ms] message".
+
+Record layout (little endian):
+    0xC5, message id (1), argument count (1), time in ms (4), arguments (4 each)
+
+DEBUG_EVENT frames are printed as "[sender] message". Frames with a bad
+checksum are skipped, and a trimmed payload is filled out with zeros.
+
+Notes:
+-----
+* 2026-10-18 -- dagoodma
+    Created.
+* 2026-10-18 -- dagoodma
+    Decode MAVLink DEBUG_EVENT messages.
+
+"""
+import sys
+import os
+import re
+import struct
+import argparse
+
+CONSOLE_SYNC = 0xC5
+HEADER_SIZE = 7
+DEFAULT_HEADER = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+    '..', '..', 'include', 'ConsoleMessages.h')
+DEFAULT_BAUD = 115200
+
+MAVLINK_STX = 0xFE
+MAVLINK_HEADER_SIZE = 6 # STX, length, sequence, system, component, message ID
+MAVLINK_CRC_SIZE = 2
+DEBUG_EVENT_ID = 248
+DEBUG_EVENT_LENGTH = 37
+DEBUG_EVENT_CRC_EXTRA = 75
+DEBUG_EVENT_ARGS = 5 # offset of the arguments in the payload
+SENDERS = {1: 'A', 2: 'C'}
+
+MESSAGE_PATTERN = re.compile(r'CONSOLE_MESSAGE\(\s*(\w+)\s*,\s*"((?:[^"\\]|\\.)*)"\s*\)')
+SPEC_PATTERN = re.compile(r'%(%|[-+ #0]*\d*(?:\.\d+)?[hlLqjzt]*[diuxXcfeEgGs])')
+
+
+# Reads the message table in the same order the firmware numbers it.
+def loadMessages(path):
+    with open(path) as f:
+        text = f.read()
+    messages = []
+    for name, fmt in MESSAGE_PATTERN.findall(text):
+        fmt = fmt.encode('latin-1').decode('unicode_escape')
+        messages.append((name, fmt))
+    return messages
+
+
+# Renders one format with raw 32-bit argument words.
+def formatMessage(fmt, words):
+    args = list(words)
+
+    def convert(match):
+        spec = match.group(1)
+        if spec == '%':
+            return '%'
+        spec = re.sub(r'[hlLqjzt]', '', spec)
+        word = args.pop(0) if args else 0
+        kind = spec[-1]
+        if kind in 'dic':
+            value = struct.unpack('<i', struct.pack('<I', word))[0]
+        elif kind in 'uxX':
+            value = word
+        elif kind == 's':
+            return '?'
+        else:
+            value = struct.unpack('<f', struct.pack('<I', word))[0]
+        return ('%' + spec) % value
+
+    return SPEC_PATTERN.sub(convert, fmt)
+
+
+# Yields (time, id, words) for each record, skipping garbage between them.
+def readRecords(read):
+    data = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        data.extend(bytearray(chunk))
+        while True:
+            start = data.find(bytearray([CONSOLE_SYNC]))
+            if start < 0:
+                del data[:]
+                break
+            del data[:start]
+            if len(data) < HEADER_SIZE:
+                break
+            msgId, count = data[1], data[2]
+            length = HEADER_SIZE + 4 * count
+            if len(data) < length:
+                break
+            time = struct.unpack('<I', bytes(data[3:7]))[0]
+            words = struct.unpack('<%dI' % count, bytes(data[HEADER_SIZE:length]))
+            del data[:length]
+            yield time, msgId, words
+
+
+# X.25 checksum of MAVLink frames.
+def mavlinkCrc(data):
+    crc = 0xFFFF
+    for byte in bytearray(data):
+        tmp = (byte ^ crc) & 0xFF
+        tmp = (tmp ^ (tmp << 4)) & 0xFF
+        crc = ((crc >> 8) ^ (tmp << 8) ^ (tmp << 3) ^ (tmp >> 4)) & 0xFFFF
+    return crc
+
+
+# Yields (sender, id, words) for each DEBUG_EVENT, skipping other frames.
+def readDebugEvents(read):
+    data = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        data.extend(bytearray(chunk))
+        while True:
+            start = data.find(bytearray([MAVLINK_STX]))
+            if start < 0:
+                del data[:]
+                break
+            del data[:start]
+            if len(data) < MAVLINK_HEADER_SIZE:
+                break
+            length = MAVLINK_HEADER_SIZE + data[1] + MAVLINK_CRC_SIZE
+            if len(data) < length:
+                break
+            msgId = data[5]
+            if msgId != DEBUG_EVENT_ID or data[1] > DEBUG_EVENT_LENGTH:
+                del data[:1] # only the start byte, in case this wasn't a frame
+                continue
+            crc = mavlinkCrc(bytes(data[1:length - MAVLINK_CRC_SIZE])
+                + bytes(bytearray([DEBUG_EVENT_CRC_EXTRA])))
+            if crc != struct.unpack('<H', bytes(data[length - MAVLINK_CRC_SIZE:length]))[0]:
+                del data[:1]
+                continue
+            payload = bytes(data[MAVLINK_HEADER_SIZE:length - MAVLINK_CRC_SIZE])
+            payload += bytes(bytearray(DEBUG_EVENT_LENGTH - len(payload)))
+            del data[:length]
+            message, ack, sender, count = struct.unpack('<HBBB', payload[:DEBUG_EVENT_ARGS])
+            count = min(count, (DEBUG_EVENT_LENGTH - DEBUG_EVENT_ARGS) // 4)
+            words = struct.unpack('<%dI' % count,
+                payload[DEBUG_EVENT_ARGS:DEBUG_EVENT_ARGS + 4 * count])
+            yield SENDERS.get(sender, '?'), message, words
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode a binary console stream.')
+    parser.add_argument('source', help='captured stream file or serial port')
+    parser.add_argument('-m', '--messages', default=DEFAULT_HEADER,
+        help='path to ConsoleMessages.h')
+    parser.add_argument('-b', '--baud', type=int, default=DEFAULT_BAUD,
+        help='baud rate when reading a serial port')
+    parser.add_argument('--mavlink', action='store_true',
+        help='render DEBUG_EVENT messages in a MAVLink stream')
+    args = parser.parse_args()
+
+    messages = loadMessages(args.messages)
+
+    if os.path.isfile(args.source):
+        stream = open(args.source, 'rb')
+        read = lambda: stream.read(4096)
+    else:
+        import serial
+        stream = serial.Serial(args.source, args.baud, timeout=None)
+        read = lambda: stream.read(max(1, stream.inWaiting()))
+
+    records = readDebugEvents(read) if args.mavlink else readRecords(read)
+    try:
+        for time, msgId, words in records:
+            if msgId >= len(messages):
+                sys.stdout.write('[%s] unknown message %d %s\n' % (time, msgId, list(words)))
+                continue
+            sys.stdout.write('[%s] %s' % (time, formatMessage(messages[msgId][1], words)))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        stream.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,154 @@
+/*
+ * crc_benchmark.c checks every checksum method in src/MavlinkCrc.c against
+ * crc_accumulate from mavlink/checksum.h, and reports bytes/s for each.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -DMAVLINK_CRC_ALL -I../../include -o crc_benchmark crc_benchmark.c \
+ *         ../../src/MavlinkCrc.c
+ *
+ * Usage:
+ *     crc_benchmark [-n checks] [-b span_bytes] [-m megabytes] [-s seed]
+ *
+ * Each check takes a random span of random bytes, up to the largest MAVLink
+ * frame, at a random offset (so any alignment) and from a random starting
+ * checksum, and runs it through every method and through crc_accumulate a
+ * byte at a time. Any difference fails the benchmark.
+ *
+ * The timing runs each method over the same buffer, a span at a time like
+ * the parser does with frames. The default span is a BOAT_STATE frame. The
+ * host's speeds only show how the methods compare; the PIC32 has no data
+ * cache to lose the tables from, so the table methods do better there.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MavlinkCrc.h"
+#include "mavlink/autoLifeguard/mavlink.h"
+
+#define DEFAULT_CHECKS      100000
+#define DEFAULT_SPAN        (MAVLINK_MSG_ID_BOAT_STATE_LEN + MAVLINK_CORE_HEADER_LEN)
+#define DEFAULT_MEGABYTES   64
+#define BUFFER_SIZE         65536
+#define MAX_CHECK_LENGTH    MAVLINK_MAX_PACKET_LEN
+#define METHODS             4
+
+typedef uint16_t (*CrcMethod)(uint16_t crc, const uint8_t *data, uint16_t length);
+
+static const char *methodNames[METHODS] = {"bitwise", "nibble", "table", "slice8"};
+static const CrcMethod methods[METHODS] = {MavlinkCrc_updateBitwise,
+    MavlinkCrc_updateNibble, MavlinkCrc_updateTable, MavlinkCrc_updateSlice8};
+static const char *methodTables[METHODS] = {"none", "32 B", "512 B", "512 B + 4 KB RAM"};
+
+static uint8_t buffer[BUFFER_SIZE];
+
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// The checksum the MAVLink headers would give
+static uint16_t reference(uint16_t crc, const uint8_t *data, uint16_t length) {
+    uint16_t i;
+    for (i = 0; i < length; i++)
+        crc_accumulate(data[i], &crc);
+    return crc;
+}
+
+// Returns the number of checks any method got wrong
+static unsigned long checkMethods(unsigned long checks) {
+    unsigned long n, failures = 0;
+    uint16_t length, offset, start, expected;
+    int method;
+
+    for (n = 0; n < checks; n++) {
+        length = rand() % (MAX_CHECK_LENGTH + 1);
+        offset = rand() % (BUFFER_SIZE - MAX_CHECK_LENGTH);
+        start = (n % 4 == 0) ? X25_INIT_CRC : (uint16_t)rand();
+        expected = reference(start, &buffer[offset], length);
+        for (method = 0; method < METHODS; method++) {
+            if (methods[method](start, &buffer[offset], length) != expected) {
+                if (failures < 10)
+                    printf("  %s gave 0x%04X, not 0x%04X, for %u bytes at %u from 0x%04X\n",
+                        methodNames[method],
+                        methods[method](start, &buffer[offset], length), expected,
+                        length, offset, start);
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+// Returns bytes/s for a method run over the buffer a span at a time
+static double timeMethod(CrcMethod method, uint16_t span, unsigned long megabytes,
+        volatile uint16_t *sink) {
+    unsigned long total = megabytes * 1024UL * 1024UL, done = 0;
+    uint16_t offset = 0, crc = 0;
+    double start = now();
+    while (done < total) {
+        crc ^= method(X25_INIT_CRC, &buffer[offset], span);
+        offset += span;
+        if (offset + span > BUFFER_SIZE)
+            offset = 0;
+        done += span;
+    }
+    *sink = crc;
+    return done / (now() - start);
+}
+
+int main(int argc, char **argv) {
+    unsigned long checks = DEFAULT_CHECKS, megabytes = DEFAULT_MEGABYTES, failures;
+    unsigned int seed = 15;
+    long span = DEFAULT_SPAN;
+    double rate[METHODS];
+    volatile uint16_t sink;
+    int method, i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            checks = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            span = atol(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            megabytes = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [-n checks] [-b span_bytes] [-m megabytes]"
+                " [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (span <= 0 || span > BUFFER_SIZE / 2 || megabytes == 0) {
+        fprintf(stderr, "Bad span or size.\n");
+        return 2;
+    }
+
+    srand(seed);
+    for (i = 0; i < BUFFER_SIZE; i++)
+        buffer[i] = (uint8_t)rand();
+    failures = checkMethods(checks);
+
+    printf("%lu random checks, %lu MB in %ld byte spans:\n", checks, megabytes, span);
+    for (method = 0; method < METHODS; method++) {
+        rate[method] = timeMethod(methods[method], (uint16_t)span, megabytes, &sink);
+        printf("  %-8s %8.1f MB/s  %5.2fx  tables %s\n", methodNames[method],
+            rate[method] / (1024 * 1024), rate[method] / rate[0], methodTables[method]);
+    }
+
+    if (failures > 0) {
+        printf("FAILED: %lu checksums differ from crc_accumulate.\n", failures);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * ecef_accuracy.c measures how much the GPS position loses on its way to
+ * a local (NED) position, with ECEF in integer centimeters
+ * (src/Coordinates.c), and with the float meters used before.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o ecef_accuracy ecef_accuracy.c \
+ *         ../../src/Coordinates.c -lm
+ *
+ * Usage:
+ *     ecef_accuracy [-o meters] log.dlm [log.dlm ...]
+ *
+ * The logs are geodetic recordings from model/gps/data (lat,lon,alt
+ * lines), whose 1e-7 degrees and millimeters are what the receiver sends.
+ * The origin is the first position of each log, moved the given distance
+ * north and east (500 m by default) so the positions are as far away as
+ * in a rescue. Each position goes from the receiver to NED like:
+ *     NAV-PVT  - convertFixedGeodetic2ECEF, then convertECEF2NED from an
+ *                origin set by Navigation_setOrigin
+ *     NAV-SOL  - ECEF in cm as sent, worked out here in doubles, then
+ *                convertECEF2NED
+ *     float    - float ECEF in meters through a copy of the conversions
+ *                from before
+ * and is compared to the same conversions in doubles. Both the position
+ * and the origin are rounded to whole centimeters, so the first two are
+ * about half a centimeter off on average. Fails if either is ever 3 cm or
+ * more off horizontally.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Coordinates.h"
+
+#define DEFAULT_OFFSET      500.0 // (m) of the origin from the first position
+#define MAX_ERROR           0.03 // (m) horizontal, two points rounded to cm
+#define LINE_SIZE           128
+
+#define A                   6378137.0 // (m) WGS 84 semi-major axis
+#define E2                  0.00669437999014 // eccentricity squared
+
+typedef struct {
+    double north, east, down;
+} Ned;
+
+typedef struct {
+    const char *name;
+    double sum, max;        // of squared and greatest horizontal errors
+} Error;
+
+/**********************************************************************
+ * Double precision reference
+ **********************************************************************/
+
+static void geodeticToEcef(double lat, double lon, double alt, double *ecef) {
+    double sinLat = sin(lat * M_PI / 180.0), cosLat = cos(lat * M_PI / 180.0);
+    double n = A / sqrt(1.0 - E2 * sinLat * sinLat);
+    ecef[0] = (n + alt) * cosLat * cos(lon * M_PI / 180.0);
+    ecef[1] = (n + alt) * cosLat * sin(lon * M_PI / 180.0);
+    ecef[2] = (n * (1.0 - E2) + alt) * sinLat;
+}
+
+static void ecefToNed(const double *ecef, const double *origin, double lat, double lon,
+        Ned *ned) {
+    double dx = ecef[0] - origin[0], dy = ecef[1] - origin[1], dz = ecef[2] - origin[2];
+    double sinLat = sin(lat * M_PI / 180.0), cosLat = cos(lat * M_PI / 180.0);
+    double sinLon = sin(lon * M_PI / 180.0), cosLon = cos(lon * M_PI / 180.0);
+    double t = cosLon * dx + sinLon * dy;
+    ned->north = -sinLat * t + cosLat * dz;
+    ned->east = -sinLon * dx + cosLon * dy;
+    ned->down = -(cosLat * t + sinLat * dz);
+}
+
+/**********************************************************************
+ * Float ECEF in meters, as src/Gps.c converted it before
+ **********************************************************************/
+
+#define ECC     0.0818191908426f
+#define ECC2    (ECC*ECC)
+#define R_EN    6378137.0f
+
+typedef struct {
+    float x, y, z;
+} FloatEcef;
+
+static void floatGeodetic2ECEF(FloatEcef *ecef, GeodeticCoordinate *lla) {
+    float sinlat = sinf(DEGREE_TO_RADIAN*lla->lat);
+    float coslat = cosf(DEGREE_TO_RADIAN*lla->lat);
+
+    float rad_ne = R_EN / sqrt(1.0 - (ECC2 * sinlat * sinlat));
+    ecef->x = (rad_ne + lla->alt) * coslat * cosf(lla->lon*DEGREE_TO_RADIAN);
+    ecef->y = (rad_ne + lla->alt) * coslat * sinf(lla->lon*DEGREE_TO_RADIAN);
+    ecef->z = (rad_ne*(1.0 - ECC2) + lla->alt) * sinlat;
+}
+
+static void floatECEF2NED(LocalCoordinate *ned, FloatEcef *ecef_cur, FloatEcef *ecef_ref,
+        GeodeticCoordinate *geo_ref) {
+    FloatEcef ecef_path;
+    ecef_path.x = ecef_cur->x - ecef_ref->x;
+    ecef_path.y = ecef_cur->y - ecef_ref->y;
+    ecef_path.z = ecef_cur->z - ecef_ref->z;
+
+    float cosLat = cosf(geo_ref->lat * DEGREE_TO_RADIAN);
+    float sinLat = sinf(geo_ref->lat * DEGREE_TO_RADIAN);
+    float cosLon = cosf(geo_ref->lon * DEGREE_TO_RADIAN);
+    float sinLon = sinf(geo_ref->lon * DEGREE_TO_RADIAN);
+
+    float t =  cosLon * ecef_path.x + sinLon * ecef_path.y;
+
+    ned->north = -sinLat * t + cosLat * ecef_path.z;
+    ned->east = -sinLon * ecef_path.x + cosLon * ecef_path.y;
+    ned->down = -(cosLat * t + sinLat * ecef_path.z);
+}
+
+/**********************************************************************
+ * Comparison
+ **********************************************************************/
+
+static void addError(Error *error, const LocalCoordinate *ned, const Ned *reference) {
+    double dn = ned->north - reference->north, de = ned->east - reference->east;
+    double squared = dn * dn + de * de;
+    error->sum += squared;
+    if (sqrt(squared) > error->max)
+        error->max = sqrt(squared);
+}
+
+static int32_t toFixed(double value, double scale) {
+    return (int32_t)lround(value * scale);
+}
+
+int main(int argc, char **argv) {
+    double offset = DEFAULT_OFFSET;
+    Error errors[3] = { { .name = "NAV-PVT" }, { .name = "NAV-SOL" }, { .name = "float" } };
+    unsigned long count = 0;
+    int i, e, logs = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            offset = atof(argv[++i]);
+            continue;
+        }
+        FILE *file = fopen(argv[i], "r");
+        char line[LINE_SIZE];
+        double lat, lon, alt, originLat = 0.0, originLon = 0.0, originAlt = 0.0;
+        double originEcef[3], ecef[3];
+        GeocentricCoordinate fixedOrigin, fixed;
+        GeodeticCoordinate llaOrigin, lla, floatLlaOrigin;
+        FloatEcef floatOrigin, floatPosition;
+        LocalCoordinate ned;
+        Ned reference;
+        int hasOrigin = 0;
+
+        if (file == NULL) {
+            perror(argv[i]);
+            return 2;
+        }
+        logs++;
+        while (fgets(line, sizeof(line), file) != NULL) {
+            if (sscanf(line, "%lf,%lf,%lf", &lat, &lon, &alt) != 3)
+                continue;
+            // As the receiver would send it
+            lat = toFixed(lat, 1e7) / 1e7;
+            lon = toFixed(lon, 1e7) / 1e7;
+            alt = toFixed(alt, 1e3) / 1e3;
+
+            if (!hasOrigin) {
+                // Moved north and east, like a command center on the shore
+                originLat = toFixed(lat + offset / 111320.0, 1e7) / 1e7;
+                originLon = toFixed(lon + offset / (111320.0 * cos(lat * M_PI / 180.0)),
+                    1e7) / 1e7;
+                originAlt = alt;
+                geodeticToEcef(originLat, originLon, originAlt, originEcef);
+                convertFixedGeodetic2ECEF(&fixedOrigin, toFixed(originLat, 1e7),
+                    toFixed(originLon, 1e7), toFixed(originAlt, 1e3));
+                convertECEF2Geodetic(&llaOrigin, &fixedOrigin); // Navigation_setOrigin
+                floatLlaOrigin.lat = originLat;
+                floatLlaOrigin.lon = originLon;
+                floatLlaOrigin.alt = originAlt;
+                floatGeodetic2ECEF(&floatOrigin, &floatLlaOrigin);
+                hasOrigin = 1;
+            }
+            geodeticToEcef(lat, lon, alt, ecef);
+            ecefToNed(ecef, originEcef, originLat, originLon, &reference);
+
+            convertFixedGeodetic2ECEF(&fixed, toFixed(lat, 1e7), toFixed(lon, 1e7),
+                toFixed(alt, 1e3));
+            convertECEF2NED(&ned, &fixed, &fixedOrigin, &llaOrigin);
+            addError(&errors[0], &ned, &reference);
+
+            fixed.x = toFixed(ecef[0], ECEF_PER_METER);
+            fixed.y = toFixed(ecef[1], ECEF_PER_METER);
+            fixed.z = toFixed(ecef[2], ECEF_PER_METER);
+            convertECEF2NED(&ned, &fixed, &fixedOrigin, &llaOrigin);
+            addError(&errors[1], &ned, &reference);
+
+            lla.lat = lat;
+            lla.lon = lon;
+            lla.alt = alt;
+            floatGeodetic2ECEF(&floatPosition, &lla);
+            floatECEF2NED(&ned, &floatPosition, &floatOrigin, &floatLlaOrigin);
+            addError(&errors[2], &ned, &reference);
+            count++;
+        }
+        fclose(file);
+    }
+    if (count == 0) {
+        fprintf(stderr, "usage: %s [-o meters] log.dlm [log.dlm ...]\n", argv[0]);
+        return 2;
+    }
+
+    printf("%lu positions from %d logs, origin %.0f m away\n", count, logs,
+        offset * sqrt(2.0));
+    printf("  %-8s %12s %12s\n", "path", "RMS (cm)", "max (cm)");
+    for (e = 0; e < 3; e++) {
+        printf("  %-8s %12.2f %12.2f\n", errors[e].name,
+            100.0 * sqrt(errors[e].sum / count), 100.0 * errors[e].max);
+    }
+    if (errors[0].max >= MAX_ERROR || errors[1].max >= MAX_ERROR) {
+        printf("FAILED\n");
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * gps_history.c checks the GPS fix history (src/GpsHistory.c) against a
+ * boat circling at 5 m/s, and times its lookups.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o gps_history gps_history.c \
+ *         ../../src/GpsHistory.c -lm
+ *
+ * Usage:
+ *     gps_history [-r rate_hz] [-j jitter_ms] [-n fixes]
+ *
+ * Fixes are added at the given rate (5 Hz by default), starting a few
+ * seconds before the end of the GPS week, each arriving 40 ms after its
+ * iTow plus up to jitter_ms. After each one, the history is looked up at
+ * random local and GPS times over the last GPS_HISTORY_LENGTH fixes, and
+ * the interpolated position, velocity and heading are compared to the
+ * circle. Positions must be within a centimeter or two of the chord
+ * between the fixes. Times outside the history must not be found, and a fix
+ * out of order must empty it.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "GpsHistory.h"
+
+#define DEFAULT_RATE        5   // (Hz)
+#define DEFAULT_JITTER      10  // (ms) on top of ARRIVAL_DELAY
+#define DEFAULT_FIXES       2000
+#define ARRIVAL_DELAY       40  // (ms) from iTow to the message arriving
+#define LOOKUPS             20  // per fix added
+#define TIMED_LOOKUPS       1000000
+#define START_TOW           (GPS_WEEK_MS - 5000) // wraps after 5 s
+
+#define RADIUS              10.0 // (m) of the circle
+#define SPEED               5.0 // (m/s), so fixes are far apart
+#define ROUNDING_ERROR      0.02 // (m) on top of cutting the corners
+#define MAX_VELOCITY_ERROR  20  // (cm/s) cutting the corners at 1 Hz
+#define MAX_HEADING_ERROR   50000 // (1e-5 deg)
+
+// Center of the circle, and the ENU to ECEF rotation there
+static double center[3], east[3], north[3];
+static double maxPositionError; // (m)
+
+static void setCenter(double lat, double lon) {
+    double a = 6378137.0, e2 = 0.00669437999014;
+    double sinLat = sin(lat * M_PI / 180.0), cosLat = cos(lat * M_PI / 180.0);
+    double sinLon = sin(lon * M_PI / 180.0), cosLon = cos(lon * M_PI / 180.0);
+    double n = a / sqrt(1.0 - e2 * sinLat * sinLat);
+    center[0] = n * cosLat * cosLon;
+    center[1] = n * cosLat * sinLon;
+    center[2] = n * (1.0 - e2) * sinLat;
+    east[0] = -sinLon; east[1] = cosLon; east[2] = 0.0;
+    north[0] = -sinLat * cosLon; north[1] = -sinLat * sinLon; north[2] = cosLat;
+}
+
+// Where the boat is, seconds after it starts
+static void getTruth(double seconds, GpsFix *fix) {
+    double angle = seconds * SPEED / RADIUS;
+    double e = RADIUS * cos(angle), n = RADIUS * sin(angle);
+    double heading = atan2(cos(angle), -sin(angle)) * 180.0 / M_PI; // from north
+    fix->position.x = (int32_t)lround((center[0] + e * east[0] + n * north[0]) * ECEF_PER_METER);
+    fix->position.y = (int32_t)lround((center[1] + e * east[1] + n * north[1]) * ECEF_PER_METER);
+    fix->position.z = (int32_t)lround((center[2] + e * east[2] + n * north[2]) * ECEF_PER_METER);
+    fix->northVelocity = (int32_t)lround(SPEED * 100.0 * cos(angle));
+    fix->eastVelocity = (int32_t)lround(-SPEED * 100.0 * sin(angle));
+    if (heading < 0.0)
+        heading += 360.0;
+    fix->heading = (int32_t)lround(heading * 100000.0);
+}
+
+static int checkFix(const GpsFix *fix, double seconds, const char *name) {
+    GpsFix truth;
+    double dx, dy, dz;
+    int32_t turn;
+    getTruth(seconds, &truth);
+    dx = ECEF_TO_METERS(fix->position.x - truth.position.x);
+    dy = ECEF_TO_METERS(fix->position.y - truth.position.y);
+    dz = ECEF_TO_METERS(fix->position.z - truth.position.z);
+    turn = labs(fix->heading - truth.heading);
+    if (turn > 18000000)
+        turn = 36000000 - turn;
+    if (sqrt(dx * dx + dy * dy + dz * dz) > maxPositionError
+            || labs(fix->northVelocity - truth.northVelocity) > MAX_VELOCITY_ERROR
+            || labs(fix->eastVelocity - truth.eastVelocity) > MAX_VELOCITY_ERROR
+            || turn > MAX_HEADING_ERROR) {
+        printf("    %s at %.3f s is off: %.2f m, %d %d cm/s, heading %d\n", name,
+            seconds, sqrt(dx * dx + dy * dy + dz * dz),
+            (int)(fix->northVelocity - truth.northVelocity),
+            (int)(fix->eastVelocity - truth.eastVelocity), (int)turn);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    int rate = DEFAULT_RATE, jitter = DEFAULT_JITTER, fixes = DEFAULT_FIXES;
+    int i, n, failed = 0;
+    uint32_t period, iTow, times[GPS_HISTORY_LENGTH], tows[GPS_HISTORY_LENGTH];
+    unsigned long lookups = 0, found = 0;
+    GpsHistory history;
+    GpsFix fix, result;
+    clock_t start;
+    double elapsed;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            rate = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            jitter = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            fixes = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-r rate_hz] [-j jitter_ms] [-n fixes]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rate < 1 || rate > 20 || jitter < 0 || fixes < GPS_HISTORY_LENGTH) {
+        fprintf(stderr, "Bad rate, jitter or number of fixes.\n");
+        return 2;
+    }
+    period = 1000 / rate;
+    maxPositionError = RADIUS * (1.0 - cos(SPEED * period / 1000.0 / RADIUS / 2.0))
+        + ROUNDING_ERROR;
+    setCenter(36.9512546, -122.0269492);
+    srand(1);
+
+    GpsHistory_init(&history);
+    if (GpsHistory_getLatest(&history) != NULL || GpsHistory_getAt(&history, 0, &result)) {
+        printf("    empty history returned a fix\n");
+        failed = 1;
+    }
+    memset(&fix, 0, sizeof(fix));
+    fix.numSv = 8;
+    fix.fixType = 3;
+    fix.hAcc = 2500;
+    fix.vAcc = 4000;
+    for (n = 0; n < fixes; n++) {
+        iTow = (START_TOW + n * period) % GPS_WEEK_MS;
+        getTruth(n * period / 1000.0, &fix);
+        fix.iTow = iTow;
+        // Local time starts near its own wrap too
+        fix.time = 0xFFFFF000UL + n * period + ARRIVAL_DELAY + rand() % (jitter + 1);
+        GpsHistory_add(&history, &fix);
+        times[n % GPS_HISTORY_LENGTH] = fix.time;
+        tows[n % GPS_HISTORY_LENGTH] = iTow;
+        if (GpsHistory_getLatest(&history)->iTow != iTow) {
+            printf("    latest fix isn't the one added\n");
+            failed = 1;
+        }
+
+        for (i = 0; i < LOOKUPS && n > 0; i++) {
+            int held = (n + 1 < GPS_HISTORY_LENGTH) ? n + 1 : GPS_HISTORY_LENGTH;
+            int older = n - (rand() % (held - 1)) - 1; // a fix and the next one
+            uint32_t offset = rand() % period, localSpan;
+            double seconds = (older * period + offset) / 1000.0;
+            bool isFound;
+
+            lookups++;
+            isFound = GpsHistory_getAtTow(&history,
+                (tows[older % GPS_HISTORY_LENGTH] + offset) % GPS_WEEK_MS, &result);
+            if (!isFound || !checkFix(&result, seconds, "GPS time")) {
+                printf("    fix %d: lookup by GPS time failed\n", n);
+                failed = 1;
+                continue;
+            }
+            found++;
+
+            // Same place in between the arrivals
+            localSpan = times[(older + 1) % GPS_HISTORY_LENGTH] - times[older % GPS_HISTORY_LENGTH];
+            offset = localSpan * offset / period;
+            lookups++;
+            isFound = GpsHistory_getAt(&history, times[older % GPS_HISTORY_LENGTH] + offset,
+                &result);
+            seconds = (older * period + offset * (double)period / localSpan) / 1000.0;
+            if (!isFound || !checkFix(&result, seconds, "local time")) {
+                printf("    fix %d: lookup by local time failed\n", n);
+                failed = 1;
+                continue;
+            }
+            found++;
+        }
+
+        // Just outside of the history
+        if (GpsHistory_getAt(&history, fix.time + 1, &result)
+                || (n >= GPS_HISTORY_LENGTH && GpsHistory_getAtTow(&history,
+                (tows[(n + 1) % GPS_HISTORY_LENGTH] + GPS_WEEK_MS - 1) % GPS_WEEK_MS,
+                &result))) {
+            printf("    fix %d: found a time outside the history\n", n);
+            failed = 1;
+        }
+    }
+
+    // Timed over the whole history
+    start = clock();
+    for (i = 0; i < TIMED_LOOKUPS; i++) {
+        GpsHistory_getAt(&history, times[(n - GPS_HISTORY_LENGTH) % GPS_HISTORY_LENGTH]
+            + i % ((GPS_HISTORY_LENGTH - 1) * period), &result);
+    }
+    elapsed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    // Going back in time empties it
+    fix.iTow = (START_TOW + period) % GPS_WEEK_MS;
+    GpsHistory_add(&history, &fix);
+    if (history.count != 1) {
+        printf("    fix out of order kept %u old fixes\n", history.count - 1);
+        failed = 1;
+    }
+
+    printf("%d fixes at %d Hz, %lu of %lu lookups good, %.0f ns each\n", fixes, rate,
+        found, lookups, 1e9 * elapsed / TIMED_LOOKUPS);
+    if (failed || found != lookups) {
+        printf("FAILED\n");
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
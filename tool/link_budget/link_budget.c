@@ -0,0 +1,172 @@
+/*
+ * link_budget.c compares the XBee airtime of the boat's telemetry sent as
+ * separate frames with the BOAT_STATE keyframe and delta stream
+ * (src/Telemetry.c), for a simulated boat run.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o link_budget link_budget.c ../../src/Telemetry.c -lm
+ *
+ * Usage:
+ *     link_budget [-r rate_hz] [-t seconds] [-b baud] [-s share_percent] [-l loss_percent]
+ *
+ * Separate frames means a GPS_NED position, a STATUS_AND_ERROR and a DATA
+ * frame for each update, which still leaves out heading and speed. Both ways
+ * also carry the heartbeat, DATA and UART_STATS frames Atlas sends on its
+ * timers. The budget is the share of the link's bytes per second (10 bits a
+ * byte) given to the boat, and the report gives the fastest update rate that
+ * fits in it.
+ *
+ * Every frame of the stream is decoded again and checked against what was
+ * sent. With loss, deltas whose keyframe was lost are counted instead.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "Telemetry.h"
+
+#define DEFAULT_RATE        4 // (Hz) boat state updates
+#define DEFAULT_SECONDS     600
+#define DEFAULT_BAUD        9600 // XBEE_BAUD_RATE
+#define DEFAULT_SHARE       50 // (%) of the link for the boat
+
+#define BOAT_SPEED          1.5 // (m/s)
+#define TURN_PERIOD         120.0 // (s) for a full circle
+#define STATE_PERIOD        90 // (s) between nav state changes
+
+// Background frames Atlas sends on its timers
+#define HEARTBEAT_PERIOD    3.0 // (s) HEARTBEAT_SEND_DELAY
+#define DATA_PERIOD         10.0 // (s) DATA_SEND_DELAY, DATA and 2 UART_STATS
+
+#define FRAME_SIZE(len)     ((len) + MAVLINK_NUM_NON_PAYLOAD_BYTES)
+
+
+static double separateUpdateSize() {
+    return FRAME_SIZE(MAVLINK_MSG_ID_GPS_NED_LEN)
+        + FRAME_SIZE(MAVLINK_MSG_ID_STATUS_AND_ERROR_LEN)
+        + FRAME_SIZE(MAVLINK_MSG_ID_DATA_LEN);
+}
+
+static double backgroundRate() {
+    return FRAME_SIZE(MAVLINK_MSG_ID_HEARTBEAT_LEN) / HEARTBEAT_PERIOD
+        + (FRAME_SIZE(MAVLINK_MSG_ID_DATA_LEN)
+        + 2*FRAME_SIZE(MAVLINK_MSG_ID_UART_STATS_LEN)) / DATA_PERIOD;
+}
+
+// Boat driving a circle at constant speed, changing nav state now and then
+static void simulate(double t, mavlink_boat_state_t *state) {
+    double angle = 2*M_PI*t / TURN_PERIOD;
+    double radius = BOAT_SPEED * TURN_PERIOD / (2*M_PI);
+    double heading = fmod(angle * 180/M_PI + 90.0, 360.0);
+    memset(state, 0, sizeof(mavlink_boat_state_t));
+    state->north = (int32_t)lround(100 * radius * sin(angle));
+    state->east = (int32_t)lround(100 * radius * (1 - cos(angle)));
+    state->down = -20;
+    state->heading = (uint16_t)lround(heading * 100) % 36000;
+    state->speed = (uint16_t)lround(100 * (BOAT_SPEED + 0.2*sin(t)));
+    state->navState = 1 + ((int)t / STATE_PERIOD) % 5;
+    state->batVolt1 = 12000 - (uint16_t)(t / 2);
+    state->batVolt2 = 11800 - (uint16_t)(t / 3);
+}
+
+static int headingError(uint16_t a, uint16_t b) {
+    int error = abs((int)a - (int)b);
+    return (error > 18000) ? 36000 - error : error;
+}
+
+int main(int argc, char **argv) {
+    double rate = DEFAULT_RATE, seconds = DEFAULT_SECONDS, t;
+    int baud = DEFAULT_BAUD, share = DEFAULT_SHARE, loss = 0, i;
+    TelemetryEncoder encoder;
+    TelemetryDecoder decoder;
+    TelemetryPayload payload;
+    mavlink_boat_state_t sent, received;
+    uint8_t msgid, length;
+    unsigned long updates = 0, keyframes = 0, lost = 0, bad = 0, streamBytes = 0;
+    int maxPositionError = 0, maxHeadingError = 0;
+    double budget, background, separateSize, streamSize;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            rate = atof(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            baud = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            share = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            loss = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-r rate_hz] [-t seconds] [-b baud]"
+                " [-s share_percent] [-l loss_percent]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rate <= 0 || seconds <= 0 || baud <= 0 || share <= 0 || share > 100) {
+        fprintf(stderr, "Bad rate, time, baud or share.\n");
+        return 2;
+    }
+
+    Telemetry_initEncoder(&encoder);
+    Telemetry_initDecoder(&decoder);
+    srand(3);
+    for (t = 0; t < seconds; t += 1.0 / rate) {
+        simulate(t, &sent);
+        length = Telemetry_encode(&encoder, &sent, &payload, &msgid);
+        streamBytes += FRAME_SIZE(length);
+        updates++;
+        if (msgid == MAVLINK_MSG_ID_BOAT_STATE)
+            keyframes++;
+        if (rand() % 100 < loss) {
+            lost++;
+            continue;
+        }
+        if (!Telemetry_unpack(&decoder, msgid, (const uint8_t*)&payload, length,
+                &received))
+            continue;
+        if (received.north != sent.north || received.east != sent.east
+                || received.speed != sent.speed || received.navState != sent.navState
+                || headingError(received.heading, sent.heading) > 50)
+            bad++;
+        if (abs(received.north - sent.north) > maxPositionError)
+            maxPositionError = abs(received.north - sent.north);
+        if (headingError(received.heading, sent.heading) > maxHeadingError)
+            maxHeadingError = headingError(received.heading, sent.heading);
+    }
+
+    budget = baud / 10.0 * share / 100;
+    background = backgroundRate();
+    separateSize = separateUpdateSize();
+    streamSize = (double)streamBytes / updates;
+
+    printf("%.0f s at %.1f Hz, %d baud, %d%% share (%.0f bytes/s), background %.1f bytes/s\n",
+        seconds, rate, baud, share, budget, background);
+    printf("  %-16s %5.1f bytes/update  %7.1f bytes/s  fits %5.1f Hz\n",
+        "separate frames", separateSize, separateSize * rate + background,
+        (budget - background) / separateSize);
+    printf("  %-16s %5.1f bytes/update  %7.1f bytes/s  fits %5.1f Hz"
+        "  (%lu keyframes, %lu deltas)\n",
+        "boat state", streamSize, streamSize * rate + background,
+        (budget - background) / streamSize, keyframes, updates - keyframes);
+    printf("  %-16s %5.1f bytes/update  (position only)\n", "GPS_NED",
+        (double)FRAME_SIZE(MAVLINK_MSG_ID_GPS_NED_LEN));
+    printf("Update rate gain: %.1fx. Max heading error %.2f deg, position error %d cm.\n",
+        separateSize / streamSize, maxHeadingError / 100.0, maxPositionError);
+    if (loss > 0)
+        printf("Lost %lu frames, %lu deltas dropped for a missing keyframe.\n",
+            lost, (unsigned long)decoder.droppedCount);
+
+    if (bad > 0) {
+        printf("FAILED: %lu updates decoded wrong.\n", bad);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
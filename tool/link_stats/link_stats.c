@@ -0,0 +1,282 @@
+/*
+ * link_stats.c runs the command center and the boat as two nodes joined by
+ * a simulated XBee link, and checks the round trip time, frame loss and
+ * CRC failures that src/LinkStats.c measures from their heartbeats against
+ * what the link did.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o link_stats link_stats.c \
+ *         ../../src/LinkStats.c ../../src/MavlinkParser.c ../../src/MavlinkCrc.c
+ *
+ * Usage:
+ *     link_stats [-t seconds] [-d delay_ms] [-b baud] [-l loss_percent]
+ *                [-c corrupt_percent]
+ *
+ * The boat sends a BOAT_STATE_DELTA every 250 ms and a DATA frame every 10
+ * s, and the command center a GPS_NED every 3.75 s. Both send a heartbeat
+ * every 3 s, like Atlas and Compas. Frames go out one after another at the
+ * baud rate, and arrive after the one-way delay. Each frame is lost with
+ * the given chance, or has a payload byte changed with the corrupt chance.
+ *
+ * Fails if the RTT is under twice the delay or more than 100 ms over it,
+ * if the frames counted lost differ from the frames the link lost or
+ * corrupted by more than the frames sent between heartbeats, or if fewer
+ * CRC failures are counted than frames were corrupted. There can be more,
+ * when the parser tries a start byte inside a corrupted frame.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "LinkStats.h"
+#include "MavlinkParser.h"
+
+#define DEFAULT_SECONDS     600
+#define DEFAULT_DELAY       20 // (ms) one way, besides time on the air
+#define DEFAULT_BAUD        9600 // XBEE_BAUD_RATE
+#define MAX_IN_FLIGHT       64
+#define RTT_SLACK           100 // (ms) allowed for waiting behind other frames
+
+#define HEARTBEAT_PERIOD    3000 // (ms) HEARTBEAT_SEND_DELAY
+#define DELTA_PERIOD        250 // (ms) boat state updates at 4 Hz
+#define DATA_PERIOD         10000 // (ms) DATA_SEND_DELAY
+#define CORRECTION_PERIOD   3750 // (ms) GPS_CORRECTION_SEND_DELAY
+
+#define SYSID               15
+#define COMPID              15
+
+#define COMMAND_CENTER      0
+#define BOAT                1
+#define NODES               2
+
+typedef struct {
+    unsigned long start; // (ms) first byte arrives
+    unsigned long end; // (ms) last byte arrives
+    uint16_t length;
+    uint8_t data[MAVLINK_MAX_PACKET_LEN];
+} Packet;
+
+typedef struct {
+    LinkStats stats;
+    MavlinkParser parser;
+    uint8_t sequence;
+    Packet link[MAX_IN_FLIGHT]; // frames on the way to this node
+    unsigned long linkFree; // (ms) when the other node can start a frame
+    unsigned long lost; // frames the link lost or corrupted to this node
+    unsigned long corrupted;
+    unsigned long lostAtHeartbeat; // lost before the last heartbeat
+    unsigned long windows; // complete windows, for the average loss rate
+    unsigned long lossRateTotal;
+    unsigned long rttSamples;
+} Node;
+
+static Node nodes[NODES];
+static int delay, baud, lossPercent, corruptPercent;
+static unsigned long now; // (ms)
+static Node *receiver;
+static unsigned long arrival;
+
+
+static unsigned long airtime(uint16_t length) {
+    return (length * 10 * 1000UL) / baud;
+}
+
+// Like writeXbee in src/Mavlink.c, the frame counts as sent once written
+static void sendFrame(int from, uint8_t msgid, const void *payload, uint8_t length) {
+    Node *sender = &nodes[from], *to = &nodes[NODES - 1 - from];
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    uint16_t frameLength = MavlinkParser_pack(frame, sender->sequence++, SYSID, COMPID,
+        msgid, payload, length);
+    unsigned long start = (to->linkFree > now) ? to->linkFree : now;
+    int i;
+
+    LinkStats_sent(&sender->stats, frameLength);
+    to->linkFree = start + airtime(frameLength);
+    if (rand() % 100 < lossPercent) {
+        to->lost++;
+        return;
+    }
+    if (rand() % 100 < corruptPercent) {
+        frame[MAVLINK_NUM_HEADER_BYTES + rand() % length] ^= 1 << (rand() % 8);
+        to->lost++;
+        to->corrupted++;
+    }
+    for (i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (to->link[i].length == 0) {
+            to->link[i].start = start + delay + airtime(1);
+            to->link[i].end = start + delay + airtime(frameLength);
+            to->link[i].length = frameLength;
+            memcpy(to->link[i].data, frame, frameLength);
+            return;
+        }
+    }
+    fprintf(stderr, "Too many frames in flight.\n");
+    exit(2);
+}
+
+static void sendHeartbeat(int from) {
+    mavlink_heartbeat_t heartbeat;
+    memset(&heartbeat, 0, sizeof(heartbeat));
+    heartbeat.data = 0x1;
+    LinkStats_fillHeartbeat(&nodes[from].stats, &heartbeat, now);
+    sendFrame(from, MAVLINK_MSG_ID_HEARTBEAT, &heartbeat, MAVLINK_MSG_ID_HEARTBEAT_LEN);
+}
+
+static void sendDelta(unsigned long n) {
+    mavlink_boat_state_delta_t delta;
+    memset(&delta, 0, sizeof(delta));
+    delta.keyframe = (uint8_t)(n / 20);
+    delta.north = (int16_t)n;
+    sendFrame(BOAT, MAVLINK_MSG_ID_BOAT_STATE_DELTA, &delta,
+        MAVLINK_MSG_ID_BOAT_STATE_DELTA_LEN);
+}
+
+static void sendData() {
+    mavlink_data_t data;
+    memset(&data, 0, sizeof(data));
+    data.temperature = 21.5f;
+    data.batVolt1 = 12000;
+    sendFrame(BOAT, MAVLINK_MSG_ID_DATA, &data, MAVLINK_MSG_ID_DATA_LEN);
+}
+
+static void sendCorrection() {
+    mavlink_gps_ned_t correction;
+    memset(&correction, 0, sizeof(correction));
+    correction.north = 1.5f;
+    sendFrame(COMMAND_CENTER, MAVLINK_MSG_ID_GPS_NED, &correction,
+        MAVLINK_MSG_ID_GPS_NED_LEN);
+}
+
+// Like handleFrame in src/Mavlink.c
+static void handleFrame(const MavlinkFrame *frame) {
+    mavlink_heartbeat_t heartbeat;
+    LinkStats_received(&receiver->stats, frame->wireLen + MAVLINK_NUM_NON_PAYLOAD_BYTES);
+    if (frame->msgid != MAVLINK_MSG_ID_HEARTBEAT)
+        return;
+    memcpy(&heartbeat, frame->payload, frame->len);
+    if (LinkStats_handleHeartbeat(&receiver->stats, &heartbeat, arrival))
+        receiver->rttSamples++;
+    receiver->lostAtHeartbeat = receiver->lost;
+}
+
+// Moves time ahead by a ms, handing over frames that arrived
+static void tick() {
+    int n, i;
+    now++;
+    for (n = 0; n < NODES; n++) {
+        receiver = &nodes[n];
+        for (i = 0; i < MAX_IN_FLIGHT; i++) {
+            if (receiver->link[i].length == 0 || receiver->link[i].end > now)
+                continue;
+            arrival = receiver->link[i].start;
+            MavlinkParser_parse(&receiver->parser, receiver->link[i].data,
+                receiver->link[i].length, handleFrame);
+            receiver->link[i].length = 0;
+        }
+        LinkStats_runSM(&receiver->stats, receiver->parser.errorCount, now);
+        if (receiver->stats.windowStart == now && now > LINK_STATS_WINDOW) {
+            receiver->windows++;
+            receiver->lossRateTotal += receiver->stats.lossRate;
+        }
+    }
+}
+
+static int report(const char *name, const Node *node, const Node *other) {
+    const LinkStats *stats = &node->stats;
+    unsigned long between;
+    long lostError = (long)stats->framesLost - (long)node->lostAtHeartbeat;
+    int passed = 1;
+
+    // Frames the other end sends between heartbeats
+    between = (other->stats.framesSent * HEARTBEAT_PERIOD) / now + 1;
+    printf("  %-14s RTT %4u/%4u/%4u ms (%lu samples)  lost %5lu of %5lu (link %5lu)"
+        "  avg loss %4.1f%%  CRC %3lu (link %3lu)  %4u bytes/s in, %4u out\n", name,
+        stats->rttMin, stats->rttAverage, stats->rttMax, node->rttSamples,
+        (unsigned long)stats->framesLost, (unsigned long)other->stats.framesSent,
+        node->lostAtHeartbeat,
+        node->windows ? node->lossRateTotal / 10.0 / node->windows : 0.0,
+        (unsigned long)stats->crcErrors, node->corrupted,
+        stats->bytesInRate, stats->bytesOutRate);
+
+    if (node->rttSamples == 0 || stats->rttMin < 2 * delay
+            || stats->rttMax > 2 * delay + RTT_SLACK) {
+        printf("FAILED: %s RTT out of range.\n", name);
+        passed = 0;
+    }
+    if (labs(lostError) > (long)between) {
+        printf("FAILED: %s counted %lu frames lost, the link lost %lu.\n", name,
+            (unsigned long)stats->framesLost, node->lostAtHeartbeat);
+        passed = 0;
+    }
+    if (stats->crcErrors < node->corrupted) {
+        printf("FAILED: %s counted %lu CRC failures, %lu frames were corrupted.\n",
+            name, (unsigned long)stats->crcErrors, node->corrupted);
+        passed = 0;
+    }
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    unsigned long seconds = DEFAULT_SECONDS, end, n = 0;
+    int i, passed;
+
+    delay = DEFAULT_DELAY;
+    baud = DEFAULT_BAUD;
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            delay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            baud = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            lossPercent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            corruptPercent = atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-t seconds] [-d delay_ms] [-b baud]"
+                " [-l loss_percent] [-c corrupt_percent]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds == 0 || delay < 0 || baud <= 0 || lossPercent < 0 || lossPercent > 90
+            || corruptPercent < 0 || corruptPercent > 90) {
+        fprintf(stderr, "Bad time, delay, baud, loss or corruption.\n");
+        return 2;
+    }
+
+    memset(nodes, 0, sizeof(nodes));
+    for (i = 0; i < NODES; i++) {
+        LinkStats_init(&nodes[i].stats);
+        MavlinkParser_init(&nodes[i].parser);
+    }
+    srand(5);
+    now = 0;
+    for (end = seconds * 1000; now < end; ) {
+        if (now % HEARTBEAT_PERIOD == 0)
+            sendHeartbeat(BOAT);
+        if (now % HEARTBEAT_PERIOD == HEARTBEAT_PERIOD / 2)
+            sendHeartbeat(COMMAND_CENTER);
+        if (now % DELTA_PERIOD == 0)
+            sendDelta(n++);
+        if (now % DATA_PERIOD == 0)
+            sendData();
+        if (now % CORRECTION_PERIOD == 0)
+            sendCorrection();
+        tick();
+    }
+
+    printf("%lu s, %d ms delay, %d baud, %d%% loss, %d%% corrupted:\n", seconds, delay,
+        baud, lossPercent, corruptPercent);
+    passed = report("command center", &nodes[COMMAND_CENTER], &nodes[BOAT]);
+    passed &= report("boat", &nodes[BOAT], &nodes[COMMAND_CENTER]);
+    if (!passed)
+        return 1;
+    printf("PASSED\n");
+    return 0;
+}
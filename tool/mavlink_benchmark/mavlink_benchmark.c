@@ -0,0 +1,271 @@
+/*
+ * mavlink_benchmark.c replays a MAVLink byte stream through the span parser
+ * (src/MavlinkParser.c) and through mavlink_parse_char, and reports frames/s
+ * and bytes/s for each.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o mavlink_benchmark mavlink_benchmark.c \
+ *         ../../src/MavlinkParser.c ../../src/MavlinkCrc.c
+ *
+ * Usage:
+ *     mavlink_benchmark [-s span_bytes] [-r repeats] [capture_file]
+ *
+ * The capture file holds raw bytes received from the XBee, e.g. a log from
+ * tool/serial_logger. Without one, a stream of autoLifeguard messages is
+ * generated, with some corrupted frames and line noise between frames.
+ * The span size is how many bytes the parser is given at a time, like the
+ * spans returned by UART_peekContiguous.
+ *
+ * The span parser must find every frame that mavlink_parse_char finds, in
+ * the same order, or the benchmark fails. It may find more: after a bad
+ * checksum, mavlink_parse_char drops the bytes it took as the bad frame's
+ * payload, while the span parser looks for the next frame inside them.
+ *
+ * Then a heartbeat with a length byte too long for it is sent ahead of
+ * three good frames, in spans of 1, 5 and 64 bytes. Fails unless the span
+ * parser has found the three frames by the end of them, rather than
+ * waiting for the bad frame's length worth of bytes.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MavlinkParser.h"
+
+#define DEFAULT_SPAN        64
+#define DEFAULT_REPEATS     50
+#define GENERATED_FRAMES    20000
+#define CORRUPT_PERCENT     1   // frames with a flipped byte
+#define NOISE_PERCENT       2   // frames followed by a few bytes of noise
+#define BAD_LENGTH          200 // heartbeat length byte in the bad frame
+
+// Frames found by a parser, as (msgid, seq, first payload byte) keys
+typedef struct {
+    unsigned long frames;
+    uint32_t *keys;
+} Result;
+
+static Result spanResult;
+
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void addFrame(Result *result, uint8_t msgid, uint8_t seq, uint8_t firstByte) {
+    result->keys[result->frames++] = ((uint32_t)msgid << 16)
+        | ((uint32_t)seq << 8) | firstByte;
+}
+
+// True if every frame in part is also in all, in the same order
+static int isSubsequence(const Result *part, const Result *all) {
+    unsigned long i, j = 0;
+    for (i = 0; i < part->frames; i++) {
+        while (j < all->frames && all->keys[j] != part->keys[i])
+            j++;
+        if (j++ >= all->frames)
+            return 0;
+    }
+    return 1;
+}
+
+static void handleSpanFrame(const MavlinkFrame *frame) {
+    addFrame(&spanResult, frame->msgid, frame->seq,
+        frame->len > 0 ? frame->payload[0] : 0);
+}
+
+static Result runSpanParser(const uint8_t *data, size_t length, size_t span,
+        uint32_t *keys) {
+    MavlinkParser parser;
+    size_t i, count;
+    spanResult.frames = 0;
+    spanResult.keys = keys;
+    MavlinkParser_init(&parser);
+    for (i = 0; i < length; i += count) {
+        count = (length - i < span) ? length - i : span;
+        MavlinkParser_parse(&parser, &data[i], (uint16_t)count, handleSpanFrame);
+    }
+    return spanResult;
+}
+
+static Result runCharParser(const uint8_t *data, size_t length, uint32_t *keys) {
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    Result result;
+    size_t i;
+    result.frames = 0;
+    result.keys = keys;
+    memset(mavlink_get_channel_status(MAVLINK_COMM_0), 0, sizeof(status));
+    for (i = 0; i < length; i++) {
+        if (mavlink_parse_char(MAVLINK_COMM_0, data[i], &msg, &status))
+            addFrame(&result, msg.msgid, msg.seq,
+                msg.len > 0 ? _MAV_PAYLOAD(&msg)[0] : 0);
+    }
+    return result;
+}
+
+// Packs a mix of the messages the boat and command center exchange
+static uint8_t *generateStream(size_t *length) {
+    uint8_t *data = malloc(GENERATED_FRAMES * (MAVLINK_MAX_PACKET_LEN + 4));
+    mavlink_message_t msg;
+    char text[MAVLINK_MSG_DEBUG_FIELD_MESSAGE_LEN] = "Benchmark debug message";
+    size_t used = 0;
+    uint16_t frameLength;
+    int i, n;
+
+    srand(1);
+    for (i = 0; i < GENERATED_FRAMES; i++) {
+        switch (i % 5) {
+            case 0:
+                mavlink_msg_heartbeat_pack(1, 1, &msg, 0, 0, i, 0, 0xFFFF, i);
+                break;
+            case 1:
+                mavlink_msg_gps_ned_pack(1, 1, &msg, 0, 3, i * 0.1f, -i * 0.2f, 0.0f);
+                break;
+            case 2:
+                mavlink_msg_status_and_error_pack(1, 1, &msg, 0, i & 0xFF, 0);
+                break;
+            case 3:
+                mavlink_msg_data_pack(1, 1, &msg, 0, 20.0f, 12.5f, 11900, 12100);
+                break;
+            default:
+                mavlink_msg_debug_pack(1, 1, &msg, 0, 1, text);
+                break;
+        }
+        frameLength = mavlink_msg_to_send_buffer(&data[used], &msg);
+        if (rand() % 100 < CORRUPT_PERCENT)
+            data[used + 1 + rand() % (frameLength - 1)] ^= 0x5A;
+        used += frameLength;
+        if (rand() % 100 < NOISE_PERCENT) {
+            for (n = rand() % 4 + 1; n > 0; n--)
+                data[used++] = (uint8_t)rand();
+        }
+    }
+    *length = used;
+    return data;
+}
+
+// Good frames behind a bad length byte must come out without waiting
+static int checkBadLength() {
+    static const size_t spans[] = {1, 5, 64};
+    uint8_t data[4 * MAVLINK_MAX_PACKET_LEN];
+    uint32_t keys[4];
+    mavlink_message_t msg;
+    size_t length = 0, i;
+    Result result;
+    int passed = 1;
+
+    mavlink_msg_heartbeat_pack(1, 1, &msg, 0, 0, 0, 0, 0xFFFF, 0);
+    length = mavlink_msg_to_send_buffer(data, &msg);
+    data[1] = BAD_LENGTH;
+    mavlink_msg_status_and_error_pack(1, 1, &msg, 0, 1, 0);
+    length += mavlink_msg_to_send_buffer(&data[length], &msg);
+    mavlink_msg_gps_ned_pack(1, 1, &msg, 0, 3, 1.0f, 2.0f, 0.0f);
+    length += mavlink_msg_to_send_buffer(&data[length], &msg);
+    mavlink_msg_data_pack(1, 1, &msg, 0, 20.0f, 12.5f, 11900, 12100);
+    length += mavlink_msg_to_send_buffer(&data[length], &msg);
+
+    for (i = 0; i < sizeof(spans) / sizeof(spans[0]); i++) {
+        result = runSpanParser(data, length, spans[i], keys);
+        if (result.frames != 3)
+            passed = 0;
+    }
+    printf("Bad length byte ahead of 3 frames: %s\n",
+        passed ? "all found" : "frames held back");
+    return passed;
+}
+
+static uint8_t *readCapture(const char *path, size_t *length) {
+    FILE *file = fopen(path, "rb");
+    uint8_t *data;
+    long size;
+    if (file == NULL)
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    data = malloc(size > 0 ? size : 1);
+    *length = fread(data, 1, size, file);
+    fclose(file);
+    return data;
+}
+
+static void report(const char *name, Result result, double seconds,
+        size_t length, int repeats) {
+    printf("%-18s %8lu frames  %10.0f frames/s  %8.2f MB/s\n", name,
+        result.frames, result.frames * repeats / seconds,
+        length * repeats / seconds / 1e6);
+}
+
+int main(int argc, char **argv) {
+    size_t span = DEFAULT_SPAN, length;
+    int repeats = DEFAULT_REPEATS, i;
+    const char *path = NULL;
+    uint8_t *data;
+    Result spanRun, charRun;
+    uint32_t *spanKeys, *charKeys;
+    double start, spanTime, charTime;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            span = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repeats = atoi(argv[++i]);
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: %s [-s span_bytes] [-r repeats] [capture_file]\n", argv[0]);
+            return 2;
+        }
+        else
+            path = argv[i];
+    }
+    if (span == 0 || span > 0xFFFF || repeats <= 0) {
+        fprintf(stderr, "Bad span size or repeat count.\n");
+        return 2;
+    }
+
+    data = (path != NULL) ? readCapture(path, &length) : generateStream(&length);
+    if (data == NULL) {
+        fprintf(stderr, "Could not read %s.\n", path);
+        return 1;
+    }
+    // can't find more frames than there are start bytes
+    spanKeys = malloc(length * sizeof(uint32_t) / MAVLINK_NUM_NON_PAYLOAD_BYTES + 1);
+    charKeys = malloc(length * sizeof(uint32_t) / MAVLINK_NUM_NON_PAYLOAD_BYTES + 1);
+    printf("%s: %lu bytes, %lu byte spans, %d repeats\n",
+        (path != NULL) ? path : "generated stream", (unsigned long)length,
+        (unsigned long)span, repeats);
+
+    start = now();
+    for (i = 0; i < repeats; i++)
+        charRun = runCharParser(data, length, charKeys);
+    charTime = now() - start;
+
+    start = now();
+    for (i = 0; i < repeats; i++)
+        spanRun = runSpanParser(data, length, span, spanKeys);
+    spanTime = now() - start;
+
+    report("mavlink_parse_char", charRun, charTime, length, repeats);
+    report("MavlinkParser", spanRun, spanTime, length, repeats);
+    printf("Speedup: %.2fx\n", charTime / spanTime);
+
+    i = isSubsequence(&charRun, &spanRun) && checkBadLength();
+    free(data);
+    free(spanKeys);
+    free(charKeys);
+    if (!i) {
+        printf("FAILED: MavlinkParser missed or held back frames.\n");
+        return 1;
+    }
+    printf("PASSED: MavlinkParser found all %lu frames, and recovered %lu more.\n",
+        charRun.frames, spanRun.frames - charRun.frames);
+    return 0;
+}
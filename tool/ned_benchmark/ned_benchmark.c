@@ -0,0 +1,158 @@
+/*
+ * ned_benchmark.c compares converting ECEF positions to NED with
+ * convertECEF2NED, which works out the origin's rotation every call, and
+ * with convertECEF2LocalNED from a LocalOrigin (src/Coordinates.c).
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o ned_benchmark ned_benchmark.c \
+ *         ../../src/Coordinates.c -lm
+ *
+ * Usage:
+ *     ned_benchmark [-n conversions] [-d meters] [-s seed]
+ *
+ * Positions are random, up to the given distance (2000 m by default) from
+ * an origin off Santa Cruz, as Navigation converts them every update. Both
+ * must give the same NED to within a millimeter per kilometer from the
+ * origin, which is about what the float trig in convertECEF2NED loses, or
+ * the benchmark fails.
+ *
+ * Times are per conversion, in cycles on x86 hosts (from the time stamp
+ * counter) and in nanoseconds. The host has an FPU, so it only shows the
+ * trig being taken out; on the PIC32MX, with soft floats, the difference
+ * is much larger (see GPS_LIBRARY_TEST in src/Gps.c, which counts core
+ * timer cycles for both).
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "Coordinates.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAS_CYCLES          1
+#else
+#define HAS_CYCLES          0
+#endif
+
+#define DEFAULT_CONVERSIONS 1000000
+#define DEFAULT_DISTANCE    2000.0 // (m)
+#define POSITIONS           1024 // converted in turn
+#define MAX_ERROR           1e-6 // (m per m from the origin) between the two
+
+// Origin near the pier (1e-7 deg and mm)
+#define ORIGIN_LAT          369512546L
+#define ORIGIN_LON          -1220269492L
+#define ORIGIN_HEIGHT       -28000L
+
+typedef struct {
+    double ns, cycles;
+} Timing;
+
+static unsigned long long getCycles(void) {
+#if HAS_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static double getRandom(double range) {
+    return range * (2.0 * rand() / RAND_MAX - 1.0);
+}
+
+/* Times the conversions, one way or the other, and sums the results so
+ * they aren't optimized out. */
+static Timing timeConversions(int useOrigin, long conversions,
+        GeocentricCoordinate *positions, LocalOrigin *origin, double *sum) {
+    LocalCoordinate ned;
+    Timing timing;
+    clock_t start = clock();
+    unsigned long long startCycles = getCycles();
+    long i;
+
+    for (i = 0; i < conversions; i++) {
+        GeocentricCoordinate *position = &positions[i % POSITIONS];
+        if (useOrigin)
+            convertECEF2LocalNED(&ned, position, origin);
+        else
+            convertECEF2NED(&ned, position, &origin->ecef, &origin->lla);
+        *sum += ned.north;
+    }
+    timing.cycles = (double)(getCycles() - startCycles) / conversions;
+    timing.ns = 1e9 * (double)(clock() - start) / CLOCKS_PER_SEC / conversions;
+    return timing;
+}
+
+int main(int argc, char **argv) {
+    long conversions = DEFAULT_CONVERSIONS;
+    double distance = DEFAULT_DISTANCE, maxError = 0.0, sum = 0.0;
+    unsigned int seed = 1;
+    GeocentricCoordinate originEcef, positions[POSITIONS];
+    LocalOrigin origin;
+    LocalCoordinate ned, nedLocal;
+    Timing before, after;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            conversions = atol(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            distance = atof(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-n conversions] [-d meters] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (conversions < 1 || distance <= 0.0) {
+        fprintf(stderr, "Bad number of conversions or distance.\n");
+        return 2;
+    }
+    srand(seed);
+
+    convertFixedGeodetic2ECEF(&originEcef, ORIGIN_LAT, ORIGIN_LON, ORIGIN_HEIGHT);
+    setLocalOrigin(&origin, &originEcef);
+    for (i = 0; i < POSITIONS; i++) {
+        double dx, dy, dz, error, range;
+        positions[i].x = originEcef.x + (int32_t)lround(getRandom(distance) * ECEF_PER_METER);
+        positions[i].y = originEcef.y + (int32_t)lround(getRandom(distance) * ECEF_PER_METER);
+        positions[i].z = originEcef.z + (int32_t)lround(getRandom(distance) * ECEF_PER_METER);
+
+        convertECEF2NED(&ned, &positions[i], &origin.ecef, &origin.lla);
+        convertECEF2LocalNED(&nedLocal, &positions[i], &origin);
+        dx = nedLocal.north - ned.north;
+        dy = nedLocal.east - ned.east;
+        dz = nedLocal.down - ned.down;
+        range = sqrt(ned.north * ned.north + ned.east * ned.east + ned.down * ned.down);
+        if (range < 1.0)
+            continue; // on top of the origin
+        error = sqrt(dx * dx + dy * dy + dz * dz) / range;
+        if (error > maxError)
+            maxError = error;
+    }
+
+    before = timeConversions(0, conversions, positions, &origin, &sum);
+    after = timeConversions(1, conversions, positions, &origin, &sum);
+
+    printf("%ld conversions up to %.0f m away, %.2f mm per km apart at most\n",
+        conversions, distance, 1e6 * maxError);
+    printf("  %-20s %10s %10s\n", "method", "cycles", "ns");
+    printf("  %-20s %10.1f %10.1f\n", "convertECEF2NED", before.cycles, before.ns);
+    printf("  %-20s %10.1f %10.1f\n", "convertECEF2LocalNED", after.cycles, after.ns);
+    if (!HAS_CYCLES)
+        printf("  (no cycle counter on this host)\n");
+    if (sum == 0.0 || maxError >= MAX_ERROR) {
+        printf("FAILED\n");
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
@@ -0,0 +1,394 @@
+/*
+ * pack_benchmark.c times the ways src/Mavlink.c has sent a message, and
+ * measures the stack each one uses:
+ *   byte copy      mavlink_msg_*_pack into a mavlink_message_t, then
+ *                  mavlink_msg_to_send_buffer, then one byte at a time into
+ *                  a transmit ring, like the old UART_putString
+ *   send buffer    the same two steps, then Scheduler_queue
+ *   pack in place  MavlinkParser_pack from the payload struct straight into
+ *                  space from Scheduler_reserve
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o pack_benchmark pack_benchmark.c \
+ *         ../../src/MavlinkParser.c ../../src/MavlinkCrc.c ../../src/Scheduler.c
+ *
+ * Usage:
+ *     pack_benchmark [-n messages]
+ *
+ * Each round sends a GPS_NED, a STATUS_AND_ERROR, a DATA, a
+ * BOAT_STATE_DELTA and a DEBUG message. The scheduler is drained after every
+ * message. Fails if a frame packed in place differs from the one
+ * mavlink_msg_to_send_buffer makes.
+ *
+ * Each message is also packed with its trailing zeros dropped, as
+ * src/Mavlink.c does for an end that takes trimmed payloads, and parsed
+ * back with both MavlinkParser and mavlink_parse_char. Fails if either
+ * gives a payload other than the full one. The bytes saved are printed.
+ *
+ * Stack use is found by sending each message on a stack of its own (with
+ * ucontext), filled with a pattern beforehand, and counting how much of
+ * the pattern was overwritten, less what an empty call uses. It's the
+ * host's stack use, as a guide to the PIC32's.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ * 2026-10-18 -- dagoodma
+ *     Check trimmed payloads.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+#include "MavlinkParser.h"
+#include "Scheduler.h"
+
+#define DEFAULT_MESSAGES    1000000
+#define MESSAGES_PER_ROUND  5
+#define RING_SIZE           512 // the XBee UART's transmit buffer
+#define STACK_SIZE          65536 // of the stack messages are measured on
+#define STACK_PATTERN       0xA5
+
+#define SYSID               15
+#define COMPID              15
+#define DEBUG_TEXT          "Drive: rudder 12.5 deg, thrust 40%, heading error -3.2 deg"
+
+#define METHOD_BYTE_COPY    0
+#define METHOD_SEND_BUFFER  1
+#define METHOD_IN_PLACE     2
+#define METHODS             3
+
+static const char *methodNames[METHODS] = {"byte copy", "send buffer", "pack in place"};
+
+static uint8_t ring[RING_SIZE];
+static uint16_t ringHead, ringTail;
+static Scheduler scheduler;
+static unsigned long bytesOut;
+static uint8_t lastFrame[MAVLINK_MAX_PACKET_LEN];
+static uint16_t lastLength;
+static uint8_t sequence;
+static int trimPayloads;
+static uint8_t parsedPayload[MAVLINK_MAX_PAYLOAD_LEN];
+static uint8_t parsedLength;
+
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Like the old UART_putString, a byte at a time
+static void putString(const uint8_t *data, uint16_t length) {
+    uint16_t i;
+    for (i = 0; i < length; i++) {
+        ring[ringTail] = data[i];
+        ringTail = (ringTail + 1) % RING_SIZE;
+    }
+    ringHead = ringTail; // drained at once
+    bytesOut += length;
+}
+
+static uint16_t writeLink(const uint8_t *data, uint16_t length) {
+    memcpy(lastFrame, data, length);
+    lastLength = length;
+    bytesOut += length;
+    return length;
+}
+
+static void sendMessage(mavlink_message_t *msg, int method) {
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    uint16_t length = mavlink_msg_to_send_buffer(buf, msg);
+    if (method == METHOD_BYTE_COPY)
+        putString(buf, length);
+    else {
+        Scheduler_queue(&scheduler, SCHEDULER_PRIORITY_COMMAND, SCHEDULER_KEY_NONE,
+            buf, length, 0);
+        Scheduler_runSM(&scheduler, 0);
+    }
+}
+
+static void sendPayload(uint8_t msgid, const void *payload, uint8_t length) {
+    uint16_t frameLength;
+    uint8_t *space;
+    if (trimPayloads)
+        length = _mav_trim_payload((const char *)payload, length);
+    frameLength = length + MAVLINK_NUM_NON_PAYLOAD_BYTES;
+    space = Scheduler_reserve(&scheduler, SCHEDULER_PRIORITY_COMMAND,
+        SCHEDULER_KEY_NONE, frameLength, 0);
+    if (space != NULL) {
+        MavlinkParser_pack(space, sequence++, SYSID, COMPID, msgid, payload, length);
+        Scheduler_commit(&scheduler);
+    }
+    Scheduler_runSM(&scheduler, 0);
+}
+
+/* Each message the old way and packed in place, in separate functions so
+ * each has only its own buffers on the stack. The mavlink_msg functions
+ * keep their own sequence number, so sequence is kept in step. */
+
+static void __attribute__((noinline)) sendGpsNed(int method, unsigned long n) {
+    mavlink_message_t msg;
+    mavlink_msg_gps_ned_pack(SYSID, COMPID, &msg, 0, 3, (float)n, -12.5f, 0.2f);
+    sendMessage(&msg, method);
+    sequence++;
+}
+
+static void __attribute__((noinline)) packGpsNed(int method, unsigned long n) {
+    mavlink_gps_ned_t payload;
+    (void)method;
+    payload.ack = 0;
+    payload.status = 3;
+    payload.north = (float)n;
+    payload.east = -12.5f;
+    payload.down = 0.2f;
+    sendPayload(MAVLINK_MSG_ID_GPS_NED, &payload, MAVLINK_MSG_ID_GPS_NED_LEN);
+}
+
+static void __attribute__((noinline)) sendStatus(int method, unsigned long n) {
+    mavlink_message_t msg;
+    mavlink_msg_status_and_error_pack(SYSID, COMPID, &msg, 0, (uint16_t)n, 0);
+    sendMessage(&msg, method);
+    sequence++;
+}
+
+static void __attribute__((noinline)) packStatus(int method, unsigned long n) {
+    mavlink_status_and_error_t payload;
+    (void)method;
+    payload.ack = 0;
+    payload.status = (uint16_t)n;
+    payload.error = 0;
+    sendPayload(MAVLINK_MSG_ID_STATUS_AND_ERROR, &payload,
+        MAVLINK_MSG_ID_STATUS_AND_ERROR_LEN);
+}
+
+static void __attribute__((noinline)) sendData(int method, unsigned long n) {
+    mavlink_message_t msg;
+    mavlink_msg_data_pack(SYSID, COMPID, &msg, 0, 21.5f, 3.0f, (uint16_t)n, 11800);
+    sendMessage(&msg, method);
+    sequence++;
+}
+
+static void __attribute__((noinline)) packData(int method, unsigned long n) {
+    mavlink_data_t payload;
+    (void)method;
+    payload.ack = 0;
+    payload.temperature = 21.5f;
+    payload.altitude = 3.0f;
+    payload.batVolt1 = (uint16_t)n;
+    payload.batVolt2 = 11800;
+    sendPayload(MAVLINK_MSG_ID_DATA, &payload, MAVLINK_MSG_ID_DATA_LEN);
+}
+
+static void __attribute__((noinline)) sendDelta(int method, unsigned long n) {
+    mavlink_message_t msg;
+    mavlink_msg_boat_state_delta_pack(SYSID, COMPID, &msg, 0, 7, (int16_t)n, 40, -2, 5);
+    sendMessage(&msg, method);
+    sequence++;
+}
+
+static void __attribute__((noinline)) packDelta(int method, unsigned long n) {
+    mavlink_boat_state_delta_t payload;
+    (void)method;
+    payload.ack = 0;
+    payload.keyframe = 7;
+    payload.north = (int16_t)n;
+    payload.east = 40;
+    payload.heading = -2;
+    payload.speed = 5;
+    sendPayload(MAVLINK_MSG_ID_BOAT_STATE_DELTA, &payload,
+        MAVLINK_MSG_ID_BOAT_STATE_DELTA_LEN);
+}
+
+static void __attribute__((noinline)) sendDebug(int method, unsigned long n) {
+    mavlink_message_t msg;
+    char str[100];
+    (void)n;
+    strncpy(str, DEBUG_TEXT, sizeof(str)); // as Mavlink_sendDebug padded it
+    mavlink_msg_debug_pack(SYSID, COMPID, &msg, 0, 1, str);
+    sendMessage(&msg, method);
+    sequence++;
+}
+
+static void __attribute__((noinline)) packDebug(int method, unsigned long n) {
+    mavlink_debug_t payload;
+    (void)method;
+    (void)n;
+    payload.ack = 0;
+    payload.sender = 1;
+    strncpy(payload.message, DEBUG_TEXT, sizeof(payload.message));
+    sendPayload(MAVLINK_MSG_ID_DEBUG, &payload, MAVLINK_MSG_ID_DEBUG_LEN);
+}
+
+typedef void (*Sender)(int method, unsigned long n);
+
+static const Sender oldSenders[MESSAGES_PER_ROUND] = {
+    sendGpsNed, sendStatus, sendData, sendDelta, sendDebug};
+static const Sender newSenders[MESSAGES_PER_ROUND] = {
+    packGpsNed, packStatus, packData, packDelta, packDebug};
+
+static void sendRound(int method, unsigned long n) {
+    if (method == METHOD_IN_PLACE)
+        newSenders[n % MESSAGES_PER_ROUND](method, n);
+    else
+        oldSenders[n % MESSAGES_PER_ROUND](method, n);
+}
+
+// The stack a message is sent on, and what to send on it
+static uint8_t measuredStack[STACK_SIZE];
+static ucontext_t mainContext, measuredContext;
+static int measuredMethod, measuredMessage;
+
+static void runMeasured() {
+    if (measuredMethod >= 0)
+        sendRound(measuredMethod, measuredMessage);
+}
+
+// Bytes of measuredStack used to send the message, or by an empty call if method is -1
+static int runOnStack(int method, int message) {
+    int i;
+    memset(measuredStack, STACK_PATTERN, sizeof(measuredStack));
+    measuredMethod = method;
+    measuredMessage = message;
+    getcontext(&measuredContext);
+    measuredContext.uc_stack.ss_sp = measuredStack;
+    measuredContext.uc_stack.ss_size = sizeof(measuredStack);
+    measuredContext.uc_link = &mainContext;
+    makecontext(&measuredContext, runMeasured, 0);
+    swapcontext(&mainContext, &measuredContext);
+
+    // The stack grows down, so the low end is what was never touched
+    for (i = 0; i < STACK_SIZE && measuredStack[i] == STACK_PATTERN; i++)
+        ;
+    return STACK_SIZE - i;
+}
+
+static int stackUse(int method, int message) {
+    return runOnStack(method, message) - runOnStack(-1, 0);
+}
+
+// Packs every kind of message both ways and compares the frames
+static unsigned long checkFrames() {
+    uint8_t expected[MAVLINK_MAX_PACKET_LEN];
+    uint16_t expectedLength;
+    unsigned long n, mismatches = 0;
+    for (n = 0; n < 100; n++) {
+        mavlink_get_channel_status(MAVLINK_COMM_0)->current_tx_seq = sequence;
+        sendRound(METHOD_SEND_BUFFER, n);
+        memcpy(expected, lastFrame, lastLength);
+        expectedLength = lastLength;
+        sequence--;
+        sendRound(METHOD_IN_PLACE, n);
+        if (lastLength != expectedLength || memcmp(expected, lastFrame, lastLength) != 0)
+            mismatches++;
+    }
+    return mismatches;
+}
+
+static void handleFrame(const MavlinkFrame *frame) {
+    memcpy(parsedPayload, frame->payload, frame->len);
+    parsedLength = frame->len;
+}
+
+// Packs every kind of message trimmed and checks both parsers fill it out
+static unsigned long checkTrimmed(unsigned long *fullBytes, unsigned long *trimmedBytes) {
+    uint8_t expected[MAVLINK_MAX_PACKET_LEN];
+    uint16_t expectedLength, i;
+    uint8_t expectedLen;
+    const uint8_t *expectedPayload = &expected[MAVLINK_NUM_HEADER_BYTES];
+    MavlinkParser parser;
+    mavlink_message_t msg;
+    mavlink_status_t status;
+    unsigned long n, mismatches = 0;
+    int received;
+
+    MavlinkParser_init(&parser);
+    *fullBytes = *trimmedBytes = 0;
+    for (n = 0; n < 100; n++) {
+        sendRound(METHOD_SEND_BUFFER, n);
+        memcpy(expected, lastFrame, lastLength);
+        expectedLength = lastLength;
+        expectedLen = expected[1];
+        trimPayloads = 1;
+        sendRound(METHOD_IN_PLACE, n);
+        trimPayloads = 0;
+        *fullBytes += expectedLength;
+        *trimmedBytes += lastLength;
+
+        parsedLength = 0;
+        MavlinkParser_parse(&parser, lastFrame, lastLength, handleFrame);
+        if (parsedLength != expectedLen
+                || memcmp(parsedPayload, expectedPayload, expectedLen) != 0)
+            mismatches++;
+
+        received = 0;
+        for (i = 0; i < lastLength; i++)
+            received |= mavlink_parse_char(MAVLINK_COMM_1, lastFrame[i], &msg, &status);
+        if (!received || msg.len != expectedLen
+                || memcmp(_MAV_PAYLOAD(&msg), expectedPayload, expectedLen) != 0)
+            mismatches++;
+    }
+    return mismatches;
+}
+
+int main(int argc, char **argv) {
+    unsigned long messages = DEFAULT_MESSAGES, n, mismatches, trimMismatches;
+    unsigned long fullBytes, trimmedBytes;
+    double start, seconds[METHODS];
+    int method, stack[METHODS], message, i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            messages = strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [-n messages]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (messages == 0) {
+        fprintf(stderr, "Bad message count.\n");
+        return 2;
+    }
+
+    Scheduler_init(&scheduler, writeLink, UINT16_MAX, UINT8_MAX);
+    mismatches = checkFrames();
+    trimMismatches = checkTrimmed(&fullBytes, &trimmedBytes);
+
+    for (method = 0; method < METHODS; method++) {
+        stack[method] = 0;
+        for (message = 0; message < MESSAGES_PER_ROUND; message++) {
+            int used = stackUse(method, message);
+            if (used > stack[method])
+                stack[method] = used;
+        }
+        bytesOut = 0;
+        start = now();
+        for (n = 0; n < messages; n++)
+            sendRound(method, n);
+        seconds[method] = now() - start;
+    }
+
+    printf("%lu messages, %.1f bytes each:\n", messages, (double)bytesOut / messages);
+    for (method = 0; method < METHODS; method++)
+        printf("  %-14s %6.1f ns/message  %5.2fx  stack %4d bytes\n", methodNames[method],
+            seconds[method] * 1e9 / messages, seconds[METHOD_BYTE_COPY] / seconds[method],
+            stack[method]);
+    printf("sizeof(mavlink_message_t) %u, MAVLINK_MAX_PACKET_LEN %u\n",
+        (unsigned int)sizeof(mavlink_message_t), (unsigned int)MAVLINK_MAX_PACKET_LEN);
+    printf("trimmed payloads: %lu bytes instead of %lu, %.1f%% saved\n", trimmedBytes,
+        fullBytes, 100.0 * (fullBytes - trimmedBytes) / fullBytes);
+
+    if (mismatches > 0) {
+        printf("FAILED: %lu frames packed in place differ.\n", mismatches);
+        return 1;
+    }
+    if (trimMismatches > 0) {
+        printf("FAILED: %lu trimmed frames parsed wrong.\n", trimMismatches);
+        return 1;
+    }
+    printf("PASSED\n");
+    return 0;
+}
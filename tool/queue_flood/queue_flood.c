@@ -0,0 +1,186 @@
+/*
+ * queue_flood.c floods the receive queue of decoded MAVLink messages
+ * (src/MavlinkQueue.c) and checks every message comes out once, in order,
+ * with its payload intact.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o queue_flood queue_flood.c ../../src/MavlinkQueue.c
+ *
+ * Usage:
+ *     queue_flood [-n rounds] [-s seed]
+ *
+ * Each round (100000 by default) pushes half a queue, then reserves one
+ * more entry and leaves it uncommitted, like a repeat the transport drops,
+ * and pops them all. Then it fills the queue to MAVLINK_QUEUE_SIZE, as a
+ * burst of frames parsed from one span does, and pops it empty. A second
+ * run mixes pushes and pops at random, pushing only while there is room.
+ * Fails if a message is lost, repeated, out of order or changed, if an
+ * uncommitted one comes out, or if either run counts a drop.
+ *
+ * Last, one message more than fits is pushed. Fails unless it is the one
+ * dropped and counted, and the others still come out in order.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "MavlinkQueue.h"
+
+#define DEFAULT_ROUNDS      100000
+#define UNCOMMITTED         0xFFFFFFFF // time of an entry left uncommitted
+
+typedef struct {
+    unsigned long pushed, popped, errors;
+} Count;
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// Payload and header made from the message's number, to check it later
+static void fillEntry(MavlinkQueueEntry *entry, unsigned long n) {
+    uint16_t i;
+    entry->msgid = (uint8_t)(n % 251);
+    entry->sysid = (uint8_t)(n >> 8);
+    entry->seq = (uint8_t)n;
+    entry->wantsAck = (n % 3) == 0;
+    entry->time = (uint32_t)n;
+    for (i = 0; i < MAVLINK_QUEUE_PAYLOAD_SIZE; i++)
+        entry->payload[i] = (uint8_t)(n * 31 + i);
+}
+
+static int isEntry(const MavlinkQueueEntry *entry, unsigned long n) {
+    MavlinkQueueEntry expected;
+    fillEntry(&expected, n);
+    return entry->msgid == expected.msgid && entry->sysid == expected.sysid
+        && entry->seq == expected.seq && entry->wantsAck == expected.wantsAck
+        && entry->time == expected.time
+        && memcmp(entry->payload, expected.payload, MAVLINK_QUEUE_PAYLOAD_SIZE) == 0;
+}
+
+static int push(MavlinkQueue *queue, Count *count, unsigned long *n) {
+    MavlinkQueueEntry *entry = MavlinkQueue_reserve(queue);
+    if (entry == NULL)
+        return 0;
+    fillEntry(entry, (*n)++);
+    MavlinkQueue_commit(queue);
+    count->pushed++;
+    return 1;
+}
+
+// Reserves an entry and fills it, but doesn't commit it
+static void leaveUncommitted(MavlinkQueue *queue) {
+    MavlinkQueueEntry *entry = MavlinkQueue_reserve(queue);
+    if (entry != NULL)
+        fillEntry(entry, UNCOMMITTED);
+}
+
+static int pop(MavlinkQueue *queue, Count *count, unsigned long *n) {
+    const MavlinkQueueEntry *entry = MavlinkQueue_pop(queue);
+    if (entry == NULL)
+        return 0;
+    if (!isEntry(entry, (*n)++))
+        count->errors++;
+    count->popped++;
+    return 1;
+}
+
+static int report(const char *name, const MavlinkQueue *queue, Count count,
+        double seconds) {
+    int passed = count.errors == 0 && count.pushed == count.popped
+        && queue->droppedCount == 0 && MavlinkQueue_getLength(queue) == 0;
+    printf("  %-7s %9lu pushed %9lu popped %6lu wrong %4lu dropped  %6.1f ns each\n",
+        name, count.pushed, count.popped, count.errors,
+        (unsigned long)queue->droppedCount,
+        1e9 * seconds / (count.pushed + count.popped + 1));
+    return passed;
+}
+
+// One past full must be dropped, and the rest kept
+static int checkOverflow() {
+    MavlinkQueue queue;
+    Count count = {0, 0, 0};
+    unsigned long in = 0, out = 0;
+    int i, passed;
+
+    MavlinkQueue_init(&queue);
+    for (i = 0; i < MAVLINK_QUEUE_SIZE; i++)
+        push(&queue, &count, &in);
+    passed = !push(&queue, &count, &in) && queue.droppedCount == 1;
+    while (pop(&queue, &count, &out))
+        ;
+    passed = passed && count.errors == 0 && count.popped == MAVLINK_QUEUE_SIZE;
+    printf("  one past full: %s\n", passed ? "dropped and counted" : "mixed up");
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    unsigned long rounds = DEFAULT_ROUNDS, round, in, out;
+    unsigned int seed = 1;
+    MavlinkQueue queue;
+    Count count;
+    double start;
+    int i, passed;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            rounds = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else {
+            fprintf(stderr, "usage: %s [-n rounds] [-s seed]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rounds == 0) {
+        fprintf(stderr, "Bad number of rounds.\n");
+        return 2;
+    }
+    srand(seed);
+
+    printf("%lu rounds through a %d message queue:\n", rounds, MAVLINK_QUEUE_SIZE);
+    MavlinkQueue_init(&queue);
+    memset(&count, 0, sizeof(count));
+    in = out = 0;
+    start = now();
+    for (round = 0; round < rounds; round++) {
+        for (i = 0; i < MAVLINK_QUEUE_SIZE / 2; i++)
+            push(&queue, &count, &in);
+        leaveUncommitted(&queue);
+        while (pop(&queue, &count, &out))
+            ;
+        for (i = 0; i < MAVLINK_QUEUE_SIZE; i++)
+            push(&queue, &count, &in);
+        while (pop(&queue, &count, &out))
+            ;
+    }
+    passed = report("full", &queue, count, now() - start);
+
+    MavlinkQueue_init(&queue);
+    memset(&count, 0, sizeof(count));
+    in = out = 0;
+    start = now();
+    for (round = 0; round < rounds * MAVLINK_QUEUE_SIZE; round++) {
+        if (rand() % 8 == 0 && MavlinkQueue_getLength(&queue) < MAVLINK_QUEUE_SIZE)
+            leaveUncommitted(&queue);
+        else if (rand() % 2 && MavlinkQueue_getLength(&queue) < MAVLINK_QUEUE_SIZE)
+            push(&queue, &count, &in);
+        else
+            pop(&queue, &count, &out);
+    }
+    while (pop(&queue, &count, &out))
+        ;
+    passed = report("mixed", &queue, count, now() - start) && passed;
+    passed = checkOverflow() && passed;
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+/*
+ * ring_buffer.c stress tests the lock-free ring buffer (include/RingBuffer.h)
+ * with a producer and a consumer thread, like the UART ISR and main loop.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -pthread -I../../include -o ring_buffer ring_buffer.c
+ *
+ * Usage:
+ *     ring_buffer [-m megabytes] [-s seed] [size ...]
+ *
+ * For each buffer size (2, 16, 512 and 4096 by default), the producer
+ * sends a known sequence of bytes with a random mix of put and write,
+ * retrying whatever didn't fit. The consumer takes them with a random mix
+ * of get, peek, read and peekContiguous/consume, and checks every byte is
+ * the next one in the sequence. The 16-bit indices wrap many times over.
+ *
+ * Fails if a byte is out of order, lost or repeated, or if the overflow
+ * count differs from the puts the producer saw refused.
+ *
+ * Run it on at least two cores. On one, the threads only meet where the
+ * scheduler preempts them, which seldom lands inside a race, and they
+ * yield whenever the buffer is empty or full so the small sizes are slow.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include "RingBuffer.h"
+
+#define DEFAULT_MEGABYTES   8 // per buffer size
+#define MAX_CHUNK           300 // bytes per write or read
+#define SEQUENCE_LENGTH     251 // prime, so it never lines up with the size
+
+typedef struct {
+    RingBuffer rb;
+    unsigned long total;        // bytes to send
+    unsigned int seed;
+    unsigned long refused;      // puts that found it full
+    unsigned long received;
+    unsigned long errors;       // bytes out of order
+} Test;
+
+static uint8_t getByte(unsigned long n) {
+    return (uint8_t)(n % SEQUENCE_LENGTH);
+}
+
+static void *produce(void *arg) {
+    Test *test = arg;
+    uint8_t chunk[MAX_CHUNK];
+    unsigned int seed = test->seed;
+    unsigned long sent = 0;
+    uint16_t length, i;
+
+    while (sent < test->total) {
+        if (rand_r(&seed) % 2) {
+            if (RingBuffer_put(&test->rb, getByte(sent)))
+                sent++;
+            else {
+                test->refused++;
+                sched_yield(); // full, let the consumer run on one core
+            }
+            continue;
+        }
+        length = 1 + rand_r(&seed) % MAX_CHUNK;
+        if (length > test->total - sent)
+            length = test->total - sent;
+        for (i = 0; i < length; i++)
+            chunk[i] = getByte(sent + i);
+        length = RingBuffer_write(&test->rb, chunk, length);
+        if (length == 0)
+            sched_yield();
+        sent += length;
+    }
+    return NULL;
+}
+
+static void *consume(void *arg) {
+    Test *test = arg;
+    uint8_t chunk[MAX_CHUNK], data;
+    const uint8_t *span;
+    unsigned int seed = test->seed + 1;
+    unsigned long n = 0;
+    uint16_t length, i;
+
+    while (n < test->total) {
+        length = 0;
+        switch (rand_r(&seed) % 4) {
+            case 0:
+                if (RingBuffer_get(&test->rb, &data))
+                    chunk[length++] = data;
+                break;
+            case 1:
+                // Peeked byte must still be the one got next
+                if (RingBuffer_peek(&test->rb, &data)) {
+                    RingBuffer_get(&test->rb, &chunk[0]);
+                    if (chunk[0] != data)
+                        test->errors++;
+                    length = 1;
+                }
+                break;
+            case 2:
+                length = RingBuffer_read(&test->rb, chunk, 1 + rand_r(&seed) % MAX_CHUNK);
+                break;
+            default:
+                length = RingBuffer_peekContiguous(&test->rb, &span);
+                if (length > MAX_CHUNK)
+                    length = MAX_CHUNK;
+                memcpy(chunk, span, length);
+                RingBuffer_consume(&test->rb, length);
+                break;
+        }
+        if (length == 0)
+            sched_yield(); // empty, let the producer run on one core
+        for (i = 0; i < length; i++, n++) {
+            if (chunk[i] != getByte(n))
+                test->errors++;
+        }
+    }
+    test->received = n;
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    unsigned long sizes[16] = {2, 16, 512, 4096}, megabytes = DEFAULT_MEGABYTES;
+    unsigned int seed = 1;
+    int sizeCount = 0, i, passed = 1;
+    static uint8_t storage[RINGBUFFER_MAX_SIZE];
+    pthread_t producer, consumer;
+    struct timespec start, end;
+    Test test;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            megabytes = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else if (argv[i][0] == '-' || sizeCount >= 16) {
+            fprintf(stderr, "usage: %s [-m megabytes] [-s seed] [size ...]\n", argv[0]);
+            return 2;
+        }
+        else
+            sizes[sizeCount++] = strtoul(argv[i], NULL, 10);
+    }
+    if (sizeCount == 0)
+        sizeCount = 4;
+    if (megabytes == 0) {
+        fprintf(stderr, "Bad number of megabytes.\n");
+        return 2;
+    }
+
+    for (i = 0; i < sizeCount; i++) {
+        double seconds;
+        memset(&test, 0, sizeof(test));
+        if (sizes[i] > RINGBUFFER_MAX_SIZE
+                || RingBuffer_init(&test.rb, storage, (uint16_t)sizes[i]) != 0) {
+            fprintf(stderr, "Bad size %lu, must be a power of two up to %d.\n",
+                sizes[i], RINGBUFFER_MAX_SIZE);
+            return 2;
+        }
+        test.total = megabytes << 20;
+        test.seed = seed;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        pthread_create(&consumer, NULL, consume, &test);
+        pthread_create(&producer, NULL, produce, &test);
+        pthread_join(producer, NULL);
+        pthread_join(consumer, NULL);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+        printf("  size %5lu: %lu MB at %6.1f MB/s, %lu out of order, %lu puts refused,"
+            " overflow %lu\n", sizes[i], megabytes, megabytes / seconds, test.errors,
+            test.refused, (unsigned long)RingBuffer_getOverflow(&test.rb));
+        if (test.errors != 0 || test.received != test.total
+                || !RingBuffer_isEmpty(&test.rb)
+                || RingBuffer_getOverflow(&test.rb) != test.refused)
+            passed = 0;
+    }
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
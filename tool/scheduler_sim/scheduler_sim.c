@@ -0,0 +1,269 @@
+/*
+ * scheduler_sim.c loads the boat's XBee link with telemetry and debug
+ * strings and measures how long a stop command takes to leave the UART,
+ * writing frames straight into the UART as Mavlink.c used to, and through
+ * src/Scheduler.c.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o scheduler_sim scheduler_sim.c ../../src/Scheduler.c
+ *
+ * Usage:
+ *     scheduler_sim [-t seconds] [-r state_hz] [-d debug_ms] [-s stop_ms]
+ *
+ * The UART has a 512 byte transmit buffer drained at 9600 baud, and refuses
+ * a frame that doesn't fit, as UART_write with UART_WRITE_REJECT does.
+ * Written straight to the UART, a refused frame is lost, while the
+ * scheduler sends it later. The main loop runs every ms. The boat sends a
+ * boat state frame at the given rate (30 byte keyframes and 16 byte
+ * deltas), a 110 byte debug string every debug_ms, a heartbeat every 3 s,
+ * and DATA with two UART_STATS every 10 s. A stop command (a CMD_OTHER or
+ * its ACK, 10 bytes) is sent every stop_ms.
+ *
+ * Latency is from sending the stop to its last byte leaving the UART. Fails
+ * if the scheduler drops a stop, or takes longer than it takes to send two
+ * bursts, a debug frame and the stop itself.
+ *
+ * The scheduler is run again with a 112 byte transmit buffer, so the UART
+ * refuses frames now and then, and the scheduler must send them later. Fails unless
+ * every stop leaves the UART.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Scheduler.h"
+
+#define DEFAULT_SECONDS     600
+#define DEFAULT_STATE_RATE  10 // (Hz)
+#define DEFAULT_DEBUG_DELAY 100 // (ms)
+#define DEFAULT_STOP_DELAY  2700 // (ms)
+
+#define BAUD_RATE           9600
+#define UART_BUFFER_SIZE    512
+#define LINK_RATE           864 // (bytes/s) as in Mavlink.c
+#define LINK_BURST          64 // (bytes)
+
+#define HEARTBEAT_DELAY     3000 // (ms)
+#define DATA_DELAY          10000 // (ms)
+
+#define STOP_SIZE           (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_CMD_OTHER_LEN)
+#define KEYFRAME_SIZE       (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_BOAT_STATE_LEN)
+#define DELTA_SIZE          (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_BOAT_STATE_DELTA_LEN)
+#define DEBUG_SIZE          (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_DEBUG_LEN)
+#define HEARTBEAT_SIZE      (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_HEARTBEAT_LEN)
+#define DATA_SIZE           (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_DATA_LEN)
+#define UART_STATS_SIZE     (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_UART_STATS_LEN)
+
+// First byte of each fake frame, so the UART can tell what it is sending
+#define KIND_STOP           1
+#define KIND_STATE          2
+#define KIND_DEBUG          3
+#define KIND_OTHER          4
+#define KINDS               5
+
+#define KEY_BOAT_STATE      1
+#define KEY_DATA            4
+#define KEY_UART_STATS      5
+
+#define MAX_STOPS           4096
+#define SMALL_UART_SIZE     112 // (bytes) just fits a debug frame
+#define DRAIN_TIME          10000 // (ms) after the trial
+
+typedef struct {
+    unsigned long stops; // out the UART
+    unsigned long stopsSent; // handed to the UART or scheduler
+    unsigned long stopsDropped;
+    unsigned long maxLatency; // (ms)
+    double totalLatency;
+    unsigned long sent[KINDS]; // frames out the UART
+    unsigned long dropped; // frames the UART refused, the scheduler retries them
+} Result;
+
+static unsigned long now; // (ms)
+static unsigned long uartSize, uartUsed, uartWritten, uartDrained; // (bytes)
+static long uartCredit; // (bits) toward the next byte on the air
+static int useScheduler;
+static Scheduler scheduler;
+static Result result;
+
+// Where each stop ends in the UART's byte stream, and when it was sent
+static unsigned long stopEnd[MAX_STOPS], stopTime[MAX_STOPS];
+static int stopCount, stopNext;
+
+
+// Like UART_write with UART_WRITE_REJECT, refuses a frame that doesn't fit
+static uint16_t writeUart(const uint8_t *data, uint16_t length) {
+    int kind = data[0];
+    if (uartSize - uartUsed < length)
+        return 0;
+    uartUsed += length;
+    uartWritten += length;
+    if (kind == KIND_STOP && stopCount < MAX_STOPS) {
+        stopEnd[stopCount] = uartWritten;
+        stopTime[stopCount++] = now;
+    }
+    result.sent[kind]++;
+    return length;
+}
+
+static void send(int kind, uint8_t priority, uint8_t key, uint16_t length) {
+    uint8_t frame[MAVLINK_MAX_PACKET_LEN];
+    memset(frame, kind, length);
+    if (kind == KIND_STOP)
+        result.stopsSent++;
+    if (!useScheduler) {
+        if (writeUart(frame, length) == 0) {
+            result.dropped++;
+            if (kind == KIND_STOP)
+                result.stopsDropped++;
+        }
+        return;
+    }
+    if (!Scheduler_queue(&scheduler, priority, key, frame, length, now)
+            && kind == KIND_STOP)
+        result.stopsDropped++;
+    Scheduler_runSM(&scheduler, now);
+}
+
+// Moves time ahead by a ms, draining the UART at the baud rate
+static void tick() {
+    unsigned long latency;
+    now++;
+    uartCredit += BAUD_RATE / 1000 + ((now % 5 == 0) ? 3 : 0); // 9.6 bits/ms
+    while (uartCredit >= 10 && uartUsed > 0) {
+        uartCredit -= 10;
+        uartUsed--;
+        uartDrained++;
+    }
+    if (uartUsed == 0 && uartCredit > 10)
+        uartCredit = 10;
+    while (stopNext < stopCount && uartDrained >= stopEnd[stopNext]) {
+        latency = now - stopTime[stopNext];
+        result.stops++;
+        result.totalLatency += latency;
+        if (latency > result.maxLatency)
+            result.maxLatency = latency;
+        stopNext++;
+    }
+    if (useScheduler)
+        Scheduler_runSM(&scheduler, now);
+}
+
+static int isWaiting() {
+    uint8_t i;
+    for (i = 0; useScheduler && i < SCHEDULER_PRIORITIES; i++) {
+        if (scheduler.queues[i].used > 0)
+            return 1;
+    }
+    return 0;
+}
+
+static Result runTrial(int scheduled, unsigned long size, unsigned long seconds,
+        double stateRate, unsigned long debugDelay, unsigned long stopDelay) {
+    unsigned long stateDelay = (unsigned long)(1000 / stateRate), frames = 0;
+    uint8_t i;
+    memset(&result, 0, sizeof(result));
+    useScheduler = scheduled;
+    uartSize = size;
+    Scheduler_init(&scheduler, writeUart, LINK_RATE, LINK_BURST);
+    now = uartUsed = uartWritten = uartDrained = 0;
+    uartCredit = 0;
+    stopCount = stopNext = 0;
+
+    while (now < seconds * 1000) {
+        if (now % stateDelay == 0)
+            send(KIND_STATE, SCHEDULER_PRIORITY_TELEMETRY, KEY_BOAT_STATE,
+                (frames++ % 8 == 0) ? KEYFRAME_SIZE : DELTA_SIZE);
+        if (now % debugDelay == 0)
+            send(KIND_DEBUG, SCHEDULER_PRIORITY_DEBUG, SCHEDULER_KEY_NONE, DEBUG_SIZE);
+        if (now % HEARTBEAT_DELAY == 0)
+            send(KIND_OTHER, SCHEDULER_PRIORITY_STATE, SCHEDULER_KEY_NONE, HEARTBEAT_SIZE);
+        if (now % DATA_DELAY == 0) {
+            send(KIND_OTHER, SCHEDULER_PRIORITY_TELEMETRY, KEY_DATA, DATA_SIZE);
+            send(KIND_OTHER, SCHEDULER_PRIORITY_TELEMETRY, KEY_UART_STATS, UART_STATS_SIZE);
+            send(KIND_OTHER, SCHEDULER_PRIORITY_TELEMETRY, KEY_UART_STATS + 1, UART_STATS_SIZE);
+        }
+        if (now % stopDelay == stopDelay / 2)
+            send(KIND_STOP, SCHEDULER_PRIORITY_COMMAND, SCHEDULER_KEY_NONE, STOP_SIZE);
+        tick();
+    }
+    // Let whatever is still waiting go out
+    for (seconds = now + DRAIN_TIME; now < seconds && (uartUsed > 0 || isWaiting()); )
+        tick();
+    for (i = 0; i < SCHEDULER_PRIORITIES; i++)
+        result.dropped += scheduler.queues[i].refusedCount;
+    return result;
+}
+
+static void report(const char *name, Result r, unsigned long seconds) {
+    printf("  %-10s stop mean %5.0f ms  max %5lu ms  dropped %3lu | state %5.1f Hz"
+        "  debug %5.1f/s  UART refused %6lu\n", name,
+        r.stops ? r.totalLatency / r.stops : 0.0, r.maxLatency, r.stopsDropped,
+        (double)r.sent[KIND_STATE] / seconds, (double)r.sent[KIND_DEBUG] / seconds,
+        r.dropped);
+}
+
+int main(int argc, char **argv) {
+    unsigned long seconds = DEFAULT_SECONDS, debugDelay = DEFAULT_DEBUG_DELAY;
+    unsigned long stopDelay = DEFAULT_STOP_DELAY, bound;
+    double stateRate = DEFAULT_STATE_RATE;
+    Result direct, scheduled, small;
+    int i;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            stateRate = atof(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            debugDelay = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            stopDelay = strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [-t seconds] [-r state_hz] [-d debug_ms]"
+                " [-s stop_ms]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (seconds == 0 || stateRate <= 0 || stateRate > 1000 || debugDelay == 0
+            || stopDelay < 2) {
+        fprintf(stderr, "Bad time, rate or delay.\n");
+        return 2;
+    }
+
+    printf("%lu s, boat state %.1f Hz, debug every %lu ms, stop every %lu ms,"
+        " %d baud:\n", seconds, stateRate, debugDelay, stopDelay, BAUD_RATE);
+    small = runTrial(1, SMALL_UART_SIZE, seconds, stateRate, debugDelay, stopDelay);
+    direct = runTrial(0, UART_BUFFER_SIZE, seconds, stateRate, debugDelay, stopDelay);
+    scheduled = runTrial(1, UART_BUFFER_SIZE, seconds, stateRate, debugDelay, stopDelay);
+    report("direct", direct, seconds);
+    report("scheduler", scheduled, seconds);
+    report("small UART", small, seconds);
+    printf("  scheduler  waits: command %lu ms, state %lu ms, telemetry %lu ms,"
+        " debug %lu ms; replaced %lu, debug dropped %lu\n",
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_COMMAND].maxWait,
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_STATE].maxWait,
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_TELEMETRY].maxWait,
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_DEBUG].maxWait,
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_TELEMETRY].replacedCount,
+        (unsigned long)scheduler.queues[SCHEDULER_PRIORITY_DEBUG].droppedCount);
+
+    // Burst, debt and a debug frame ahead of the stop, then the stop itself
+    bound = ((2*LINK_BURST + DEBUG_SIZE + STOP_SIZE) * 10 * 1000UL) / BAUD_RATE + 2;
+    if (scheduled.stopsDropped > 0 || scheduled.maxLatency > bound) {
+        printf("FAILED: scheduler stop latency over %lu ms, or a stop dropped.\n", bound);
+        return 1;
+    }
+    if (small.stops != small.stopsSent) {
+        printf("FAILED: %lu of %lu stops lost in the UART %d byte buffer.\n",
+            small.stopsSent - small.stops, small.stopsSent, SMALL_UART_SIZE);
+        return 1;
+    }
+    printf("PASSED (bound %lu ms)\n", bound);
+    return 0;
+}
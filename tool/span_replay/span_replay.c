@@ -0,0 +1,321 @@
+/*
+ * span_replay.c replays GPS and XBee byte streams through the receive ring
+ * buffer (include/RingBuffer.h), draining it a byte at a time with get, as
+ * consumers did through UART_getChar, and a span at a time with
+ * peekContiguous and consume, as they do now. The bytes go to the frame
+ * parsers (src/UbxParser.c and src/MavlinkParser.c) either way.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o span_replay span_replay.c \
+ *         ../../src/UbxParser.c ../../src/MavlinkParser.c ../../src/MavlinkCrc.c
+ *
+ * Usage:
+ *     span_replay [-r repeats] [-c chunk_bytes] [-g gps_capture]
+ *         [-x xbee_capture]
+ *
+ * Captures hold raw bytes from the receiver or the XBee, e.g. logs from
+ * tool/serial_logger. Without one, a stream is generated: NAV-POSLLH,
+ * NAV-STATUS, NAV-SOL and NAV-VELNED epochs for the GPS, and heartbeats,
+ * boat states, GPS_NED and debug strings for the XBee, with a few
+ * corrupted frames and line noise between frames.
+ *
+ * The stream arrives in chunks of 1 to chunk_bytes bytes (64 by default),
+ * which the main loop drains from a 512 byte buffer, as QUEUESIZE in
+ * src/Uart.c, before the next one arrives. So spans often stop where the
+ * buffer wraps. Each stream is replayed the given number of times (20 by
+ * default) each way, and the time per byte is reported.
+ *
+ * Fails unless both ways find the same frames, in the same order, and find
+ * at least one frame in each stream.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "RingBuffer.h"
+#include "UbxParser.h"
+#include "MavlinkParser.h"
+
+#define DEFAULT_REPEATS     20
+#define DEFAULT_CHUNK       64
+#define BUFFER_SIZE         512 // QUEUESIZE in src/Uart.c
+#define GENERATED_EPOCHS    5000
+#define GENERATED_FRAMES    20000
+#define CORRUPT_PERCENT     1   // frames with a flipped byte
+#define NOISE_PERCENT       2   // frames followed by a few bytes of noise
+
+#define DRAIN_GET           0
+#define DRAIN_SPAN          1
+
+#define STREAM_GPS          0
+#define STREAM_XBEE         1
+
+// Frames a parser found, as hashes of their bytes
+typedef struct {
+    unsigned long count, capacity;
+    uint32_t *keys;
+} FrameList;
+
+typedef struct {
+    uint8_t *data;
+    size_t length, size;
+} Stream;
+
+static FrameList *mavlinkFrames;
+
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// FNV-1a
+static uint32_t hash(uint32_t h, const uint8_t *data, size_t length) {
+    size_t i;
+    for (i = 0; i < length; i++)
+        h = (h ^ data[i]) * 16777619u;
+    return h;
+}
+
+static void addKey(FrameList *list, uint32_t key) {
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity * 2 + 256;
+        list->keys = realloc(list->keys, list->capacity * sizeof(uint32_t));
+    }
+    list->keys[list->count++] = key;
+}
+
+/**********************************************************************
+ * Building the streams
+ **********************************************************************/
+
+static void append(Stream *stream, const uint8_t *data, size_t length) {
+    if (stream->length + length > stream->size) {
+        stream->size = (stream->size + length) * 2;
+        stream->data = realloc(stream->data, stream->size);
+    }
+    memcpy(&stream->data[stream->length], data, length);
+    stream->length += length;
+}
+
+// Corrupts some frames, and puts noise after some
+static void appendFrame(Stream *stream, uint8_t *frame, uint16_t length) {
+    uint8_t noise[4];
+    int n, i;
+    if (rand() % 100 < CORRUPT_PERCENT)
+        frame[1 + rand() % (length - 1)] ^= 0x5A;
+    append(stream, frame, length);
+    if (rand() % 100 < NOISE_PERCENT) {
+        n = rand() % 4 + 1;
+        for (i = 0; i < n; i++)
+            noise[i] = (uint8_t)rand();
+        append(stream, noise, n);
+    }
+}
+
+static void fillPayload(uint8_t *payload, uint16_t length) {
+    uint16_t i;
+    for (i = 0; i < length; i++)
+        payload[i] = (uint8_t)rand();
+}
+
+static void generateGps(Stream *stream) {
+    static const struct { uint8_t id; uint16_t length; } messages[] = {
+        { UBX_NAV_POSLLH_ID, sizeof(UbxNavPosllh) },
+        { UBX_NAV_STATUS_ID, sizeof(UbxNavStatus) },
+        { UBX_NAV_SOL_ID, sizeof(UbxNavSol) },
+        { UBX_NAV_VELNED_ID, sizeof(UbxNavVelned) },
+    };
+    uint8_t payload[UBX_MAX_PAYLOAD_LEN], frame[UBX_MAX_FRAME_LEN];
+    int i, j;
+    srand(1);
+    for (i = 0; i < GENERATED_EPOCHS; i++) {
+        for (j = 0; j < 4; j++) {
+            fillPayload(payload, messages[j].length);
+            appendFrame(stream, frame, UbxParser_pack(frame, UBX_NAV_CLASS,
+                messages[j].id, payload, messages[j].length));
+        }
+    }
+}
+
+static void generateXbee(Stream *stream) {
+    static const struct { uint8_t id; uint8_t length; } messages[] = {
+        { MAVLINK_MSG_ID_HEARTBEAT, MAVLINK_MSG_ID_HEARTBEAT_LEN },
+        { MAVLINK_MSG_ID_BOAT_STATE, MAVLINK_MSG_ID_BOAT_STATE_LEN },
+        { MAVLINK_MSG_ID_GPS_NED, MAVLINK_MSG_ID_GPS_NED_LEN },
+        { MAVLINK_MSG_ID_BOAT_STATE, MAVLINK_MSG_ID_BOAT_STATE_LEN },
+        { MAVLINK_MSG_ID_DEBUG, MAVLINK_MSG_ID_DEBUG_LEN },
+    };
+    uint8_t payload[MAVLINK_MAX_PAYLOAD_LEN], frame[MAVLINK_MAX_PACKET_LEN];
+    int i, m;
+    srand(2);
+    for (i = 0; i < GENERATED_FRAMES; i++) {
+        m = i % (int)(sizeof(messages) / sizeof(messages[0]));
+        fillPayload(payload, messages[m].length);
+        appendFrame(stream, frame, MavlinkParser_pack(frame, (uint8_t)i, 1, 1,
+            messages[m].id, payload, messages[m].length));
+    }
+}
+
+static int readCapture(const char *path, Stream *stream) {
+    FILE *file = fopen(path, "rb");
+    uint8_t chunk[4096];
+    size_t count;
+    if (file == NULL)
+        return 0;
+    while ((count = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        append(stream, chunk, count);
+    fclose(file);
+    return 1;
+}
+
+/**********************************************************************
+ * Draining the buffer into the parsers
+ **********************************************************************/
+
+static void handleMavlinkFrame(const MavlinkFrame *frame) {
+    uint8_t header[4] = { frame->msgid, frame->sysid, frame->compid, frame->seq };
+    addKey(mavlinkFrames, hash(hash(2166136261u, header, sizeof(header)),
+        frame->payload, frame->len));
+}
+
+// Hands bytes to the stream's parser, and notes the frames it finds
+static void parse(int kind, UbxParser *ubx, MavlinkParser *mavlink,
+        const uint8_t *data, uint16_t length, FrameList *found) {
+    uint16_t i = 0;
+    if (kind == STREAM_XBEE) {
+        mavlinkFrames = found;
+        MavlinkParser_parse(mavlink, data, length, handleMavlinkFrame);
+        return;
+    }
+    while (i < length) {
+        i += UbxParser_read(ubx, &data[i], length - i);
+        if (ubx->hasFrame)
+            addKey(found, hash(2166136261u, ubx->frame, ubx->length));
+    }
+}
+
+// Empties the buffer one way or the other
+static void drain(int method, int kind, RingBuffer *rb, UbxParser *ubx,
+        MavlinkParser *mavlink, FrameList *found) {
+    const uint8_t *span;
+    uint16_t length;
+    uint8_t ch;
+    if (method == DRAIN_GET) {
+        while (RingBuffer_get(rb, &ch))
+            parse(kind, ubx, mavlink, &ch, 1, found);
+        return;
+    }
+    while ((length = RingBuffer_peekContiguous(rb, &span)) > 0) {
+        parse(kind, ubx, mavlink, span, length, found);
+        RingBuffer_consume(rb, length);
+    }
+}
+
+// Replays the stream, returning the seconds spent draining
+static double replay(int method, int kind, const Stream *stream, size_t chunk,
+        int repeats, FrameList *found) {
+    static uint8_t storage[BUFFER_SIZE];
+    RingBuffer rb;
+    UbxParser ubx;
+    MavlinkParser mavlink;
+    size_t i, count;
+    double start, seconds = 0.0;
+    int r;
+
+    for (r = 0; r < repeats; r++) {
+        RingBuffer_init(&rb, storage, BUFFER_SIZE);
+        UbxParser_init(&ubx);
+        MavlinkParser_init(&mavlink);
+        found->count = 0;
+        srand(3);
+        for (i = 0; i < stream->length; i += count) {
+            count = rand() % chunk + 1;
+            if (count > stream->length - i)
+                count = stream->length - i;
+            RingBuffer_write(&rb, &stream->data[i], (uint16_t)count);
+            start = now();
+            drain(method, kind, &rb, &ubx, &mavlink, found);
+            seconds += now() - start;
+        }
+    }
+    return seconds;
+}
+
+static int run(const char *name, int kind, const Stream *stream, size_t chunk,
+        int repeats) {
+    FrameList byGet = {0, 0, NULL}, bySpan = {0, 0, NULL};
+    double getTime, spanTime;
+    int same;
+
+    getTime = replay(DRAIN_GET, kind, stream, chunk, repeats, &byGet);
+    spanTime = replay(DRAIN_SPAN, kind, stream, chunk, repeats, &bySpan);
+    same = byGet.count == bySpan.count && byGet.count > 0
+        && memcmp(byGet.keys, bySpan.keys, byGet.count * sizeof(uint32_t)) == 0;
+
+    printf("  %-5s %8lu bytes %6lu frames | get %6.2f ns/byte  span %6.2f ns/byte"
+        "  %5.2fx | %s\n", name, (unsigned long)stream->length, bySpan.count,
+        1e9 * getTime / repeats / stream->length,
+        1e9 * spanTime / repeats / stream->length, getTime / spanTime,
+        same ? "same frames" : "frames differ");
+    free(byGet.keys);
+    free(bySpan.keys);
+    return same;
+}
+
+int main(int argc, char **argv) {
+    Stream gps = {NULL, 0, 0}, xbee = {NULL, 0, 0};
+    const char *gpsPath = NULL, *xbeePath = NULL;
+    size_t chunk = DEFAULT_CHUNK;
+    int repeats = DEFAULT_REPEATS, i, passed;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            chunk = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+            gpsPath = argv[++i];
+        else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+            xbeePath = argv[++i];
+        else {
+            fprintf(stderr, "usage: %s [-r repeats] [-c chunk_bytes] [-g gps_capture]"
+                " [-x xbee_capture]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (repeats <= 0 || chunk == 0 || chunk > BUFFER_SIZE) {
+        fprintf(stderr, "Bad repeat count or chunk size.\n");
+        return 2;
+    }
+
+    if (gpsPath == NULL)
+        generateGps(&gps);
+    else if (!readCapture(gpsPath, &gps)) {
+        fprintf(stderr, "Could not read %s.\n", gpsPath);
+        return 1;
+    }
+    if (xbeePath == NULL)
+        generateXbee(&xbee);
+    else if (!readCapture(xbeePath, &xbee)) {
+        fprintf(stderr, "Could not read %s.\n", xbeePath);
+        return 1;
+    }
+
+    printf("Chunks of up to %lu bytes into a %d byte buffer, %d repeats:\n",
+        (unsigned long)chunk, BUFFER_SIZE, repeats);
+    passed = run("GPS", STREAM_GPS, &gps, chunk, repeats);
+    passed = run("XBee", STREAM_XBEE, &xbee, chunk, repeats) && passed;
+    free(gps.data);
+    free(xbee.data);
+
+    printf("%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
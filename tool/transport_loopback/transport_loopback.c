@@ -0,0 +1,388 @@
+/*
+ * transport_loopback.c runs the command center and the boat as two nodes
+ * joined by a simulated lossy XBee link, and compares how long a start
+ * rescue command takes to be acked with src/Transport.c against the old
+ * fixed resend timer.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o transport_loopback transport_loopback.c \
+ *         ../../src/Transport.c ../../src/MavlinkParser.c ../../src/MavlinkCrc.c
+ *
+ * Usage:
+ *     transport_loopback [-n commands] [-d delay_ms] [loss_percent ...]
+ *
+ * Each frame is lost with the given chance, in either direction, and
+ * otherwise arrives after the one-way delay plus its time on the air at
+ * 57600 baud. Without loss percentages, 0, 10, 30 and 50 are run.
+ *
+ * The boat acks every new command. With the transport it drops resent
+ * copies (acking them again when the first ACK was lost), while with the
+ * fixed timer every copy reaches the boat's state machine. Fails if the
+ * transport delivers a command twice, or gives up on one at under 50% loss.
+ *
+ * Then the boat ignores the first copy of each command without acking it,
+ * like Atlas does with a start rescue while it sets its origin. Fails
+ * unless a resend reaches the boat and gets acked every time.
+ *
+ * Last, two commands with the same message ID and sequence number, from two
+ * senders, are received and only the second is acked. Fails unless repeats
+ * of each get the answer for that one. And one more command than there are
+ * slots is sent with no ACKs; fails unless the first is reported dead and
+ * the others are still waiting.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "MavlinkParser.h"
+#include "Transport.h"
+
+#define DEFAULT_COMMANDS    1000
+#define DEFAULT_DELAY       20 // (ms) one way, besides time on the air
+#define BAUD_RATE           57600
+#define MAX_IN_FLIGHT       64
+
+#define FIXED_RESEND_DELAY  4000 // (ms) the old RESEND_MESSAGE_DELAY
+#define FIXED_RESEND_LIMIT  5 // the old RESEND_MESSAGE_LIMIT
+#define COMMAND_GAP         1000 // (ms) between commands
+
+#define SYSID               15
+#define COMPID              15
+#define START_RESCUE        0x3 // MAVLINK_LOCAL_START_RESCUE
+
+#define TO_BOAT             0
+#define TO_COMMAND_CENTER   1
+
+typedef struct {
+    int to;
+    unsigned long time; // (ms) when it arrives
+    uint16_t length;
+    uint8_t data[MAVLINK_MAX_PACKET_LEN];
+} Packet;
+
+typedef struct {
+    unsigned long commands;
+    unsigned long failed;
+    unsigned long frames; // sent both ways
+    unsigned long duplicates; // commands the boat acted on twice
+    double totalLatency;
+    unsigned long *latencies;
+} Result;
+
+static Packet link[MAX_IN_FLIGHT];
+static int lossPercent, delay;
+static unsigned long now; // (ms)
+
+static Transport commandCenter, boat;
+static MavlinkParser commandCenterParser, boatParser;
+static int useTransport;
+static int ignoreFirst; // boat passes on the first copy of each command
+static unsigned long acked, frames, repeats;
+static unsigned char *boatActed; // by command number
+
+
+static void sendPacket(int to, const uint8_t *data, uint16_t length) {
+    int i;
+    frames++;
+    if (rand() % 100 < lossPercent)
+        return;
+    for (i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (link[i].length == 0) {
+            link[i].to = to;
+            link[i].time = now + delay + (length * 10 * 1000UL) / BAUD_RATE + 1;
+            link[i].length = length;
+            memcpy(link[i].data, data, length);
+            return;
+        }
+    }
+}
+
+static void writeToBoat(const uint8_t *data, uint16_t length) {
+    sendPacket(TO_BOAT, data, length);
+}
+
+static void writeToCommandCenter(const uint8_t *data, uint16_t length) {
+    sendPacket(TO_COMMAND_CENTER, data, length);
+}
+
+static void sendAck(uint8_t msgID, uint16_t msgStatus) {
+    mavlink_message_t msg;
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    mavlink_msg_mavlink_ack_pack(SYSID, COMPID, &msg, msgID, msgStatus);
+    writeToCommandCenter(buf, mavlink_msg_to_send_buffer(buf, &msg));
+}
+
+// Like handleFrame in src/Mavlink.c, with the boat acking right away
+static void handleBoatFrame(const MavlinkFrame *frame) {
+    mavlink_gps_ned_t command;
+    uint16_t msgStatus;
+    if (frame->msgid != MAVLINK_MSG_ID_GPS_NED)
+        return;
+    memcpy(&command, frame->payload, frame->len);
+    msgStatus = command.status;
+    if (useTransport) {
+        switch (Transport_receive(&boat, frame->sysid, frame->msgid,
+                frame->seq, now, &msgStatus)) {
+            case TRANSPORT_DUPLICATE_ACKED:
+                sendAck(frame->msgid, msgStatus);
+                return;
+            case TRANSPORT_DUPLICATE:
+                return;
+        }
+        // Handed straight to the state machine
+        Transport_delivered(&boat, frame->sysid, frame->msgid, frame->seq);
+    }
+    // The command number is sent as north
+    if (ignoreFirst && boatActed[(unsigned long)command.north] == 0) {
+        boatActed[(unsigned long)command.north] = 2; // seen, not acted on
+        return;
+    }
+    if (boatActed[(unsigned long)command.north] == 1)
+        repeats++;
+    boatActed[(unsigned long)command.north] = 1;
+    sendAck(frame->msgid, msgStatus);
+    if (useTransport)
+        Transport_sentAck(&boat, frame->sysid, frame->msgid, frame->seq, msgStatus);
+}
+
+static void handleCommandCenterFrame(const MavlinkFrame *frame) {
+    mavlink_mavlink_ack_t ack;
+    if (frame->msgid != MAVLINK_MSG_ID_MAVLINK_ACK)
+        return;
+    memcpy(&ack, frame->payload, frame->len);
+    if (useTransport)
+        Transport_handleAck(&commandCenter, ack.msgID, ack.msgStatus, now);
+    else if (ack.msgID == MAVLINK_MSG_ID_GPS_NED && ack.msgStatus == START_RESCUE)
+        acked = 1;
+}
+
+// Moves time ahead by a ms, handing over packets that arrived
+static void tick() {
+    int i;
+    now++;
+    for (i = 0; i < MAX_IN_FLIGHT; i++) {
+        if (link[i].length == 0 || link[i].time > now)
+            continue;
+        if (link[i].to == TO_BOAT)
+            MavlinkParser_parse(&boatParser, link[i].data, link[i].length, handleBoatFrame);
+        else
+            MavlinkParser_parse(&commandCenterParser, link[i].data, link[i].length,
+                handleCommandCenterFrame);
+        link[i].length = 0;
+    }
+    if (useTransport) {
+        Transport_runSM(&commandCenter, now);
+        Transport_runSM(&boat, now);
+    }
+}
+
+// Sends one start rescue and waits for its ACK, returns FALSE if it failed
+static int runCommand(unsigned long number, unsigned long *latency) {
+    mavlink_message_t msg;
+    uint8_t buf[MAVLINK_MAX_PACKET_LEN];
+    uint16_t length;
+    unsigned long start = now, lastSend = now;
+    int resendCount = 0;
+    uint8_t status;
+
+    mavlink_msg_gps_ned_pack(SYSID, COMPID, &msg, 1, START_RESCUE,
+        (float)number, 0.0f, 0.0f);
+    length = mavlink_msg_to_send_buffer(buf, &msg);
+
+    acked = 0;
+    if (useTransport)
+        Transport_send(&commandCenter, buf, length, msg.msgid, START_RESCUE, now);
+    else
+        writeToBoat(buf, length);
+
+    while (1) {
+        tick();
+        if (useTransport) {
+            status = Transport_getStatus(&commandCenter, msg.msgid, START_RESCUE);
+            if (status == ACK_STATUS_RECIEVED)
+                break;
+            if (status == ACK_STATUS_DEAD)
+                return 0;
+        }
+        else {
+            // What the state machines in Compas.c used to do
+            if (acked)
+                break;
+            if (now - lastSend >= FIXED_RESEND_DELAY) {
+                if (resendCount >= FIXED_RESEND_LIMIT)
+                    return 0;
+                writeToBoat(buf, length);
+                lastSend = now;
+                resendCount++;
+            }
+        }
+    }
+    *latency = now - start;
+    return 1;
+}
+
+static int compareLatency(const void *a, const void *b) {
+    unsigned long x = *(const unsigned long*)a, y = *(const unsigned long*)b;
+    return (x > y) - (x < y);
+}
+
+static Result runTrial(int transport, int ignore, unsigned long commands) {
+    Result result;
+    unsigned long i, latency, end;
+    memset(&result, 0, sizeof(result));
+    result.latencies = malloc(commands * sizeof(unsigned long));
+    memset(link, 0, sizeof(link));
+    useTransport = transport;
+    ignoreFirst = ignore;
+    Transport_init(&commandCenter, writeToBoat);
+    Transport_init(&boat, writeToCommandCenter);
+    MavlinkParser_init(&commandCenterParser);
+    MavlinkParser_init(&boatParser);
+    boatActed = calloc(commands, 1);
+    repeats = frames = 0;
+    now = 1;
+    srand(7);
+
+    for (i = 0; i < commands; i++) {
+        if (runCommand(i, &latency)) {
+            result.latencies[result.commands++] = latency;
+            result.totalLatency += latency;
+        }
+        else
+            result.failed++;
+        // Let late copies land before the next command
+        for (end = now + COMMAND_GAP; now < end; )
+            tick();
+    }
+    result.frames = frames;
+    result.duplicates = repeats;
+    free(boatActed);
+    qsort(result.latencies, result.commands, sizeof(unsigned long), compareLatency);
+    return result;
+}
+
+static void report(const char *name, Result result) {
+    unsigned long p95 = 0, max = 0;
+    if (result.commands > 0) {
+        p95 = result.latencies[(result.commands * 95) / 100];
+        max = result.latencies[result.commands - 1];
+    }
+    printf("  %-12s mean %6.0f ms  p95 %6lu ms  max %6lu ms  failed %4lu"
+        "  repeats %4lu  frames %6lu\n", name,
+        result.commands ? result.totalLatency / result.commands : 0.0,
+        p95, max, result.failed, result.duplicates, result.frames);
+}
+
+// Only the ACKed one of two look-alike commands may be acked again
+static int checkAckMatching() {
+    Transport receiver;
+    uint16_t status;
+    int passed = 1;
+
+    Transport_init(&receiver, writeToCommandCenter);
+    status = 1; // first sender, MAVLINK_RETURN_STATION say
+    if (Transport_receive(&receiver, 1, MAVLINK_MSG_ID_CMD_OTHER, 5, 100, &status)
+            != TRANSPORT_NEW_FRAME)
+        passed = 0;
+    Transport_delivered(&receiver, 1, MAVLINK_MSG_ID_CMD_OTHER, 5);
+    status = 2;
+    if (Transport_receive(&receiver, 2, MAVLINK_MSG_ID_CMD_OTHER, 5, 110, &status)
+            != TRANSPORT_NEW_FRAME)
+        passed = 0;
+    Transport_delivered(&receiver, 2, MAVLINK_MSG_ID_CMD_OTHER, 5);
+    Transport_sentAck(&receiver, 2, MAVLINK_MSG_ID_CMD_OTHER, 5, 2);
+
+    // The second is acked again with its status, the first handed over again
+    status = 0;
+    if (Transport_receive(&receiver, 2, MAVLINK_MSG_ID_CMD_OTHER, 5, 500, &status)
+            != TRANSPORT_DUPLICATE_ACKED || status != 2)
+        passed = 0;
+    if (Transport_receive(&receiver, 1, MAVLINK_MSG_ID_CMD_OTHER, 5, 500, &status)
+            != TRANSPORT_NEW_FRAME)
+        passed = 0;
+    printf("ACK for one of two look-alike commands: %s\n", passed ? "matched" : "mixed up");
+    return passed;
+}
+
+// Sending into a table full of waiting messages gives up on the first one
+static int checkEviction() {
+    Transport sender;
+    uint8_t frame[MAVLINK_NUM_NON_PAYLOAD_BYTES] = {0};
+    uint16_t i;
+    int passed = 1;
+
+    Transport_init(&sender, writeToCommandCenter);
+    for (i = 0; i <= TRANSPORT_SLOTS; i++) {
+        if (!Transport_send(&sender, frame, sizeof(frame), MAVLINK_MSG_ID_CMD_OTHER,
+                i, 100 + i))
+            passed = 0;
+    }
+    if (Transport_getStatus(&sender, MAVLINK_MSG_ID_CMD_OTHER, 0) != ACK_STATUS_DEAD
+            || sender.failedCount != 1)
+        passed = 0;
+    for (i = 1; i <= TRANSPORT_SLOTS; i++) {
+        if (Transport_getStatus(&sender, MAVLINK_MSG_ID_CMD_OTHER, i) != ACK_STATUS_WAIT)
+            passed = 0;
+    }
+    printf("%d commands into %d slots: %s\n", TRANSPORT_SLOTS + 1, TRANSPORT_SLOTS,
+        passed ? "first given up on" : "lost track");
+    return passed;
+}
+
+int main(int argc, char **argv) {
+    int losses[16] = {0, 10, 30, 50}, lossCount = 0, i, passed = 1;
+    unsigned long commands = DEFAULT_COMMANDS;
+    Result fixed, transport;
+
+    delay = DEFAULT_DELAY;
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            commands = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            delay = atoi(argv[++i]);
+        else if (argv[i][0] == '-' || lossCount >= 16) {
+            fprintf(stderr, "usage: %s [-n commands] [-d delay_ms] [loss_percent ...]\n", argv[0]);
+            return 2;
+        }
+        else
+            losses[lossCount++] = atoi(argv[i]);
+    }
+    if (lossCount == 0)
+        lossCount = 4;
+    if (commands == 0 || delay < 0) {
+        fprintf(stderr, "Bad command count or delay.\n");
+        return 2;
+    }
+
+    for (i = 0; i < lossCount; i++) {
+        lossPercent = losses[i];
+        printf("%d%% loss, %d ms delay, %lu commands:\n", lossPercent, delay, commands);
+        fixed = runTrial(0, 0, commands);
+        transport = runTrial(1, 0, commands);
+        report("fixed 4 s", fixed);
+        report("Transport", transport);
+        if (transport.duplicates != 0 || (lossPercent < 50 && transport.failed != 0))
+            passed = 0;
+        free(fixed.latencies);
+        free(transport.latencies);
+    }
+
+    lossPercent = 0;
+    printf("boat ignores the first copy, %d ms delay, %lu commands:\n", delay, commands);
+    transport = runTrial(1, 1, commands);
+    report("Transport", transport);
+    if (transport.failed != 0 || transport.duplicates != 0)
+        passed = 0;
+    free(transport.latencies);
+
+    if (!checkAckMatching() || !checkEviction())
+        passed = 0;
+
+    printf("%s\n", passed ? "PASSED" : "FAILED: Transport repeated or lost a command.");
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,33 @@
+/*
+ * Host stand-in for include/Board.h, for tool/uart_write. Shares its include
+ * guard, so include/Timer.h doesn't pull in the real one.
+ *
+ * DELAY spins the same nop loop as the real one, then tells the tool's
+ * model how long the loop would take on the PIC32, so the UART keeps
+ * sending while it runs.
+ */
+#ifndef Board_H
+#define Board_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "xc.h"
+#include "plib.h"
+
+#define DELAY(ms)   do { int i; for (i = 0; i < (ms << 8); i++) { asm ("nop"); } \
+                        Stub_delay(ms); } while(0);
+
+#ifndef TRUE
+#define FALSE ((int8_t) 0)
+#define TRUE ((int8_t) 1)
+#endif
+
+#ifndef SUCCESS
+#define SUCCESS ((int8_t) 0)
+#define FAILURE ((int8_t) 1)
+#endif
+
+void Stub_delay(int ms);
+uint32_t Board_GetPBClock();
+
+#endif // Board_H
@@ -0,0 +1,38 @@
+/*
+ * Host stand-in for the plib <peripheral/uart.h>, for tool/uart_write. Only
+ * the calls Uart.c makes, implemented by the tool against its model of the
+ * UART hardware.
+ */
+#ifndef STUB_PERIPHERAL_UART_H
+#define STUB_PERIPHERAL_UART_H
+
+#include <stdint.h>
+#include "../plib.h"
+
+typedef enum {
+    UART1 = 0,
+    UART2,
+    UART_NUMBER_OF_MODULES
+} UART_MODULE;
+
+#define UART_INTERRUPT_ON_TX_BUFFER_EMPTY   0x8000
+#define UART_INTERRUPT_ON_RX_NOT_EMPTY      0x0000
+#define UART_INTERRUPT_ON_RX_HALF_FULL      0x0040
+#define UART_INTERRUPT_ON_RX_3_QUARTER_FULL 0x0080
+
+#define UART_PERIPHERAL                     0x01
+#define UART_RX                             0x02
+#define UART_TX                             0x04
+#define UART_ENABLE_FLAGS(flags)            (flags)
+#define UART_DISABLE_FLAGS(flags)           ((flags) << 8)
+
+void UARTConfigure(UART_MODULE module, int flags);
+uint32_t UARTSetDataRate(UART_MODULE module, uint32_t sourceClock, uint32_t dataRate);
+void UARTSetFifoMode(UART_MODULE module, int mode);
+void UARTEnable(UART_MODULE module, int mode);
+int UARTReceivedDataIsAvailable(UART_MODULE module);
+uint8_t UARTGetDataByte(UART_MODULE module);
+int UARTTransmitBufferIsFull(UART_MODULE module);
+void UARTSendDataByte(UART_MODULE module, uint8_t data);
+
+#endif // STUB_PERIPHERAL_UART_H
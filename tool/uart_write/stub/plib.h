@@ -0,0 +1,37 @@
+/*
+ * Host stand-in for the plib interrupt and core timer calls Uart.c makes,
+ * for tool/uart_write. The tool implements them against its model of the
+ * UART hardware.
+ */
+#ifndef STUB_PLIB_H
+#define STUB_PLIB_H
+
+#include <stdint.h>
+#include "peripheral/uart.h"
+
+typedef enum {
+    INT_DISABLED = 0,
+    INT_ENABLED
+} INT_EN_DIS;
+
+// Sources are two per module, receive then transmit
+#define INT_SOURCE_UART_RX(module)  ((module) * 2)
+#define INT_SOURCE_UART_TX(module)  ((module) * 2 + 1)
+#define INT_VECTOR_UART(module)     (module)
+
+#define INT_PRIORITY_LEVEL_4        4
+#define INT_SUB_PRIORITY_LEVEL_0    0
+
+void INTSetVectorPriority(int vector, int priority);
+void INTSetVectorSubPriority(int vector, int subPriority);
+void INTEnable(int source, INT_EN_DIS enable);
+int INTGetEnable(int source);
+void INTSetFlag(int source);
+int INTGetFlag(int source);
+void INTClearFlag(int source);
+unsigned int INTDisableInterrupts(void);
+void INTRestoreInterrupts(unsigned int status);
+
+uint32_t ReadCoreTimer(void); // (ticks) at SYSCLK/2
+
+#endif // STUB_PLIB_H
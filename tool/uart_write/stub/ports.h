@@ -0,0 +1,4 @@
+/*
+ * Host stand-in for the plib <ports.h>, for tool/uart_write. Uart.c doesn't
+ * use any of it.
+ */
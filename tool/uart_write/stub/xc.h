@@ -0,0 +1,16 @@
+/*
+ * Host stand-in for the XC32 <xc.h>, for tool/uart_write.
+ *
+ * Interrupt handlers become plain functions the tool calls itself.
+ */
+#ifndef STUB_XC_H
+#define STUB_XC_H
+
+#include <stdint.h>
+
+#define __ISR(vector, ipl)
+
+#define _UART1_VECTOR   24
+#define _UART2_VECTOR   32
+
+#endif // STUB_XC_H
@@ -0,0 +1,368 @@
+/*
+ * uart_write.c builds src/Uart.c on a host, against stand-ins for the plib
+ * UART and interrupt calls (in stub/), and compares how long the main loop
+ * is held up sending a burst the old way, a UART_putChar and a DELAY(10)
+ * per byte, and with UART_write.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -Istub -I../../include -o uart_write uart_write.c ../../src/Uart.c
+ *
+ * Usage:
+ *     uart_write [-r repeats] [-b baud]
+ *
+ * The model UART has a 4 byte transmit FIFO that sends one byte per byte
+ * time at the given baud rate (9600 by default, as for the XBee). When the
+ * FIFO empties, its transmit interrupt runs the ISR in Uart.c, unless
+ * interrupts are disabled. Time on the model only moves ahead while DELAY
+ * runs, by what its nop loop takes on the PIC32 (5 cycles a pass at
+ * 80 MHz), and while the tool drains the UART between bursts.
+ *
+ * The bursts are a heartbeat, a boat position (BOAT_STATE and GPS_NED) and
+ * a debug string, each sent the given number of times (1000 by default).
+ * For each, the host time of the call is reported for both ways, and the
+ * PIC32 time the old way spends in DELAY alone. UART_write doesn't wait at
+ * all, so the main loop is only held up for the copy.
+ *
+ * Fails unless the bytes leave the model UART in order and none are
+ * dropped, both ways, and a frame written with UART_WRITE_REJECT into a
+ * buffer too full for it is refused whole rather than cut in half.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Uart.h"
+#include "Board.h"
+#include "Timer.h"
+#include "mavlink/autoLifeguard/mavlink.h"
+
+#define DEFAULT_REPEATS     1000
+#define DEFAULT_BAUD        9600
+#define UART_ID             UART2_ID
+#define MODULE              UART2
+
+#define FIFO_SIZE           4 // transmit FIFO on the PIC32MX320
+#define PB_CLOCK            80000000UL
+#define CORE_TICKS_PER_MS   40000 // core timer runs at SYSCLK/2
+#define NOP_LOOP_CYCLES     5 // nop, addiu, slt, bne and its delay slot
+#define WIRE_SIZE           1024 // bytes kept of what the UART sent
+#define BURSTS              3
+
+#define HEARTBEAT_SIZE      (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_HEARTBEAT_LEN)
+#define POSITION_SIZE       (2*MAVLINK_NUM_NON_PAYLOAD_BYTES \
+                                + MAVLINK_MSG_ID_BOAT_STATE_LEN + MAVLINK_MSG_ID_GPS_NED_LEN)
+#define DEBUG_SIZE          (MAVLINK_NUM_NON_PAYLOAD_BYTES + MAVLINK_MSG_ID_DEBUG_LEN)
+
+// Interrupt handlers in Uart.c, plain functions here (see stub/xc.h)
+void IntUart1Handler(void);
+void IntUart2Handler(void);
+
+// Model of a UART module and its two interrupt sources
+typedef struct {
+    uint8_t fifo[FIFO_SIZE];
+    int fifoLength;
+    uint32_t byteTicks; // core ticks to send one byte
+    uint32_t credit; // core ticks toward the next byte
+    int flag[2], enable[2]; // receive, transmit
+} Module;
+
+typedef struct {
+    const char *name;
+    uint16_t length;
+} Burst;
+
+static Module modules[UART_NUMBER_OF_MODULES];
+static uint32_t coreTicks;
+static int interruptsOn = 1, inInterrupt;
+static uint8_t wire[WIRE_SIZE];
+static uint16_t wireLength;
+static uint32_t delayTicks; // spent in DELAY
+
+
+/**********************************************************************
+ * Model of the hardware, behind the stand-ins in stub/               *
+ **********************************************************************/
+
+static void dispatch() {
+    int i;
+    if (!interruptsOn || inInterrupt)
+        return;
+    inInterrupt = 1;
+    for (i = 0; i < UART_NUMBER_OF_MODULES; i++) {
+        Module *m = &modules[i];
+        if ((m->flag[0] && m->enable[0]) || (m->flag[1] && m->enable[1])) {
+            if (i == UART1)
+                IntUart1Handler();
+            else
+                IntUart2Handler();
+        }
+    }
+    inInterrupt = 0;
+}
+
+// Moves time ahead, sending bytes out of the FIFOs
+static void advance(uint32_t ticks) {
+    Module *m = &modules[MODULE];
+    coreTicks += ticks;
+    m->credit += ticks;
+    while (m->fifoLength > 0 && m->credit >= m->byteTicks) {
+        m->credit -= m->byteTicks;
+        if (wireLength < WIRE_SIZE)
+            wire[wireLength++] = m->fifo[0];
+        memmove(m->fifo, &m->fifo[1], --m->fifoLength);
+        if (m->fifoLength == 0) {
+            m->flag[1] = 1;
+            dispatch();
+        }
+    }
+    if (m->fifoLength == 0)
+        m->credit = 0; // idle line saves nothing up
+}
+
+void UARTConfigure(UART_MODULE module, int flags) {
+    (void)flags;
+    memset(&modules[module], 0, sizeof(Module));
+}
+
+uint32_t UARTSetDataRate(UART_MODULE module, uint32_t sourceClock, uint32_t dataRate) {
+    (void)sourceClock;
+    modules[module].byteTicks = 10 * CORE_TICKS_PER_MS * 1000UL / dataRate;
+    return dataRate;
+}
+
+void UARTSetFifoMode(UART_MODULE module, int mode) {
+    (void)module;
+    (void)mode;
+}
+
+void UARTEnable(UART_MODULE module, int mode) {
+    (void)module;
+    (void)mode;
+}
+
+int UARTReceivedDataIsAvailable(UART_MODULE module) {
+    (void)module;
+    return 0;
+}
+
+uint8_t UARTGetDataByte(UART_MODULE module) {
+    (void)module;
+    return 0;
+}
+
+int UARTTransmitBufferIsFull(UART_MODULE module) {
+    return modules[module].fifoLength >= FIFO_SIZE;
+}
+
+void UARTSendDataByte(UART_MODULE module, uint8_t data) {
+    Module *m = &modules[module];
+    if (m->fifoLength < FIFO_SIZE)
+        m->fifo[m->fifoLength++] = data;
+}
+
+void INTSetVectorPriority(int vector, int priority) {
+    (void)vector;
+    (void)priority;
+}
+
+void INTSetVectorSubPriority(int vector, int subPriority) {
+    (void)vector;
+    (void)subPriority;
+}
+
+void INTEnable(int source, INT_EN_DIS enable) {
+    modules[source / 2].enable[source % 2] = (enable == INT_ENABLED);
+    dispatch();
+}
+
+int INTGetEnable(int source) {
+    return modules[source / 2].enable[source % 2];
+}
+
+void INTSetFlag(int source) {
+    modules[source / 2].flag[source % 2] = 1;
+    dispatch();
+}
+
+int INTGetFlag(int source) {
+    return modules[source / 2].flag[source % 2];
+}
+
+void INTClearFlag(int source) {
+    modules[source / 2].flag[source % 2] = 0;
+}
+
+unsigned int INTDisableInterrupts(void) {
+    unsigned int status = interruptsOn;
+    interruptsOn = 0;
+    return status;
+}
+
+void INTRestoreInterrupts(unsigned int status) {
+    interruptsOn = status;
+    dispatch();
+}
+
+uint32_t ReadCoreTimer(void) {
+    return coreTicks;
+}
+
+void Stub_delay(int ms) {
+    uint32_t ticks = ((uint32_t)ms << 8) * NOP_LOOP_CYCLES / 2;
+    delayTicks += ticks;
+    advance(ticks);
+}
+
+uint32_t Board_GetPBClock() {
+    return PB_CLOCK;
+}
+
+bool Timer_isInitialized() {
+    return true;
+}
+
+uint32_t get_time(void) {
+    return coreTicks / CORE_TICKS_PER_MS;
+}
+
+/**********************************************************************
+ * Benchmark                                                          *
+ **********************************************************************/
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// UART_putString before UART_write
+static void putStringWithDelay(uint8_t id, char *data, int length) {
+    int x;
+    for (x = 0; x < length; x++) {
+        UART_putChar(id, data[x]);
+        DELAY(10);
+    }
+}
+
+// Runs the model until everything queued has gone out
+static void drain() {
+    while (!UART_isTransmitEmpty(UART_ID) || modules[MODULE].fifoLength > 0)
+        advance(modules[MODULE].byteTicks);
+}
+
+static void fillBurst(uint8_t *data, uint16_t length, int repeat) {
+    uint16_t i;
+    for (i = 0; i < length; i++)
+        data[i] = (uint8_t)(repeat * 7 + i);
+}
+
+// Sends a burst many times, checking what went out each time
+static int runBurst(int useWrite, uint16_t length, int repeats, double *seconds) {
+    uint8_t data[DEBUG_SIZE + POSITION_SIZE];
+    double start;
+    int i, passed = 1;
+
+    *seconds = 0.0;
+    delayTicks = 0;
+    for (i = 0; i < repeats; i++) {
+        fillBurst(data, length, i);
+        wireLength = 0;
+        start = now();
+        if (useWrite) {
+            if (UART_write(UART_ID, data, length, UART_WRITE_REJECT, 0) != length)
+                passed = 0;
+        }
+        else {
+            putStringWithDelay(UART_ID, (char *)data, length);
+        }
+        *seconds += now() - start;
+        drain();
+        if (wireLength != length || memcmp(wire, data, length) != 0)
+            passed = 0;
+    }
+    return passed;
+}
+
+// A frame that doesn't fit must be refused whole
+static int checkReject() {
+    uint8_t data[DEBUG_SIZE];
+    uint16_t space, first;
+
+    fillBurst(data, DEBUG_SIZE, 1);
+    wireLength = 0;
+    interruptsOn = 0; // hold the ISR off, so the buffer only fills
+    space = UART_getTransmitSpace(UART_ID);
+    first = 0;
+    while (UART_getTransmitSpace(UART_ID) >= DEBUG_SIZE) {
+        if (UART_write(UART_ID, data, DEBUG_SIZE, UART_WRITE_REJECT, 0) != DEBUG_SIZE)
+            return 0;
+        first += DEBUG_SIZE;
+    }
+    if (UART_write(UART_ID, data, DEBUG_SIZE, UART_WRITE_REJECT, 0) != 0
+            || UART_getTransmitSpace(UART_ID) != space - first)
+        return 0;
+    INTRestoreInterrupts(1);
+    drain();
+    return wireLength == first;
+}
+
+int main(int argc, char **argv) {
+    const Burst bursts[BURSTS] = {
+        { "heartbeat", HEARTBEAT_SIZE },
+        { "position", POSITION_SIZE },
+        { "debug", DEBUG_SIZE },
+    };
+    int repeats = DEFAULT_REPEATS, i, passed = 1;
+    unsigned long baud = DEFAULT_BAUD;
+    double before, after;
+    UartStatistics stats;
+    uint32_t picTicks;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            baud = strtoul(argv[++i], NULL, 10);
+        else {
+            fprintf(stderr, "usage: %s [-r repeats] [-b baud]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (repeats <= 0 || baud < 300 || baud > 1000000) {
+        fprintf(stderr, "Bad repeat count or baud rate.\n");
+        return 2;
+    }
+
+    UART_init(UART_ID, baud);
+    printf("%d of each burst at %lu baud:\n", repeats, baud);
+    printf("  %-10s %6s %16s %16s %16s\n", "burst", "bytes", "DELAY host (us)",
+        "DELAY PIC (ms)", "UART_write (us)");
+    for (i = 0; i < BURSTS; i++) {
+        if (!runBurst(0, bursts[i].length, repeats, &before))
+            passed = 0;
+        picTicks = delayTicks / repeats;
+        if (!runBurst(1, bursts[i].length, repeats, &after))
+            passed = 0;
+        printf("  %-10s %6u %16.1f %16.2f %16.3f\n", bursts[i].name,
+            bursts[i].length, 1e6 * before / repeats,
+            (double)picTicks / CORE_TICKS_PER_MS, 1e6 * after / repeats);
+    }
+
+    UART_getStatistics(UART_ID, &stats);
+    printf("  %lu bytes out, %lu dropped, %lu interrupts\n",
+        (unsigned long)stats.bytesOut, (unsigned long)stats.transmitDropped,
+        (unsigned long)stats.interruptCount);
+    if (stats.transmitDropped != 0)
+        passed = 0;
+    i = checkReject();
+    printf("  full buffer: %s\n", i ? "frame refused whole" : "frame cut or lost");
+
+    printf("%s\n", (passed && i) ? "PASSED" : "FAILED");
+    return (passed && i) ? 0 : 1;
+}
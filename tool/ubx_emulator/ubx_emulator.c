@@ -0,0 +1,511 @@
+/*
+ * ubx_emulator.c stands in for the u-blox GPS receiver on a pseudo-terminal,
+ * so the configuration in src/UbxConfig.c can be run against it without
+ * the hardware.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o ubx_emulator ubx_emulator.c \
+ *         ../../src/UbxConfig.c ../../src/UbxParser.c -lm
+ *
+ * Usage:
+ *     ubx_emulator [-b baud] [-6] [-t]
+ *
+ * Prints the pseudo-terminal and runs until killed. The receiver starts
+ * at the given baud rate (38400 by default), sending an NMEA GGA sentence
+ * once a second, like a new receiver. Whatever is written at another baud
+ * rate than the receiver's, as set on the pseudo-terminal with tcsetattr,
+ * reaches it as noise, and it is heard as noise too.
+ *
+ * It answers CFG-PRT polls, and CFG-PRT, CFG-RATE and CFG-MSG settings
+ * with ACK-ACK, or ACK-NAK for a setting it doesn't have. A new baud rate
+ * takes effect after the ACK is sent. Enabled NAV-PVT, NAV-POSLLH,
+ * NAV-SOL, NAV-VELNED and NAV-STATUS messages are sent each measurement,
+ * from a boat circling at 1 m/s. With -6 it is a LEA-6: no NAV-PVT, and
+ * no faster than 5 Hz.
+ *
+ * With -t, the emulator runs UbxConfig itself against receivers in a few
+ * starting states, like GPS_init in src/Gps.c. Fails if the configuration
+ * doesn't finish, the receiver isn't left at the wanted baud rate, rate
+ * and messages, or the NAV messages don't then arrive at that rate.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "UbxParser.h"
+#include "UbxConfig.h"
+
+#define DEFAULT_BAUD        38400
+#define NAV_MESSAGES        5
+#define READ_SIZE           512
+#define CONFIG_TIMEOUT      15000 // (ms) for -t to finish configuring
+#define COUNT_TIME          3000 // (ms) for -t to count NAV messages
+#define LEA6_MIN_PERIOD     200 // (ms) 5 Hz
+
+#define PORT_MODE_INDEX     4 // offsets in a CFG-PRT payload
+#define PORT_BAUD_INDEX     8
+#define PORT_IN_INDEX       12
+#define PORT_OUT_INDEX      14
+#define PROTOCOL_UBX        0x0001
+#define PROTOCOL_NMEA       0x0002
+
+typedef struct {
+    int master;
+    int slave; // held open to keep it raw, and used by -t
+    char name[64];
+    UbxParser parser;
+    uint32_t baudRate;
+    int isLea6;
+    uint16_t inProtocols, outProtocols;
+    uint16_t measureRate; // (ms)
+    uint8_t rates[NAV_MESSAGES]; // per measurement, of navIds
+    uint32_t nextTime, epoch;
+} Receiver;
+
+static const uint8_t navIds[NAV_MESSAGES] = { UBX_NAV_PVT_ID, UBX_NAV_POSLLH_ID,
+    UBX_NAV_SOL_ID, UBX_NAV_VELNED_ID, UBX_NAV_STATUS_ID };
+
+static const struct {
+    uint32_t baudRate;
+    speed_t speed;
+} speeds[] = { { 9600, B9600 }, { 19200, B19200 }, { 38400, B38400 },
+    { 57600, B57600 }, { 115200, B115200 } };
+
+static Receiver receiver;
+
+
+static uint32_t now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint32_t)(t.tv_sec * 1000 + t.tv_nsec / 1000000);
+}
+
+static speed_t getSpeed(uint32_t baudRate) {
+    size_t i;
+    for (i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        if (speeds[i].baudRate == baudRate)
+            return speeds[i].speed;
+    }
+    return B0;
+}
+
+// True if the other end is set to the receiver's baud rate
+static int isMatched() {
+    struct termios settings;
+    return tcgetattr(receiver.master, &settings) == 0
+        && cfgetospeed(&settings) == getSpeed(receiver.baudRate);
+}
+
+static void writeAll(int fd, const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    ssize_t n;
+    while (length > 0) {
+        n = write(fd, bytes, length);
+        if (n < 0) {
+            struct pollfd wait = { fd, POLLOUT, 0 };
+            poll(&wait, 1, 100);
+            continue;
+        }
+        bytes += n;
+        length -= n;
+    }
+}
+
+// Sends from the receiver, as noise at the wrong baud rate
+static void sendBytes(const uint8_t *data, size_t length) {
+    uint8_t noise[READ_SIZE];
+    size_t i;
+    if (isMatched()) {
+        writeAll(receiver.master, data, length);
+        return;
+    }
+    for (i = 0; i < length && i < sizeof(noise); i++)
+        noise[i] = (uint8_t)rand();
+    writeAll(receiver.master, noise, i);
+}
+
+static void sendMessage(uint8_t messageClass, uint8_t id, const uint8_t *payload,
+        uint16_t length) {
+    uint8_t frame[UBX_MAX_FRAME_LEN];
+    if (receiver.outProtocols & PROTOCOL_UBX)
+        sendBytes(frame, UbxParser_pack(frame, messageClass, id, payload, length));
+}
+
+static void sendAck(uint8_t id, int isAck) {
+    uint8_t payload[2] = { UBX_CFG_CLASS, id };
+    sendMessage(UBX_ACK_CLASS, isAck ? UBX_ACK_ACK_ID : UBX_ACK_NAK_ID, payload, 2);
+}
+
+static void put16(uint8_t *data, uint16_t value) {
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t *data, uint32_t value) {
+    put16(data, (uint16_t)value);
+    put16(&data[2], (uint16_t)(value >> 16));
+}
+
+static uint16_t get16(const uint8_t *data) {
+    return data[0] | (data[1] << 8);
+}
+
+static void handlePort(const uint8_t *payload, uint16_t length) {
+    uint8_t answer[20];
+    if (length == 1) {
+        memset(answer, 0, sizeof(answer));
+        answer[0] = payload[0];
+        put32(&answer[PORT_MODE_INDEX], 0x08D0);
+        put32(&answer[PORT_BAUD_INDEX], receiver.baudRate);
+        put16(&answer[PORT_IN_INDEX], receiver.inProtocols);
+        put16(&answer[PORT_OUT_INDEX], receiver.outProtocols);
+        sendMessage(UBX_CFG_CLASS, UBX_CFG_PRT_ID, answer, sizeof(answer));
+        sendAck(UBX_CFG_PRT_ID, 1);
+        return;
+    }
+    uint32_t baudRate = payload[PORT_BAUD_INDEX] | (payload[PORT_BAUD_INDEX + 1] << 8)
+        | ((uint32_t)payload[PORT_BAUD_INDEX + 2] << 16)
+        | ((uint32_t)payload[PORT_BAUD_INDEX + 3] << 24);
+    if (length != 20 || getSpeed(baudRate) == B0) {
+        sendAck(UBX_CFG_PRT_ID, 0);
+        return;
+    }
+    sendAck(UBX_CFG_PRT_ID, 1); // at the old rate
+    tcdrain(receiver.master);
+    receiver.baudRate = baudRate;
+    receiver.inProtocols = get16(&payload[PORT_IN_INDEX]);
+    receiver.outProtocols = get16(&payload[PORT_OUT_INDEX]);
+}
+
+static void handleRate(const uint8_t *payload, uint16_t length) {
+    uint16_t measureRate = get16(payload);
+    if (length != 6 || measureRate < 50
+            || (receiver.isLea6 && measureRate < LEA6_MIN_PERIOD)) {
+        sendAck(UBX_CFG_RATE_ID, 0);
+        return;
+    }
+    receiver.measureRate = measureRate;
+    receiver.nextTime = now() + measureRate;
+    sendAck(UBX_CFG_RATE_ID, 1);
+}
+
+static void handleMessageRate(const uint8_t *payload, uint16_t length) {
+    int i;
+    if (length == 3 && payload[0] == UBX_NAV_CLASS) {
+        for (i = 0; i < NAV_MESSAGES; i++) {
+            if (navIds[i] == payload[1] && !(receiver.isLea6 && i == 0)) {
+                receiver.rates[i] = payload[2];
+                sendAck(UBX_CFG_MSG_ID, 1);
+                return;
+            }
+        }
+    }
+    sendAck(UBX_CFG_MSG_ID, 0);
+}
+
+static void handleFrame() {
+    const uint8_t *payload = &receiver.parser.frame[UBX_PAYLOAD_INDEX];
+    uint16_t length = UbxParser_getPayloadLength(&receiver.parser);
+    if (receiver.parser.frame[UBX_CLASS_INDEX] != UBX_CFG_CLASS
+            || !(receiver.inProtocols & PROTOCOL_UBX))
+        return;
+    switch (receiver.parser.frame[UBX_ID_INDEX]) {
+        case UBX_CFG_PRT_ID:
+            handlePort(payload, length);
+            break;
+        case UBX_CFG_RATE_ID:
+            handleRate(payload, length);
+            break;
+        case UBX_CFG_MSG_ID:
+            handleMessageRate(payload, length);
+            break;
+        default:
+            sendAck(receiver.parser.frame[UBX_ID_INDEX], 0);
+            break;
+    }
+}
+
+// Takes what the host wrote, as noise at the wrong baud rate
+static void readHost() {
+    uint8_t data[READ_SIZE];
+    ssize_t length = read(receiver.master, data, sizeof(data));
+    uint16_t i = 0;
+    if (length <= 0)
+        return;
+    if (!isMatched()) {
+        for (i = 0; i < length; i++)
+            data[i] = (uint8_t)rand();
+        i = 0;
+    }
+    while (i < length) {
+        i += UbxParser_read(&receiver.parser, &data[i], (uint16_t)(length - i));
+        if (receiver.parser.hasFrame)
+            handleFrame();
+    }
+}
+
+// Sends a measurement from the circle, if it is time for one
+static void sendEpoch(uint32_t time) {
+    uint8_t payload[92];
+    double angle, lat, lon, lat0 = 36.9512546, lon0 = -122.0269492, r = 50.0;
+    int32_t velN, velE;
+    char line[96];
+    int i, length;
+
+    if ((int32_t)(time - receiver.nextTime) < 0)
+        return;
+    angle = receiver.epoch * (receiver.measureRate / 1000.0) / r; // 1 m/s
+    lat = lat0 + r * sin(angle) / 6378137.0 * 180.0 / M_PI;
+    lon = lon0 + r * cos(angle) / (6378137.0 * cos(lat0 * M_PI / 180.0)) * 180.0 / M_PI;
+    velN = (int32_t)(cos(angle) * 1000.0); // (mm/s)
+    velE = (int32_t)(-sin(angle) * 1000.0);
+    for (i = 0; i < NAV_MESSAGES; i++) {
+        if (receiver.rates[i] == 0 || receiver.epoch % receiver.rates[i] != 0)
+            continue;
+        memset(payload, 0, sizeof(payload));
+        put32(&payload[0], receiver.epoch * receiver.measureRate);
+        switch (navIds[i]) {
+            case UBX_NAV_PVT_ID:
+                payload[20] = 3;
+                put32(&payload[24], (int32_t)lround(lon * 1e7));
+                put32(&payload[28], (int32_t)lround(lat * 1e7));
+                put32(&payload[48], velN);
+                put32(&payload[52], velE);
+                sendMessage(UBX_NAV_CLASS, navIds[i], payload, 92);
+                break;
+            case UBX_NAV_POSLLH_ID:
+                put32(&payload[4], (int32_t)lround(lon * 1e7));
+                put32(&payload[8], (int32_t)lround(lat * 1e7));
+                sendMessage(UBX_NAV_CLASS, navIds[i], payload, 28);
+                break;
+            case UBX_NAV_SOL_ID:
+                payload[10] = 3;
+                sendMessage(UBX_NAV_CLASS, navIds[i], payload, 52);
+                break;
+            case UBX_NAV_VELNED_ID:
+                put32(&payload[4], velN / 10);
+                put32(&payload[8], velE / 10);
+                sendMessage(UBX_NAV_CLASS, navIds[i], payload, 36);
+                break;
+            default:
+                payload[4] = 3;
+                sendMessage(UBX_NAV_CLASS, navIds[i], payload, 16);
+                break;
+        }
+    }
+    if ((receiver.outProtocols & PROTOCOL_NMEA) && (receiver.epoch
+            * receiver.measureRate) % 1000 < receiver.measureRate) {
+        length = snprintf(line, sizeof(line),
+            "$GPGGA,%06u.00,3657.07528,N,12201.61695,W,1,08,1.0,3.6,M,-32.0,M,,*5A\r\n",
+            (unsigned)(receiver.epoch % 1000000));
+        sendBytes((const uint8_t *)line, length);
+    }
+    receiver.epoch++;
+    receiver.nextTime += receiver.measureRate;
+    if ((int32_t)(time - receiver.nextTime) > 0)
+        receiver.nextTime = time + receiver.measureRate; // fell behind
+}
+
+static int openReceiver(uint32_t baudRate, int isLea6) {
+    struct termios settings;
+    memset(&receiver, 0, sizeof(receiver));
+    receiver.master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (receiver.master < 0 || grantpt(receiver.master) != 0
+            || unlockpt(receiver.master) != 0)
+        return 0;
+    strncpy(receiver.name, ptsname(receiver.master), sizeof(receiver.name) - 1);
+    receiver.slave = open(receiver.name, O_RDWR | O_NOCTTY);
+    if (receiver.slave < 0 || tcgetattr(receiver.slave, &settings) != 0)
+        return 0;
+    cfmakeraw(&settings);
+    cfsetspeed(&settings, getSpeed(DEFAULT_BAUD));
+    tcsetattr(receiver.slave, TCSANOW, &settings);
+    fcntl(receiver.master, F_SETFL, O_NONBLOCK);
+    fcntl(receiver.slave, F_SETFL, O_NONBLOCK);
+    UbxParser_init(&receiver.parser);
+    receiver.baudRate = baudRate;
+    receiver.isLea6 = isLea6;
+    receiver.inProtocols = PROTOCOL_UBX | PROTOCOL_NMEA;
+    receiver.outProtocols = PROTOCOL_UBX | PROTOCOL_NMEA; // the defaults
+    receiver.measureRate = 1000;
+    receiver.nextTime = now();
+    return 1;
+}
+
+static void closeReceiver() {
+    close(receiver.slave);
+    close(receiver.master);
+}
+
+static void runReceiver(int timeout) {
+    struct pollfd wait = { receiver.master, POLLIN, 0 };
+    poll(&wait, 1, timeout);
+    readHost();
+    sendEpoch(now());
+}
+
+/**********************************************************************
+ * The board's end, for -t
+ **********************************************************************/
+
+static UbxParser hostParser;
+static UbxConfig hostConfig;
+static unsigned long navCounts[NAV_MESSAGES];
+
+static uint16_t hostSend(const uint8_t *frame, uint16_t length) {
+    writeAll(receiver.slave, frame, length);
+    return length;
+}
+
+static bool hostIsSent() {
+    return tcdrain(receiver.slave) == 0;
+}
+
+static void hostSetBaudRate(uint32_t baudRate) {
+    struct termios settings;
+    tcgetattr(receiver.slave, &settings);
+    cfsetspeed(&settings, getSpeed(baudRate));
+    tcsetattr(receiver.slave, TCSANOW, &settings);
+}
+
+static const UbxConfigPort hostPort = { hostSend, hostIsSent, hostSetBaudRate };
+
+static void runHost() {
+    uint8_t data[READ_SIZE];
+    ssize_t length = read(receiver.slave, data, sizeof(data));
+    uint16_t i = 0;
+    int n;
+    while (length > 0 && i < length) {
+        i += UbxParser_read(&hostParser, &data[i], (uint16_t)(length - i));
+        if (!hostParser.hasFrame)
+            continue;
+        UbxConfig_handleFrame(&hostConfig, &hostParser);
+        for (n = 0; n < NAV_MESSAGES; n++) {
+            if (hostParser.frame[UBX_CLASS_INDEX] == UBX_NAV_CLASS
+                    && hostParser.frame[UBX_ID_INDEX] == navIds[n])
+                navCounts[n]++;
+        }
+    }
+    if (!UbxConfig_isDone(&hostConfig) && !UbxConfig_hasFailed(&hostConfig))
+        UbxConfig_run(&hostConfig, now());
+}
+
+// Configures a receiver in the given state, then counts its messages
+static int runTest(uint32_t startBaud, int isLea6, int isConfigured,
+        uint32_t baudRate, uint8_t navigationRate) {
+    uint32_t start, configTime;
+    int n, failed = 0;
+    double expected, seconds;
+
+    if (!openReceiver(startBaud, isLea6)) {
+        perror("pseudo-terminal");
+        exit(2);
+    }
+    if (isConfigured) {
+        receiver.outProtocols = PROTOCOL_UBX;
+        receiver.measureRate = 1000 / navigationRate;
+        receiver.rates[isLea6 ? 2 : 0] = 1;
+    }
+    printf("%s at %u baud%s, to %u baud and %u Hz:\n", isLea6 ? "LEA-6" : "u-blox 7",
+        (unsigned)startBaud, isConfigured ? ", already set up" : "",
+        (unsigned)baudRate, navigationRate);
+
+    UbxParser_init(&hostParser);
+    UbxConfig_init(&hostConfig, &hostPort, baudRate, navigationRate);
+    start = now();
+    while (!UbxConfig_isDone(&hostConfig) && !UbxConfig_hasFailed(&hostConfig)
+            && now() - start < CONFIG_TIMEOUT) {
+        runReceiver(5);
+        runHost();
+    }
+    configTime = now() - start;
+    if (!UbxConfig_isDone(&hostConfig)) {
+        printf("    FAILED: not configured after %u ms\n", (unsigned)configTime);
+        closeReceiver();
+        return 0;
+    }
+    printf("    configured in %u ms, %s\n", (unsigned)configTime,
+        hostConfig.hasPvt ? "NAV-PVT" : "NAV-SOL, NAV-VELNED and NAV-STATUS");
+
+    memset(navCounts, 0, sizeof(navCounts));
+    start = now();
+    while (now() - start < COUNT_TIME) {
+        runReceiver(5);
+        runHost();
+    }
+    seconds = (now() - start) / 1000.0;
+    for (n = 0; n < NAV_MESSAGES; n++) {
+        int isWanted = (isLea6 ? (n == 2 || n == 3 || n == 4) : n == 0);
+        expected = isWanted ? navigationRate * seconds : 0.0;
+        printf("    NAV 0x%02X: %5.1f Hz\n", navIds[n], navCounts[n] / seconds);
+        if (fabs(navCounts[n] - expected) > navigationRate * 0.5 + 1)
+            failed = 1;
+    }
+    if (receiver.baudRate != baudRate || receiver.outProtocols != PROTOCOL_UBX
+            || hostConfig.hasPvt == isLea6)
+        failed = 1;
+    if (failed)
+        printf("    FAILED: receiver at %u baud, %u ms, out 0x%X\n",
+            (unsigned)receiver.baudRate, receiver.measureRate, receiver.outProtocols);
+    closeReceiver();
+    return !failed;
+}
+
+int main(int argc, char **argv) {
+    uint32_t baudRate = DEFAULT_BAUD;
+    int isLea6 = 0, test = 0, i, passed;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            baudRate = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-6") == 0)
+            isLea6 = 1;
+        else if (strcmp(argv[i], "-t") == 0)
+            test = 1;
+        else {
+            fprintf(stderr, "usage: %s [-b baud] [-6] [-t]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (getSpeed(baudRate) == B0) {
+        fprintf(stderr, "Unsupported baud rate %u.\n", (unsigned)baudRate);
+        return 2;
+    }
+
+    if (test) {
+        passed = runTest(9600, 0, 0, 115200, 10);
+        passed &= runTest(38400, 1, 0, 115200, 5);
+        passed &= runTest(57600, 0, 0, 38400, 5);
+        passed &= runTest(115200, 0, 1, 115200, 10);
+        if (!passed) {
+            printf("FAILED\n");
+            return 1;
+        }
+        printf("PASSED\n");
+        return 0;
+    }
+
+    if (!openReceiver(baudRate, isLea6)) {
+        perror("pseudo-terminal");
+        return 2;
+    }
+    printf("%s on %s at %u baud\n", isLea6 ? "LEA-6" : "u-blox 7", receiver.name,
+        (unsigned)baudRate);
+    fflush(stdout);
+    while (1)
+        runReceiver(10);
+    return 0;
+}
@@ -0,0 +1,704 @@
+/*
+ * ubx_stream.c feeds a u-blox UBX stream with injected bit errors through
+ * the GPS frame parser (src/UbxParser.c), and through a copy of the byte
+ * parser src/Gps.c used before, and reports the frames each accepted and
+ * rejected, how fast each parsed, and how long a fix took to reach the
+ * rest of the code.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o ubx_stream ubx_stream.c ../../src/UbxParser.c -lm
+ *
+ * Usage:
+ *     ubx_stream [-s span_bytes] [-e error_percent] [-n noise_percent]
+ *         [-r repeats] [-l loop_ms] [recording]
+ *
+ * The recording is either raw bytes from the receiver, starting with the
+ * sync bytes, or a geodetic log from model/gps/data (lat,lon,alt lines).
+ * For a log, each position is sent as the NAV-POSLLH, NAV-STATUS, NAV-SOL
+ * and NAV-VELNED frames the receiver is set up to send, with ECEF and
+ * velocity worked out from the positions. Without a recording, a boat
+ * circling at 1 m/s is generated.
+ *
+ * The given percent of frames get one bit flipped, anywhere in the frame,
+ * and the noise percent are followed by a few random bytes. The stream is
+ * handed to the parsers in spans of 1 to span_bytes bytes, like the spans
+ * returned by UART_peekContiguous.
+ *
+ * UbxParser must accept every frame that wasn't touched, in order, and no
+ * other frames, or the test fails. The old parser's count of corrupted
+ * frames it passed on, and of good frames it lost, is printed beside it.
+ *
+ * The latency replay runs each parser in a model of the Atlas superloop:
+ * each epoch is sent at its iTow at the GPS baud rate, the other state
+ * machines take 0 to twice loop_ms between GPS_runSM calls, and each call
+ * does what the GPS state machine does. The old one decoded one payload
+ * field per call; the new one decodes the NAV-SOL frame in the call that
+ * checks it. Latency is from the last byte of a NAV-SOL frame arriving to
+ * its position being returned by GPS_getPosition. Bytes that arrive while
+ * the UART's receive buffer is full are lost.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "UbxParser.h"
+
+#define DEFAULT_SPAN        64
+#define DEFAULT_ERROR       5   // (%) frames with a flipped bit
+#define DEFAULT_NOISE       2   // (%) frames followed by random bytes
+#define DEFAULT_REPEATS     20
+#define GENERATED_EPOCHS    5000
+#define MAX_NOISE           8   // (bytes) after a frame
+#define LINE_SIZE           128
+#define DEFAULT_LOOP        4.0 // (ms) mean time between GPS_runSM calls
+#define BAUD_RATE           38400
+#define UART_RX_SIZE        512 // (bytes) QUEUESIZE in src/Uart.c
+
+#define NAV_CLASS           0x01
+#define NAV_POSLLH_ID       0x02
+#define NAV_STATUS_ID       0x03
+#define NAV_SOL_ID          0x06
+#define NAV_VELNED_ID       0x12
+#define FIX_3D              0x03
+
+#define EPOCH_MS            200 // (ms) between positions, 5 Hz
+#define EARTH_A             6378137.0 // (m) WGS84 semi-major axis
+#define EARTH_E2            6.69437999014e-3 // eccentricity squared
+#define DEG_TO_RAD          (M_PI / 180.0)
+
+// Frames, as offsets into one buffer
+typedef struct {
+    uint8_t *data;
+    size_t length, size;
+    size_t *offsets;
+    unsigned long count, capacity;
+} FrameList;
+
+// Frames a parser accepted, checked against the untouched ones
+typedef struct {
+    unsigned long accepted;     // frames passed on
+    unsigned long matched;      // of those, untouched frames in order
+    unsigned long bad;          // of those, corrupted or made of noise
+} Result;
+
+typedef struct {
+    const FrameList *good;      // untouched frames, in order
+    unsigned long next;         // next untouched frame to look for
+    Result result;
+} Checker;
+
+/**********************************************************************
+ * Frame lists and building the stream
+ **********************************************************************/
+
+static void addFrame(FrameList *list, const uint8_t *frame, size_t length) {
+    if (list->length + length > list->size) {
+        list->size = (list->size + length) * 2;
+        list->data = realloc(list->data, list->size);
+    }
+    if (list->count == list->capacity) {
+        list->capacity = list->capacity * 2 + 64;
+        list->offsets = realloc(list->offsets, list->capacity * sizeof(size_t));
+    }
+    list->offsets[list->count++] = list->length;
+    memcpy(&list->data[list->length], frame, length);
+    list->length += length;
+}
+
+static size_t getFrameLength(const FrameList *list, unsigned long i) {
+    size_t end = (i + 1 < list->count) ? list->offsets[i + 1] : list->length;
+    return end - list->offsets[i];
+}
+
+static void put32(uint8_t *data, int32_t value) {
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+static void addMessage(FrameList *list, uint8_t id, const uint8_t *payload,
+        uint16_t length) {
+    uint8_t frame[UBX_MAX_FRAME_LEN];
+    addFrame(list, frame, UbxParser_pack(frame, NAV_CLASS, id, payload, length));
+}
+
+// Sends one epoch the way the receiver on the boat is set up
+static void addEpoch(FrameList *list, uint32_t iTow, double lat, double lon,
+        double alt, double velN, double velE) {
+    uint8_t posllh[28] = {0}, status[16] = {0}, sol[52] = {0}, velned[36] = {0};
+    double sinLat = sin(lat * DEG_TO_RAD), cosLat = cos(lat * DEG_TO_RAD);
+    double n = EARTH_A / sqrt(1.0 - EARTH_E2 * sinLat * sinLat);
+    double speed = sqrt(velN * velN + velE * velE);
+    double heading = atan2(velE, velN) / DEG_TO_RAD;
+    if (heading < 0.0)
+        heading += 360.0;
+
+    put32(&posllh[0], iTow);
+    put32(&posllh[4], (int32_t)lround(lon * 1e7));
+    put32(&posllh[8], (int32_t)lround(lat * 1e7));
+    put32(&posllh[12], (int32_t)lround(alt * 1e3));
+    put32(&posllh[16], (int32_t)lround(alt * 1e3));
+    put32(&posllh[20], 2500);
+    put32(&posllh[24], 4000);
+    addMessage(list, NAV_POSLLH_ID, posllh, sizeof(posllh));
+
+    put32(&status[0], iTow);
+    status[4] = FIX_3D;
+    status[5] = 0x0D; // gpsFixOk, wknSet, towSet
+    addMessage(list, NAV_STATUS_ID, status, sizeof(status));
+
+    put32(&sol[0], iTow);
+    sol[10] = FIX_3D;
+    sol[11] = 0x0D;
+    put32(&sol[12], (int32_t)lround((n + alt) * cosLat * cos(lon * DEG_TO_RAD) * 100.0));
+    put32(&sol[16], (int32_t)lround((n + alt) * cosLat * sin(lon * DEG_TO_RAD) * 100.0));
+    put32(&sol[20], (int32_t)lround((n * (1.0 - EARTH_E2) + alt) * sinLat * 100.0));
+    put32(&sol[24], 300);
+    sol[47] = 8; // numSV
+    addMessage(list, NAV_SOL_ID, sol, sizeof(sol));
+
+    put32(&velned[0], iTow);
+    put32(&velned[4], (int32_t)lround(velN * 100.0));
+    put32(&velned[8], (int32_t)lround(velE * 100.0));
+    put32(&velned[16], (int32_t)lround(speed * 100.0));
+    put32(&velned[20], (int32_t)lround(speed * 100.0));
+    put32(&velned[24], (int32_t)lround(heading * 1e5));
+    put32(&velned[28], 50);
+    put32(&velned[32], 500000);
+    addMessage(list, NAV_VELNED_ID, velned, sizeof(velned));
+}
+
+// Velocity from the last position, on a flat earth around it
+static void addPosition(FrameList *list, uint32_t epoch, double lat, double lon,
+        double alt, double lastLat, double lastLon) {
+    double dt = EPOCH_MS / 1000.0;
+    double velN = (lat - lastLat) * DEG_TO_RAD * EARTH_A / dt;
+    double velE = (lon - lastLon) * DEG_TO_RAD * EARTH_A * cos(lat * DEG_TO_RAD) / dt;
+    addEpoch(list, epoch * EPOCH_MS, lat, lon, alt, velN, velE);
+}
+
+static int readPositions(FILE *file, FrameList *list) {
+    char line[LINE_SIZE];
+    double lat, lon, alt, lastLat = 0.0, lastLon = 0.0;
+    uint32_t epoch = 0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (sscanf(line, "%lf,%lf,%lf", &lat, &lon, &alt) != 3)
+            continue;
+        if (epoch == 0) {
+            lastLat = lat;
+            lastLon = lon;
+        }
+        addPosition(list, epoch++, lat, lon, alt, lastLat, lastLon);
+        lastLat = lat;
+        lastLon = lon;
+    }
+    return list->count > 0;
+}
+
+// Splits a clean recording into frames
+static int readCapture(FILE *file, FrameList *list) {
+    uint8_t chunk[4096];
+    UbxParser parser;
+    size_t length, i;
+    UbxParser_init(&parser);
+    while ((length = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        for (i = 0; i < length; ) {
+            i += UbxParser_read(&parser, &chunk[i], (uint16_t)(length - i));
+            if (parser.hasFrame)
+                addFrame(list, parser.frame, parser.length);
+        }
+    }
+    if (parser.errorCount > 0)
+        printf("Recording has %lu bad frames, left out.\n",
+            (unsigned long)parser.errorCount);
+    return list->count > 0;
+}
+
+static void generatePositions(FrameList *list) {
+    double lat0 = 36.9512546, lon0 = -122.0269492, radius = 50.0;
+    double lat, lon, lastLat = lat0, lastLon = lon0 + radius / (EARTH_A * cos(lat0 * DEG_TO_RAD)) / DEG_TO_RAD;
+    uint32_t epoch;
+    for (epoch = 0; epoch < GENERATED_EPOCHS; epoch++) {
+        double angle = epoch * (EPOCH_MS / 1000.0) / radius; // 1 m/s
+        lat = lat0 + radius * sin(angle) / EARTH_A / DEG_TO_RAD;
+        lon = lon0 + radius * cos(angle) / (EARTH_A * cos(lat0 * DEG_TO_RAD)) / DEG_TO_RAD;
+        addPosition(list, epoch, lat, lon, 3.6, lastLat, lastLon);
+        lastLat = lat;
+        lastLon = lon;
+    }
+}
+
+// Time the receiver sends a frame, from its iTow, or -1 if not known
+static double getSendTime(const uint8_t *frame, size_t length) {
+    static uint32_t firstTow;
+    static bool hasFirstTow = false;
+    uint32_t iTow;
+    if (frame[UBX_CLASS_INDEX] != NAV_CLASS || length < UBX_HEADER_LEN + 4
+            + UBX_CHECKSUM_LEN)
+        return -1.0;
+    iTow = frame[6] | (frame[7] << 8) | (frame[8] << 16) | ((uint32_t)frame[9] << 24);
+    if (!hasFirstTow) {
+        firstTow = iTow;
+        hasFirstTow = true;
+    }
+    return (double)(iTow - firstTow);
+}
+
+// Copies the frames into a stream, breaking some and adding noise. Each
+// epoch is sent at its iTow, a byte at a time at the baud rate.
+static uint8_t *buildStream(const FrameList *frames, int errorPercent,
+        int noisePercent, FrameList *good, size_t *length,
+        unsigned long *corrupted, double **arrival) {
+    uint8_t *data = malloc(frames->length + frames->count * MAX_NOISE);
+    double byteMs = 10000.0 / BAUD_RATE, time = 0.0, sendTime;
+    size_t used = 0, frameLength, start;
+    unsigned long i;
+    int n;
+
+    *arrival = malloc((frames->length + frames->count * MAX_NOISE) * sizeof(double));
+    srand(1);
+    *corrupted = 0;
+    for (i = 0; i < frames->count; i++) {
+        frameLength = getFrameLength(frames, i);
+        start = used;
+        memcpy(&data[used], &frames->data[frames->offsets[i]], frameLength);
+        sendTime = getSendTime(&data[used], frameLength);
+        if (sendTime > time)
+            time = sendTime;
+        if (rand() % 100 < errorPercent) {
+            data[used + rand() % frameLength] ^= (uint8_t)(1 << (rand() % 8));
+            (*corrupted)++;
+        }
+        else
+            addFrame(good, &data[used], frameLength);
+        used += frameLength;
+        if (rand() % 100 < noisePercent) {
+            for (n = rand() % MAX_NOISE + 1; n > 0; n--)
+                data[used++] = (uint8_t)rand();
+        }
+        for (; start < used; start++) {
+            time += byteMs;
+            (*arrival)[start] = time; // when the whole byte is in
+        }
+    }
+    *length = used;
+    return data;
+}
+
+/**********************************************************************
+ * Checking frames
+ **********************************************************************/
+
+static void checkFrame(Checker *checker, const uint8_t *frame, size_t length) {
+    const FrameList *good = checker->good;
+    unsigned long i;
+    checker->result.accepted++;
+    // Good frames can be lost to the old parser, so look ahead for it
+    for (i = checker->next; i < good->count; i++) {
+        if (getFrameLength(good, i) == length
+                && memcmp(&good->data[good->offsets[i]], frame, length) == 0) {
+            checker->next = i + 1;
+            checker->result.matched++;
+            return;
+        }
+    }
+    checker->result.bad++;
+}
+
+/**********************************************************************
+ * Parsers
+ **********************************************************************/
+
+static Result runUbxParser(const uint8_t *data, size_t length, size_t span,
+        const FrameList *good, UbxParser *parser) {
+    Checker checker = { good, 0, {0, 0, 0} };
+    size_t i = 0, end;
+    srand(2);
+    UbxParser_init(parser);
+    while (i < length) {
+        end = i + rand() % span + 1;
+        if (end > length)
+            end = length;
+        while (i < end) {
+            i += UbxParser_read(parser, &data[i], (uint16_t)(end - i));
+            if (parser->hasFrame && good != NULL)
+                checkFrame(&checker, parser->frame, parser->length);
+        }
+    }
+    return checker.result;
+}
+
+// src/Gps.c before UbxParser: no checksum, and back to idle on a bad sync
+typedef struct {
+    uint8_t message[256];
+    uint8_t byteIndex, messageLength;
+} OldParser;
+
+static int readOldByte(OldParser *parser, uint8_t ch) {
+    parser->message[parser->byteIndex] = ch;
+    switch (parser->byteIndex) {
+        case 0:
+            if (ch != UBX_SYNC1)
+                return -1;
+            break;
+        case 1:
+            if (ch != UBX_SYNC2)
+                return -1;
+            break;
+        case 2:
+        case 3:
+            break;
+        case 4:
+            parser->messageLength = ch;
+            break;
+        case 5:
+            parser->messageLength += ch << 8;
+            parser->messageLength += UBX_HEADER_LEN + UBX_CHECKSUM_LEN;
+            break;
+        default:
+            if (parser->byteIndex >= (parser->messageLength - 1)) {
+                parser->byteIndex++;
+                return 1;
+            }
+    }
+    parser->byteIndex++;
+    return 0;
+}
+
+static Result runOldParser(const uint8_t *data, size_t length, size_t span,
+        const FrameList *good) {
+    Checker checker = { good, 0, {0, 0, 0} };
+    OldParser parser;
+    size_t i = 0, end;
+    int result;
+    srand(2);
+    parser.byteIndex = 0;
+    while (i < length) {
+        end = i + rand() % span + 1;
+        if (end > length)
+            end = length;
+        for (; i < end; i++) {
+            result = readOldByte(&parser, data[i]);
+            if (result != 0) {
+                if (result > 0 && good != NULL)
+                    checkFrame(&checker, parser.message, parser.byteIndex);
+                parser.byteIndex = 0;
+            }
+        }
+    }
+    return checker.result;
+}
+
+/**********************************************************************
+ * Latency replay
+ **********************************************************************/
+
+typedef struct {
+    unsigned long fixes;
+    unsigned long calls;        // GPS_runSM calls after the frame was read
+    double total, worst;        // (ms)
+    unsigned long dropped;      // bytes lost to a full UART buffer
+} Latency;
+
+// The stream as the GPS state machine gets it from the UART
+typedef struct {
+    const uint8_t *data;
+    const double *arrival;      // (ms) of each byte
+    size_t length;
+    size_t next;                // next byte to arrive
+    uint8_t *received;          // bytes that fit in the UART buffer
+    double *receivedTime;
+    size_t count;               // bytes received
+    size_t read;                // bytes taken from the UART
+    unsigned long dropped;
+    double time;                // (ms)
+    unsigned long calls;
+    bool reading;               // read state, else idle
+} Loop;
+
+static void startLoop(Loop *loop, const uint8_t *data, const double *arrival,
+        size_t length) {
+    memset(loop, 0, sizeof(Loop));
+    loop->data = data;
+    loop->arrival = arrival;
+    loop->length = length;
+    loop->received = malloc(length);
+    loop->receivedTime = malloc(length * sizeof(double));
+    srand(3);
+}
+
+static Latency endLoop(Loop *loop, Latency latency) {
+    free(loop->received);
+    free(loop->receivedTime);
+    latency.dropped = loop->dropped;
+    return latency;
+}
+
+static void addFix(Latency *latency, const Loop *loop, size_t frameEnd,
+        unsigned long frameCall) {
+    double delay = loop->time - loop->receivedTime[frameEnd - 1];
+    latency->fixes++;
+    latency->calls += loop->calls - frameCall;
+    latency->total += delay;
+    if (delay > latency->worst)
+        latency->worst = delay;
+}
+
+// Runs the other state machines, then returns for a GPS_runSM call
+static bool nextCall(Loop *loop, double loopMs) {
+    if (loop->next >= loop->length && loop->read >= loop->count)
+        return false;
+    loop->time += 2.0 * loopMs * rand() / RAND_MAX;
+    for (; loop->next < loop->length && loop->arrival[loop->next] <= loop->time;
+            loop->next++) {
+        if (loop->count - loop->read >= UART_RX_SIZE) {
+            loop->dropped++;
+            continue;
+        }
+        loop->receivedTime[loop->count] = loop->arrival[loop->next];
+        loop->received[loop->count++] = loop->data[loop->next];
+    }
+    loop->calls++;
+    return true;
+}
+
+// GPS_runSM with UbxParser and whole frame decoding
+static Latency replayUbxParser(const uint8_t *data, const double *arrival,
+        size_t length, double loopMs) {
+    Latency latency = { 0, 0, 0.0, 0.0, 0 };
+    Loop loop;
+    UbxParser parser;
+    UbxNavSol sol;
+    size_t span;
+
+    startLoop(&loop, data, arrival, length);
+    UbxParser_init(&parser);
+    while (nextCall(&loop, loopMs)) {
+        if (!loop.reading) {
+            if (loop.count == loop.read)
+                continue;
+            loop.reading = true; // and read in this call
+        }
+        span = loop.count - loop.read;
+        loop.read += UbxParser_read(&parser, &loop.received[loop.read],
+            (uint16_t)(span < 0xFFFF ? span : 0xFFFF));
+        if (parser.hasFrame) {
+            if (parser.frame[UBX_CLASS_INDEX] == NAV_CLASS
+                    && parser.frame[UBX_ID_INDEX] == NAV_SOL_ID
+                    && UbxParser_getPayload(&parser, &sol, sizeof(sol)))
+                addFix(&latency, &loop, loop.read - (parser.held - parser.length),
+                    loop.calls);
+            loop.reading = false;
+        }
+    }
+    return endLoop(&loop, latency);
+}
+
+// GPS_runSM calls the old parse state took for a frame's payload
+static unsigned long getOldFieldCalls(const uint8_t *frame, unsigned long *fixCall) {
+    *fixCall = 0;
+    if (frame[UBX_CLASS_INDEX] != NAV_CLASS)
+        return 1;
+    switch (frame[UBX_ID_INDEX]) {
+        case NAV_POSLLH_ID:
+            return 7;
+        case NAV_STATUS_ID:
+            return 7;
+        case NAV_SOL_ID:
+            *fixCall = 8; // ecefZ, after iTow to ecefY
+            return 11;
+        case NAV_VELNED_ID:
+            return 8;
+        default:
+            return 1;
+    }
+}
+
+// GPS_runSM with the old byte parser and one payload field per call
+static Latency replayOldParser(const uint8_t *data, const double *arrival,
+        size_t length, double loopMs) {
+    Latency latency = { 0, 0, 0.0, 0.0, 0 };
+    Loop loop;
+    OldParser parser = { {0}, 0, 0 };
+    bool hasNewMessage = false, parsing = false;
+    unsigned long fields = 0, fieldCalls = 0, fixCall = 0, frameCall = 0;
+    size_t frameEnd = 0;
+    int result = 0;
+
+    startLoop(&loop, data, arrival, length);
+    while (nextCall(&loop, loopMs)) {
+        if (parsing) {
+            if (!hasNewMessage) {
+                parsing = false; // back to idle
+                loop.reading = false;
+            }
+            else if (fields++ < fieldCalls) {
+                if (fields == fixCall)
+                    addFix(&latency, &loop, frameEnd, frameCall);
+            }
+            else
+                hasNewMessage = false;
+        }
+        else if (!loop.reading) {
+            if (loop.count > loop.read) {
+                loop.reading = true;
+                parser.byteIndex = 0;
+            }
+        }
+        else if (hasNewMessage) {
+            parsing = true;
+            fields = 0;
+            fieldCalls = getOldFieldCalls(parser.message, &fixCall);
+        }
+        else {
+            for (result = 0; loop.read < loop.count && result == 0; loop.read++)
+                result = readOldByte(&parser, loop.received[loop.read]);
+            if (result > 0) {
+                hasNewMessage = true;
+                frameEnd = loop.read;
+                frameCall = loop.calls;
+            }
+            else if (result < 0)
+                loop.reading = false;
+        }
+    }
+    return endLoop(&loop, latency);
+}
+
+static void reportLatency(const char *name, Latency latency) {
+    if (latency.fixes == 0) {
+        printf("%-10s no NAV-SOL fixes\n", name);
+        return;
+    }
+    printf("%-10s %7lu fixes  %6.2f ms mean  %6.2f ms worst  %5.2f more calls  %6lu bytes lost\n",
+        name, latency.fixes, latency.total / latency.fixes, latency.worst,
+        (double)latency.calls / latency.fixes, latency.dropped);
+}
+
+static double now() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void report(const char *name, Result result, unsigned long good,
+        double seconds, size_t length, int repeats) {
+    printf("%-10s %7lu accepted  %5lu corrupted  %5lu good lost  %6.2f ns/byte  %7.2f MB/s\n",
+        name, result.accepted, result.bad, good - result.matched,
+        seconds * 1e9 / ((double)length * repeats), length * repeats / seconds / 1e6);
+}
+
+int main(int argc, char **argv) {
+    size_t span = DEFAULT_SPAN, length;
+    int errorPercent = DEFAULT_ERROR, noisePercent = DEFAULT_NOISE;
+    int repeats = DEFAULT_REPEATS, i, c, passed;
+    double loopMs = DEFAULT_LOOP;
+    const char *path = NULL;
+    FrameList frames, good;
+    FILE *file;
+    uint8_t *data;
+    double *arrival;
+    UbxParser parser;
+    unsigned long corrupted;
+    Result ubxRun, oldRun;
+    double start, ubxTime, oldTime;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            span = strtoul(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+            errorPercent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            noisePercent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            repeats = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            loopMs = atof(argv[++i]);
+        else if (argv[i][0] == '-') {
+            fprintf(stderr, "usage: %s [-s span_bytes] [-e error_percent] "
+                "[-n noise_percent] [-r repeats] [-l loop_ms] [recording]\n", argv[0]);
+            return 2;
+        }
+        else
+            path = argv[i];
+    }
+    if (span == 0 || span > 0xFFFF || repeats <= 0 || errorPercent < 0
+            || noisePercent < 0 || loopMs < 0.0) {
+        fprintf(stderr, "Bad span size, percent, repeat count or loop time.\n");
+        return 2;
+    }
+
+    memset(&frames, 0, sizeof(frames));
+    memset(&good, 0, sizeof(good));
+    if (path == NULL)
+        generatePositions(&frames);
+    else {
+        file = fopen(path, "rb");
+        if (file == NULL) {
+            fprintf(stderr, "Could not read %s.\n", path);
+            return 1;
+        }
+        c = fgetc(file);
+        rewind(file);
+        if (!((c == UBX_SYNC1) ? readCapture(file, &frames) : readPositions(file, &frames))) {
+            fprintf(stderr, "No frames or positions in %s.\n", path);
+            fclose(file);
+            return 1;
+        }
+        fclose(file);
+    }
+
+    data = buildStream(&frames, errorPercent, noisePercent, &good, &length,
+        &corrupted, &arrival);
+    printf("%s: %lu frames (%lu with a flipped bit), %lu bytes, %lu byte spans\n",
+        (path != NULL) ? path : "generated circle", frames.count, corrupted,
+        (unsigned long)length, (unsigned long)span);
+
+    ubxRun = runUbxParser(data, length, span, &good, &parser);
+    oldRun = runOldParser(data, length, span, &good);
+    printf("UbxParser: %lu good frames, %lu bad length or checksum, %lu resync bytes\n",
+        (unsigned long)parser.frameCount, (unsigned long)parser.errorCount,
+        (unsigned long)parser.skippedCount);
+
+    start = now();
+    for (i = 0; i < repeats; i++)
+        runOldParser(data, length, span, NULL);
+    oldTime = now() - start;
+
+    start = now();
+    for (i = 0; i < repeats; i++)
+        runUbxParser(data, length, span, NULL, &parser);
+    ubxTime = now() - start;
+
+    report("old Gps.c", oldRun, good.count, oldTime, length, repeats);
+    report("UbxParser", ubxRun, good.count, ubxTime, length, repeats);
+
+    printf("Latency, %d baud and %.1f ms mean loop:\n", BAUD_RATE, loopMs);
+    reportLatency("old Gps.c", replayOldParser(data, arrival, length, loopMs));
+    reportLatency("UbxParser", replayUbxParser(data, arrival, length, loopMs));
+
+    passed = ubxRun.bad == 0 && ubxRun.matched == good.count
+        && ubxRun.accepted == good.count;
+    free(data);
+    free(arrival);
+    free(frames.data);
+    free(frames.offsets);
+    free(good.data);
+    free(good.offsets);
+    if (!passed) {
+        printf("FAILED: UbxParser accepted %lu corrupted frames and lost %lu good ones.\n",
+            ubxRun.bad, good.count - ubxRun.matched);
+        return 1;
+    }
+    printf("PASSED: UbxParser accepted all %lu good frames and rejected all %lu corrupted.\n",
+        good.count, corrupted);
+    return 0;
+}
@@ -0,0 +1,467 @@
+/*
+ * xbee_emulator.c stands in for a pair of XBee radios, each on a
+ * pseudo-terminal, so code built for a host can talk to "radios" in API
+ * mode without the hardware.
+ *
+ * Author: David Goodman (dagoodma@ucsc.edu)
+ *
+ * Build (from this folder):
+ *     gcc -O2 -I../../include -o xbee_emulator xbee_emulator.c ../../src/XbeeApi.c
+ *
+ * Usage:
+ *     xbee_emulator [-l loss_percent] [-r rssi] [-t [packets]]
+ *
+ * Prints the pseudo-terminal of each radio and runs until killed. A radio
+ * starts in transparent mode, like a new XBee. "+++" on its own enters
+ * command mode, where every AT command is answered "OK\r", ATAP1 and ATAP0
+ * switch API mode on and off, and ATCN leaves.
+ *
+ * In API mode a transmit request (0x10) to the other radio's address, or a
+ * broadcast, comes out of the other radio as a receive packet (0x90). Each
+ * try is lost with the given chance. A unicast is tried up to
+ * MAC_RETRIES more times, and the transmit status (0x8B) gives the retries
+ * and whether it got through. An AT command (0x08) for DB answers with the
+ * given RSSI (-dBm). Other AT commands are answered OK with no value. In
+ * transparent mode bytes are sent as they come, one try each.
+ *
+ * With -t, the emulator runs both boards itself: it switches both radios
+ * to API mode like Xbee_init in src/Xbee.c, sends packets each way and
+ * reads DB. Fails if a packet comes out wrong, from the wrong address, or
+ * not at all when its transmit status said it was delivered.
+ *
+ * Notes:
+ * 2026-10-18 -- dagoodma
+ *     Created.
+ */
+#define _XOPEN_SOURCE 600
+#define _DEFAULT_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#include "XbeeApi.h"
+
+#define RADIOS              2
+#define MAC_RETRIES         10 // RR, tries after the first for a unicast
+#define DEFAULT_RSSI        60 // (-dBm)
+#define DEFAULT_PACKETS     500
+#define LINE_SIZE           32
+#define READ_SIZE           512
+#define WAIT_TIMEOUT        1000 // (ms) for a board to get what it expects
+
+#define TRANSMIT_FRAME_ID   0 // offsets in a transmit request after the type
+#define TRANSMIT_ADDRESS    1
+#define TRANSMIT_DATA       13
+#define RECEIVE_ACKED       0x01 // receive options
+#define RECEIVE_BROADCAST   0x02
+#define MAC_ACK_FAILURE     0x01 // transmit status
+
+typedef struct {
+    int master;
+    int slave; // held open to keep it raw, and used by -t
+    char name[64];
+    uint8_t address[XBEE_API_ADDRESS_LEN];
+    XbeeApiParser parser;
+    int apiMode;
+    int commandMode;
+    char line[LINE_SIZE];
+    int lineLength;
+} Radio;
+
+// The board's end, for -t
+typedef struct {
+    XbeeApiParser parser;
+    char text[LINE_SIZE]; // answers in command mode
+    int textLength;
+    uint8_t expected[XBEE_API_MAX_DATA]; // packet on its way here
+    uint16_t expectedLength;
+    int isExpecting;
+    const uint8_t *peerAddress;
+    unsigned long packets, wrong, statuses, delivered, failed, retries;
+    uint8_t lastStatus;
+    int rssi;
+} Board;
+
+static Radio radios[RADIOS];
+static Radio *current;
+static Board boards[RADIOS];
+static Board *currentBoard;
+static int lossPercent, rssi = DEFAULT_RSSI;
+
+static const uint8_t broadcastAddress[XBEE_API_ADDRESS_LEN] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF };
+
+
+static void writeAll(int fd, const void *data, size_t length) {
+    const uint8_t *bytes = data;
+    ssize_t n;
+    while (length > 0) {
+        n = write(fd, bytes, length);
+        if (n <= 0) {
+            perror("write");
+            exit(2);
+        }
+        bytes += n;
+        length -= n;
+    }
+}
+
+static int openRadio(Radio *radio, uint8_t last) {
+    struct termios settings;
+    radio->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (radio->master < 0 || grantpt(radio->master) != 0 || unlockpt(radio->master) != 0)
+        return 0;
+    strncpy(radio->name, ptsname(radio->master), sizeof(radio->name) - 1);
+    radio->slave = open(radio->name, O_RDWR | O_NOCTTY);
+    if (radio->slave < 0 || tcgetattr(radio->slave, &settings) != 0)
+        return 0;
+    cfmakeraw(&settings);
+    tcsetattr(radio->slave, TCSANOW, &settings);
+    fcntl(radio->master, F_SETFL, O_NONBLOCK);
+    fcntl(radio->slave, F_SETFL, O_NONBLOCK);
+    memcpy(radio->address, "\x00\x13\xA2\x00\x40\x00\x00", 7);
+    radio->address[7] = last;
+    XbeeApi_init(&radio->parser);
+    return 1;
+}
+
+static Radio *otherRadio(Radio *radio) {
+    return &radios[(radio == &radios[0]) ? 1 : 0];
+}
+
+// Hands RF data from a radio to the other one's board
+static void deliver(Radio *from, const uint8_t *data, uint16_t length, uint8_t options) {
+    Radio *to = otherRadio(from);
+    uint8_t frameData[XBEE_API_MAX_FRAME_DATA], frame[XBEE_API_MAX_FRAME_LEN];
+    if (!to->apiMode) {
+        writeAll(to->master, data, length);
+        return;
+    }
+    memcpy(frameData, from->address, XBEE_API_ADDRESS_LEN);
+    frameData[8] = 0xFF; // 16 bit address unknown
+    frameData[9] = 0xFE;
+    frameData[10] = options;
+    memcpy(&frameData[11], data, length);
+    writeAll(to->master, frame, XbeeApi_pack(frame, XBEE_API_RECEIVE_PACKET, frameData,
+        XBEE_API_RECEIVE_HEADER_LEN - 1 + length));
+}
+
+static void transmit(Radio *radio, const XbeeApiFrame *request) {
+    const uint8_t *address = &request->data[TRANSMIT_ADDRESS];
+    int broadcast = memcmp(address, broadcastAddress, XBEE_API_ADDRESS_LEN) == 0;
+    int tries = 0, delivered = 0;
+    uint8_t status[6], frame[16];
+
+    if (request->length < TRANSMIT_DATA)
+        return;
+    if (broadcast || memcmp(address, otherRadio(radio)->address,
+            XBEE_API_ADDRESS_LEN) == 0) {
+        do {
+            tries++;
+            delivered = rand() % 100 >= lossPercent;
+        } while (!delivered && !broadcast && tries <= MAC_RETRIES);
+    }
+    else
+        tries = MAC_RETRIES + 1; // nobody answers
+    if (delivered)
+        deliver(radio, &request->data[TRANSMIT_DATA], request->length - TRANSMIT_DATA,
+            broadcast ? RECEIVE_BROADCAST : RECEIVE_ACKED);
+
+    if (request->data[TRANSMIT_FRAME_ID] == XBEE_API_NO_FRAME_ID)
+        return;
+    status[0] = request->data[TRANSMIT_FRAME_ID];
+    status[1] = 0xFF;
+    status[2] = 0xFE;
+    status[3] = (uint8_t)(tries - 1);
+    status[4] = (delivered || broadcast) ? XBEE_API_DELIVERED : MAC_ACK_FAILURE;
+    status[5] = 0; // no discovery
+    writeAll(radio->master, frame, XbeeApi_pack(frame, XBEE_API_TRANSMIT_STATUS, status,
+        sizeof(status)));
+}
+
+static void answerCommand(Radio *radio, const XbeeApiFrame *command) {
+    uint8_t response[5], frame[16];
+    uint16_t length = 4;
+    if (command->length < 3)
+        return;
+    response[0] = command->data[0];
+    response[1] = command->data[1];
+    response[2] = command->data[2];
+    response[3] = XBEE_API_AT_OK;
+    if (command->data[1] == 'D' && command->data[2] == 'B')
+        response[length++] = (uint8_t)rssi;
+    writeAll(radio->master, frame, XbeeApi_pack(frame, XBEE_API_AT_RESPONSE, response,
+        length));
+}
+
+static void handleRadioFrame(const XbeeApiFrame *frame) {
+    if (frame->type == XBEE_API_TRANSMIT_REQUEST)
+        transmit(current, frame);
+    else if (frame->type == XBEE_API_AT_COMMAND)
+        answerCommand(current, frame);
+}
+
+static void handleCommandLine(Radio *radio) {
+    radio->line[radio->lineLength] = '\0';
+    if (strcmp(radio->line, "ATAP1") == 0 || strcmp(radio->line, "ATAP2") == 0)
+        radio->apiMode = 1;
+    else if (strcmp(radio->line, "ATAP0") == 0)
+        radio->apiMode = 0;
+    else if (strcmp(radio->line, "ATCN") == 0)
+        radio->commandMode = 0;
+    writeAll(radio->master, "OK\r", 3);
+    radio->lineLength = 0;
+}
+
+// Takes what a board wrote to its radio
+static void serviceRadio(Radio *radio) {
+    uint8_t data[READ_SIZE];
+    ssize_t length, i;
+    while ((length = read(radio->master, data, sizeof(data))) > 0) {
+        if (length == 3 && memcmp(data, "+++", 3) == 0) {
+            radio->commandMode = 1;
+            radio->lineLength = 0;
+            writeAll(radio->master, "OK\r", 3);
+        }
+        else if (radio->commandMode) {
+            for (i = 0; i < length; i++) {
+                if (data[i] == '\r')
+                    handleCommandLine(radio);
+                else if (radio->lineLength < LINE_SIZE - 1)
+                    radio->line[radio->lineLength++] = (char)data[i];
+            }
+        }
+        else if (radio->apiMode) {
+            current = radio;
+            XbeeApi_parse(&radio->parser, data, (uint16_t)length, handleRadioFrame);
+        }
+        else if (rand() % 100 >= lossPercent)
+            deliver(radio, data, (uint16_t)length, RECEIVE_BROADCAST);
+    }
+}
+
+static void serviceRadios(int timeout) {
+    struct pollfd fds[RADIOS];
+    int i;
+    for (i = 0; i < RADIOS; i++) {
+        fds[i].fd = radios[i].master;
+        fds[i].events = POLLIN;
+    }
+    if (poll(fds, RADIOS, timeout) <= 0)
+        return;
+    for (i = 0; i < RADIOS; i++) {
+        if (fds[i].revents & POLLIN)
+            serviceRadio(&radios[i]);
+    }
+}
+
+
+/*------------------------- Self test ----------------------------*/
+
+static void handleBoardFrame(const XbeeApiFrame *frame) {
+    Board *board = currentBoard;
+    switch (frame->type) {
+        case XBEE_API_RECEIVE_PACKET:
+            board->packets++;
+            if (!board->isExpecting
+                    || memcmp(frame->address, board->peerAddress, XBEE_API_ADDRESS_LEN) != 0
+                    || frame->length != board->expectedLength
+                    || memcmp(frame->data, board->expected, frame->length) != 0)
+                board->wrong++;
+            board->isExpecting = 0;
+            break;
+        case XBEE_API_TRANSMIT_STATUS:
+            board->statuses++;
+            board->retries += frame->retries;
+            board->lastStatus = frame->status;
+            if (frame->status == XBEE_API_DELIVERED)
+                board->delivered++;
+            else
+                board->failed++;
+            break;
+        case XBEE_API_AT_RESPONSE:
+            if (frame->command[0] == 'D' && frame->command[1] == 'B' && frame->length > 0)
+                board->rssi = frame->data[0];
+            break;
+    }
+}
+
+// Runs the radios and reads what comes to a board, until done() or timeout
+static int waitFor(int board, int (*done)(const Board *board, unsigned long count),
+        unsigned long count, int timeout) {
+    Board *b = &boards[board];
+    uint8_t data[READ_SIZE];
+    ssize_t length, i;
+    int waited;
+    currentBoard = b;
+    for (waited = 0; waited < timeout && !done(b, count); waited++) {
+        serviceRadios(1);
+        while ((length = read(radios[board].slave, data, sizeof(data))) > 0) {
+            for (i = 0; i < length && b->textLength < LINE_SIZE - 1; i++)
+                b->text[b->textLength++] = (char)data[i];
+            b->text[b->textLength] = '\0';
+            XbeeApi_parse(&b->parser, data, (uint16_t)length, handleBoardFrame);
+        }
+    }
+    return done(b, count);
+}
+
+static int hasOk(const Board *board, unsigned long count) {
+    (void)count;
+    return strstr(board->text, "OK\r") != NULL;
+}
+
+static int hasStatuses(const Board *board, unsigned long count) {
+    return board->statuses >= count;
+}
+
+static int hasPackets(const Board *board, unsigned long count) {
+    return board->packets >= count;
+}
+
+static int hasRssi(const Board *board, unsigned long count) {
+    (void)count;
+    return board->rssi != 0;
+}
+
+// Like setApiMode in src/Xbee.c
+static int setApiMode(int board) {
+    const char *commands[] = {"+++", "ATAP1\r", "ATCN\r"};
+    int i;
+    for (i = 0; i < 3; i++) {
+        boards[board].textLength = 0;
+        boards[board].text[0] = '\0';
+        writeAll(radios[board].slave, commands[i], strlen(commands[i]));
+        if (!waitFor(board, hasOk, 0, WAIT_TIMEOUT))
+            return 0;
+    }
+    return 1;
+}
+
+// Sends a packet from a board, returns FALSE if it didn't come out right
+static int sendPacket(int from, uint8_t frameId) {
+    Board *sender = &boards[from], *receiver = &boards[RADIOS - 1 - from];
+    uint8_t header[XBEE_API_TRANSMIT_HEADER_LEN], checksum;
+    const uint8_t *address = (from == 0) ? radios[1].address : broadcastAddress;
+    unsigned long packets = receiver->packets;
+    uint16_t i;
+
+    receiver->expectedLength = 1 + rand() % 120;
+    for (i = 0; i < receiver->expectedLength; i++)
+        receiver->expected[i] = (uint8_t)rand();
+    receiver->isExpecting = 1;
+    XbeeApi_packTransmitHeader(header, frameId, address, receiver->expected,
+        receiver->expectedLength, &checksum);
+    writeAll(radios[from].slave, header, sizeof(header));
+    writeAll(radios[from].slave, receiver->expected, receiver->expectedLength);
+    writeAll(radios[from].slave, &checksum, 1);
+
+    if (!waitFor(from, hasStatuses, sender->statuses + 1, WAIT_TIMEOUT))
+        return 0;
+    // A broadcast is always reported delivered, so the wait is short
+    if (address == broadcastAddress)
+        waitFor(RADIOS - 1 - from, hasPackets, packets + 1, 20);
+    else if (sender->lastStatus == XBEE_API_DELIVERED)
+        return waitFor(RADIOS - 1 - from, hasPackets, packets + 1, WAIT_TIMEOUT);
+    else if (waitFor(RADIOS - 1 - from, hasPackets, packets + 1, 20))
+        return 0; // came out after the radio gave up
+    receiver->isExpecting = 0;
+    return 1;
+}
+
+static int runTest(unsigned long packets) {
+    uint8_t command[16];
+    unsigned long n, lost = 0;
+    int board;
+
+    for (board = 0; board < RADIOS; board++) {
+        memset(&boards[board], 0, sizeof(Board));
+        XbeeApi_init(&boards[board].parser);
+        boards[board].peerAddress = radios[RADIOS - 1 - board].address;
+        if (!setApiMode(board)) {
+            printf("FAILED: radio %c didn't answer OK.\n", 'A' + board);
+            return 0;
+        }
+    }
+
+    for (n = 0; n < packets; n++) {
+        for (board = 0; board < RADIOS; board++) {
+            if (!sendPacket(board, (uint8_t)(1 + n % 255)))
+                lost++;
+        }
+    }
+
+    writeAll(radios[0].slave, command, XbeeApi_packAtCommand(command, 1, "DB"));
+    waitFor(0, hasRssi, 0, WAIT_TIMEOUT);
+
+    printf("%lu packets each way, %d%% loss:\n", packets, lossPercent);
+    printf("  A to B unicast    %5lu delivered, %4lu failed, %5lu retries, %5lu received\n",
+        boards[0].delivered, boards[0].failed, boards[0].retries, boards[1].packets);
+    printf("  B to A broadcast  %5lu sent, %5lu received\n", boards[1].statuses,
+        boards[0].packets);
+    printf("  RSSI -%d dBm\n", boards[0].rssi);
+
+    if (lost > 0 || boards[0].wrong > 0 || boards[1].wrong > 0) {
+        printf("FAILED: %lu packets missing, %lu wrong.\n", lost,
+            boards[0].wrong + boards[1].wrong);
+        return 0;
+    }
+    if (boards[0].rssi != rssi) {
+        printf("FAILED: DB read %d, not %d.\n", boards[0].rssi, rssi);
+        return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    unsigned long packets = 0;
+    int i, test = 0;
+
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            lossPercent = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            rssi = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0) {
+            test = 1;
+            packets = DEFAULT_PACKETS;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                packets = strtoul(argv[++i], NULL, 10);
+        }
+        else {
+            fprintf(stderr, "usage: %s [-l loss_percent] [-r rssi] [-t [packets]]\n",
+                argv[0]);
+            return 2;
+        }
+    }
+    if (lossPercent < 0 || lossPercent > 100 || rssi <= 0 || rssi > 255) {
+        fprintf(stderr, "Bad loss or RSSI.\n");
+        return 2;
+    }
+
+    srand(11);
+    for (i = 0; i < RADIOS; i++) {
+        if (!openRadio(&radios[i], (uint8_t)(1 + i))) {
+            perror("pseudo-terminal");
+            return 2;
+        }
+    }
+
+    if (test) {
+        if (!runTest(packets))
+            return 1;
+        printf("PASSED\n");
+        return 0;
+    }
+
+    for (i = 0; i < RADIOS; i++)
+        printf("Radio %c: %s (address 0013A2004000000%d)\n", 'A' + i, radios[i].name,
+            1 + i);
+    fflush(stdout);
+    while (1)
+        serviceRadios(-1);
+    return 0;
+}